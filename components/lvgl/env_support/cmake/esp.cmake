@@ -1,4 +1,13 @@
-file(GLOB_RECURSE SOURCES ${LVGL_ROOT_DIR}/src/*.c)
+file(GLOB_RECURSE SOURCES ${LVGL_ROOT_DIR}/src/*.c ${LVGL_ROOT_DIR}/src/*.S)
+
+if(CONFIG_LV_USE_DEMO_WIDGETS
+   OR CONFIG_LV_USE_DEMO_KEYPAD_AND_ENCODER
+   OR CONFIG_LV_USE_DEMO_BENCHMARK
+   OR CONFIG_LV_USE_DEMO_STRESS
+   OR CONFIG_LV_USE_DEMO_MUSIC)
+  file(GLOB_RECURSE DEMO_SOURCES ${LVGL_ROOT_DIR}/demos/*.c)
+  set(DEMO_INCLUDES ${LVGL_ROOT_DIR}/demos/)
+endif()
 
 idf_build_get_property(LV_MICROPYTHON LV_MICROPYTHON)
 
@@ -6,10 +15,12 @@ if(LV_MICROPYTHON)
   idf_component_register(
     SRCS
     ${SOURCES}
+    ${DEMO_SOURCES}
     INCLUDE_DIRS
     ${LVGL_ROOT_DIR}
     ${LVGL_ROOT_DIR}/src
     ${LVGL_ROOT_DIR}/../
+    ${DEMO_INCLUDES}
     REQUIRES
     main)
 
@@ -21,8 +32,8 @@ if(LV_MICROPYTHON)
                                INTERFACE "-DLV_ATTRIBUTE_FAST_MEM=IRAM_ATTR")
   endif()
 else()
-  idf_component_register(SRCS ${SOURCES} INCLUDE_DIRS ${LVGL_ROOT_DIR}
-                         ${LVGL_ROOT_DIR}/src ${LVGL_ROOT_DIR}/../)
+  idf_component_register(SRCS ${SOURCES} ${DEMO_SOURCES} INCLUDE_DIRS ${LVGL_ROOT_DIR}
+                         ${LVGL_ROOT_DIR}/src ${LVGL_ROOT_DIR}/../ ${DEMO_INCLUDES})
 
   target_compile_definitions(${COMPONENT_LIB} PUBLIC "-DLV_CONF_INCLUDE_SIMPLE")
 
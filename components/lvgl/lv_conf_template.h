@@ -51,6 +51,10 @@
     /*Size of the memory available for `lv_mem_alloc()` in bytes (>= 2kB)*/
     #define LV_MEM_SIZE (48U * 1024U)          /*[bytes]*/
 
+    /*Part of `LV_MEM_SIZE` for pages of 16, 32, 64 and 128 byte blocks. Allocations of up to 128 bytes are served
+     *from these pages while there is room and don't fragment the rest of the memory. 0: don't use pages*/
+    #define LV_MEM_SLAB_SIZE 0                 /*[bytes], multiple of 512*/
+
     /*Set an address for the memory pool instead of allocating it as a normal array. Can be in external SRAM too.*/
     #define LV_MEM_ADR 0     /*0: unused*/
     /*Instead of an address give a memory allocator that will be called to get a memory pool for LVGL. E.g. my_malloc*/
@@ -95,6 +99,19 @@
  *(Not so important, you can adjust it to modify default sizes and spaces)*/
 #define LV_DPI_DEF 130     /*[px/inch]*/
 
+/*Fixed cost of a flush in pixels, e.g. the command and DMA setup time of an SPI panel divided by the time of one pixel.
+ *Invalidated areas are joined whenever the extra pixels of their union cost less than the flush it saves,
+ *so close small updates are sent as one larger area. 0: join only touching areas whose union is smaller*/
+#define LV_DISP_DEF_JOIN_TRANS_PX 0     /*[px]*/
+
+/*Snap invalidated areas outwards to a grid of tiles of this size (power of 2). 0: don't snap*/
+#define LV_DISP_DEF_TILE_SIZE 0         /*[px]*/
+
+/*Keep the timers in a min-heap by their next run, so `lv_timer_handler()` only touches the due timers
+ *and finds the time till the next one at once instead of walking all of them. ~8 bytes per timer.
+ *Animations also let their timer sleep until the first delayed one starts*/
+#define LV_USE_TIMER_HEAP 0
+
 /*=======================
  * FEATURE CONFIGURATION
  *=======================*/
@@ -110,14 +127,24 @@
 
     /*Allow buffering some shadow calculation.
     *LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-    *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
+    *A shadow costs shadow size^2 bytes in the cache*/
     #define LV_SHADOW_CACHE_SIZE 0
 
+    /*[bytes] Size of the buffer of the cached shadows. The least recently used ones are dropped if a new one doesn't fit.
+    *It's allocated with `lv_mem_alloc` unless `lv_draw_sw_shadow_cache_set_mem_cb()` sets other functions*/
+    #define LV_SHADOW_CACHE_BUDGET (16 * 1024)
+
     /* Set number of maximally cached circle data.
     * The circumference of 1/4 circle are saved for anti-aliasing
     * radius * 4 bytes are used per circle (the most often used radiuses are saved)
     * 0: to disable caching */
     #define LV_CIRCLE_CACHE_SIZE 4
+
+    /* Set number of maximally cached rings for arcs.
+    * The coverage of 1/4 ring is saved and arcs with the same radius, width and ending are drawn without masks
+    * About radius * 12 bytes + the anti-aliased pixels are used per ring (the most recently used rings are saved)
+    * 0: to disable caching */
+    #define LV_ARC_MASK_CACHE_SIZE 4
 #endif /*LV_DRAW_COMPLEX*/
 
 /**
@@ -136,6 +163,14 @@
 #define LV_LAYER_SIMPLE_BUF_SIZE          (24 * 1024)
 #define LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE (3 * 1024)
 
+/*Layer buffers reserved by `lv_draw_sw_layer_pool_reserve()` and reused instead of allocated for every layer.
+ *LV_LAYER_POOL_SIMPLE_CNT: number of `LV_LAYER_SIMPLE_BUF_SIZE` buffers, one per nesting level of widgets with opacity
+ *LV_LAYER_POOL_TRANSFORM_SIZE: [bytes] size of one buffer for the transformed widgets whose whole area fits in it
+ *Layers which find no free buffer in the pool are allocated with `lv_mem_alloc`.
+ *The pool is allocated by the first layer with `lv_mem_alloc` unless `lv_draw_sw_layer_pool_set_mem_cb()` sets other functions.*/
+#define LV_LAYER_POOL_SIMPLE_CNT 0
+#define LV_LAYER_POOL_TRANSFORM_SIZE 0
+
 /*Default image cache size. Image caching keeps the images opened.
  *If only the built-in image formats are used there is no real advantage of caching. (I.e. if no new image decoder is added)
  *With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
@@ -143,6 +178,12 @@
  *0: to disable caching*/
 #define LV_IMG_CACHE_DEF_SIZE 0
 
+/*[bytes] Size the image cache in bytes instead, LV_IMG_CACHE_DEF_SIZE is ignored if not 0.
+ *Images given line by line by their decoder (indexed, alpha only, files) are decoded into a buffer once and counted with
+ *their decoded size. The least used images are closed if a new one doesn't fit.
+ *The buffers are allocated with `lv_mem_alloc` unless `lv_img_cache_set_mem_cb()` sets other functions*/
+#define LV_IMG_CACHE_BUDGET 0
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #define LV_GRADIENT_MAX_STOPS 2
@@ -151,6 +192,7 @@
  *When LVGL calculates the gradient "maps" it can save them into a cache to avoid calculating them again.
  *LV_GRAD_CACHE_DEF_SIZE sets the size of this cache in bytes.
  *If the cache is too small the map will be allocated only while it's required for the drawing.
+ *It's allocated with `lv_mem_alloc` unless `lv_gradient_set_cache_mem_cb()` sets other functions.
  *0 mean no caching.*/
 #define LV_GRAD_CACHE_DEF_SIZE 0
 
@@ -169,6 +211,20 @@
  *Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (10*1024)
 
+/*Render the two halves of the refreshed areas at the same time on two threads, e.g. on two CPU cores.
+ *The second thread and a recursive mutex are provided with `lv_parallel_set_cb()`.
+ *Event callbacks of the drawing events (`LV_EVENT_DRAW_...`, `LV_EVENT_COVER_CHECK`) can be called on either thread*/
+#define LV_USE_PARALLEL_RENDER 0
+#if LV_USE_PARALLEL_RENDER
+    /*Storage class of the thread-local variables*/
+    #define LV_PARALLEL_THREAD_LOCAL __thread
+#endif
+
+/*Blend RGB565 with swapped bytes (LV_COLOR_16_SWAP) by reading the channels with shifts, filling with 32 bit
+ *words and mixing two pixels at once, instead of through the split bitfields of lv_color_t. The pixels are the same.
+ *The blender is used with LV_COLOR_DEPTH 16 and LV_COLOR_16_SWAP 1, `lv_draw_sw_swap16_fill/map()` are always built*/
+#define LV_USE_DRAW_SW_SWAP16 0
+
 /*-------------
  * GPU
  *-----------*/
@@ -190,6 +246,10 @@
     #define LV_GPU_SWM341_DMA2D_INCLUDE "SWM341.h"
 #endif
 
+/*Use the PIE vector instructions of ESP32-S3 to blend RGB565 with swapped bytes (LV_COLOR_16_SWAP).
+ *On other targets a C reference of the kernels is used, it gives the same pixels but slower*/
+#define LV_USE_GPU_ESP32S3_PIE 0
+
 /*Use NXP's PXP GPU iMX RTxxx platforms*/
 #define LV_USE_GPU_NXP_PXP 0
 #if LV_USE_GPU_NXP_PXP
@@ -280,6 +340,13 @@
     #define LV_USE_MEM_MONITOR_POS LV_ALIGN_BOTTOM_LEFT
 #endif
 
+/*1: Time the phases of the refreshed frames (layout, rendering, flushing, waiting...), see lv_refr_prof.h.
+ *Nothing is measured until a time source is set with `lv_refr_prof_set_time_cb()`*/
+#define LV_USE_REFR_PROF 0
+#if LV_USE_REFR_PROF
+    #define LV_REFR_PROF_FRAMES 64      /*Number of the last frames kept for the statistics*/
+#endif
+
 /*1: Draw random colored rectangles over the redrawn areas*/
 #define LV_USE_REFR_DEBUG 0
 
@@ -293,6 +360,19 @@
     #define LV_SPRINTF_USE_FLOAT 0
 #endif  /*LV_SPRINTF_CUSTOM*/
 
+/*Number of resolved style properties kept in a table, so reading a property again doesn't walk the styles
+ *of the object and its parents. Power of 2, about 16 bytes each. Any style, state or parent change clears it.
+ *0: no cache*/
+#define LV_STYLE_CACHE_SIZE 0
+
+/*A grid of the objects per screen to find the object under a point and the top object covering an area
+ *without walking the whole tree. Enabled per screen with `lv_obj_index_set_enabled()`.*/
+#define LV_USE_OBJ_INDEX 0
+#if LV_USE_OBJ_INDEX
+    /*Size of the cells of the grid [px]*/
+    #define LV_OBJ_INDEX_CELL_SIZE 32
+#endif
+
 #define LV_USE_USER_DATA 1
 
 /*Garbage Collector settings
@@ -398,6 +478,11 @@
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
 
+/*[bytes] Size of the buffer of the cached glyphs of `lv_font_fmt_txt` fonts. 0: to disable caching.
+ *The glyphs are cached unpacked to 1 byte per pixel (A8) and the least recently used ones are dropped if a new one doesn't fit.
+ *The buffer is allocated with `lv_mem_alloc` unless `lv_font_cache_set_mem_cb()` sets other functions.*/
+#define LV_FONT_CACHE_BUDGET 0
+
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX 0
 #if LV_USE_FONT_SUBPX
@@ -541,6 +626,8 @@
 
 #define LV_USE_MSGBOX     1
 
+#define LV_USE_NUMLABEL   1
+
 #define LV_USE_SPAN       1
 #if LV_USE_SPAN
     /*A line text can contain maximum num of span descriptor */
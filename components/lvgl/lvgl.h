@@ -26,6 +26,7 @@ extern "C" {
 #include "src/misc/lv_timer.h"
 #include "src/misc/lv_math.h"
 #include "src/misc/lv_mem.h"
+#include "src/misc/lv_parallel.h"
 #include "src/misc/lv_async.h"
 #include "src/misc/lv_anim_timeline.h"
 #include "src/misc/lv_printf.h"
@@ -36,12 +37,14 @@ extern "C" {
 #include "src/core/lv_group.h"
 #include "src/core/lv_indev.h"
 #include "src/core/lv_refr.h"
+#include "src/core/lv_refr_prof.h"
 #include "src/core/lv_disp.h"
 #include "src/core/lv_theme.h"
 
 #include "src/font/lv_font.h"
 #include "src/font/lv_font_loader.h"
 #include "src/font/lv_font_fmt_txt.h"
+#include "src/font/lv_font_cache.h"
 
 #include "src/widgets/lv_arc.h"
 #include "src/widgets/lv_btn.h"
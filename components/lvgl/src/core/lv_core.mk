@@ -5,6 +5,7 @@ CSRCS += lv_indev_scroll.c
 CSRCS += lv_obj.c
 CSRCS += lv_obj_class.c
 CSRCS += lv_obj_draw.c
+CSRCS += lv_obj_index.c
 CSRCS += lv_obj_pos.c
 CSRCS += lv_obj_scroll.c
 CSRCS += lv_obj_style.c
@@ -12,6 +13,7 @@ CSRCS += lv_obj_style_gen.c
 CSRCS += lv_obj_tree.c
 CSRCS += lv_event.c
 CSRCS += lv_refr.c
+CSRCS += lv_refr_prof.c
 CSRCS += lv_theme.c
 
 DEPPATH += --dep-path $(LVGL_DIR)/$(LVGL_DIR_NAME)/src/core
@@ -301,6 +301,11 @@ lv_obj_t * lv_indev_search_obj(lv_obj_t * obj, lv_point_t * point)
 {
     lv_obj_t * found_p = NULL;
 
+#if LV_USE_OBJ_INDEX
+    /*Test only the objects of one cell of a screen with an index*/
+    if(obj->parent == NULL && _lv_obj_index_search_point(obj, point, &found_p)) return found_p;
+#endif
+
     /*If this obj is hidden the children are hidden too so return immediately*/
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return NULL;
 
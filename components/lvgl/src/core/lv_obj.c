@@ -14,6 +14,8 @@
 #include "lv_theme.h"
 #include "../misc/lv_assert.h"
 #include "../draw/lv_draw.h"
+#include "../draw/sw/lv_draw_sw.h"
+#include "../font/lv_font_cache.h"
 #include "../misc/lv_anim.h"
 #include "../misc/lv_timer.h"
 #include "../misc/lv_async.h"
@@ -136,7 +138,9 @@ void lv_init(void)
     _lv_refr_init();
 
     _lv_img_decoder_init();
-#if LV_IMG_CACHE_DEF_SIZE
+#if LV_IMG_CACHE_BUDGET
+    _lv_img_cache_init();
+#elif LV_IMG_CACHE_DEF_SIZE
     lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
 #endif
     /*Test if the IDE has UTF-8 encoding*/
@@ -187,9 +191,24 @@ void lv_init(void)
 
 void lv_deinit(void)
 {
+    /*Before the roots are cleared as the caches can be in an external RAM*/
+#if LV_IMG_CACHE_BUDGET
+    lv_img_cache_invalidate_src(NULL);
+#endif
+    lv_gradient_free_cache();
     _lv_gc_clear_roots();
 
     lv_disp_set_default(NULL);
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE > 0
+    lv_draw_sw_shadow_cache_clear();
+#endif
+    lv_draw_sw_layer_pool_release();
+#if LV_DRAW_COMPLEX && LV_ARC_MASK_CACHE_SIZE > 0
+    lv_draw_sw_arc_cache_clear();
+#endif
+#if LV_FONT_CACHE_BUDGET > 0
+    lv_font_cache_clear();
+#endif
     lv_mem_deinit();
     lv_initialized = false;
 
@@ -412,6 +431,7 @@ static void lv_obj_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
         obj->coords.x1  = parent->coords.x1 + lv_obj_get_style_pad_left(parent, LV_PART_MAIN) - sl;
         obj->coords.x2  = obj->coords.x1 - 1;
     }
+    _lv_obj_index_invalidate(obj);
 
     /*Set attributes*/
     obj->flags = LV_OBJ_FLAG_CLICKABLE;
@@ -866,6 +886,9 @@ static void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state)
     /*If there is no difference in styles there is nothing else to do*/
     if(cmp_res == _LV_STYLE_STATE_CMP_SAME) return;
 
+    /*The children may inherit the properties of the new state*/
+    _lv_obj_style_cache_invalidate();
+
     _lv_obj_style_transition_dsc_t * ts = lv_mem_buf_get(sizeof(_lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
     lv_memset_00(ts, sizeof(_lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
     uint32_t tsi = 0;
@@ -139,6 +139,7 @@ typedef enum {
 #include "lv_obj_scroll.h"
 #include "lv_obj_style.h"
 #include "lv_obj_draw.h"
+#include "lv_obj_index.h"
 #include "lv_obj_class.h"
 #include "lv_event.h"
 #include "lv_group.h"
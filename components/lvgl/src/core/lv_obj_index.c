@@ -0,0 +1,433 @@
+/**
+ * @file lv_obj_index.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj_index.h"
+
+#if LV_USE_OBJ_INDEX
+
+#include "lv_obj.h"
+#include "lv_disp.h"
+#include "../misc/lv_mem.h"
+#include "../misc/lv_ll.h"
+#include "../misc/lv_gc.h"
+#include "../misc/lv_log.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CELL_SIZE       LV_OBJ_INDEX_CELL_SIZE
+#define OBJ_CNT_MAX     UINT16_MAX
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*The cells covered by an object, `c1 > c2` if none*/
+typedef struct {
+    uint16_t c1;
+    uint16_t r1;
+    uint16_t c2;
+    uint16_t r2;
+} cell_rect_t;
+
+typedef struct {
+    lv_obj_t * scr;
+    lv_disp_t * disp;
+    lv_obj_t ** objs;           /*The objects in drawing order, the screen first*/
+    cell_rect_t * rects;        /*The cells of `objs[i]`*/
+    uint32_t obj_cnt;
+    uint32_t obj_cap;
+    uint32_t * cell_start;      /*`cell_objs[cell_start[c]..cell_start[c + 1])` are in cell `c`*/
+    uint16_t * cell_objs;       /*Indexes into `objs`, in a cell the topmost first*/
+    uint32_t cell_obj_cap;
+    lv_coord_t hor_res;
+    lv_coord_t ver_res;
+    uint16_t col_cnt;
+    uint16_t row_cnt;
+    uint8_t dirty : 1;
+    uint8_t valid : 1;          /*Built and no transformed object*/
+} obj_index_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static obj_index_t * find_index(const lv_obj_t * scr);
+static void free_index(obj_index_t * idx);
+static bool update_index(obj_index_t * idx);
+static bool rebuild(obj_index_t * idx);
+static bool collect_objs(obj_index_t * idx, lv_obj_t * obj, bool * transformed);
+static void get_cell_rect(const obj_index_t * idx, const lv_obj_t * obj, cell_rect_t * rect);
+static const uint16_t * get_cell(obj_index_t * idx, lv_coord_t x, lv_coord_t y, uint32_t * cnt);
+static bool point_reaches(const lv_obj_t * obj, const lv_point_t * point);
+static lv_cover_res_t cover_check(lv_obj_t * obj, const lv_area_t * area);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_obj_index_stats_t stats;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_obj_index_set_enabled(lv_obj_t * scr, bool en)
+{
+    LV_ASSERT_NULL(scr);
+    LV_ASSERT_MSG(scr->parent == NULL, "only screens can have an index");
+
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_obj_index_ll);
+    obj_index_t * idx = find_index(scr);
+    if(en) {
+        if(idx) return;
+        if(ll->n_size == 0) _lv_ll_init(ll, sizeof(obj_index_t));
+        idx = _lv_ll_ins_head(ll);
+        LV_ASSERT_MALLOC(idx);
+        if(idx == NULL) return;
+        lv_memset_00(idx, sizeof(obj_index_t));
+        idx->scr = scr;
+        idx->disp = lv_obj_get_disp(scr);
+        idx->dirty = 1;
+    }
+    else if(idx) {
+        free_index(idx);
+    }
+}
+
+bool lv_obj_index_is_enabled(const lv_obj_t * scr)
+{
+    return find_index(scr) != NULL;
+}
+
+void lv_obj_index_get_stats(lv_obj_index_stats_t * stats_out)
+{
+    *stats_out = stats;
+}
+
+void lv_obj_index_reset_stats(void)
+{
+    lv_memset_00(&stats, sizeof(stats));
+}
+
+bool _lv_obj_index_search_point(lv_obj_t * scr, const lv_point_t * point, lv_obj_t ** res)
+{
+    obj_index_t * idx = find_index(scr);
+    if(idx == NULL) return false;
+
+    uint32_t cnt;
+    const uint16_t * cell = update_index(idx) ? get_cell(idx, point->x, point->y, &cnt) : NULL;
+    if(cell == NULL) {
+        stats.fallback_cnt++;
+        return false;
+    }
+
+    /*The tree is walked from the last child to the first and the children before their parent,
+     *so the first hit in reverse drawing order is what the walk would find*/
+    *res = NULL;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_t * obj = idx->objs[cell[i]];
+        stats.candidate_cnt++;
+
+        lv_area_t click_area;
+        lv_obj_get_click_area(obj, &click_area);
+        if(!_lv_area_is_point_on(&click_area, point, 0)) continue;
+        if(!point_reaches(obj, point)) continue;
+        if(lv_obj_hit_test(obj, point)) {
+            *res = obj;
+            break;
+        }
+    }
+
+    stats.point_cnt++;
+    return true;
+}
+
+bool _lv_obj_index_search_cover(lv_obj_t * scr, const lv_area_t * area, lv_obj_t ** res)
+{
+    obj_index_t * idx = find_index(scr);
+    if(idx == NULL) return false;
+
+    /*An object covering the area covers its first point too*/
+    uint32_t cnt;
+    const uint16_t * cell = update_index(idx) ? get_cell(idx, area->x1, area->y1, &cnt) : NULL;
+    if(cell == NULL) {
+        stats.fallback_cnt++;
+        return false;
+    }
+
+    *res = NULL;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_t * obj = idx->objs[cell[i]];
+        stats.candidate_cnt++;
+
+        if(cover_check(obj, area) != LV_COVER_RES_COVER) continue;
+
+        /*Only the children of covering, not masked parents are checked by the walk*/
+        lv_obj_t * parent = obj->parent;
+        while(parent && cover_check(parent, area) != LV_COVER_RES_MASKED) parent = parent->parent;
+        if(parent == NULL) {
+            *res = obj;
+            break;
+        }
+    }
+
+    stats.cover_cnt++;
+    return true;
+}
+
+void _lv_obj_index_invalidate(const lv_obj_t * obj)
+{
+    /*Nothing to look for on the screens without an index*/
+    if(_lv_ll_get_head(&LV_GC_ROOT(_lv_obj_index_ll)) == NULL) return;
+
+    while(obj->parent) obj = obj->parent;
+    obj_index_t * idx = find_index(obj);
+    if(idx) idx->dirty = 1;
+}
+
+void _lv_obj_index_remove(const lv_obj_t * scr)
+{
+    obj_index_t * idx = find_index(scr);
+    if(idx) free_index(idx);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static obj_index_t * find_index(const lv_obj_t * scr)
+{
+    obj_index_t * idx;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_obj_index_ll), idx) {
+        if(idx->scr == scr) return idx;
+    }
+    return NULL;
+}
+
+static void free_index(obj_index_t * idx)
+{
+    lv_mem_free(idx->objs);
+    lv_mem_free(idx->rects);
+    lv_mem_free(idx->cell_start);
+    lv_mem_free(idx->cell_objs);
+    _lv_ll_remove(&LV_GC_ROOT(_lv_obj_index_ll), idx);
+    lv_mem_free(idx);
+}
+
+/**
+ * Build the index again if the objects or the resolution changed
+ * @return true: the index can be used
+ */
+static bool update_index(obj_index_t * idx)
+{
+    if(idx->hor_res != lv_disp_get_hor_res(idx->disp) || idx->ver_res != lv_disp_get_ver_res(idx->disp)) {
+        idx->dirty = 1;
+    }
+
+    if(idx->dirty) {
+        idx->valid = rebuild(idx);
+        idx->dirty = 0;
+        stats.rebuild_cnt++;
+    }
+
+    return idx->valid;
+}
+
+static bool rebuild(obj_index_t * idx)
+{
+    idx->hor_res = lv_disp_get_hor_res(idx->disp);
+    idx->ver_res = lv_disp_get_ver_res(idx->disp);
+    uint16_t col_cnt = (idx->hor_res + CELL_SIZE - 1) / CELL_SIZE;
+    uint16_t row_cnt = (idx->ver_res + CELL_SIZE - 1) / CELL_SIZE;
+    uint32_t cell_cnt = (uint32_t)col_cnt * row_cnt;
+
+    if(col_cnt != idx->col_cnt || row_cnt != idx->row_cnt) {
+        lv_mem_free(idx->cell_start);
+        idx->cell_start = lv_mem_alloc((cell_cnt + 1) * sizeof(uint32_t));
+        idx->col_cnt = col_cnt;
+        idx->row_cnt = row_cnt;
+        if(idx->cell_start == NULL) {
+            idx->col_cnt = 0;
+            idx->row_cnt = 0;
+            LV_LOG_WARN("couldn't allocate the cells of the object index");
+            return false;
+        }
+    }
+
+    /*The points of a transformed object are transformed on the way to its children, let the walk find them*/
+    bool transformed = false;
+    idx->obj_cnt = 0;
+    if(!collect_objs(idx, idx->scr, &transformed)) return false;
+    if(transformed) return false;
+
+    /*Count the objects of the cells*/
+    lv_memset_00(idx->cell_start, (cell_cnt + 1) * sizeof(uint32_t));
+    uint32_t i;
+    uint16_t c;
+    uint16_t r;
+    for(i = 0; i < idx->obj_cnt; i++) {
+        const cell_rect_t * rect = &idx->rects[i];
+        for(r = rect->r1; r <= rect->r2 && rect->c1 <= rect->c2; r++) {
+            for(c = rect->c1; c <= rect->c2; c++) idx->cell_start[r * col_cnt + c]++;
+        }
+    }
+
+    /*Make them the ends of the cells*/
+    uint32_t sum = 0;
+    for(i = 0; i < cell_cnt; i++) {
+        sum += idx->cell_start[i];
+        idx->cell_start[i] = sum;
+    }
+    idx->cell_start[cell_cnt] = sum;
+
+    if(sum > idx->cell_obj_cap) {
+        lv_mem_free(idx->cell_objs);
+        idx->cell_objs = lv_mem_alloc(sum * sizeof(uint16_t));
+        idx->cell_obj_cap = idx->cell_objs ? sum : 0;
+        if(idx->cell_objs == NULL) {
+            LV_LOG_WARN("couldn't allocate the object index");
+            return false;
+        }
+    }
+
+    /*Fill the cells from their ends, so in the end a cell starts with its topmost object
+     *and `cell_start[c]` is moved to the start of the cell*/
+    for(i = 0; i < idx->obj_cnt; i++) {
+        const cell_rect_t * rect = &idx->rects[i];
+        for(r = rect->r1; r <= rect->r2 && rect->c1 <= rect->c2; r++) {
+            for(c = rect->c1; c <= rect->c2; c++) {
+                idx->cell_objs[--idx->cell_start[r * col_cnt + c]] = (uint16_t)i;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Add an object and its children to `objs` in drawing order
+ * @return false: out of memory or too many objects
+ */
+static bool collect_objs(obj_index_t * idx, lv_obj_t * obj, bool * transformed)
+{
+    if(idx->obj_cnt == idx->obj_cap) {
+        if(idx->obj_cap == OBJ_CNT_MAX) {
+            LV_LOG_WARN("more than %d objects on the screen, not indexed", OBJ_CNT_MAX);
+            return false;
+        }
+        uint32_t cap = idx->obj_cap ? LV_MIN(idx->obj_cap * 2, OBJ_CNT_MAX) : 64;
+        lv_obj_t ** objs = lv_mem_realloc(idx->objs, cap * sizeof(lv_obj_t *));
+        if(objs) idx->objs = objs;
+        cell_rect_t * rects = lv_mem_realloc(idx->rects, cap * sizeof(cell_rect_t));
+        if(rects) idx->rects = rects;
+        if(objs == NULL || rects == NULL) {
+            LV_LOG_WARN("couldn't allocate the object index");
+            return false;
+        }
+        idx->obj_cap = cap;
+    }
+
+    if(_lv_obj_get_layer_type(obj) == LV_LAYER_TYPE_TRANSFORM) *transformed = true;
+
+    get_cell_rect(idx, obj, &idx->rects[idx->obj_cnt]);
+    idx->objs[idx->obj_cnt] = obj;
+    idx->obj_cnt++;
+
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    for(i = 0; i < child_cnt; i++) {
+        if(!collect_objs(idx, obj->spec_attr->children[i], transformed)) return false;
+    }
+
+    return true;
+}
+
+/**
+ * Get the cells of the coordinates and the click area of an object on the display
+ */
+static void get_cell_rect(const obj_index_t * idx, const lv_obj_t * obj, cell_rect_t * rect)
+{
+    lv_area_t a;
+    lv_obj_get_click_area(obj, &a);
+    a.x1 = LV_MIN(a.x1, obj->coords.x1);
+    a.y1 = LV_MIN(a.y1, obj->coords.y1);
+    a.x2 = LV_MAX(a.x2, obj->coords.x2);
+    a.y2 = LV_MAX(a.y2, obj->coords.y2);
+
+    lv_area_t disp_area;
+    lv_area_set(&disp_area, 0, 0, idx->hor_res - 1, idx->ver_res - 1);
+    if(!_lv_area_intersect(&a, &a, &disp_area)) {
+        rect->c1 = 1;
+        rect->c2 = 0;
+        rect->r1 = 0;
+        rect->r2 = 0;
+        return;
+    }
+
+    rect->c1 = a.x1 / CELL_SIZE;
+    rect->r1 = a.y1 / CELL_SIZE;
+    rect->c2 = a.x2 / CELL_SIZE;
+    rect->r2 = a.y2 / CELL_SIZE;
+}
+
+/**
+ * Get the objects of the cell of a point
+ * @param cnt   store the number of objects here
+ * @return      the indexes of the objects, the topmost first, NULL if the point is not on the display
+ */
+static const uint16_t * get_cell(obj_index_t * idx, lv_coord_t x, lv_coord_t y, uint32_t * cnt)
+{
+    if(x < 0 || y < 0 || x >= idx->hor_res || y >= idx->ver_res) return NULL;
+
+    uint32_t c = (uint32_t)(y / CELL_SIZE) * idx->col_cnt + x / CELL_SIZE;
+    *cnt = idx->cell_start[c + 1] - idx->cell_start[c];
+    return &idx->cell_objs[idx->cell_start[c]];
+}
+
+/**
+ * Tell whether `lv_indev_search_obj()` gets to an object with a point:
+ * none of them is hidden and the point is on all its parents or they let their children overflow
+ */
+static bool point_reaches(const lv_obj_t * obj, const lv_point_t * point)
+{
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return false;
+
+    const lv_obj_t * parent = obj->parent;
+    while(parent) {
+        if(lv_obj_has_flag(parent, LV_OBJ_FLAG_HIDDEN)) return false;
+        if(!_lv_area_is_point_on(&parent->coords, point, 0) &&
+           !lv_obj_has_flag(parent, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+        parent = parent->parent;
+    }
+
+    return true;
+}
+
+/**
+ * Check an object like the tree walk of `lv_refr.c` does
+ * @return LV_COVER_RES_MASKED: neither it nor its children can be the top object
+ */
+static lv_cover_res_t cover_check(lv_obj_t * obj, const lv_area_t * area)
+{
+    if(_lv_area_is_in(area, &obj->coords, 0) == false) return LV_COVER_RES_MASKED;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return LV_COVER_RES_MASKED;
+    if(_lv_obj_get_layer_type(obj) != LV_LAYER_TYPE_NONE) return LV_COVER_RES_MASKED;
+
+    lv_cover_check_info_t info;
+    info.res = LV_COVER_RES_COVER;
+    info.area = area;
+    lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+    return info.res;
+}
+
+#endif /*LV_USE_OBJ_INDEX*/
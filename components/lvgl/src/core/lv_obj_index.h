@@ -0,0 +1,122 @@
+/**
+ * @file lv_obj_index.h
+ * A uniform grid over the display which lists the objects of a screen per cell, so finding the object
+ * under a point or the top object covering an area tests only the objects of one cell instead of
+ * walking the whole tree.
+ */
+
+#ifndef LV_OBJ_INDEX_H
+#define LV_OBJ_INDEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "../misc/lv_area.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if LV_USE_OBJ_INDEX
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_obj_t;
+
+typedef struct {
+    uint32_t point_cnt;         /**< Objects under a point found with an index*/
+    uint32_t cover_cnt;         /**< Top objects covering an area found with an index*/
+    uint32_t fallback_cnt;      /**< Queries on an indexed screen answered by walking the tree:
+                                     transformed objects or a point outside the display*/
+    uint32_t candidate_cnt;     /**< Objects tested by the queries answered with an index*/
+    uint32_t rebuild_cnt;       /**< Indexes built again after a change of the objects*/
+} lv_obj_index_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Keep a spatial index of a screen (or the top or sys layer) for `lv_indev_search_obj()` and for finding the
+ * top object which covers a refreshed area. The index is built again on the first query after an object
+ * of the screen is created, deleted, moved, resized, scrolled or reordered.
+ * @param scr       pointer to a screen
+ * @param en        true: keep an index; false: free it and walk the tree
+ */
+void lv_obj_index_set_enabled(struct _lv_obj_t * scr, bool en);
+
+/**
+ * Tell whether a screen has a spatial index
+ * @param scr       pointer to a screen
+ * @return          true: the screen has an index
+ */
+bool lv_obj_index_is_enabled(const struct _lv_obj_t * scr);
+
+/**
+ * Get the statistics of the spatial indexes
+ * @param stats     store the statistics here
+ */
+void lv_obj_index_get_stats(lv_obj_index_stats_t * stats);
+
+/**
+ * Reset the statistics of the spatial indexes
+ */
+void lv_obj_index_reset_stats(void);
+
+/**
+ * Find the clickable object under a point like `lv_indev_search_obj()` walking the whole tree does
+ * @param scr       pointer to a screen
+ * @param point     the point in screen coordinates
+ * @param res       store the object here, NULL if none
+ * @return          true: `res` is set; false: the screen has no usable index, walk the tree
+ */
+bool _lv_obj_index_search_point(struct _lv_obj_t * scr, const lv_point_t * point, struct _lv_obj_t ** res);
+
+/**
+ * Find the top object which fully covers an area like walking the tree in `lv_refr.c` does
+ * @param scr       pointer to a screen
+ * @param area      the area in screen coordinates
+ * @param res       store the object here, NULL if none
+ * @return          true: `res` is set; false: the screen has no usable index, walk the tree
+ */
+bool _lv_obj_index_search_cover(struct _lv_obj_t * scr, const lv_area_t * area, struct _lv_obj_t ** res);
+
+/**
+ * Build the index of the screen of an object again on the next query.
+ * Called by LVGL when the coordinates, the ext. click area, the layer type or the place of an object changes.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_index_invalidate(const struct _lv_obj_t * obj);
+
+/**
+ * Free the index of a screen being deleted
+ * @param scr       pointer to a screen
+ */
+void _lv_obj_index_remove(const struct _lv_obj_t * scr);
+
+#else
+
+#define _lv_obj_index_invalidate(obj)   ((void)0)
+#define _lv_obj_index_remove(scr)       ((void)0)
+
+#endif /*LV_USE_OBJ_INDEX*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_INDEX_H*/
@@ -9,6 +9,7 @@
 #include "lv_obj.h"
 #include "lv_disp.h"
 #include "lv_refr.h"
+#include "lv_refr_prof.h"
 #include "../misc/lv_gc.h"
 
 /*********************
@@ -190,6 +191,7 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     else {
         obj->coords.x2 = obj->coords.x1 + w - 1;
     }
+    _lv_obj_index_invalidate(obj);
 
     /*Call the ancestor's event handler to the object with its new coordinates*/
     lv_event_send(obj, LV_EVENT_SIZE_CHANGED, &ori);
@@ -762,6 +764,7 @@ void lv_obj_move_to(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     obj->coords.y1 += diff.y;
     obj->coords.x2 += diff.x;
     obj->coords.y2 += diff.y;
+    _lv_obj_index_invalidate(obj);
 
     lv_obj_move_children_by(obj, diff.x, diff.y, false);
 
@@ -783,6 +786,7 @@ void lv_obj_move_children_by(lv_obj_t * obj, lv_coord_t x_diff, lv_coord_t y_dif
 {
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    if(child_cnt) _lv_obj_index_invalidate(obj);
     for(i = 0; i < child_cnt; i++) {
         lv_obj_t * child = obj->spec_attr->children[i];
         if(ignore_floating && lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING)) continue;
@@ -841,11 +845,19 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
     lv_disp_t * disp   = lv_obj_get_disp(obj);
     if(!lv_disp_is_invalidation_enabled(disp)) return;
 
+#if LV_USE_REFR_PROF
+    uint32_t prof_start = lv_refr_prof_time();
+#endif
+
     lv_area_t area_tmp;
     lv_area_copy(&area_tmp, area);
-    if(!lv_obj_area_is_visible(obj, &area_tmp)) return;
+    if(lv_obj_area_is_visible(obj, &area_tmp)) {
+        _lv_inv_area(lv_obj_get_disp(obj),  &area_tmp);
+    }
 
-    _lv_inv_area(lv_obj_get_disp(obj),  &area_tmp);
+#if LV_USE_REFR_PROF
+    _lv_refr_prof_add_since(LV_REFR_PROF_INVALIDATE, prof_start);
+#endif
 }
 
 void lv_obj_invalidate(const lv_obj_t * obj)
@@ -937,6 +949,7 @@ void lv_obj_set_ext_click_area(lv_obj_t * obj, lv_coord_t size)
 
     lv_obj_allocate_spec_attr(obj);
     obj->spec_attr->ext_click_pad = size;
+    _lv_obj_index_invalidate(obj);
 }
 
 void lv_obj_get_click_area(const lv_obj_t * obj, lv_area_t * area)
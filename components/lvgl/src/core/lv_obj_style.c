@@ -9,12 +9,17 @@
 #include "lv_obj.h"
 #include "lv_disp.h"
 #include "../misc/lv_gc.h"
+#include "../misc/lv_parallel.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define MY_CLASS &lv_obj_class
 
+#if LV_STYLE_CACHE_SIZE & (LV_STYLE_CACHE_SIZE - 1)
+    #error "LV_STYLE_CACHE_SIZE must be a power of 2"
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -35,6 +40,18 @@ typedef enum {
     CACHE_NEED_CHECK = 4,
 } cache_t;
 
+#if LV_STYLE_CACHE_SIZE
+/*A resolved property of an object. It's valid while `epoch` is the current one*/
+typedef struct {
+    const lv_obj_t * obj;
+    lv_style_value_t value;
+    uint16_t epoch;
+    lv_style_prop_t prop;
+    lv_state_t state;
+    uint8_t part;           /*The part shifted to the lowest byte*/
+} style_cache_entry_t;
+#endif
+
 /**********************
  *  GLOBAL PROTOTYPES
  **********************/
@@ -44,6 +61,7 @@ typedef enum {
  **********************/
 static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector);
 static _lv_obj_style_t * get_trans_style(lv_obj_t * obj, uint32_t part);
+static lv_style_value_t get_prop_resolved(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
 static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v);
 static void report_style_change_core(void * style, lv_obj_t * obj);
 static void refresh_children_style(lv_obj_t * obj);
@@ -59,6 +77,13 @@ static void fade_in_anim_ready(lv_anim_t * a);
  *  STATIC VARIABLES
  **********************/
 static bool style_refr = true;
+#if LV_STYLE_CACHE_SIZE
+    static style_cache_entry_t style_cache[LV_STYLE_CACHE_SIZE];
+    static uint16_t style_cache_epoch = 1;
+    static uint32_t style_cache_change_cnt;     /*`_lv_style_change_cnt` when the epoch started*/
+    static bool style_cache_enabled = true;
+    static lv_obj_style_cache_stats_t style_cache_stats;
+#endif
 
 /**********************
  *      MACROS
@@ -71,6 +96,11 @@ static bool style_refr = true;
 void _lv_obj_style_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_obj_style_trans_ll), sizeof(trans_t));
+#if LV_STYLE_CACHE_SIZE
+    lv_memset_00(style_cache, sizeof(style_cache));
+    style_cache_epoch = 1;
+    style_cache_change_cnt = _lv_style_change_cnt;
+#endif
 }
 
 void lv_obj_add_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t selector)
@@ -99,6 +129,7 @@ void lv_obj_add_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t se
     lv_memset_00(&obj->styles[i], sizeof(_lv_obj_style_t));
     obj->styles[i].style = style;
     obj->styles[i].selector = selector;
+    _lv_obj_style_cache_invalidate();
 
     lv_obj_refresh_style(obj, selector, LV_STYLE_PROP_ANY);
 }
@@ -140,6 +171,7 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
 
         obj->style_cnt--;
         obj->styles = lv_mem_realloc(obj->styles, obj->style_cnt * sizeof(_lv_obj_style_t));
+        _lv_obj_style_cache_invalidate();
 
         deleted = true;
         /*The style from the current `i` index is removed, so `i` points to the next style.
@@ -196,6 +228,7 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
     /*Cache the layer type*/
     if((part == LV_PART_ANY || part == LV_PART_MAIN) && is_layer_refr) {
         lv_layer_type_t layer_type = calculate_layer_type(obj);
+        if(layer_type != _lv_obj_get_layer_type(obj)) _lv_obj_index_invalidate(obj);
         if(obj->spec_attr) obj->spec_attr->layer_type = layer_type;
         else if(layer_type != LV_LAYER_TYPE_NONE) {
             lv_obj_allocate_spec_attr(obj);
@@ -222,50 +255,69 @@ void lv_obj_enable_style_refresh(bool en)
 
 lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
 {
-    lv_style_value_t value_act;
-    bool inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
-    lv_style_res_t found = LV_STYLE_RES_NOT_FOUND;
-    while(obj) {
-        found = get_prop_core(obj, part, prop, &value_act);
-        if(found == LV_STYLE_RES_FOUND) break;
-        if(!inheritable) break;
+#if LV_STYLE_CACHE_SIZE
+    /*The second render thread doesn't use the cache, the transitions read other states temporarily*/
+    if(_lv_parallel_is_active()) return get_prop_resolved(obj, part, prop);
+    if(!style_cache_enabled || obj->skip_trans || (part & 0xFFFF)) {
+        style_cache_stats.skip_cnt++;
+        return get_prop_resolved(obj, part, prop);
+    }
+
+    /*A style was changed since the cache was cleared*/
+    if(style_cache_change_cnt != _lv_style_change_cnt) _lv_obj_style_cache_invalidate();
+
+    uint32_t h = ((uint32_t)((lv_uintptr_t)obj >> 2) + ((uint32_t)prop << 8) + (part >> 16)) * 0x9E3779B1;
+    style_cache_entry_t * e = &style_cache[(h >> 16) & (LV_STYLE_CACHE_SIZE - 1)];
+    uint8_t part_id = (uint8_t)(part >> 16);
+    if(e->epoch == style_cache_epoch && e->obj == obj && e->prop == prop && e->part == part_id &&
+       e->state == obj->state) {
+        style_cache_stats.hit_cnt++;
+        return e->value;
+    }
+
+    lv_style_value_t value = get_prop_resolved(obj, part, prop);
+    e->obj = obj;
+    e->value = value;
+    e->epoch = style_cache_epoch;
+    e->prop = prop;
+    e->state = obj->state;
+    e->part = part_id;
+    style_cache_stats.miss_cnt++;
+    return value;
+#else
+    return get_prop_resolved(obj, part, prop);
+#endif
+}
 
-        /*If not found, check the `MAIN` style first*/
-        if(found != LV_STYLE_RES_INHERIT && part != LV_PART_MAIN) {
-            part = LV_PART_MAIN;
-            continue;
-        }
+#if LV_STYLE_CACHE_SIZE
+void lv_obj_style_cache_set_enabled(bool en)
+{
+    style_cache_enabled = en;
+    _lv_obj_style_cache_invalidate();
+}
 
-        /*Check the parent too.*/
-        obj = lv_obj_get_parent(obj);
-    }
+void lv_obj_style_cache_get_stats(lv_obj_style_cache_stats_t * stats)
+{
+    *stats = style_cache_stats;
+}
 
-    if(found != LV_STYLE_RES_FOUND) {
-        if(part == LV_PART_MAIN && (prop == LV_STYLE_WIDTH || prop == LV_STYLE_HEIGHT)) {
-            const lv_obj_class_t * cls = obj->class_p;
-            while(cls) {
-                if(prop == LV_STYLE_WIDTH) {
-                    if(cls->width_def != 0) break;
-                }
-                else {
-                    if(cls->height_def != 0) break;
-                }
-                cls = cls->base_class;
-            }
+void lv_obj_style_cache_reset_stats(void)
+{
+    lv_memset_00(&style_cache_stats, sizeof(style_cache_stats));
+}
 
-            if(cls) {
-                value_act.num = prop == LV_STYLE_WIDTH ? cls->width_def : cls->height_def;
-            }
-            else {
-                value_act.num = 0;
-            }
-        }
-        else {
-            value_act = lv_style_prop_get_default(prop);
-        }
+void _lv_obj_style_cache_invalidate(void)
+{
+    style_cache_change_cnt = _lv_style_change_cnt;
+    style_cache_stats.clear_cnt++;
+    style_cache_epoch++;
+    /*Entries of the previous round of the epoch might look valid again*/
+    if(style_cache_epoch == 0) {
+        lv_memset_00(style_cache, sizeof(style_cache));
+        style_cache_epoch = 1;
     }
-    return value_act;
 }
+#endif
 
 void lv_obj_set_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_style_value_t value,
                                  lv_style_selector_t selector)
@@ -568,6 +620,60 @@ static _lv_obj_style_t * get_trans_style(lv_obj_t * obj,  lv_style_selector_t se
     return &obj->styles[0];
 }
 
+/**
+ * Get the value of a style property by walking the styles of the object and its parents
+ * @param obj       pointer to an object
+ * @param part      a part from which the property should be get
+ * @param prop      the property to get
+ * @return          the value of the property
+ */
+static lv_style_value_t get_prop_resolved(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
+{
+    lv_style_value_t value_act;
+    bool inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
+    lv_style_res_t found = LV_STYLE_RES_NOT_FOUND;
+    while(obj) {
+        found = get_prop_core(obj, part, prop, &value_act);
+        if(found == LV_STYLE_RES_FOUND) break;
+        if(!inheritable) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(found != LV_STYLE_RES_INHERIT && part != LV_PART_MAIN) {
+            part = LV_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        obj = lv_obj_get_parent(obj);
+    }
+
+    if(found != LV_STYLE_RES_FOUND) {
+        if(part == LV_PART_MAIN && (prop == LV_STYLE_WIDTH || prop == LV_STYLE_HEIGHT)) {
+            const lv_obj_class_t * cls = obj->class_p;
+            while(cls) {
+                if(prop == LV_STYLE_WIDTH) {
+                    if(cls->width_def != 0) break;
+                }
+                else {
+                    if(cls->height_def != 0) break;
+                }
+                cls = cls->base_class;
+            }
+
+            if(cls) {
+                value_act.num = prop == LV_STYLE_WIDTH ? cls->width_def : cls->height_def;
+            }
+            else {
+                value_act.num = 0;
+            }
+        }
+        else {
+            value_act = lv_style_prop_get_default(prop);
+        }
+    }
+    return value_act;
+}
+
 
 static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v)
 {
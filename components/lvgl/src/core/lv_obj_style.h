@@ -54,6 +54,15 @@ typedef struct {
 #endif
 } _lv_obj_style_transition_dsc_t;
 
+#if LV_STYLE_CACHE_SIZE
+typedef struct {
+    uint32_t hit_cnt;           /**< Properties read from the cache*/
+    uint32_t miss_cnt;          /**< Properties resolved from the styles and added to the cache*/
+    uint32_t skip_cnt;          /**< Properties resolved without the cache, e.g. during transitions*/
+    uint32_t clear_cnt;         /**< The cache was cleared by a style, state or parent change*/
+} lv_obj_style_cache_stats_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -130,6 +139,32 @@ void lv_obj_enable_style_refresh(bool en);
  */
 lv_style_value_t lv_obj_get_style_prop(const struct _lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
 
+#if LV_STYLE_CACHE_SIZE
+/**
+ * Use the cache of the resolved style properties or always walk the styles. Enabled by default.
+ * @param en        true: use the cache
+ */
+void lv_obj_style_cache_set_enabled(bool en);
+
+/**
+ * Get the statistics of the style cache
+ * @param stats     store the statistics here
+ */
+void lv_obj_style_cache_get_stats(lv_obj_style_cache_stats_t * stats);
+
+/**
+ * Reset the statistics of the style cache
+ */
+void lv_obj_style_cache_reset_stats(void);
+
+/**
+ * Forget the cached properties. Called by LVGL when a style, a state or a parent changes.
+ */
+void _lv_obj_style_cache_invalidate(void);
+#else
+#define _lv_obj_style_cache_invalidate()    ((void)0)
+#endif
+
 /**
  * Set local style property on an object's part and state.
  * @param obj       pointer to an object
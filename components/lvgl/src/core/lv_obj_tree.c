@@ -145,6 +145,9 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
     }
 
     lv_obj_invalidate(obj);
+    /*The inherited properties come from the new parent*/
+    _lv_obj_style_cache_invalidate();
+    _lv_obj_index_invalidate(obj);
 
     lv_obj_allocate_spec_attr(parent);
 
@@ -171,6 +174,7 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
     parent->spec_attr->children[lv_obj_get_child_cnt(parent) - 1] = obj;
 
     obj->parent = parent;
+    _lv_obj_index_invalidate(obj);
 
     /*Notify the original parent because one of its children is lost*/
     lv_obj_readjust_scroll(old_parent, LV_ANIM_OFF);
@@ -218,6 +222,7 @@ void lv_obj_move_to_index(lv_obj_t * obj, int32_t index)
     }
 
     parent->spec_attr->children[index] = obj;
+    _lv_obj_index_invalidate(parent);
     lv_event_send(parent, LV_EVENT_CHILD_CHANGED, NULL);
     lv_obj_invalidate(parent);
 }
@@ -238,6 +243,8 @@ void lv_obj_swap(lv_obj_t * obj1, lv_obj_t * obj2)
 
     parent->spec_attr->children[index1] = obj2;
     parent2->spec_attr->children[index2] = obj1;
+    _lv_obj_index_invalidate(parent);
+    _lv_obj_index_invalidate(parent2);
 
     lv_event_send(parent, LV_EVENT_CHILD_CHANGED, obj2);
     lv_event_send(parent, LV_EVENT_CHILD_CREATED, obj2);
@@ -360,6 +367,9 @@ static void obj_del_core(lv_obj_t * obj)
     lv_res_t res = lv_event_send(obj, LV_EVENT_DELETE, NULL);
     if(res == LV_RES_INV) return;
 
+    /*A new object can get the same address*/
+    _lv_obj_style_cache_invalidate();
+
     /*Recursively delete the children*/
     lv_obj_t * child = lv_obj_get_child(obj, 0);
     while(child) {
@@ -390,6 +400,7 @@ static void obj_del_core(lv_obj_t * obj)
 
     /*Remove the screen for the screen list*/
     if(obj->parent == NULL) {
+        _lv_obj_index_remove(obj);
         lv_disp_t * disp = lv_obj_get_disp(obj);
         uint32_t i;
         /*Find the screen in the list*/
@@ -406,6 +417,7 @@ static void obj_del_core(lv_obj_t * obj)
     }
     /*Remove the object from the child list of its parent*/
     else {
+        _lv_obj_index_invalidate(obj);
         uint32_t id = lv_obj_get_index(obj);
         uint32_t i;
         for(i = id; i < obj->parent->spec_attr->child_cnt - 1; i++) {
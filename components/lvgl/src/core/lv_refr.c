@@ -15,6 +15,8 @@
 #include "../misc/lv_mem.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_gc.h"
+#include "../misc/lv_parallel.h"
+#include "lv_refr_prof.h"
 #include "../draw/lv_draw.h"
 #include "../font/lv_font_fmt_txt.h"
 #include "../extra/others/snapshot/lv_snapshot.h"
@@ -48,6 +50,15 @@ typedef struct {
 #endif
 } mem_monitor_t;
 
+#if LV_USE_PARALLEL_RENDER
+typedef struct {
+    lv_disp_t * disp;
+    lv_draw_ctx_t * draw_ctx;
+    lv_obj_t * top_act_scr;
+    lv_obj_t * top_prev_scr;
+} refr_job_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -55,7 +66,11 @@ static void lv_refr_join_area(void);
 static void refr_invalid_areas(void);
 static void refr_area(const lv_area_t * area_p);
 static void refr_area_part(lv_draw_ctx_t * draw_ctx);
-static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
+static void refr_area_layers(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr);
+#if LV_USE_PARALLEL_RENDER
+    static bool refr_area_parallel(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr);
+    static void refr_job_task(void * param);
+#endif
 static void refr_obj_and_children(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_obj);
 static void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h);
@@ -73,7 +88,7 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
  *  STATIC VARIABLES
  **********************/
 static uint32_t px_num;
-static lv_disp_t * disp_refr; /*Display being refreshed*/
+static LV_PARALLEL_THREAD_LOCAL lv_disp_t * disp_refr; /*Display being refreshed*/
 
 #if LV_USE_PERF_MONITOR
     static perf_monitor_t   perf_monitor;
@@ -83,6 +98,13 @@ static lv_disp_t * disp_refr; /*Display being refreshed*/
     static mem_monitor_t    mem_monitor;
 #endif
 
+#if LV_USE_PARALLEL_RENDER
+    static lv_draw_ctx_t * worker_draw_ctx;     /*Copy of the display's draw_ctx for the second render thread*/
+    static uint32_t worker_draw_ctx_size;
+    static lv_disp_t worker_disp;               /*Copy of the display and its driver as layers change `screen_transp`*/
+    static lv_disp_drv_t worker_disp_drv;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -239,6 +261,16 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
         return;
     }
 
+    /*Snap to the tile grid and clip to the screen again*/
+    lv_coord_t tile_size = disp->driver->tile_size;
+    if(tile_size > 1) {
+        com_area.x1 &= ~(tile_size - 1);
+        com_area.y1 &= ~(tile_size - 1);
+        com_area.x2 |= tile_size - 1;
+        com_area.y2 |= tile_size - 1;
+        _lv_area_intersect(&com_area, &com_area, &scr_area);
+    }
+
     if(disp->driver->rounder_cb) disp->driver->rounder_cb(disp->driver, &com_area);
 
     /*Save only if this area is not in one of the saved areas*/
@@ -279,6 +311,52 @@ void _lv_refr_set_disp_refreshing(lv_disp_t * disp)
     disp_refr = disp;
 }
 
+/**
+ * Search the most top object which fully covers an area
+ * @param area_p pointer to an area
+ * @param obj the first object to start the searching (typically a screen)
+ * @return the top object or NULL if none covers the area
+ */
+lv_obj_t * _lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
+{
+    lv_obj_t * found_p = NULL;
+
+#if LV_USE_OBJ_INDEX
+    /*Test only the objects of one cell of a screen with an index*/
+    if(obj->parent == NULL && _lv_obj_index_search_cover(obj, area_p, &found_p)) return found_p;
+#endif
+
+    if(_lv_area_is_in(area_p, &obj->coords, 0) == false) return NULL;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return NULL;
+    if(_lv_obj_get_layer_type(obj) != LV_LAYER_TYPE_NONE) return NULL;
+
+    /*If this object is fully cover the draw area then check the children too*/
+    lv_cover_check_info_t info;
+    info.res = LV_COVER_RES_COVER;
+    info.area = area_p;
+    lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+    if(info.res == LV_COVER_RES_MASKED) return NULL;
+
+    int32_t i;
+    int32_t child_cnt = lv_obj_get_child_cnt(obj);
+    for(i = child_cnt - 1; i >= 0; i--) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        found_p = _lv_refr_get_top_obj(area_p, child);
+
+        /*If a children is ok then break*/
+        if(found_p != NULL) {
+            break;
+        }
+    }
+
+    /*If no better children use this object*/
+    if(found_p == NULL && info.res == LV_COVER_RES_COVER) {
+        found_p = obj;
+    }
+
+    return found_p;
+}
+
 /**
  * Called periodically to handle the refreshing
  * @param tmr pointer to the timer itself
@@ -304,6 +382,11 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         disp_refr = lv_disp_get_default();
     }
 
+#if LV_USE_REFR_PROF
+    _lv_refr_prof_frame_begin();
+    uint32_t prof_start = lv_refr_prof_time();
+#endif
+
     /*Refresh the screen's layout if required*/
     lv_obj_update_layout(disp_refr->act_scr);
     if(disp_refr->prev_scr) lv_obj_update_layout(disp_refr->prev_scr);
@@ -311,18 +394,40 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     lv_obj_update_layout(disp_refr->top_layer);
     lv_obj_update_layout(disp_refr->sys_layer);
 
+#if LV_USE_REFR_PROF
+    _lv_refr_prof_add_since(LV_REFR_PROF_LAYOUT, prof_start);
+#endif
+
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
         disp_refr->inv_p = 0;
+#if LV_USE_REFR_PROF
+        _lv_refr_prof_frame_end(0, 0);
+#endif
         LV_LOG_WARN("there is no active screen");
         REFR_TRACE("finished");
         return;
     }
 
+#if LV_USE_REFR_PROF
+    prof_start = lv_refr_prof_time();
+#endif
     lv_refr_join_area();
+#if LV_USE_REFR_PROF
+    _lv_refr_prof_add_since(LV_REFR_PROF_JOIN, prof_start);
+#endif
 
     refr_invalid_areas();
 
+#if LV_USE_REFR_PROF
+    uint32_t prof_areas = 0;
+    uint32_t i;
+    for(i = 0; i < disp_refr->inv_p; i++) {
+        if(disp_refr->inv_area_joined[i] == 0) prof_areas++;
+    }
+    _lv_refr_prof_frame_end(prof_areas, px_num);
+#endif
+
     /*If refresh happened ...*/
     if(disp_refr->inv_p != 0) {
 
@@ -459,40 +564,50 @@ uint32_t lv_refr_get_fps_avg(void)
  **********************/
 
 /**
- * Join the areas which has got common parts
+ * Join the areas which has got common parts.
+ * With `join_trans_px` of the driver also join separate areas if the extra pixels of their union
+ * cost less than the flush saved by joining them.
  */
 static void lv_refr_join_area(void)
 {
     uint32_t join_from;
     uint32_t join_in;
+    uint32_t trans_px = disp_refr->driver->join_trans_px;
     lv_area_t joined_area;
-    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
-        if(disp_refr->inv_area_joined[join_in] != 0) continue;
-
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
-                continue;
-            }
+    bool joined;
+    do {
+        joined = false;
+        for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
+            if(disp_refr->inv_area_joined[join_in] != 0) continue;
+
+            /*Check all areas to join them in 'join_in'*/
+            for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
+                /*Handle only unjoined areas and ignore itself*/
+                if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
+                    continue;
+                }
 
-            /*Check if the areas are on each other*/
-            if(_lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
-            }
+                /*Without a flush cost only areas on each other are joined*/
+                if(trans_px == 0 &&
+                   _lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
+                    continue;
+                }
 
-            _lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
+                _lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
 
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
-                lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+                /*Join two area only if the joined area costs less than the two areas with a flush each*/
+                if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
+                                                     lv_area_get_size(&disp_refr->inv_areas[join_from]) + trans_px)) {
+                    lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                disp_refr->inv_area_joined[join_from] = 1;
+                    /*Mark 'join_form' is joined into 'join_in'*/
+                    disp_refr->inv_area_joined[join_from] = 1;
+                    joined = true;
+                }
             }
         }
-    }
+        /*A grown area might pay off with areas checked before, look again*/
+    } while(joined && trans_px != 0);
 }
 
 /**
@@ -619,9 +734,15 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
     bool full_sized = draw_buf->size == (uint32_t)disp_refr->driver->hor_res * disp_refr->driver->ver_res;
     if((draw_buf->buf1 && !draw_buf->buf2) ||
        (draw_buf->buf1 && draw_buf->buf2 && full_sized)) {
+#if LV_USE_REFR_PROF
+        uint32_t prof_wait_start = lv_refr_prof_time();
+#endif
         while(draw_buf->flushing) {
             if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
         }
+#if LV_USE_REFR_PROF
+        _lv_refr_prof_add_since(LV_REFR_PROF_FLUSH_WAIT, prof_wait_start);
+#endif
 
         /*If the screen is transparent initialize it when the flushing is ready*/
 #if LV_COLOR_SCREEN_TRANSP
@@ -640,11 +761,40 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
     lv_obj_t * top_prev_scr = NULL;
 
     /*Get the most top object which is not covered by others*/
-    top_act_scr = lv_refr_get_top_obj(draw_ctx->buf_area, lv_disp_get_scr_act(disp_refr));
+    top_act_scr = _lv_refr_get_top_obj(draw_ctx->buf_area, lv_disp_get_scr_act(disp_refr));
     if(disp_refr->prev_scr) {
-        top_prev_scr = lv_refr_get_top_obj(draw_ctx->buf_area, disp_refr->prev_scr);
+        top_prev_scr = _lv_refr_get_top_obj(draw_ctx->buf_area, disp_refr->prev_scr);
     }
 
+#if LV_USE_REFR_PROF
+    uint32_t prof_start = lv_refr_prof_time();
+#endif
+
+#if LV_USE_PARALLEL_RENDER
+    if(!refr_area_parallel(draw_ctx, top_act_scr, top_prev_scr))
+#endif
+    {
+        refr_area_layers(draw_ctx, top_act_scr, top_prev_scr);
+    }
+
+    /*The drawing may still run on a GPU*/
+    if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+
+#if LV_USE_REFR_PROF
+    _lv_refr_prof_band_end(prof_start);
+#endif
+
+    draw_buf_flush(disp_refr);
+}
+
+/**
+ * Draw the background, the screens and the top and sys layers on the clip area of a draw context
+ * @param draw_ctx      the draw context to use
+ * @param top_act_scr   the top object on the active screen which covers the buffer or NULL
+ * @param top_prev_scr  the top object on the previous screen which covers the buffer or NULL
+ */
+static void refr_area_layers(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr)
+{
     /*Draw a display background if there is no top object*/
     if(top_act_scr == NULL && top_prev_scr == NULL) {
         lv_area_t a;
@@ -705,51 +855,82 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
     /*Also refresh top and sys layer unconditionally*/
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_top(disp_refr));
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_sys(disp_refr));
-
-    draw_buf_flush(disp_refr);
 }
 
+#if LV_USE_PARALLEL_RENDER
 /**
- * Search the most top object which fully covers an area
- * @param area_p pointer to an area
- * @param obj the first object to start the searching (typically a screen)
- * @return
+ * Draw the upper half of the clip area on this thread and the lower half on the second render thread
+ * @param draw_ctx      the draw context to use
+ * @param top_act_scr   the top object on the active screen which covers the buffer or NULL
+ * @param top_prev_scr  the top object on the previous screen which covers the buffer or NULL
+ * @return              true: the area is drawn; false: the second thread is not used, draw the area here
  */
-static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
+static bool refr_area_parallel(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr)
 {
-    lv_obj_t * found_p = NULL;
-
-    if(_lv_area_is_in(area_p, &obj->coords, 0) == false) return NULL;
-    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return NULL;
-    if(_lv_obj_get_layer_type(obj) != LV_LAYER_TYPE_NONE) return NULL;
-
-    /*If this object is fully cover the draw area then check the children too*/
-    lv_cover_check_info_t info;
-    info.res = LV_COVER_RES_COVER;
-    info.area = area_p;
-    lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
-    if(info.res == LV_COVER_RES_MASKED) return NULL;
-
-    int32_t i;
-    int32_t child_cnt = lv_obj_get_child_cnt(obj);
-    for(i = child_cnt - 1; i >= 0; i--) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        found_p = lv_refr_get_top_obj(area_p, child);
-
-        /*If a children is ok then break*/
-        if(found_p != NULL) {
-            break;
-        }
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    lv_coord_t h = lv_area_get_height(clip_area_ori);
+    if(h < 2) return false;
+
+    /*The worker thread gets its own copy of the draw context as the drawing changes its clip area and buffer*/
+    uint32_t ctx_size = disp_refr->driver->draw_ctx_size;
+    if(worker_draw_ctx_size != ctx_size) {
+        lv_draw_ctx_t * new_ctx = lv_mem_realloc(worker_draw_ctx, ctx_size);
+        LV_ASSERT_MALLOC(new_ctx);
+        if(new_ctx == NULL) return false;
+        worker_draw_ctx = new_ctx;
+        worker_draw_ctx_size = ctx_size;
     }
 
-    /*If no better children use this object*/
-    if(found_p == NULL && info.res == LV_COVER_RES_COVER) {
-        found_p = obj;
-    }
+    lv_area_t clip_top;
+    lv_area_t clip_bottom;
+    lv_area_copy(&clip_top, clip_area_ori);
+    lv_area_copy(&clip_bottom, clip_area_ori);
+    clip_top.y2 = clip_area_ori->y1 + h / 2 - 1;
+    clip_bottom.y1 = clip_top.y2 + 1;
+
+    lv_memcpy(worker_draw_ctx, draw_ctx, ctx_size);
+    worker_draw_ctx->clip_area = &clip_bottom;
+    lv_memcpy(&worker_disp_drv, disp_refr->driver, sizeof(lv_disp_drv_t));
+    worker_disp_drv.draw_ctx = worker_draw_ctx;
+    lv_memcpy(&worker_disp, disp_refr, sizeof(lv_disp_t));
+    worker_disp.driver = &worker_disp_drv;
+
+    refr_job_t job;
+    job.disp = &worker_disp;
+    job.draw_ctx = worker_draw_ctx;
+    job.top_act_scr = top_act_scr;
+    job.top_prev_scr = top_prev_scr;
+    if(!_lv_parallel_start(lv_area_get_size(clip_area_ori), refr_job_task, &job)) return false;
+
+    draw_ctx->clip_area = &clip_top;
+    refr_area_layers(draw_ctx, top_act_scr, top_prev_scr);
+    _lv_parallel_wait();
+    draw_ctx->clip_area = clip_area_ori;
 
-    return found_p;
+    return true;
 }
 
+/**
+ * Draw the part of the area given to the second render thread. Runs on the second thread.
+ * @param param pointer to a `refr_job_t`
+ */
+static void refr_job_task(void * param)
+{
+    refr_job_t * job = param;
+    lv_disp_t * disp_ori = disp_refr;
+    disp_refr = job->disp;
+#if LV_DRAW_COMPLEX
+    _lv_draw_mask_use_thread_list(true);
+#endif
+    refr_area_layers(job->draw_ctx, job->top_act_scr, job->top_prev_scr);
+    if(job->draw_ctx->wait_for_finish) job->draw_ctx->wait_for_finish(job->draw_ctx);
+#if LV_DRAW_COMPLEX
+    _lv_draw_mask_use_thread_list(false);
+#endif
+    disp_refr = disp_ori;
+}
+#endif /*LV_USE_PARALLEL_RENDER*/
+
 /**
  * Make the refreshing from an object. Draw all its children and the youngers too.
  * @param top_p pointer to an objects. Start the drawing from it.
@@ -1159,9 +1340,15 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
             /*Flush the completed area to the display*/
             call_flush_cb(drv, area, rot_buf == NULL ? color_p : rot_buf);
             /*FIXME: Rotation forces legacy behavior where rendering and flushing are done serially*/
+#if LV_USE_REFR_PROF
+            uint32_t prof_start = lv_refr_prof_time();
+#endif
             while(draw_buf->flushing) {
                 if(drv->wait_cb) drv->wait_cb(drv);
             }
+#if LV_USE_REFR_PROF
+            _lv_refr_prof_add_since(LV_REFR_PROF_FLUSH_WAIT, prof_start);
+#endif
             color_p += area_w * height;
             row += height;
         }
@@ -1185,9 +1372,15 @@ static void draw_buf_flush(lv_disp_t * disp)
      * and driver is ready to receive the new buffer */
     bool full_sized = draw_buf->size == (uint32_t)disp_refr->driver->hor_res * disp_refr->driver->ver_res;
     if(draw_buf->buf1 && draw_buf->buf2 && !full_sized) {
+#if LV_USE_REFR_PROF
+        uint32_t prof_start = lv_refr_prof_time();
+#endif
         while(draw_buf->flushing) {
             if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
         }
+#if LV_USE_REFR_PROF
+        _lv_refr_prof_add_since(LV_REFR_PROF_FLUSH_WAIT, prof_start);
+#endif
     }
 
     draw_buf->flushing = 1;
@@ -1228,7 +1421,19 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
         .y2 = area->y2 + drv->offset_y
     };
 
+#if LV_USE_REFR_PROF
+    /*Waits added by the port while flushing are counted as flush wait only*/
+    uint32_t prof_start = lv_refr_prof_time();
+    uint32_t prof_wait = _lv_refr_prof_get_current(LV_REFR_PROF_FLUSH_WAIT);
+#endif
+
     drv->flush_cb(drv, &offset_area, color_p);
+
+#if LV_USE_REFR_PROF
+    uint32_t flush_us = lv_refr_prof_time() - prof_start;
+    uint32_t wait_us = _lv_refr_prof_get_current(LV_REFR_PROF_FLUSH_WAIT) - prof_wait;
+    lv_refr_prof_add(LV_REFR_PROF_FLUSH, flush_us > wait_us ? flush_us - wait_us : 0);
+#endif
 }
 
 #if LV_USE_PERF_MONITOR
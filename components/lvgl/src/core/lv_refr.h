@@ -85,6 +85,14 @@ lv_disp_t * _lv_refr_get_disp_refreshing(void);
  */
 void _lv_refr_set_disp_refreshing(lv_disp_t * disp);
 
+/**
+ * Search the most top object which fully covers an area, with the index of the screen if it has one
+ * @param area_p pointer to an area
+ * @param obj the first object to start the searching (typically a screen)
+ * @return the top object or NULL if none covers the area
+ */
+lv_obj_t * _lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
+
 #if LV_USE_PERF_MONITOR
 /**
  * Reset FPS counter
@@ -0,0 +1,356 @@
+/**
+ * @file lv_refr_prof.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_refr_prof.h"
+
+#if LV_USE_REFR_PROF
+
+#include "lv_disp.h"
+#include "../misc/lv_mem.h"
+#include "../misc/lv_printf.h"
+#include "../misc/lv_timer.h"
+#include "../widgets/lv_label.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define OVERLAY_PERIOD  500
+
+/*The values of a frame after its phases, see `frame_value()`*/
+#define VALUE_TOTAL     (_LV_REFR_PROF_PHASE_NUM)
+#define VALUE_BAND_MAX  (_LV_REFR_PROF_PHASE_NUM + 1)
+#define VALUE_BANDS     (_LV_REFR_PROF_PHASE_NUM + 2)
+#define VALUE_AREAS     (_LV_REFR_PROF_PHASE_NUM + 3)
+#define VALUE_PX        (_LV_REFR_PROF_PHASE_NUM + 4)
+#define VALUE_NUM       (_LV_REFR_PROF_PHASE_NUM + 5)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    lv_refr_prof_time_cb_t time_cb;
+    lv_refr_prof_frame_t cur;       /*The frame being measured*/
+    uint32_t frame_start;
+    bool in_refr;
+    lv_refr_prof_frame_t frames[LV_REFR_PROF_FRAMES];
+    uint32_t head;                  /*Index of the next frame to record*/
+    uint32_t cnt;
+} refr_prof_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t frame_value(const lv_refr_prof_frame_t * f, uint32_t value);
+static void get_dist(uint32_t value, uint32_t * buf, lv_refr_prof_dist_t * dist);
+static void print_fmt(lv_refr_prof_print_cb_t print_cb, void * user_data, const char * fmt, ...);
+#if LV_USE_LABEL
+    static void overlay_timer_cb(lv_timer_t * t);
+    static void overlay_delete_cb(lv_event_t * e);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static refr_prof_t prof;
+
+static const char * const value_names[VALUE_NUM] = {
+    "idle", "lock", "invalidate", "layout", "join", "render", "flush", "flush_wait",
+    "frame", "band_max", "bands", "areas", "px"
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_refr_prof_set_time_cb(lv_refr_prof_time_cb_t time_cb)
+{
+    prof.time_cb = time_cb;
+    lv_refr_prof_reset();
+}
+
+uint32_t lv_refr_prof_time(void)
+{
+    return prof.time_cb ? prof.time_cb() : 0;
+}
+
+void lv_refr_prof_add(lv_refr_prof_phase_t phase, uint32_t us)
+{
+    if(prof.time_cb == NULL || phase >= _LV_REFR_PROF_PHASE_NUM) return;
+
+    prof.cur.phase_us[phase] += us;
+}
+
+void lv_refr_prof_reset(void)
+{
+    lv_memset_00(&prof.cur, sizeof(prof.cur));
+    prof.head = 0;
+    prof.cnt = 0;
+}
+
+uint32_t lv_refr_prof_get_frame_cnt(void)
+{
+    return prof.cnt;
+}
+
+const lv_refr_prof_frame_t * lv_refr_prof_get_frame(uint32_t idx)
+{
+    if(idx >= prof.cnt) return NULL;
+
+    return &prof.frames[(prof.head + LV_REFR_PROF_FRAMES - prof.cnt + idx) % LV_REFR_PROF_FRAMES];
+}
+
+void lv_refr_prof_get_stats(lv_refr_prof_stats_t * stats)
+{
+    lv_memset_00(stats, sizeof(lv_refr_prof_stats_t));
+    stats->frame_cnt = prof.cnt;
+    if(prof.cnt == 0) return;
+
+    uint32_t * buf = lv_mem_buf_get(prof.cnt * sizeof(uint32_t));
+    if(buf == NULL) return;
+
+    uint32_t i;
+    for(i = 0; i < _LV_REFR_PROF_PHASE_NUM; i++) {
+        get_dist(i, buf, &stats->phase[i]);
+    }
+    get_dist(VALUE_TOTAL, buf, &stats->total);
+    get_dist(VALUE_BAND_MAX, buf, &stats->band_max);
+    get_dist(VALUE_BANDS, buf, &stats->bands);
+
+    lv_mem_buf_release(buf);
+}
+
+void lv_refr_prof_dump(lv_refr_prof_print_cb_t print_cb, void * user_data)
+{
+    lv_refr_prof_stats_t stats;
+    lv_refr_prof_get_stats(&stats);
+
+    print_fmt(print_cb, user_data, "%-10s %5"LV_PRIu32" frames %8s %8s %8s %8s %8s\n", "refr prof", stats.frame_cnt,
+              "mean", "p50", "p95", "p99", "max");
+
+    uint32_t i;
+    for(i = 0; i <= VALUE_BANDS; i++) {
+        const lv_refr_prof_dist_t * d;
+        if(i < _LV_REFR_PROF_PHASE_NUM) d = &stats.phase[i];
+        else if(i == VALUE_TOTAL) d = &stats.total;
+        else if(i == VALUE_BAND_MAX) d = &stats.band_max;
+        else d = &stats.bands;
+
+        /*`bands` is a count, the rest are microseconds*/
+        print_fmt(print_cb, user_data, "%-10s %12s %8"LV_PRIu32" %8"LV_PRIu32" %8"LV_PRIu32" %8"LV_PRIu32" %8"LV_PRIu32"\n",
+                  value_names[i], i == VALUE_BANDS ? "" : "us", d->mean, d->p50, d->p95, d->p99, d->max);
+    }
+}
+
+void lv_refr_prof_export_json(lv_refr_prof_print_cb_t print_cb, void * user_data)
+{
+    lv_refr_prof_stats_t stats;
+    lv_refr_prof_get_stats(&stats);
+
+    print_fmt(print_cb, user_data, "{\"frame_cnt\": %"LV_PRIu32", \"stats\": {", stats.frame_cnt);
+    uint32_t i;
+    for(i = 0; i <= VALUE_BANDS; i++) {
+        const lv_refr_prof_dist_t * d;
+        if(i < _LV_REFR_PROF_PHASE_NUM) d = &stats.phase[i];
+        else if(i == VALUE_TOTAL) d = &stats.total;
+        else if(i == VALUE_BAND_MAX) d = &stats.band_max;
+        else d = &stats.bands;
+
+        print_fmt(print_cb, user_data,
+                  "%s\"%s\": {\"mean\": %"LV_PRIu32", \"p50\": %"LV_PRIu32", \"p95\": %"LV_PRIu32", \"p99\": %"LV_PRIu32", \"max\": %"LV_PRIu32"}",
+                  i == 0 ? "" : ", ", value_names[i], d->mean, d->p50, d->p95, d->p99, d->max);
+    }
+
+    print_fmt(print_cb, user_data, "},\n\"columns\": [");
+    for(i = 0; i < VALUE_NUM; i++) {
+        print_fmt(print_cb, user_data, "%s\"%s\"", i == 0 ? "" : ", ", value_names[i]);
+    }
+
+    print_fmt(print_cb, user_data, "],\n\"frames\": [");
+    uint32_t f;
+    for(f = 0; f < prof.cnt; f++) {
+        const lv_refr_prof_frame_t * frame = lv_refr_prof_get_frame(f);
+        print_fmt(print_cb, user_data, "%s\n [", f == 0 ? "" : ",");
+        for(i = 0; i < VALUE_NUM; i++) {
+            print_fmt(print_cb, user_data, "%s%"LV_PRIu32, i == 0 ? "" : ", ", frame_value(frame, i));
+        }
+        print_fmt(print_cb, user_data, "]");
+    }
+    print_fmt(print_cb, user_data, "]}");
+}
+
+#if LV_USE_LABEL
+lv_obj_t * lv_refr_prof_overlay_create(void)
+{
+    lv_obj_t * label = lv_label_create(lv_layer_sys());
+    lv_obj_set_style_bg_opa(label, LV_OPA_50, 0);
+    lv_obj_set_style_bg_color(label, lv_color_black(), 0);
+    lv_obj_set_style_text_color(label, lv_color_white(), 0);
+    lv_obj_set_style_pad_all(label, 3, 0);
+    lv_label_set_text(label, "?");
+
+    lv_timer_t * timer = lv_timer_create(overlay_timer_cb, OVERLAY_PERIOD, label);
+    lv_obj_add_event_cb(label, overlay_delete_cb, LV_EVENT_DELETE, timer);
+    return label;
+}
+#endif
+
+void _lv_refr_prof_frame_begin(void)
+{
+    if(prof.time_cb == NULL) return;
+
+    prof.frame_start = prof.time_cb();
+    prof.in_refr = true;
+}
+
+void _lv_refr_prof_frame_end(uint32_t areas, uint32_t px)
+{
+    if(prof.time_cb == NULL || !prof.in_refr) return;
+
+    prof.in_refr = false;
+
+    /*Keep the idle, lock and invalidation time for the next frame if nothing was refreshed*/
+    if(areas == 0) {
+        uint32_t i;
+        for(i = LV_REFR_PROF_LAYOUT; i < _LV_REFR_PROF_PHASE_NUM; i++) {
+            prof.cur.phase_us[i] = 0;
+        }
+        prof.cur.bands = 0;
+        prof.cur.band_max_us = 0;
+        return;
+    }
+
+    prof.cur.total_us = prof.time_cb() - prof.frame_start;
+    prof.cur.areas = (uint16_t)LV_MIN(areas, UINT16_MAX);
+    prof.cur.px = px;
+
+    prof.frames[prof.head] = prof.cur;
+    prof.head = (prof.head + 1) % LV_REFR_PROF_FRAMES;
+    if(prof.cnt < LV_REFR_PROF_FRAMES) prof.cnt++;
+
+    lv_memset_00(&prof.cur, sizeof(prof.cur));
+}
+
+uint32_t _lv_refr_prof_add_since(lv_refr_prof_phase_t phase, uint32_t start)
+{
+    if(prof.time_cb == NULL) return 0;
+
+    /*Invalidation during the refresh (e.g. by the layout) belongs to the phase which caused it*/
+    if(phase == LV_REFR_PROF_INVALIDATE && prof.in_refr) return 0;
+
+    uint32_t us = prof.time_cb() - start;
+    prof.cur.phase_us[phase] += us;
+    return us;
+}
+
+void _lv_refr_prof_band_end(uint32_t start)
+{
+    uint32_t us = _lv_refr_prof_add_since(LV_REFR_PROF_RENDER, start);
+    if(prof.time_cb == NULL) return;
+
+    if(prof.cur.bands < UINT16_MAX) prof.cur.bands++;
+    if(us > prof.cur.band_max_us) prof.cur.band_max_us = us;
+}
+
+uint32_t _lv_refr_prof_get_current(lv_refr_prof_phase_t phase)
+{
+    return prof.cur.phase_us[phase];
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint32_t frame_value(const lv_refr_prof_frame_t * f, uint32_t value)
+{
+    if(value < _LV_REFR_PROF_PHASE_NUM) return f->phase_us[value];
+
+    switch(value) {
+        case VALUE_TOTAL:
+            return f->total_us;
+        case VALUE_BAND_MAX:
+            return f->band_max_us;
+        case VALUE_BANDS:
+            return f->bands;
+        case VALUE_AREAS:
+            return f->areas;
+        default:
+            return f->px;
+    }
+}
+
+/**
+ * Get the distribution of a value of the recorded frames. The percentiles are nearest rank.
+ * @param value     index of the value, see `frame_value()`
+ * @param buf       room for `prof.cnt` values
+ * @param dist      store the distribution here
+ */
+static void get_dist(uint32_t value, uint32_t * buf, lv_refr_prof_dist_t * dist)
+{
+    uint32_t n = prof.cnt;
+    uint64_t sum = 0;
+    uint32_t i;
+
+    /*Insertion sort, the ring is small*/
+    for(i = 0; i < n; i++) {
+        uint32_t v = frame_value(lv_refr_prof_get_frame(i), value);
+        uint32_t j = i;
+        while(j > 0 && buf[j - 1] > v) {
+            buf[j] = buf[j - 1];
+            j--;
+        }
+        buf[j] = v;
+        sum += v;
+    }
+
+    dist->mean = (uint32_t)(sum / n);
+    dist->p50 = buf[(n * 50 + 99) / 100 - 1];
+    dist->p95 = buf[(n * 95 + 99) / 100 - 1];
+    dist->p99 = buf[(n * 99 + 99) / 100 - 1];
+    dist->max = buf[n - 1];
+}
+
+static void print_fmt(lv_refr_prof_print_cb_t print_cb, void * user_data, const char * fmt, ...)
+{
+    char buf[256];
+    va_list args;
+    va_start(args, fmt);
+    lv_vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    print_cb(buf, user_data);
+}
+
+#if LV_USE_LABEL
+static void overlay_timer_cb(lv_timer_t * t)
+{
+    lv_obj_t * label = t->user_data;
+    lv_refr_prof_stats_t stats;
+    lv_refr_prof_get_stats(&stats);
+
+    lv_label_set_text_fmt(label,
+                          "us     p50  p95\n"
+                          "frame %4"LV_PRIu32" %4"LV_PRIu32"\n"
+                          "render %4"LV_PRIu32" %4"LV_PRIu32"\n"
+                          "flush %4"LV_PRIu32" %4"LV_PRIu32"\n"
+                          "wait %4"LV_PRIu32" %4"LV_PRIu32,
+                          stats.total.p50, stats.total.p95,
+                          stats.phase[LV_REFR_PROF_RENDER].p50, stats.phase[LV_REFR_PROF_RENDER].p95,
+                          stats.phase[LV_REFR_PROF_FLUSH].p50, stats.phase[LV_REFR_PROF_FLUSH].p95,
+                          stats.phase[LV_REFR_PROF_FLUSH_WAIT].p50, stats.phase[LV_REFR_PROF_FLUSH_WAIT].p95);
+}
+
+static void overlay_delete_cb(lv_event_t * e)
+{
+    lv_timer_del(lv_event_get_user_data(e));
+}
+#endif
+
+#endif /*LV_USE_REFR_PROF*/
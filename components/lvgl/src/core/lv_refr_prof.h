@@ -0,0 +1,196 @@
+/**
+ * @file lv_refr_prof.h
+ * Time the phases of the refreshed frames (invalidation, layout, joining, rendering, flushing and waiting)
+ * and keep the last `LV_REFR_PROF_FRAMES` frames for percentiles, a console dump and a JSON export.
+ */
+
+#ifndef LV_REFR_PROF_H
+#define LV_REFR_PROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if LV_USE_REFR_PROF
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_obj_t;
+
+typedef enum {
+    LV_REFR_PROF_IDLE,          /**< Sleeping between the frames, added by the port*/
+    LV_REFR_PROF_LOCK,          /**< Waiting for the mutex of LVGL, added by the port*/
+    LV_REFR_PROF_INVALIDATE,    /**< In `lv_obj_invalidate()` and the like since the previous frame*/
+    LV_REFR_PROF_LAYOUT,        /**< Updating the layout of the screens and layers*/
+    LV_REFR_PROF_JOIN,          /**< Joining the invalidated areas*/
+    LV_REFR_PROF_RENDER,        /**< Drawing the objects into the draw buffer*/
+    LV_REFR_PROF_FLUSH,         /**< In `flush_cb`, without the waits added by the port*/
+    LV_REFR_PROF_FLUSH_WAIT,    /**< Waiting for a flush to finish before drawing or flushing again*/
+    _LV_REFR_PROF_PHASE_NUM
+} lv_refr_prof_phase_t;
+
+typedef struct {
+    uint32_t phase_us[_LV_REFR_PROF_PHASE_NUM];
+    uint32_t total_us;          /**< From the start to the end of the refresh, without IDLE, LOCK and INVALIDATE*/
+    uint32_t band_max_us;       /**< Render time of the slowest part drawn into the draw buffer*/
+    uint32_t px;                /**< Refreshed pixels*/
+    uint16_t areas;             /**< Refreshed areas after joining*/
+    uint16_t bands;             /**< Parts drawn into the draw buffer*/
+} lv_refr_prof_frame_t;
+
+typedef struct {
+    uint32_t mean;
+    uint32_t p50;
+    uint32_t p95;
+    uint32_t p99;
+    uint32_t max;
+} lv_refr_prof_dist_t;
+
+typedef struct {
+    uint32_t frame_cnt;         /**< Frames in the statistics (at most `LV_REFR_PROF_FRAMES`)*/
+    lv_refr_prof_dist_t phase[_LV_REFR_PROF_PHASE_NUM];
+    lv_refr_prof_dist_t total;
+    lv_refr_prof_dist_t band_max;
+    lv_refr_prof_dist_t bands;
+} lv_refr_prof_stats_t;
+
+/**
+ * Return a free running time in microseconds. It may wrap around.
+ */
+typedef uint32_t (*lv_refr_prof_time_cb_t)(void);
+
+/**
+ * Receive a piece of the text of `lv_refr_prof_dump()` or `lv_refr_prof_export_json()`
+ */
+typedef void (*lv_refr_prof_print_cb_t)(const char * str, void * user_data);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Set the time source of the profiler. Nothing is measured until it's set.
+ * @param time_cb   a function returning microseconds, NULL to stop measuring
+ */
+void lv_refr_prof_set_time_cb(lv_refr_prof_time_cb_t time_cb);
+
+/**
+ * Get the time of the profiler's time source
+ * @return          the current time in microseconds or 0 if there is no time source
+ */
+uint32_t lv_refr_prof_time(void);
+
+/**
+ * Add time spent outside of LVGL to the next recorded frame, e.g. `LV_REFR_PROF_IDLE` and `LV_REFR_PROF_LOCK`
+ * measured by the task calling `lv_timer_handler()`. `LV_REFR_PROF_FLUSH_WAIT` added while `flush_cb` runs
+ * is subtracted from `LV_REFR_PROF_FLUSH`.
+ * @param phase     the phase to add to
+ * @param us        microseconds spent in the phase
+ */
+void lv_refr_prof_add(lv_refr_prof_phase_t phase, uint32_t us);
+
+/**
+ * Forget the recorded frames and the time added to the next frame
+ */
+void lv_refr_prof_reset(void);
+
+/**
+ * Get the number of recorded frames
+ * @return          the number of frames, at most `LV_REFR_PROF_FRAMES`
+ */
+uint32_t lv_refr_prof_get_frame_cnt(void);
+
+/**
+ * Get a recorded frame
+ * @param idx       0: the oldest frame, `lv_refr_prof_get_frame_cnt() - 1`: the latest one
+ * @return          pointer to the frame or NULL if `idx` is out of range
+ */
+const lv_refr_prof_frame_t * lv_refr_prof_get_frame(uint32_t idx);
+
+/**
+ * Get the mean, the percentiles and the maximum of the phases of the recorded frames
+ * @param stats     store the statistics here
+ */
+void lv_refr_prof_get_stats(lv_refr_prof_stats_t * stats);
+
+/**
+ * Print the statistics of the recorded frames as a table, a line per call of `print_cb`
+ * @param print_cb  receives the lines with their '\n'
+ * @param user_data passed to `print_cb`
+ */
+void lv_refr_prof_dump(lv_refr_prof_print_cb_t print_cb, void * user_data);
+
+/**
+ * Print the statistics and every recorded frame as a JSON object
+ * @param print_cb  receives the JSON in pieces
+ * @param user_data passed to `print_cb`
+ */
+void lv_refr_prof_export_json(lv_refr_prof_print_cb_t print_cb, void * user_data);
+
+#if LV_USE_LABEL
+/**
+ * Create a label on the system layer showing the median and the 95th percentile of the main phases.
+ * It's updated every 500 ms, delete it like any object.
+ * @return          pointer to the label, align it as needed
+ */
+struct _lv_obj_t * lv_refr_prof_overlay_create(void);
+#endif
+
+/**
+ * Start a refresh of a display
+ */
+void _lv_refr_prof_frame_begin(void);
+
+/**
+ * End the refresh started by `_lv_refr_prof_frame_begin()` and record it if something was refreshed
+ * @param areas     number of refreshed areas, 0 if nothing was refreshed
+ * @param px        number of refreshed pixels
+ */
+void _lv_refr_prof_frame_end(uint32_t areas, uint32_t px);
+
+/**
+ * Add the time since `start` to a phase of the current frame
+ * @param phase     the phase to add to
+ * @param start     a time returned by `lv_refr_prof_time()`
+ * @return          the added microseconds
+ */
+uint32_t _lv_refr_prof_add_since(lv_refr_prof_phase_t phase, uint32_t start);
+
+/**
+ * Add the render time of a part drawn into the draw buffer
+ * @param start     a time returned by `lv_refr_prof_time()` before drawing the part
+ */
+void _lv_refr_prof_band_end(uint32_t start);
+
+/**
+ * Get the time of a phase accumulated in the current frame, to exclude nested phases
+ * @param phase     a phase
+ * @return          microseconds of the phase so far
+ */
+uint32_t _lv_refr_prof_get_current(lv_refr_prof_phase_t phase);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_REFR_PROF*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_REFR_PROF_H*/
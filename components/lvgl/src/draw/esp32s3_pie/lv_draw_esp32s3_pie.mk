@@ -0,0 +1,6 @@
+CSRCS += lv_gpu_esp32s3_pie.c
+
+DEPPATH += --dep-path $(LVGL_DIR)/$(LVGL_DIR_NAME)/src/draw/esp32s3_pie
+VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/draw/esp32s3_pie
+
+CFLAGS += "-I$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/draw/esp32s3_pie"
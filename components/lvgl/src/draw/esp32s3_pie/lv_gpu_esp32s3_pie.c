@@ -0,0 +1,471 @@
+/**
+ * @file lv_gpu_esp32s3_pie.c
+ *
+ * Normal blending of RGB565 stored with swapped bytes (`LV_COLOR_16_SWAP`) with the PIE
+ * (Processor Instruction Extensions) vector instructions of ESP32-S3, 8 pixels per instruction.
+ * The kernels are in lv_gpu_esp32s3_pie.S. Their C reference below does the same lane operations
+ * one pixel at a time, it replaces the kernels on other targets (e.g. the tests on the PC).
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+#include "lv_gpu_esp32s3_pie.h"
+#include "../../core/lv_refr.h"
+
+#if LV_USE_GPU_ESP32S3_PIE
+
+/*********************
+ *      DEFINES
+ *********************/
+/*The kernels of lv_gpu_esp32s3_pie.S are used on ESP32-S3, their C reference everywhere else*/
+#if defined(ESP_PLATFORM) && defined(CONFIG_IDF_TARGET_ESP32S3)
+    #define PIE_ASM 1
+#else
+    #define PIE_ASM 0
+#endif
+
+#define LANES       8       /*16 bit lanes of a 128 bit PIE register*/
+#define CHUNK_PX    64      /*Pixels of a row whose opacities are prepared for one kernel call*/
+#define PIE_ALIGNED __attribute__((aligned(16)))
+
+/*Index of the constants in `lv_gpu_esp32s3_pie_mix_consts`, the kernel loads them from `2 * index` bytes.
+ *PIE has no 16 bit shifts, the lanes are multiplied instead: with SAR 16 `(x * 8192) >> 16 == x >> 3`,
+ *with SAR 0 the lower 16 bits of `x * 8192` are `(x & 7) << 13`.*/
+#define K_8192      0
+#define K_256       1
+#define K_8         2
+#define K_1F        3
+#define K_38        4
+#define K_8081      5       /*With SAR 23 `(x * 0x8081) >> 23 == LV_UDIV255(x)`*/
+#define K_255       6
+#define K_OFS       7
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    ALPHA_TRANSP,
+    ALPHA_COVER,
+    ALPHA_MIX,
+} alpha_res_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void ref_fill(uint16_t * dest, const uint16_t * color8, uint32_t px);
+static void ref_copy(uint16_t * dest, const uint16_t * src, uint32_t px);
+static void ref_mix(uint16_t * dest, const uint16_t * fg, uint32_t fg_inc, const uint16_t * alpha,
+                    uint32_t alpha_inc, uint32_t px);
+
+#if PIE_ASM
+/*lv_gpu_esp32s3_pie.S. `dest` (and `src`, `fg` and `alpha` if they have a value per pixel) are 16 byte aligned.*/
+void lv_gpu_esp32s3_pie_asm_fill(uint16_t * dest, const uint16_t * color8, uint32_t blocks);
+void lv_gpu_esp32s3_pie_asm_copy(uint16_t * dest, const uint16_t * src, uint32_t blocks);
+void lv_gpu_esp32s3_pie_asm_mix(uint16_t * dest, const uint16_t * fg, uint32_t fg_inc, const uint16_t * alpha,
+                                uint32_t alpha_inc, uint32_t blocks);
+#endif
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+/*Broadcast to the lanes by the mix kernel*/
+const uint16_t lv_gpu_esp32s3_pie_mix_consts[LANES] PIE_ALIGNED = {
+    8192, 256, 8, 0x1F, 0x38, 0x8081, 255, LV_COLOR_MIX_ROUND_OFS
+};
+
+/**********************
+ *      MACROS
+ **********************/
+#if PIE_ASM
+    #define KERNEL_FILL(dest, color8, blocks)   lv_gpu_esp32s3_pie_asm_fill(dest, color8, blocks)
+    #define KERNEL_COPY(dest, src, blocks)      lv_gpu_esp32s3_pie_asm_copy(dest, src, blocks)
+    #define KERNEL_MIX(dest, fg, fg_inc, alpha, alpha_inc, blocks) \
+        lv_gpu_esp32s3_pie_asm_mix(dest, fg, fg_inc, alpha, alpha_inc, blocks)
+#else
+    #define KERNEL_FILL(dest, color8, blocks)   ref_fill(dest, color8, (blocks) * LANES)
+    #define KERNEL_COPY(dest, src, blocks)      ref_copy(dest, src, (blocks) * LANES)
+    #define KERNEL_MIX(dest, fg, fg_inc, alpha, alpha_inc, blocks) \
+        ref_mix(dest, fg, fg_inc, alpha, alpha_inc, (blocks) * LANES)
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*One lane of the PIE instructions used by the kernels*/
+
+/*EE.VMUL.U16: the product shifted right by SAR, lower 16 bits*/
+static inline uint16_t vmul_u16(uint16_t x, uint16_t y, uint32_t sar)
+{
+    return (uint16_t)(((uint32_t)x * y) >> sar);
+}
+
+/*EE.VADDS.S16*/
+static inline uint16_t vadds_s16(uint16_t x, uint16_t y)
+{
+    int32_t s = (int32_t)(int16_t)x + (int16_t)y;
+    return (uint16_t)LV_CLAMP(INT16_MIN, s, INT16_MAX);
+}
+
+/*EE.VSUBS.S16*/
+static inline uint16_t vsubs_s16(uint16_t x, uint16_t y)
+{
+    int32_t s = (int32_t)(int16_t)x - (int16_t)y;
+    return (uint16_t)LV_CLAMP(INT16_MIN, s, INT16_MAX);
+}
+
+static void ref_fill(uint16_t * dest, const uint16_t * color8, uint32_t px)
+{
+    uint32_t i;
+    for(i = 0; i < px; i++) dest[i] = color8[i % LANES];
+}
+
+static void ref_copy(uint16_t * dest, const uint16_t * src, uint32_t px)
+{
+    uint32_t i;
+    for(i = 0; i < px; i++) dest[i] = src[i];
+}
+
+/*The mix kernel lane by lane, in the order of its instructions. `fg_inc` and `alpha_inc` are 0 for a single value.
+ *The swapped pixel has green[2:0] in bits 15..13, blue in 12..8, red in 7..3 and green[5:3] in 2..0*/
+static void ref_mix(uint16_t * dest, const uint16_t * fg, uint32_t fg_inc, const uint16_t * alpha,
+                    uint32_t alpha_inc, uint32_t px)
+{
+    const uint16_t * k = lv_gpu_esp32s3_pie_mix_consts;
+    uint32_t i;
+    for(i = 0; i < px; i++) {
+        uint16_t f = fg[i * fg_inc];
+        uint16_t b = dest[i];
+        uint16_t a = alpha[i * alpha_inc];
+        uint16_t na = vsubs_s16(k[K_255], a);
+        uint16_t fc;
+        uint16_t bc;
+        uint16_t res;
+
+        /*Red*/
+        fc = vmul_u16(f, k[K_8192], 16) & k[K_1F];
+        bc = vmul_u16(b, k[K_8192], 16) & k[K_1F];
+        fc = vadds_s16(vadds_s16(vmul_u16(fc, a, 0), vmul_u16(bc, na, 0)), k[K_OFS]);
+        fc = vmul_u16(fc, k[K_8081], 23);
+        res = vmul_u16(fc, k[K_8], 0);
+
+        /*Blue*/
+        fc = vmul_u16(f, k[K_256], 16) & k[K_1F];
+        bc = vmul_u16(b, k[K_256], 16) & k[K_1F];
+        fc = vadds_s16(vadds_s16(vmul_u16(fc, a, 0), vmul_u16(bc, na, 0)), k[K_OFS]);
+        fc = vmul_u16(fc, k[K_8081], 23);
+        res |= vmul_u16(fc, k[K_256], 0);
+
+        /*Green*/
+        fc = (vmul_u16(f, k[K_8], 0) & k[K_38]) | vmul_u16(f, k[K_8], 16);
+        bc = (vmul_u16(b, k[K_8], 0) & k[K_38]) | vmul_u16(b, k[K_8], 16);
+        fc = vadds_s16(vadds_s16(vmul_u16(fc, a, 0), vmul_u16(bc, na, 0)), k[K_OFS]);
+        fc = vmul_u16(fc, k[K_8081], 23);
+        res |= vmul_u16(fc, k[K_8192], 16) | vmul_u16(fc, k[K_8192], 0);
+
+        dest[i] = res;
+    }
+}
+
+/*Pixels before the first 16 byte aligned one*/
+static inline int32_t head_px(const uint16_t * p)
+{
+    return (int32_t)((0x10 - ((lv_uintptr_t)p & 0xF)) & 0xF) / 2;
+}
+
+/*Index of the first pixel of `dest` in a 16 byte aligned buffer which has the values aligned like the pixels*/
+static inline int32_t buf_ofs(const uint16_t * dest)
+{
+    return (int32_t)((lv_uintptr_t)dest & 0xF) / 2;
+}
+
+static void fill_row(uint16_t * dest, int32_t w, const uint16_t * color8)
+{
+    int32_t head = LV_MIN(w, head_px(dest));
+    int32_t blocks = (w - head) / LANES;
+    int32_t x = head + blocks * LANES;
+    ref_fill(dest, color8, head);
+    if(blocks) KERNEL_FILL(dest + head, color8, blocks);
+    ref_fill(dest + x, color8, w - x);
+}
+
+static void copy_row(uint16_t * dest, const uint16_t * src, int32_t w)
+{
+    if(((lv_uintptr_t)dest ^ (lv_uintptr_t)src) & 0xF) {
+        lv_memcpy(dest, src, w * sizeof(uint16_t));
+        return;
+    }
+
+    int32_t head = LV_MIN(w, head_px(dest));
+    int32_t blocks = (w - head) / LANES;
+    int32_t x = head + blocks * LANES;
+    ref_copy(dest, src, head);
+    if(blocks) KERNEL_COPY(dest + head, src + head, blocks);
+    ref_copy(dest + x, src + x, w - x);
+}
+
+/*With `inc == 1` `fg` and `alpha` have a value per pixel, aligned like the pixels of `dest`.
+ *With `inc == 0` they point to `LANES` equal 16 byte aligned values.*/
+static void mix_row(uint16_t * dest, const uint16_t * fg, uint32_t fg_inc, const uint16_t * alpha,
+                    uint32_t alpha_inc, int32_t w)
+{
+    int32_t head = LV_MIN(w, head_px(dest));
+    int32_t blocks = (w - head) / LANES;
+    int32_t x = head + blocks * LANES;
+    ref_mix(dest, fg, fg_inc, alpha, alpha_inc, head);
+    if(blocks) KERNEL_MIX(dest + head, fg + head * fg_inc, fg_inc, alpha + head * alpha_inc, alpha_inc, blocks);
+    ref_mix(dest + x, fg + x * fg_inc, fg_inc, alpha + x * alpha_inc, alpha_inc, w - x);
+}
+
+/*The mix ratio of masked pixels like `fill_normal()` (`mask_full == LV_OPA_COVER`) and `map_normal()`
+ *(`mask_full == LV_OPA_MAX`) of the basic blender calculate it. `opa == LV_OPA_COVER` means the mask alone.*/
+static alpha_res_t prepare_alpha(uint16_t * alpha, const lv_opa_t * mask, int32_t n, lv_opa_t opa,
+                                 lv_opa_t mask_full)
+{
+    uint32_t all = 0xFF;
+    uint32_t any = 0;
+    int32_t i;
+    if(opa == LV_OPA_COVER) {
+        for(i = 0; i < n; i++) {
+            alpha[i] = mask[i];
+            all &= mask[i];
+            any |= mask[i];
+        }
+    }
+    else {
+        for(i = 0; i < n; i++) {
+            uint32_t a = mask[i] >= mask_full ? opa : (uint32_t)((uint32_t)mask[i] * opa) >> 8;
+            alpha[i] = (uint16_t)a;
+            all &= a;
+            any |= a;
+        }
+    }
+
+    if(any == 0) return ALPHA_TRANSP;
+    if(all == 0xFF) return ALPHA_COVER;
+    return ALPHA_MIX;
+}
+
+static void set_lanes(uint16_t * v, uint16_t value)
+{
+    uint32_t i;
+    for(i = 0; i < LANES; i++) v[i] = value;
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+LV_ATTRIBUTE_FAST_MEM void lv_gpu_esp32s3_pie_fill(uint16_t * dest, lv_coord_t dest_stride, lv_coord_t w,
+                                                   lv_coord_t h, uint16_t color, lv_opa_t opa,
+                                                   const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    PIE_ALIGNED uint16_t color8[LANES];
+    PIE_ALIGNED uint16_t alpha_buf[CHUNK_PX + LANES];
+    int32_t x;
+    int32_t y;
+
+    set_lanes(color8, color);
+
+    if(mask == NULL) {
+        if(opa >= LV_OPA_MAX) {
+            for(y = 0; y < h; y++) {
+                fill_row(dest, w, color8);
+                dest += dest_stride;
+            }
+            return;
+        }
+
+#if LV_COLOR_MIX_ROUND_OFS == 0
+        /*The same rounding of the opacity as `fill_normal()` of the basic blender with 16 bit colors*/
+        opa = (uint32_t)((uint32_t)opa + 4) >> 3;
+        opa = opa << 3;
+#endif
+        set_lanes(alpha_buf, opa);
+        for(y = 0; y < h; y++) {
+            mix_row(dest, color8, 0, alpha_buf, 0, w);
+            dest += dest_stride;
+        }
+        return;
+    }
+
+    if(opa >= LV_OPA_MAX) opa = LV_OPA_COVER;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x += CHUNK_PX) {
+            int32_t n = LV_MIN(CHUNK_PX, w - x);
+            uint16_t * alpha = alpha_buf + buf_ofs(dest + x);
+            alpha_res_t res = prepare_alpha(alpha, mask + x, n, opa, LV_OPA_COVER);
+            if(res == ALPHA_COVER) fill_row(dest + x, n, color8);
+            else if(res == ALPHA_MIX) mix_row(dest + x, color8, 0, alpha, 1, n);
+        }
+        dest += dest_stride;
+        mask += mask_stride;
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM void lv_gpu_esp32s3_pie_map(uint16_t * dest, lv_coord_t dest_stride, const uint16_t * src,
+                                                  lv_coord_t src_stride, lv_coord_t w, lv_coord_t h, lv_opa_t opa,
+                                                  const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    PIE_ALIGNED uint16_t alpha_buf[CHUNK_PX + LANES];
+    PIE_ALIGNED uint16_t src_buf[CHUNK_PX + LANES];
+    int32_t x;
+    int32_t y;
+
+    if(mask == NULL) {
+        if(opa >= LV_OPA_MAX) {
+            for(y = 0; y < h; y++) {
+                copy_row(dest, src, w);
+                dest += dest_stride;
+                src += src_stride;
+            }
+            return;
+        }
+        set_lanes(alpha_buf, opa);
+    }
+    /*Same opacity limit as `map_normal()` of the basic blender*/
+    else if(opa > LV_OPA_MAX) {
+        opa = LV_OPA_COVER;
+    }
+
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x += CHUNK_PX) {
+            int32_t n = LV_MIN(CHUNK_PX, w - x);
+            uint16_t * d = dest + x;
+            const uint16_t * s = src + x;
+            uint16_t * alpha = alpha_buf;
+            uint32_t alpha_inc = 0;
+            if(mask) {
+                alpha = alpha_buf + buf_ofs(d);
+                alpha_inc = 1;
+                alpha_res_t res = prepare_alpha(alpha, mask + x, n, opa, LV_OPA_MAX);
+                if(res == ALPHA_TRANSP) continue;
+                if(res == ALPHA_COVER) {
+                    copy_row(d, s, n);
+                    continue;
+                }
+            }
+
+            /*The kernel loads the image with the alignment of the destination*/
+            if(((lv_uintptr_t)d ^ (lv_uintptr_t)s) & 0xF) {
+                lv_memcpy(src_buf + buf_ofs(d), s, n * sizeof(uint16_t));
+                s = src_buf + buf_ofs(d);
+            }
+            mix_row(d, s, 1, alpha, alpha_inc, n);
+        }
+        dest += dest_stride;
+        src += src_stride;
+        if(mask) mask += mask_stride;
+    }
+}
+
+bool lv_gpu_esp32s3_pie_check(void)
+{
+#if PIE_ASM
+    static int8_t checked = -1;
+    if(checked >= 0) return checked;
+
+    PIE_ALIGNED uint16_t fg[4 * LANES];
+    PIE_ALIGNED uint16_t alpha[4 * LANES];
+    PIE_ALIGNED uint16_t ref[4 * LANES];
+    PIE_ALIGNED uint16_t res[4 * LANES];
+    uint32_t rnd = 0x12345678;
+    uint32_t i;
+    for(i = 0; i < 4 * LANES; i++) {
+        rnd = rnd * 1103515245 + 12345;
+        fg[i] = (uint16_t)(rnd >> 16);
+        ref[i] = (uint16_t)rnd;
+        alpha[i] = (uint16_t)(i * 8 + (i & 7));
+    }
+    alpha[0] = LV_OPA_TRANSP;
+    alpha[1] = LV_OPA_COVER;
+
+    bool ok = true;
+    lv_memcpy(res, ref, sizeof(res));
+    ref_mix(ref, fg, 1, alpha, 1, 4 * LANES);
+    lv_gpu_esp32s3_pie_asm_mix(res, fg, 1, alpha, 1, 4);
+    ok = ok && memcmp(ref, res, sizeof(res)) == 0;
+
+    ref_mix(ref, fg, 0, alpha + LANES, 0, 4 * LANES);
+    lv_gpu_esp32s3_pie_asm_mix(res, fg, 0, alpha + LANES, 0, 4);
+    ok = ok && memcmp(ref, res, sizeof(res)) == 0;
+
+    lv_gpu_esp32s3_pie_asm_copy(res, fg, 4);
+    ok = ok && memcmp(fg, res, sizeof(res)) == 0;
+
+    set_lanes(fg, 0xA5C3);
+    ref_fill(ref, fg, 4 * LANES);
+    lv_gpu_esp32s3_pie_asm_fill(res, fg, 4);
+    ok = ok && memcmp(ref, res, sizeof(res)) == 0;
+
+    checked = ok;
+    return ok;
+#else
+    return true;
+#endif
+}
+
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+
+void lv_draw_esp32s3_pie_ctx_init(lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx)
+{
+    lv_draw_sw_init_ctx(drv, draw_ctx);
+
+    if(!lv_gpu_esp32s3_pie_check()) {
+        LV_LOG_WARN("the PIE kernels don't match their C reference, blending without them");
+        return;
+    }
+
+    lv_draw_esp32s3_pie_ctx_t * pie_draw_ctx = (lv_draw_sw_ctx_t *)draw_ctx;
+    pie_draw_ctx->blend = lv_draw_esp32s3_pie_blend;
+}
+
+void lv_draw_esp32s3_pie_ctx_deinit(lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx)
+{
+    lv_draw_sw_deinit_ctx(drv, draw_ctx);
+}
+
+LV_ATTRIBUTE_FAST_MEM void lv_draw_esp32s3_pie_blend(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc)
+{
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp->driver->set_px_cb || disp->driver->screen_transp || dsc->blend_mode != LV_BLEND_MODE_NORMAL) {
+        lv_draw_sw_blend_basic(draw_ctx, dsc);
+        return;
+    }
+
+    const lv_opa_t * mask;
+    if(dsc->mask_buf && dsc->mask_res == LV_DRAW_MASK_RES_TRANSP) return;
+    else if(dsc->mask_buf == NULL || dsc->mask_res == LV_DRAW_MASK_RES_FULL_COVER) mask = NULL;
+    else mask = dsc->mask_buf;
+
+    lv_area_t blend_area;
+    if(!_lv_area_intersect(&blend_area, dsc->blend_area, draw_ctx->clip_area)) return;
+
+    lv_coord_t dest_stride = lv_area_get_width(draw_ctx->buf_area);
+    uint16_t * dest_buf = (uint16_t *)draw_ctx->buf;
+    dest_buf += dest_stride * (blend_area.y1 - draw_ctx->buf_area->y1) + (blend_area.x1 - draw_ctx->buf_area->x1);
+
+    lv_coord_t mask_stride = 0;
+    if(mask) {
+        mask_stride = lv_area_get_width(dsc->mask_area);
+        mask += mask_stride * (blend_area.y1 - dsc->mask_area->y1) + (blend_area.x1 - dsc->mask_area->x1);
+    }
+
+    lv_coord_t w = lv_area_get_width(&blend_area);
+    lv_coord_t h = lv_area_get_height(&blend_area);
+    if(dsc->src_buf == NULL) {
+        lv_gpu_esp32s3_pie_fill(dest_buf, dest_stride, w, h, dsc->color.full, dsc->opa, mask, mask_stride);
+    }
+    else {
+        lv_coord_t src_stride = lv_area_get_width(dsc->blend_area);
+        const uint16_t * src_buf = (const uint16_t *)dsc->src_buf;
+        src_buf += src_stride * (blend_area.y1 - dsc->blend_area->y1) + (blend_area.x1 - dsc->blend_area->x1);
+        lv_gpu_esp32s3_pie_map(dest_buf, dest_stride, src_buf, src_stride, w, h, dsc->opa, mask, mask_stride);
+    }
+}
+
+#endif /*LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP*/
+
+#endif /*LV_USE_GPU_ESP32S3_PIE*/
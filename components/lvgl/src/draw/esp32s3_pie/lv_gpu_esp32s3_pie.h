@@ -0,0 +1,106 @@
+/**
+ * @file lv_gpu_esp32s3_pie.h
+ *
+ */
+
+#ifndef LV_GPU_ESP32S3_PIE_H
+#define LV_GPU_ESP32S3_PIE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../misc/lv_color.h"
+#include "../../hal/lv_hal_disp.h"
+#include "../sw/lv_draw_sw.h"
+
+#if LV_USE_GPU_ESP32S3_PIE
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef lv_draw_sw_ctx_t lv_draw_esp32s3_pie_ctx_t;
+
+struct _lv_disp_drv_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Normal blending of a color into RGB565 pixels stored with swapped bytes (like `LV_COLOR_16_SWAP`)
+ * with the PIE vector kernels. Gives the same pixels as `lv_draw_sw_blend_basic()` with 16 bit swapped colors.
+ * @param dest          pointer to the first pixel to draw
+ * @param dest_stride   pixels from a row of `dest` to the next
+ * @param w             width of the drawn area
+ * @param h             height of the drawn area
+ * @param color         the color, stored like `dest`
+ * @param opa           the overall opacity
+ * @param mask          NULL or the opacity of the first pixel
+ * @param mask_stride   bytes from a row of `mask` to the next
+ */
+void lv_gpu_esp32s3_pie_fill(uint16_t * dest, lv_coord_t dest_stride, lv_coord_t w, lv_coord_t h, uint16_t color,
+                             lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride);
+
+/**
+ * Normal blending of an image into RGB565 pixels stored with swapped bytes (like `LV_COLOR_16_SWAP`)
+ * with the PIE vector kernels. Gives the same pixels as `lv_draw_sw_blend_basic()` with 16 bit swapped colors.
+ * @param dest          pointer to the first pixel to draw
+ * @param dest_stride   pixels from a row of `dest` to the next
+ * @param src           pointer to the first pixel of the image, stored like `dest`
+ * @param src_stride    pixels from a row of `src` to the next
+ * @param w             width of the drawn area
+ * @param h             height of the drawn area
+ * @param opa           the overall opacity
+ * @param mask          NULL or the opacity of the first pixel
+ * @param mask_stride   bytes from a row of `mask` to the next
+ */
+void lv_gpu_esp32s3_pie_map(uint16_t * dest, lv_coord_t dest_stride, const uint16_t * src, lv_coord_t src_stride,
+                            lv_coord_t w, lv_coord_t h, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride);
+
+/**
+ * Run the vector kernels and their C reference on the same pixels once and compare the results.
+ * Always true where the C reference is used in place of the kernels (not on ESP32-S3).
+ * @return true if the kernels give the same pixels as the reference
+ */
+bool lv_gpu_esp32s3_pie_check(void);
+
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+
+/**
+ * Initialize a software draw context whose blending is done with the PIE kernels.
+ * If `lv_gpu_esp32s3_pie_check()` fails the blend function of the software renderer is kept.
+ * @param drv           pointer to a display driver
+ * @param draw_ctx      pointer to a draw context with `sizeof(lv_draw_esp32s3_pie_ctx_t)` bytes
+ */
+void lv_draw_esp32s3_pie_ctx_init(struct _lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx);
+
+void lv_draw_esp32s3_pie_ctx_deinit(struct _lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx);
+
+/**
+ * Blend with the PIE kernels. Other blend modes, `set_px_cb` and transparent screens go to `lv_draw_sw_blend_basic()`.
+ * @param draw_ctx      pointer to a draw context
+ * @param dsc           pointer to an initialized blend descriptor
+ */
+void lv_draw_esp32s3_pie_blend(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
+
+#endif /*LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif  /*LV_USE_GPU_ESP32S3_PIE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_GPU_ESP32S3_PIE_H*/
@@ -13,6 +13,7 @@
 #include "../core/lv_refr.h"
 #include "../misc/lv_mem.h"
 #include "../misc/lv_math.h"
+#include "../misc/lv_parallel.h"
 
 /*********************
  *      DEFINES
@@ -27,6 +28,11 @@
  **********************/
 LV_ATTRIBUTE_FAST_MEM static lv_res_t decode_and_draw(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * draw_dsc,
                                                       const lv_area_t * coords, const void * src);
+LV_ATTRIBUTE_FAST_MEM static void draw_decoded(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * draw_dsc,
+                                               const lv_area_t * coords, const uint8_t * img_data, lv_img_cf_t cf);
+#if LV_USE_PARALLEL_RENDER
+    static bool is_raw_variable(const void * src);
+#endif
 
 static void show_error(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const char * msg);
 static void draw_cleanup(_lv_img_cache_entry_t * cache);
@@ -73,8 +79,18 @@ void lv_draw_img(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const
     if(draw_ctx->draw_img) {
         res = draw_ctx->draw_img(draw_ctx, dsc, coords, src);
     }
+#if LV_USE_PARALLEL_RENDER
+    else if(_lv_parallel_is_active() && is_raw_variable(src)) {
+        /*These images need no decoder and image cache so both render threads can draw them at the same time*/
+        const lv_img_dsc_t * img = src;
+        draw_decoded(draw_ctx, dsc, coords, img->data, img->header.cf);
+        res = LV_RES_OK;
+    }
+#endif
     else {
+        _lv_parallel_lock();
         res = decode_and_draw(draw_ctx, dsc, coords, src);
+        _lv_parallel_unlock();
     }
 
     if(res == LV_RES_INV) {
@@ -259,33 +275,7 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t decode_and_draw(lv_draw_ctx_t * draw_ctx,
     /*The decoder could open the image and gave the entire uncompressed image.
      *Just draw it!*/
     else if(cdsc->dec_dsc.img_data) {
-        lv_area_t map_area_rot;
-        lv_area_copy(&map_area_rot, coords);
-        if(draw_dsc->angle || draw_dsc->zoom != LV_IMG_ZOOM_NONE) {
-            int32_t w = lv_area_get_width(coords);
-            int32_t h = lv_area_get_height(coords);
-
-            _lv_img_buf_get_transformed_area(&map_area_rot, w, h, draw_dsc->angle, draw_dsc->zoom, &draw_dsc->pivot);
-
-            map_area_rot.x1 += coords->x1;
-            map_area_rot.y1 += coords->y1;
-            map_area_rot.x2 += coords->x1;
-            map_area_rot.y2 += coords->y1;
-        }
-
-        lv_area_t clip_com; /*Common area of mask and coords*/
-        bool union_ok;
-        union_ok = _lv_area_intersect(&clip_com, draw_ctx->clip_area, &map_area_rot);
-        /*Out of mask. There is nothing to draw so the image is drawn successfully.*/
-        if(union_ok == false) {
-            draw_cleanup(cdsc);
-            return LV_RES_OK;
-        }
-
-        const lv_area_t * clip_area_ori = draw_ctx->clip_area;
-        draw_ctx->clip_area = &clip_com;
-        lv_draw_img_decoded(draw_ctx, draw_dsc, coords, cdsc->dec_dsc.img_data, cf);
-        draw_ctx->clip_area = clip_area_ori;
+        draw_decoded(draw_ctx, draw_dsc, coords, cdsc->dec_dsc.img_data, cf);
     }
     /*The whole uncompressed image is not available. Try to read it line-by-line*/
     else {
@@ -340,6 +330,50 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t decode_and_draw(lv_draw_ctx_t * draw_ctx,
     return LV_RES_OK;
 }
 
+LV_ATTRIBUTE_FAST_MEM static void draw_decoded(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * draw_dsc,
+                                               const lv_area_t * coords, const uint8_t * img_data, lv_img_cf_t cf)
+{
+    lv_area_t map_area_rot;
+    lv_area_copy(&map_area_rot, coords);
+    if(draw_dsc->angle || draw_dsc->zoom != LV_IMG_ZOOM_NONE) {
+        int32_t w = lv_area_get_width(coords);
+        int32_t h = lv_area_get_height(coords);
+
+        _lv_img_buf_get_transformed_area(&map_area_rot, w, h, draw_dsc->angle, draw_dsc->zoom, &draw_dsc->pivot);
+
+        map_area_rot.x1 += coords->x1;
+        map_area_rot.y1 += coords->y1;
+        map_area_rot.x2 += coords->x1;
+        map_area_rot.y2 += coords->y1;
+    }
+
+    lv_area_t clip_com; /*Common area of mask and coords*/
+    bool union_ok;
+    union_ok = _lv_area_intersect(&clip_com, draw_ctx->clip_area, &map_area_rot);
+    /*Out of mask. There is nothing to draw so the image is drawn successfully.*/
+    if(union_ok == false) return;
+
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    draw_ctx->clip_area = &clip_com;
+    lv_draw_img_decoded(draw_ctx, draw_dsc, coords, img_data, cf);
+    draw_ctx->clip_area = clip_area_ori;
+}
+
+#if LV_USE_PARALLEL_RENDER
+/**
+ * Tell whether an image is a variable whose pixels can be drawn directly (without palette or decoding)
+ */
+static bool is_raw_variable(const void * src)
+{
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) return false;
+
+    const lv_img_dsc_t * img = src;
+    if(img->data == NULL) return false;
+
+    lv_img_cf_t cf = img->header.cf;
+    return cf == LV_IMG_CF_TRUE_COLOR || cf == LV_IMG_CF_TRUE_COLOR_ALPHA || cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED;
+}
+#endif
 
 static void show_error(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const char * msg)
 {
@@ -356,9 +390,5 @@ static void show_error(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const
 static void draw_cleanup(_lv_img_cache_entry_t * cache)
 {
     /*Automatically close images with no caching*/
-#if LV_IMG_CACHE_DEF_SIZE == 0
-    lv_img_decoder_close(&cache->dec_dsc);
-#else
-    LV_UNUSED(cache);
-#endif
+    _lv_img_cache_cleanup(cache);
 }
@@ -13,6 +13,7 @@
 #include "../core/lv_refr.h"
 #include "../misc/lv_bidi.h"
 #include "../misc/lv_assert.h"
+#include "../misc/lv_parallel.h"
 
 /*********************
  *      DEFINES
@@ -88,6 +89,9 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
         return;
     }
 
+    /*The hint is written while drawing so it's not shared by the render threads*/
+    if(_lv_parallel_is_active()) hint = NULL;
+
     lv_draw_label_dsc_t dsc_mod = *dsc;
 
     const lv_font_t * font = dsc->font;
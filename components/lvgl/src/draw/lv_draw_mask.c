@@ -12,6 +12,7 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_assert.h"
 #include "../misc/lv_gc.h"
+#include "../misc/lv_parallel.h"
 
 /*********************
  *      DEFINES
@@ -63,10 +64,19 @@ LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_USE_PARALLEL_RENDER
+    static _lv_draw_mask_saved_arr_t worker_mask_list;
+    static LV_PARALLEL_THREAD_LOCAL _lv_draw_mask_saved_t * thread_mask_list; /*NULL on the main thread*/
+#endif
 
 /**********************
  *      MACROS
  **********************/
+#if LV_USE_PARALLEL_RENDER
+    #define MASK_LIST   (thread_mask_list ? thread_mask_list : LV_GC_ROOT(_lv_draw_mask_list))
+#else
+    #define MASK_LIST   LV_GC_ROOT(_lv_draw_mask_list)
+#endif
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -83,7 +93,7 @@ int16_t lv_draw_mask_add(void * param, void * custom_id)
     /*Look for a free entry*/
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_draw_mask_list[i]).param == NULL) break;
+        if(MASK_LIST[i].param == NULL) break;
     }
 
     if(i >= _LV_MASK_MAX_NUM) {
@@ -91,8 +101,8 @@ int16_t lv_draw_mask_add(void * param, void * custom_id)
         return LV_MASK_ID_INV;
     }
 
-    LV_GC_ROOT(_lv_draw_mask_list[i]).param = param;
-    LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id = custom_id;
+    MASK_LIST[i].param = param;
+    MASK_LIST[i].custom_id = custom_id;
 
     return i;
 }
@@ -114,7 +124,7 @@ LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf,
     bool changed = false;
     _lv_draw_mask_common_dsc_t * dsc;
 
-    _lv_draw_mask_saved_t * m = LV_GC_ROOT(_lv_draw_mask_list);
+    _lv_draw_mask_saved_t * m = MASK_LIST;
 
     while(m->param) {
         dsc = m->param;
@@ -151,7 +161,7 @@ LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply_ids(lv_opa_t * mask_
     for(int i = 0; i < ids_count; i++) {
         int16_t id = ids[i];
         if(id == LV_MASK_ID_INV) continue;
-        dsc = LV_GC_ROOT(_lv_draw_mask_list[id]).param;
+        dsc = MASK_LIST[id].param;
         if(!dsc) continue;
         lv_draw_mask_res_t res = LV_DRAW_MASK_RES_FULL_COVER;
         res = dsc->cb(mask_buf, abs_x, abs_y, len, dsc);
@@ -173,9 +183,9 @@ void * lv_draw_mask_remove_id(int16_t id)
     _lv_draw_mask_common_dsc_t * p = NULL;
 
     if(id != LV_MASK_ID_INV) {
-        p = LV_GC_ROOT(_lv_draw_mask_list[id]).param;
-        LV_GC_ROOT(_lv_draw_mask_list[id]).param = NULL;
-        LV_GC_ROOT(_lv_draw_mask_list[id]).custom_id = NULL;
+        p = MASK_LIST[id].param;
+        MASK_LIST[id].param = NULL;
+        MASK_LIST[id].custom_id = NULL;
     }
 
     return p;
@@ -192,8 +202,8 @@ void * lv_draw_mask_remove_custom(void * custom_id)
     _lv_draw_mask_common_dsc_t * p = NULL;
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id == custom_id) {
-            p = LV_GC_ROOT(_lv_draw_mask_list[i]).param;
+        if(MASK_LIST[i].custom_id == custom_id) {
+            p = MASK_LIST[i].param;
             lv_draw_mask_remove_id(i);
         }
     }
@@ -218,7 +228,9 @@ void lv_draw_mask_free_param(void * p)
                 lv_mem_free(radius_p->circle);
             }
             else {
+                _lv_parallel_lock();
                 radius_p->circle->used_cnt--;
+                _lv_parallel_unlock();
             }
         }
     }
@@ -239,6 +251,13 @@ void _lv_draw_mask_cleanup(void)
     }
 }
 
+#if LV_USE_PARALLEL_RENDER
+void _lv_draw_mask_use_thread_list(bool en)
+{
+    thread_mask_list = en ? worker_mask_list : NULL;
+}
+#endif
+
 /**
  * Count the currently added masks
  * @return number of active masks
@@ -248,21 +267,21 @@ LV_ATTRIBUTE_FAST_MEM uint8_t lv_draw_mask_get_cnt(void)
     uint8_t cnt = 0;
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_draw_mask_list[i]).param) cnt++;
+        if(MASK_LIST[i].param) cnt++;
     }
     return cnt;
 }
 
 bool lv_draw_mask_is_any(const lv_area_t * a)
 {
-    if(a == NULL) return LV_GC_ROOT(_lv_draw_mask_list[0]).param ? true : false;
+    if(a == NULL) return MASK_LIST[0].param ? true : false;
 
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        _lv_draw_mask_common_dsc_t * comm_param = LV_GC_ROOT(_lv_draw_mask_list[i]).param;
+        _lv_draw_mask_common_dsc_t * comm_param = MASK_LIST[i].param;
         if(comm_param == NULL) continue;
         if(comm_param->type == LV_DRAW_MASK_TYPE_RADIUS) {
-            lv_draw_mask_radius_param_t * radius_param = LV_GC_ROOT(_lv_draw_mask_list[i]).param;
+            lv_draw_mask_radius_param_t * radius_param = MASK_LIST[i].param;
             if(radius_param->cfg.outer) {
                 if(!_lv_area_is_out(a, &radius_param->cfg.rect, radius_param->cfg.radius)) return true;
             }
@@ -492,12 +511,15 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
 
     uint32_t i;
 
+    _lv_parallel_lock();
+
     /*Try to reuse a circle cache entry*/
     for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
         if(LV_GC_ROOT(_lv_circle_cache[i]).radius == radius) {
             LV_GC_ROOT(_lv_circle_cache[i]).used_cnt++;
             CIRCLE_CACHE_AGING(LV_GC_ROOT(_lv_circle_cache[i]).life, radius);
             param->circle = &LV_GC_ROOT(_lv_circle_cache[i]);
+            _lv_parallel_unlock();
             return;
         }
     }
@@ -526,6 +548,8 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
     param->circle = entry;
 
     circ_calc_aa4(param->circle, radius);
+
+    _lv_parallel_unlock();
 }
 
 /**
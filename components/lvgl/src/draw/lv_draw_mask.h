@@ -293,6 +293,14 @@ void lv_draw_mask_free_param(void * p);
  */
 void _lv_draw_mask_cleanup(void);
 
+#if LV_USE_PARALLEL_RENDER
+/**
+ * Make the calling thread use the mask list of the second render thread instead of the main one.
+ * @param en    true: use the list of the second thread; false: use the main list
+ */
+void _lv_draw_mask_use_thread_list(bool en);
+#endif
+
 //! @cond Doxygen_Suppress
 
 /**
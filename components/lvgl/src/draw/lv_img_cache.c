@@ -26,6 +26,10 @@
  * "die" from very high values*/
 #define LV_IMG_CACHE_LIFE_LIMIT 1000
 
+/*With LV_IMG_CACHE_BUDGET don't let the use count of an entry grow beyond this
+ *so that it can age out in a few evictions*/
+#define LV_IMG_CACHE_USE_LIMIT 16
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -33,14 +37,27 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-#if LV_IMG_CACHE_DEF_SIZE
+#if LV_IMG_CACHE_DEF_SIZE || LV_IMG_CACHE_BUDGET
     static bool lv_img_cache_match(const void * src1, const void * src2);
 #endif
+#if LV_IMG_CACHE_BUDGET
+    static uint32_t decoded_px_size(lv_img_cf_t cf);
+    static uint32_t entry_size(const _lv_img_cache_entry_t * entry);
+    static void decode_entry(_lv_img_cache_entry_t * entry);
+    static void close_entry(_lv_img_cache_entry_t * entry);
+    static void evict_entry(void);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
-#if LV_IMG_CACHE_DEF_SIZE
+#if LV_IMG_CACHE_BUDGET
+    static uint32_t budget = LV_IMG_CACHE_BUDGET;
+    static uint32_t use_cnt;
+    static void * (*alloc_cb)(size_t size) = lv_mem_alloc;
+    static void (*free_cb)(void * p) = lv_mem_free;
+    static lv_img_cache_stats_t stats;
+#elif LV_IMG_CACHE_DEF_SIZE
     static uint16_t entry_cnt;
 #endif
 
@@ -52,6 +69,157 @@
  *   GLOBAL FUNCTIONS
  **********************/
 
+#if LV_IMG_CACHE_BUDGET
+
+void _lv_img_cache_init(void)
+{
+    _lv_ll_init(&LV_GC_ROOT(_lv_img_cache_ll), sizeof(_lv_img_cache_entry_t));
+}
+
+/**
+ * Open an image using the image decoder interface and cache it.
+ * If the decoder gives the image line by line, it's decoded into a buffer once and the buffer is drawn later.
+ * Images which don't fit in the budget are opened only for one draw.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @param color color The color of the image with `LV_IMG_CF_ALPHA_...`
+ * @return pointer to the cache entry or NULL if can open the image
+ */
+_lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, int32_t frame_id)
+{
+    use_cnt++;
+
+    _lv_img_cache_entry_t * entry;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_img_cache_ll), entry) {
+        if(color.full == entry->dec_dsc.color.full &&
+           frame_id == entry->dec_dsc.frame_id &&
+           lv_img_cache_match(src, entry->dec_dsc.src)) {
+            if(entry->life < LV_IMG_CACHE_USE_LIMIT) entry->life++;
+            entry->last_use = use_cnt;
+            stats.hit_cnt++;
+            LV_LOG_TRACE("image source found in the cache");
+            return entry;
+        }
+    }
+    stats.miss_cnt++;
+
+    /*Open into the single entry first and move it into the cache if it fits*/
+    _lv_img_cache_entry_t * single = &LV_GC_ROOT(_lv_img_cache_single);
+    lv_memset_00(single, sizeof(_lv_img_cache_entry_t));
+    single->not_cached = 1;
+    uint32_t t_start  = lv_tick_get();
+    lv_res_t open_res = lv_img_decoder_open(&single->dec_dsc, src, color, frame_id);
+    if(open_res == LV_RES_INV) {
+        LV_LOG_WARN("Image draw cannot open the image resource");
+        lv_memset_00(single, sizeof(_lv_img_cache_entry_t));
+        return NULL;
+    }
+
+    /*If `time_to_open` was not set in the open function set it here*/
+    if(single->dec_dsc.time_to_open == 0) {
+        single->dec_dsc.time_to_open = lv_tick_elaps(t_start);
+    }
+    if(single->dec_dsc.time_to_open == 0) single->dec_dsc.time_to_open = 1;
+
+    uint32_t size = entry_size(single);
+    if(size > budget || single->dec_dsc.error_msg != NULL) {
+        stats.skip_cnt++;
+        return single;
+    }
+
+    while(stats.used + size > budget && stats.entry_cnt) evict_entry();
+
+    entry = _lv_ll_ins_head(&LV_GC_ROOT(_lv_img_cache_ll));
+    LV_ASSERT_MALLOC(entry);
+    if(entry == NULL) {
+        stats.skip_cnt++;
+        return single;
+    }
+
+    *entry = *single;
+    lv_memset_00(single, sizeof(_lv_img_cache_entry_t));
+    entry->not_cached = 0;
+    entry->life = 1;
+    entry->last_use = use_cnt;
+    entry->size = size;
+    decode_entry(entry);
+    stats.used += entry->size;
+    stats.entry_cnt++;
+    LV_LOG_INFO("image draw: cache miss, cached %d bytes", (int)entry->size);
+
+    return entry;
+}
+
+/**
+ * Release an entry after drawing. Entries which weren't cached are closed.
+ * @param entry an entry returned by `_lv_img_cache_open`
+ */
+void _lv_img_cache_cleanup(_lv_img_cache_entry_t * entry)
+{
+    if(entry->not_cached) lv_img_decoder_close(&entry->dec_dsc);
+}
+
+/**
+ * With `LV_IMG_CACHE_BUDGET` the cache is sized in bytes, use `lv_img_cache_set_budget`
+ */
+void lv_img_cache_set_size(uint16_t new_entry_cnt)
+{
+    LV_UNUSED(new_entry_cnt);
+    LV_LOG_WARN("The image cache is sized in bytes by LV_IMG_CACHE_BUDGET, use lv_img_cache_set_budget()");
+}
+
+/**
+ * Invalidate an image source in the cache.
+ * Useful if the image source is updated therefore it needs to be cached again.
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ */
+void lv_img_cache_invalidate_src(const void * src)
+{
+    _lv_img_cache_entry_t * entry = _lv_ll_get_head(&LV_GC_ROOT(_lv_img_cache_ll));
+    while(entry) {
+        _lv_img_cache_entry_t * next = _lv_ll_get_next(&LV_GC_ROOT(_lv_img_cache_ll), entry);
+        if(src == NULL || lv_img_cache_match(src, entry->dec_dsc.src)) {
+            close_entry(entry);
+        }
+        entry = next;
+    }
+}
+
+void lv_img_cache_set_budget(uint32_t max_bytes)
+{
+    lv_img_cache_invalidate_src(NULL);
+    budget = max_bytes;
+}
+
+void lv_img_cache_set_mem_cb(void * (*new_alloc_cb)(size_t size), void (*new_free_cb)(void * p))
+{
+    lv_img_cache_invalidate_src(NULL);
+    if(new_alloc_cb == NULL || new_free_cb == NULL) {
+        alloc_cb = lv_mem_alloc;
+        free_cb = lv_mem_free;
+    }
+    else {
+        alloc_cb = new_alloc_cb;
+        free_cb = new_free_cb;
+    }
+}
+
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats_out)
+{
+    *stats_out = stats;
+    stats_out->budget = budget;
+}
+
+void lv_img_cache_reset_stats(void)
+{
+    stats.hit_cnt = 0;
+    stats.miss_cnt = 0;
+    stats.evict_cnt = 0;
+    stats.skip_cnt = 0;
+    stats.decode_cnt = 0;
+}
+
+#else
+
 /**
  * Open an image using the image decoder interface and cache it.
  * The image will be left open meaning if the image decoder open callback allocated memory then it will remain.
@@ -196,11 +364,26 @@ void lv_img_cache_invalidate_src(const void * src)
 #endif
 }
 
+/**
+ * Release an entry after drawing. Without caching the image is closed.
+ * @param entry an entry returned by `_lv_img_cache_open`
+ */
+void _lv_img_cache_cleanup(_lv_img_cache_entry_t * entry)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    lv_img_decoder_close(&entry->dec_dsc);
+#else
+    LV_UNUSED(entry);
+#endif
+}
+
+#endif /*LV_IMG_CACHE_BUDGET*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
-#if LV_IMG_CACHE_DEF_SIZE
+#if LV_IMG_CACHE_DEF_SIZE || LV_IMG_CACHE_BUDGET
 static bool lv_img_cache_match(const void * src1, const void * src2)
 {
     lv_img_src_t src_type = lv_img_src_get_type(src1);
@@ -213,3 +396,126 @@ static bool lv_img_cache_match(const void * src1, const void * src2)
     return strcmp(src1, src2) == 0;
 }
 #endif
+
+#if LV_IMG_CACHE_BUDGET
+/**
+ * The bytes per pixel `decode_and_draw` draws an image of `cf` read line by line with, 0 if it's not drawn
+ * as a plain pixel array
+ */
+static uint32_t decoded_px_size(lv_img_cf_t cf)
+{
+    switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+            return LV_COLOR_SIZE / 8;
+        case LV_IMG_CF_TRUE_COLOR_ALPHA:
+        case LV_IMG_CF_INDEXED_1BIT:
+        case LV_IMG_CF_INDEXED_2BIT:
+        case LV_IMG_CF_INDEXED_4BIT:
+        case LV_IMG_CF_INDEXED_8BIT:
+        case LV_IMG_CF_ALPHA_1BIT:
+        case LV_IMG_CF_ALPHA_2BIT:
+        case LV_IMG_CF_ALPHA_4BIT:
+            return LV_IMG_PX_SIZE_ALPHA_BYTE;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * The bytes an opened image holds: the decoded pixels if the cache decodes them or
+ * the decoder gave them in a buffer of its own
+ */
+static uint32_t entry_size(const _lv_img_cache_entry_t * entry)
+{
+    const lv_img_decoder_dsc_t * dsc = &entry->dec_dsc;
+    uint32_t px_cnt = (uint32_t)dsc->header.w * dsc->header.h;
+    uint32_t size = sizeof(_lv_img_cache_entry_t);
+
+    if(dsc->img_data == NULL) {
+        size += px_cnt * decoded_px_size(dsc->header.cf);
+    }
+    else if(dsc->src_type != LV_IMG_SRC_VARIABLE || dsc->img_data != ((const lv_img_dsc_t *)dsc->src)->data) {
+        size += (px_cnt * lv_img_cf_get_px_size(dsc->header.cf)) >> 3;
+    }
+    return size;
+}
+
+/**
+ * Read the lines of an image given line by line into a buffer and close the decoder
+ * as it's not needed to draw from the buffer. The image stays line by line if there is no memory.
+ */
+static void decode_entry(_lv_img_cache_entry_t * entry)
+{
+    lv_img_decoder_dsc_t * dsc = &entry->dec_dsc;
+    uint32_t px_size = decoded_px_size(dsc->header.cf);
+    if(dsc->img_data || px_size == 0) return;
+
+    uint32_t line_size = dsc->header.w * px_size;
+    uint32_t decoded_size = line_size * dsc->header.h;
+    uint8_t * buf = alloc_cb(decoded_size);
+    if(buf == NULL) {
+        LV_LOG_WARN("couldn't allocate %d bytes for a decoded image", (int)decoded_size);
+        entry->size -= decoded_size;
+        return;
+    }
+
+    lv_coord_t y;
+    for(y = 0; y < dsc->header.h; y++) {
+        if(lv_img_decoder_read_line(dsc, 0, y, dsc->header.w, buf + y * line_size) != LV_RES_OK) {
+            LV_LOG_WARN("couldn't decode the image, it's read line by line");
+            free_cb(buf);
+            entry->size -= decoded_size;
+            return;
+        }
+    }
+
+    /*Free the palette, file etc. of the decoder but keep the source to match it*/
+    if(dsc->decoder->close_cb) dsc->decoder->close_cb(dsc->decoder, dsc);
+    entry->decoded = buf;
+    dsc->img_data = buf;
+    stats.decode_cnt++;
+}
+
+static void close_entry(_lv_img_cache_entry_t * entry)
+{
+    if(entry->decoded) {
+        free_cb(entry->decoded);
+        /*The decoder was closed after decoding, only the copy of the path is left*/
+        if(entry->dec_dsc.src_type == LV_IMG_SRC_FILE) lv_mem_free((void *)entry->dec_dsc.src);
+    }
+    else {
+        lv_img_decoder_close(&entry->dec_dsc);
+    }
+
+    stats.used -= entry->size;
+    stats.entry_cnt--;
+    _lv_ll_remove(&LV_GC_ROOT(_lv_img_cache_ll), entry);
+    lv_mem_free(entry);
+}
+
+/**
+ * Drop an entry to make room. Frequently used images are kept over recently used ones:
+ * the victim is the entry used the fewest times and of those the least recently used one.
+ * The use counts are halved on every eviction so an image used a lot long ago can go too.
+ */
+static void evict_entry(void)
+{
+    _lv_img_cache_entry_t * victim = NULL;
+    _lv_img_cache_entry_t * entry;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_img_cache_ll), entry) {
+        if(victim == NULL || entry->life < victim->life ||
+           (entry->life == victim->life && (int32_t)(entry->last_use - victim->last_use) < 0)) {
+            victim = entry;
+        }
+    }
+    if(victim == NULL) return;
+
+    close_entry(victim);
+    stats.evict_cnt++;
+
+    _LV_LL_READ(&LV_GC_ROOT(_lv_img_cache_ll), entry) {
+        entry->life = (entry->life + 1) / 2;
+    }
+}
+#endif
@@ -33,10 +33,31 @@ typedef struct {
 
     /** Count the cache entries's life. Add `time_to_open` to `life` when the entry is used.
      * Decrement all lifes by one every in every ::lv_img_cache_open.
-     * If life == 0 the entry can be reused*/
+     * If life == 0 the entry can be reused.
+     * With `LV_IMG_CACHE_BUDGET` the number of uses, halved on every eviction*/
     int32_t life;
+
+#if LV_IMG_CACHE_BUDGET
+    uint32_t last_use;      /**< When the entry was used last time, in opened images*/
+    uint32_t size;          /**< Bytes of the entry and its decoded pixels*/
+    uint8_t * decoded;      /**< Pixels of a line by line image decoded by the cache, or NULL*/
+    uint8_t not_cached : 1; /**< Opened only for one draw because it doesn't fit in the budget*/
+#endif
 } _lv_img_cache_entry_t;
 
+#if LV_IMG_CACHE_BUDGET
+typedef struct {
+    uint32_t hit_cnt;       /**< Images found in the cache*/
+    uint32_t miss_cnt;      /**< Images which had to be opened*/
+    uint32_t evict_cnt;     /**< Entries dropped to make room for a new one*/
+    uint32_t skip_cnt;      /**< Opened images which were too large to cache, opened again on every draw*/
+    uint32_t decode_cnt;    /**< Line by line images decoded into a buffer by the cache*/
+    uint32_t entry_cnt;     /**< Entries in the cache now*/
+    uint32_t used;          /**< Bytes used by the entries now*/
+    uint32_t budget;        /**< Max. bytes the entries can use*/
+} lv_img_cache_stats_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -52,6 +73,12 @@ typedef struct {
  */
 _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, int32_t frame_id);
 
+/**
+ * Release an entry after drawing. Images which aren't cached are closed.
+ * @param entry an entry returned by `_lv_img_cache_open`
+ */
+void _lv_img_cache_cleanup(_lv_img_cache_entry_t * entry);
+
 /**
  * Set the number of images to be cached.
  * More cached images mean more opened image at same time which might mean more memory usage.
@@ -67,6 +94,43 @@ void lv_img_cache_set_size(uint16_t new_slot_num);
  */
 void lv_img_cache_invalidate_src(const void * src);
 
+#if LV_IMG_CACHE_BUDGET
+
+/**
+ * Initialize the image cache, called by `lv_init()`
+ */
+void _lv_img_cache_init(void);
+
+/**
+ * Set the bytes the cached images can use. Images given line by line by their decoder are decoded
+ * into a buffer when cached, they count with their decoded size.
+ * The least used images are closed if a new one doesn't fit. The default is `LV_IMG_CACHE_BUDGET`.
+ * The cache is cleared.
+ * @param max_bytes the budget in bytes, 0 disables caching
+ */
+void lv_img_cache_set_budget(uint32_t max_bytes);
+
+/**
+ * Set where the decoded pixels of the cached images are allocated, e.g. in an external RAM.
+ * By default `lv_mem_alloc` and `lv_mem_free` are used. The cache is cleared.
+ * @param alloc_cb  allocate memory, NULL to restore the default
+ * @param free_cb   free memory allocated by `alloc_cb`
+ */
+void lv_img_cache_set_mem_cb(void * (*alloc_cb)(size_t size), void (*free_cb)(void * p));
+
+/**
+ * Get the statistics of the image cache
+ * @param stats store the statistics here
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats);
+
+/**
+ * Reset the hit, miss, evict, skip and decode counters
+ */
+void lv_img_cache_reset_stats(void);
+
+#endif /*LV_IMG_CACHE_BUDGET*/
+
 /**********************
  *      MACROS
  **********************/
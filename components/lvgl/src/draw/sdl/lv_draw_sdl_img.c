@@ -205,9 +205,7 @@ bool lv_draw_sdl_img_load_texture(lv_draw_sdl_ctx_t * ctx, lv_draw_sdl_cache_key
         else {
             *texture = upload_img_texture(ctx->renderer, dsc);
         }
-#if LV_IMG_CACHE_DEF_SIZE == 0
-        lv_img_decoder_close(dsc);
-#endif
+        _lv_img_cache_cleanup(cdsc);
     }
     if(texture && cdsc) {
         *header = SDL_malloc(sizeof(lv_draw_sdl_img_header_t));
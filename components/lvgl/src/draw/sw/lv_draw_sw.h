@@ -14,6 +14,8 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include "lv_draw_sw_blend.h"
+#include "lv_draw_sw_shadow_cache.h"
+#include "lv_draw_sw_layer_pool.h"
 #include "../lv_draw.h"
 #include "../../misc/lv_area.h"
 #include "../../misc/lv_color.h"
@@ -29,6 +31,15 @@ extern "C" {
 
 struct _lv_disp_drv_t;
 
+#if LV_DRAW_COMPLEX && LV_ARC_MASK_CACHE_SIZE > 0
+typedef struct {
+    uint32_t hit_cnt;       /**< Arcs drawn from a cached ring*/
+    uint32_t miss_cnt;      /**< Rings which had to be calculated*/
+    uint32_t entry_cnt;     /**< Rings in the cache now*/
+    uint32_t size;          /**< Bytes used by the cached rings*/
+} lv_draw_sw_arc_cache_stats_t;
+#endif
+
 typedef struct {
     lv_draw_ctx_t base_draw;
 
@@ -55,6 +66,39 @@ void lv_draw_sw_wait_for_finish(lv_draw_ctx_t * draw_ctx);
 void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center, uint16_t radius,
                     uint16_t start_angle, uint16_t end_angle);
 
+#if LV_DRAW_COMPLEX && LV_ARC_MASK_CACHE_SIZE > 0
+/**
+ * Set the number of rings whose coverage is cached to draw arcs without masks.
+ * The cache is cleared.
+ * @param entry_cnt number of rings, at most `LV_ARC_MASK_CACHE_SIZE`, 0 to disable caching
+ */
+void lv_draw_sw_arc_cache_set_size(uint8_t entry_cnt);
+
+/**
+ * Set where the cached rings are allocated, e.g. in an external RAM.
+ * By default `lv_mem_alloc` and `lv_mem_free` are used. The cache is cleared.
+ * @param alloc_cb  allocate memory, NULL to restore the default
+ * @param free_cb   free memory allocated by `alloc_cb`
+ */
+void lv_draw_sw_arc_cache_set_mem_cb(void * (*alloc_cb)(size_t size), void (*free_cb)(void * p));
+
+/**
+ * Drop all the cached rings
+ */
+void lv_draw_sw_arc_cache_clear(void);
+
+/**
+ * Get the statistics of the arc cache
+ * @param stats store the statistics here
+ */
+void lv_draw_sw_arc_cache_get_stats(lv_draw_sw_arc_cache_stats_t * stats);
+
+/**
+ * Reset the hit and miss counters of the arc cache
+ */
+void lv_draw_sw_arc_cache_reset_stats(void);
+#endif
+
 void lv_draw_sw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
 
 void lv_draw_sw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
@@ -10,6 +10,7 @@
 #include "../../misc/lv_math.h"
 #include "../../misc/lv_log.h"
 #include "../../misc/lv_mem.h"
+#include "../../misc/lv_parallel.h"
 #include "../lv_draw.h"
 
 /*********************
@@ -32,8 +33,36 @@ typedef struct {
     lv_draw_rect_dsc_t * draw_dsc;
     const lv_area_t * draw_area;
     lv_draw_ctx_t * draw_ctx;
+#if LV_DRAW_COMPLEX && LV_ARC_MASK_CACHE_SIZE > 0
+    const struct _ring_cache_entry_t * ring;    /*Cached coverage of the ring or NULL to draw it with masks*/
+    lv_draw_mask_angle_param_t * mask_angle;
+#endif
 } quarter_draw_dsc_t;
 
+#if LV_DRAW_COMPLEX && LV_ARC_MASK_CACHE_SIZE > 0
+/*A row of the lower right quarter of a ring: `x1..x2` is covered, `full_x1..full_x2` is fully covered.
+ *The opacity of the anti-aliased pixels left and right to the fully covered part are stored from `ofs`*/
+typedef struct {
+    lv_coord_t x1;          /*-1: nothing is covered*/
+    lv_coord_t x2;
+    lv_coord_t full_x1;
+    lv_coord_t full_x2;     /*`full_x1 - 1` if no pixel is fully covered*/
+    uint32_t ofs;
+} ring_row_t;
+
+typedef struct _ring_cache_entry_t {
+    lv_coord_t radius;
+    lv_coord_t width;
+    bool rounded;
+    uint32_t life;          /*Value of `ring_cache_life` when the entry was used last time*/
+    uint32_t size;          /*Bytes of the allocation*/
+    lv_coord_t cap_size;    /*Width and height of `cap`*/
+    ring_row_t * rows;      /*`radius` rows from the center*/
+    lv_opa_t * opa;         /*Anti-aliased pixels of the rows*/
+    lv_opa_t * cap;         /*Coverage of a rounded end, NULL if not rounded*/
+} ring_cache_entry_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -43,11 +72,35 @@ typedef struct {
     static void draw_quarter_2(quarter_draw_dsc_t * q);
     static void draw_quarter_3(quarter_draw_dsc_t * q);
     static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness, lv_area_t * res_area);
+    static void draw_ring_part(quarter_draw_dsc_t * q);
 #endif /*LV_DRAW_COMPLEX*/
 
+#if LV_DRAW_COMPLEX && LV_ARC_MASK_CACHE_SIZE > 0
+    static const ring_cache_entry_t * ring_cache_get(lv_coord_t radius, lv_coord_t width, bool rounded);
+    static ring_cache_entry_t * ring_cache_build(lv_coord_t radius, lv_coord_t width, bool rounded);
+    static void ring_cache_free(uint32_t i);
+    static void draw_arc_cached(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, lv_draw_rect_dsc_t * cir_dsc,
+                                const ring_cache_entry_t * ring, const lv_point_t * center, lv_coord_t radius,
+                                lv_coord_t width, const lv_area_t * area_out, uint16_t start_angle, uint16_t end_angle);
+    static void draw_ring_spans(quarter_draw_dsc_t * q);
+    static void draw_ring_seg(quarter_draw_dsc_t * q, lv_draw_sw_blend_dsc_t * blend_dsc, const lv_area_t * clipped,
+                              lv_coord_t y, lv_coord_t x1, lv_coord_t x2, const lv_opa_t * quarter_buf);
+    static void draw_ring_cap(lv_draw_ctx_t * draw_ctx, const ring_cache_entry_t * ring, const lv_area_t * round_area,
+                              const lv_area_t * clip_area, const lv_area_t * area_out, lv_color_t color,
+                              lv_blend_mode_t blend_mode);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_DRAW_COMPLEX && LV_ARC_MASK_CACHE_SIZE > 0
+    static ring_cache_entry_t * ring_cache[LV_ARC_MASK_CACHE_SIZE];
+    static uint8_t ring_cache_max = LV_ARC_MASK_CACHE_SIZE;
+    static uint32_t ring_cache_life;
+    static void * (*ring_cache_alloc_cb)(size_t size) = lv_mem_alloc;
+    static void (*ring_cache_free_cb)(void * p) = lv_mem_free;
+    static lv_draw_sw_arc_cache_stats_t ring_cache_stats;
+#endif
 
 /**********************
  *      MACROS
@@ -87,6 +140,23 @@ void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, con
     area_out.x2 = center->x + radius - 1;  /*-1 because the center already belongs to the left/bottom part*/
     area_out.y2 = center->y + radius - 1;
 
+    bool full_ring = start_angle + 360 == end_angle || start_angle == end_angle + 360;
+
+#if LV_ARC_MASK_CACHE_SIZE > 0
+    /*Take the coverage of the ring from the cache and only cut it with the angles.
+     *It's the same what the masks below would draw if the arc is the only mask and it's opaque*/
+    const ring_cache_entry_t * ring = NULL;
+    if(ring_cache_max > 0 && !full_ring && dsc->img_src == NULL && dsc->opa >= LV_OPA_MAX &&
+       !lv_draw_mask_is_any(&area_out)) {
+        /*The other render thread could evict the entry, so keep the cache locked while it's used*/
+        _lv_parallel_lock();
+        ring = ring_cache_get(radius, width, dsc->rounded);
+        if(ring) draw_arc_cached(draw_ctx, dsc, &cir_dsc, ring, center, radius, width, &area_out, start_angle, end_angle);
+        _lv_parallel_unlock();
+    }
+    if(ring) return;
+#endif
+
     lv_area_t area_in;
     lv_area_copy(&area_in, &area_out);
     area_in.x1 += dsc->width;
@@ -109,7 +179,7 @@ void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, con
     int16_t mask_out_id = lv_draw_mask_add(&mask_out_param, NULL);
 
     /*Draw a full ring*/
-    if(start_angle + 360 == end_angle || start_angle == end_angle + 360) {
+    if(full_ring) {
         cir_dsc.radius = LV_RADIUS_CIRCLE;
         lv_draw_rect(draw_ctx, &cir_dsc, &area_out);
 
@@ -154,6 +224,9 @@ void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, con
         q_dsc.draw_dsc = &cir_dsc;
         q_dsc.draw_area = &area_out;
         q_dsc.draw_ctx = draw_ctx;
+#if LV_ARC_MASK_CACHE_SIZE > 0
+        q_dsc.ring = NULL;
+#endif
 
         draw_quarter_0(&q_dsc);
         draw_quarter_1(&q_dsc);
@@ -222,11 +295,64 @@ void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, con
 #endif /*LV_DRAW_COMPLEX*/
 }
 
+#if LV_DRAW_COMPLEX && LV_ARC_MASK_CACHE_SIZE > 0
+
+void lv_draw_sw_arc_cache_set_size(uint8_t entry_cnt)
+{
+    lv_draw_sw_arc_cache_clear();
+    ring_cache_max = LV_MIN(entry_cnt, LV_ARC_MASK_CACHE_SIZE);
+}
+
+void lv_draw_sw_arc_cache_set_mem_cb(void * (*alloc_cb)(size_t size), void (*free_cb)(void * p))
+{
+    lv_draw_sw_arc_cache_clear();
+    if(alloc_cb == NULL || free_cb == NULL) {
+        ring_cache_alloc_cb = lv_mem_alloc;
+        ring_cache_free_cb = lv_mem_free;
+    }
+    else {
+        ring_cache_alloc_cb = alloc_cb;
+        ring_cache_free_cb = free_cb;
+    }
+}
+
+void lv_draw_sw_arc_cache_clear(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_ARC_MASK_CACHE_SIZE; i++) {
+        ring_cache_free(i);
+    }
+}
+
+void lv_draw_sw_arc_cache_get_stats(lv_draw_sw_arc_cache_stats_t * stats)
+{
+    *stats = ring_cache_stats;
+}
+
+void lv_draw_sw_arc_cache_reset_stats(void)
+{
+    ring_cache_stats.hit_cnt = 0;
+    ring_cache_stats.miss_cnt = 0;
+}
+
+#endif /*LV_DRAW_COMPLEX && LV_ARC_MASK_CACHE_SIZE > 0*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
 #if LV_DRAW_COMPLEX
+static void draw_ring_part(quarter_draw_dsc_t * q)
+{
+#if LV_ARC_MASK_CACHE_SIZE > 0
+    if(q->ring) {
+        draw_ring_spans(q);
+        return;
+    }
+#endif
+    lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+}
+
 static void draw_quarter_0(quarter_draw_dsc_t * q)
 {
     const lv_area_t * clip_area_ori = q->draw_ctx->clip_area;
@@ -243,7 +369,7 @@ static void draw_quarter_0(quarter_draw_dsc_t * q)
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
         if(ok) {
             q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+            draw_ring_part(q);
         }
     }
     else if(q->start_quarter == 0 || q->end_quarter == 0) {
@@ -258,7 +384,7 @@ static void draw_quarter_0(quarter_draw_dsc_t * q)
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
             if(ok) {
                 q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+                draw_ring_part(q);
             }
         }
         if(q->end_quarter == 0) {
@@ -271,7 +397,7 @@ static void draw_quarter_0(quarter_draw_dsc_t * q)
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
             if(ok) {
                 q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+                draw_ring_part(q);
             }
         }
     }
@@ -288,7 +414,7 @@ static void draw_quarter_0(quarter_draw_dsc_t * q)
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
         if(ok) {
             q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+            draw_ring_part(q);
         }
     }
     q->draw_ctx->clip_area = clip_area_ori;
@@ -310,7 +436,7 @@ static void draw_quarter_1(quarter_draw_dsc_t * q)
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
         if(ok) {
             q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+            draw_ring_part(q);
         }
     }
     else if(q->start_quarter == 1 || q->end_quarter == 1) {
@@ -325,7 +451,7 @@ static void draw_quarter_1(quarter_draw_dsc_t * q)
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
             if(ok) {
                 q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+                draw_ring_part(q);
             }
         }
         if(q->end_quarter == 1) {
@@ -338,7 +464,7 @@ static void draw_quarter_1(quarter_draw_dsc_t * q)
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
             if(ok) {
                 q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+                draw_ring_part(q);
             }
         }
     }
@@ -355,7 +481,7 @@ static void draw_quarter_1(quarter_draw_dsc_t * q)
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
         if(ok) {
             q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+            draw_ring_part(q);
         }
     }
     q->draw_ctx->clip_area = clip_area_ori;
@@ -377,7 +503,7 @@ static void draw_quarter_2(quarter_draw_dsc_t * q)
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
         if(ok) {
             q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+            draw_ring_part(q);
         }
     }
     else if(q->start_quarter == 2 || q->end_quarter == 2) {
@@ -392,7 +518,7 @@ static void draw_quarter_2(quarter_draw_dsc_t * q)
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
             if(ok) {
                 q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+                draw_ring_part(q);
             }
         }
         if(q->end_quarter == 2) {
@@ -405,7 +531,7 @@ static void draw_quarter_2(quarter_draw_dsc_t * q)
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
             if(ok) {
                 q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+                draw_ring_part(q);
             }
         }
     }
@@ -422,7 +548,7 @@ static void draw_quarter_2(quarter_draw_dsc_t * q)
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
         if(ok) {
             q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+            draw_ring_part(q);
         }
     }
     q->draw_ctx->clip_area = clip_area_ori;
@@ -444,7 +570,7 @@ static void draw_quarter_3(quarter_draw_dsc_t * q)
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
         if(ok) {
             q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+            draw_ring_part(q);
         }
     }
     else if(q->start_quarter == 3 || q->end_quarter == 3) {
@@ -459,7 +585,7 @@ static void draw_quarter_3(quarter_draw_dsc_t * q)
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
             if(ok) {
                 q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+                draw_ring_part(q);
             }
         }
         if(q->end_quarter == 3) {
@@ -472,7 +598,7 @@ static void draw_quarter_3(quarter_draw_dsc_t * q)
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
             if(ok) {
                 q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+                draw_ring_part(q);
             }
         }
     }
@@ -489,7 +615,7 @@ static void draw_quarter_3(quarter_draw_dsc_t * q)
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
         if(ok) {
             q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+            draw_ring_part(q);
         }
     }
 
@@ -535,3 +661,352 @@ static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness
 }
 
 #endif /*LV_DRAW_COMPLEX*/
+
+#if LV_DRAW_COMPLEX && LV_ARC_MASK_CACHE_SIZE > 0
+static void draw_arc_cached(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, lv_draw_rect_dsc_t * cir_dsc,
+                            const ring_cache_entry_t * ring, const lv_point_t * center, lv_coord_t radius,
+                            lv_coord_t width, const lv_area_t * area_out, uint16_t start_angle, uint16_t end_angle)
+{
+    while(start_angle >= 360) start_angle -= 360;
+    while(end_angle >= 360) end_angle -= 360;
+
+    /*The angle mask is not added, only applied on the covered part of the rows*/
+    lv_draw_mask_angle_param_t mask_angle_param;
+    lv_draw_mask_angle_init(&mask_angle_param, center->x, center->y, start_angle, end_angle);
+
+    int32_t angle_gap;
+    if(end_angle > start_angle) {
+        angle_gap = 360 - (end_angle - start_angle);
+    }
+    else {
+        angle_gap = start_angle - end_angle;
+    }
+
+    quarter_draw_dsc_t q_dsc;
+    q_dsc.center = center;
+    q_dsc.radius = radius;
+    q_dsc.start_angle = start_angle;
+    q_dsc.end_angle = end_angle;
+    q_dsc.start_quarter = (start_angle / 90) & 0x3;
+    q_dsc.end_quarter = (end_angle / 90) & 0x3;
+    q_dsc.width = width;
+    q_dsc.draw_dsc = cir_dsc;
+    q_dsc.draw_area = area_out;
+    q_dsc.draw_ctx = draw_ctx;
+    q_dsc.ring = ring;
+    q_dsc.mask_angle = &mask_angle_param;
+
+    /*Skip the empty quarters the same way as with masks*/
+    if(angle_gap > SPLIT_ANGLE_GAP_LIMIT && radius > SPLIT_RADIUS_LIMIT) {
+        draw_quarter_0(&q_dsc);
+        draw_quarter_1(&q_dsc);
+        draw_quarter_2(&q_dsc);
+        draw_quarter_3(&q_dsc);
+    }
+    else {
+        draw_ring_spans(&q_dsc);
+    }
+
+    lv_draw_mask_free_param(&mask_angle_param);
+
+    if(dsc->rounded) {
+        lv_area_t round_area;
+        get_rounded_area(start_angle, radius, width, &round_area);
+        lv_area_move(&round_area, center->x, center->y);
+        draw_ring_cap(draw_ctx, ring, &round_area, draw_ctx->clip_area, area_out, cir_dsc->bg_color, cir_dsc->blend_mode);
+
+        get_rounded_area(end_angle, radius, width, &round_area);
+        lv_area_move(&round_area, center->x, center->y);
+        draw_ring_cap(draw_ctx, ring, &round_area, draw_ctx->clip_area, area_out, cir_dsc->bg_color, cir_dsc->blend_mode);
+    }
+}
+
+/*Unpack a row of the quarter ring to `buf[row->x1..row->x2]`*/
+static void ring_row_fill(const ring_cache_entry_t * ring, const ring_row_t * row, lv_opa_t * buf)
+{
+    lv_coord_t left_len = row->full_x1 - row->x1;
+    lv_memcpy(buf + row->x1, ring->opa + row->ofs, left_len);
+    if(row->full_x2 >= row->full_x1) lv_memset_ff(buf + row->full_x1, row->full_x2 - row->full_x1 + 1);
+    lv_memcpy(buf + row->full_x2 + 1, ring->opa + row->ofs + left_len, row->x2 - row->full_x2);
+}
+
+/*Blend `x1..x2` of a row. The coverage of `x` is `quarter_buf[x - cx]` right to the center and
+ *`quarter_buf[cx - 1 - x]` left to it.*/
+static void draw_ring_seg(quarter_draw_dsc_t * q, lv_draw_sw_blend_dsc_t * blend_dsc, const lv_area_t * clipped,
+                          lv_coord_t y, lv_coord_t x1, lv_coord_t x2, const lv_opa_t * quarter_buf)
+{
+    x1 = LV_MAX(x1, clipped->x1);
+    x2 = LV_MIN(x2, clipped->x2);
+    if(x1 > x2) return;
+
+    lv_coord_t cx = q->center->x;
+    lv_coord_t len = x2 - x1 + 1;
+    lv_opa_t * mask_buf = (lv_opa_t *)blend_dsc->mask_buf;
+    lv_coord_t left_len = LV_CLAMP(0, cx - x1, len);
+    lv_coord_t i;
+    for(i = 0; i < left_len; i++) {
+        mask_buf[i] = quarter_buf[cx - 1 - x1 - i];
+    }
+    if(left_len < len) lv_memcpy(mask_buf + left_len, quarter_buf + (x1 + left_len - cx), len - left_len);
+
+    lv_draw_mask_res_t res = q->mask_angle->dsc.cb(mask_buf, x1, y, len, q->mask_angle);
+    if(res == LV_DRAW_MASK_RES_TRANSP) return;
+
+    lv_area_t blend_area;
+    blend_area.x1 = x1;
+    blend_area.x2 = x2;
+    blend_area.y1 = y;
+    blend_area.y2 = y;
+    blend_dsc->blend_area = &blend_area;
+    blend_dsc->mask_area = &blend_area;
+    blend_dsc->mask_res = LV_DRAW_MASK_RES_CHANGED;
+    lv_draw_sw_blend(q->draw_ctx, blend_dsc);
+}
+
+/*Draw the part of the ring in the clip area. The quarters are mirrored from the lower right one.*/
+static void draw_ring_spans(quarter_draw_dsc_t * q)
+{
+    const ring_cache_entry_t * ring = q->ring;
+    lv_area_t clipped;
+    if(!_lv_area_intersect(&clipped, q->draw_area, q->draw_ctx->clip_area)) return;
+
+    lv_coord_t cx = q->center->x;
+    lv_coord_t cy = q->center->y;
+    lv_opa_t * quarter_buf = lv_mem_buf_get(ring->radius);
+
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memset_00(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.mask_buf = lv_mem_buf_get(2 * ring->radius);
+    blend_dsc.color = q->draw_dsc->bg_color;
+    blend_dsc.opa = LV_OPA_COVER;
+    blend_dsc.blend_mode = q->draw_dsc->blend_mode;
+
+    lv_coord_t y;
+    for(y = clipped.y1; y <= clipped.y2; y++) {
+        const ring_row_t * row = &ring->rows[y >= cy ? y - cy : cy - 1 - y];
+        if(row->x1 < 0) continue;
+        ring_row_fill(ring, row, quarter_buf);
+
+        /*The left and the right part, or one part if they meet in the middle*/
+        if(row->x1 == 0) {
+            draw_ring_seg(q, &blend_dsc, &clipped, y, cx - 1 - row->x2, cx + row->x2, quarter_buf);
+        }
+        else {
+            draw_ring_seg(q, &blend_dsc, &clipped, y, cx - 1 - row->x2, cx - 1 - row->x1, quarter_buf);
+            draw_ring_seg(q, &blend_dsc, &clipped, y, cx + row->x1, cx + row->x2, quarter_buf);
+        }
+    }
+
+    lv_mem_buf_release((void *)blend_dsc.mask_buf);
+    lv_mem_buf_release(quarter_buf);
+}
+
+static void draw_ring_cap(lv_draw_ctx_t * draw_ctx, const ring_cache_entry_t * ring, const lv_area_t * round_area,
+                          const lv_area_t * clip_area, const lv_area_t * area_out, lv_color_t color,
+                          lv_blend_mode_t blend_mode)
+{
+    lv_area_t clipped;
+    if(!_lv_area_intersect(&clipped, clip_area, round_area)) return;
+    if(!_lv_area_intersect(&clipped, &clipped, area_out)) return;
+
+    lv_area_t blend_area;
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memset_00(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.blend_area = &blend_area;
+    blend_dsc.mask_area = &blend_area;
+    blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+    blend_dsc.color = color;
+    blend_dsc.opa = LV_OPA_COVER;
+    blend_dsc.blend_mode = blend_mode;
+
+    blend_area.x1 = clipped.x1;
+    blend_area.x2 = clipped.x2;
+    lv_coord_t y;
+    for(y = clipped.y1; y <= clipped.y2; y++) {
+        blend_area.y1 = y;
+        blend_area.y2 = y;
+        blend_dsc.mask_buf = ring->cap + (y - round_area->y1) * ring->cap_size + clipped.x1 - round_area->x1;
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+    }
+}
+
+static const ring_cache_entry_t * ring_cache_get(lv_coord_t radius, lv_coord_t width, bool rounded)
+{
+    uint32_t i;
+    ring_cache_life++;
+    for(i = 0; i < ring_cache_max; i++) {
+        ring_cache_entry_t * e = ring_cache[i];
+        if(e && e->radius == radius && e->width == width && e->rounded == rounded) {
+            e->life = ring_cache_life;
+            ring_cache_stats.hit_cnt++;
+            return e;
+        }
+    }
+
+    ring_cache_stats.miss_cnt++;
+
+    /*Use an empty entry or replace the least recently used one*/
+    uint32_t slot = 0;
+    for(i = 0; i < ring_cache_max; i++) {
+        if(ring_cache[i] == NULL) {
+            slot = i;
+            break;
+        }
+        if(ring_cache[i]->life < ring_cache[slot]->life) slot = i;
+    }
+    ring_cache_free(slot);
+
+    ring_cache_entry_t * e = ring_cache_build(radius, width, rounded);
+    if(e == NULL) return NULL;
+
+    e->life = ring_cache_life;
+    ring_cache[slot] = e;
+    ring_cache_stats.entry_cnt++;
+    ring_cache_stats.size += e->size;
+    return e;
+}
+
+/*Get the coverage of a row of the ring like `lv_draw_mask_apply` would with the inner and outer masks*/
+static void ring_line(lv_draw_mask_radius_param_t * mask_in, lv_draw_mask_radius_param_t * mask_out,
+                      lv_coord_t radius, lv_coord_t y, lv_opa_t * line)
+{
+    lv_memset_ff(line, radius);
+    lv_draw_mask_res_t res = LV_DRAW_MASK_RES_FULL_COVER;
+    if(mask_in) res = mask_in->dsc.cb(line, radius, y, radius, mask_in);
+    if(res != LV_DRAW_MASK_RES_TRANSP) res = mask_out->dsc.cb(line, radius, y, radius, mask_out);
+    if(res == LV_DRAW_MASK_RES_TRANSP) lv_memset_00(line, radius);
+}
+
+static ring_cache_entry_t * ring_cache_build(lv_coord_t radius, lv_coord_t width, bool rounded)
+{
+    /*The masks of `lv_draw_sw_arc` with the center at (radius; radius)*/
+    lv_area_t area_out;
+    area_out.x1 = 0;
+    area_out.y1 = 0;
+    area_out.x2 = 2 * radius - 1;
+    area_out.y2 = 2 * radius - 1;
+
+    lv_area_t area_in;
+    lv_area_copy(&area_in, &area_out);
+    area_in.x1 += width;
+    area_in.y1 += width;
+    area_in.x2 -= width;
+    area_in.y2 -= width;
+
+    lv_draw_mask_radius_param_t mask_in_param;
+    lv_draw_mask_radius_param_t * mask_in = NULL;
+    if(lv_area_get_width(&area_in) > 0 && lv_area_get_height(&area_in) > 0) {
+        lv_draw_mask_radius_init(&mask_in_param, &area_in, LV_RADIUS_CIRCLE, true);
+        mask_in = &mask_in_param;
+    }
+
+    lv_draw_mask_radius_param_t mask_out_param;
+    lv_draw_mask_radius_init(&mask_out_param, &area_out, LV_RADIUS_CIRCLE, false);
+
+    lv_coord_t cap_size = 0;
+    if(rounded) {
+        lv_area_t round_area;
+        get_rounded_area(0, radius, width, &round_area);
+        cap_size = lv_area_get_width(&round_area);
+    }
+
+    lv_opa_t * line = lv_mem_buf_get(radius);
+    ring_row_t * rows = lv_mem_buf_get(radius * sizeof(ring_row_t));
+
+    /*Find the covered and the fully covered part of the rows*/
+    uint32_t opa_cnt = 0;
+    lv_coord_t y;
+    for(y = 0; y < radius; y++) {
+        ring_row_t * row = &rows[y];
+        ring_line(mask_in, &mask_out_param, radius, radius + y, line);
+
+        lv_coord_t x;
+        row->x1 = -1;
+        row->full_x1 = -1;
+        for(x = 0; x < radius; x++) {
+            if(line[x] == LV_OPA_TRANSP) continue;
+            if(row->x1 < 0) row->x1 = x;
+            row->x2 = x;
+            if(line[x] == LV_OPA_COVER) {
+                if(row->full_x1 < 0) row->full_x1 = x;
+                row->full_x2 = x;
+            }
+        }
+        if(row->x1 < 0) continue;
+
+        /*Store every pixel if there is a gap in the fully covered part*/
+        bool gap = row->full_x1 < 0;
+        for(x = row->full_x1; !gap && x <= row->full_x2; x++) {
+            if(line[x] != LV_OPA_COVER) gap = true;
+        }
+        if(gap) {
+            row->full_x1 = row->x2 + 1;
+            row->full_x2 = row->x2;
+        }
+
+        row->ofs = opa_cnt;
+        opa_cnt += (row->full_x1 - row->x1) + (row->x2 - row->full_x2);
+    }
+
+    uint32_t size = sizeof(ring_cache_entry_t) + radius * sizeof(ring_row_t) + opa_cnt + cap_size * cap_size;
+    ring_cache_entry_t * e = ring_cache_alloc_cb(size);
+    if(e) {
+        e->radius = radius;
+        e->width = width;
+        e->rounded = rounded;
+        e->size = size;
+        e->cap_size = cap_size;
+        e->rows = (ring_row_t *)(e + 1);
+        e->opa = (lv_opa_t *)(e->rows + radius);
+        e->cap = rounded ? e->opa + opa_cnt : NULL;
+        lv_memcpy(e->rows, rows, radius * sizeof(ring_row_t));
+
+        /*Save the anti-aliased pixels*/
+        for(y = 0; y < radius; y++) {
+            ring_row_t * row = &rows[y];
+            if(row->x1 < 0) continue;
+            ring_line(mask_in, &mask_out_param, radius, radius + y, line);
+            lv_coord_t left_len = row->full_x1 - row->x1;
+            lv_memcpy(e->opa + row->ofs, line + row->x1, left_len);
+            lv_memcpy(e->opa + row->ofs + left_len, line + row->full_x2 + 1, row->x2 - row->full_x2);
+        }
+
+        /*The rounded ends are circles, drawn in a `cap_size` large square*/
+        if(rounded) {
+            lv_area_t cap_area;
+            cap_area.x1 = 0;
+            cap_area.y1 = 0;
+            cap_area.x2 = cap_size - 1;
+            cap_area.y2 = cap_size - 1;
+            lv_draw_mask_radius_param_t mask_cap_param;
+            lv_draw_mask_radius_init(&mask_cap_param, &cap_area, LV_RADIUS_CIRCLE, false);
+            for(y = 0; y < cap_size; y++) {
+                lv_opa_t * cap_line = e->cap + y * cap_size;
+                lv_memset_ff(cap_line, cap_size);
+                lv_draw_mask_res_t res = mask_cap_param.dsc.cb(cap_line, 0, y, cap_size, &mask_cap_param);
+                if(res == LV_DRAW_MASK_RES_TRANSP) lv_memset_00(cap_line, cap_size);
+            }
+            lv_draw_mask_free_param(&mask_cap_param);
+        }
+    }
+    else {
+        LV_LOG_WARN("couldn't allocate %d bytes to cache an arc", (int)size);
+    }
+
+    lv_mem_buf_release(rows);
+    lv_mem_buf_release(line);
+    lv_draw_mask_free_param(&mask_out_param);
+    if(mask_in) lv_draw_mask_free_param(mask_in);
+
+    return e;
+}
+
+static void ring_cache_free(uint32_t i)
+{
+    if(ring_cache[i] == NULL) return;
+    ring_cache_stats.entry_cnt--;
+    ring_cache_stats.size -= ring_cache[i]->size;
+    ring_cache_free_cb(ring_cache[i]);
+    ring_cache[i] = NULL;
+}
+#endif /*LV_DRAW_COMPLEX && LV_ARC_MASK_CACHE_SIZE > 0*/
@@ -58,6 +58,51 @@ void lv_draw_sw_blend(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_d
  */
 LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_basic(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
 
+#if LV_USE_DRAW_SW_SWAP16
+/**
+ * Normal blending of a color into RGB565 pixels stored with swapped bytes (like `LV_COLOR_16_SWAP`).
+ * Gives the same pixels as `lv_draw_sw_blend_basic()` with 16 bit swapped colors.
+ * @param dest          pointer to the first pixel to fill
+ * @param dest_stride   pixels from a row of `dest` to the next
+ * @param w             width of the filled area
+ * @param h             height of the filled area
+ * @param color         the color as stored in the buffer
+ * @param opa           the overall opacity
+ * @param mask          NULL or the opacity of the first pixel
+ * @param mask_stride   bytes from a row of `mask` to the next
+ */
+LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_swap16_fill(uint16_t * dest, lv_coord_t dest_stride, lv_coord_t w,
+                                                  lv_coord_t h, uint16_t color, lv_opa_t opa,
+                                                  const lv_opa_t * mask, lv_coord_t mask_stride);
+
+/**
+ * Normal blending of an image into RGB565 pixels stored with swapped bytes (like `LV_COLOR_16_SWAP`).
+ * Gives the same pixels as `lv_draw_sw_blend_basic()` with 16 bit swapped colors.
+ * @param dest          pointer to the first pixel to draw
+ * @param dest_stride   pixels from a row of `dest` to the next
+ * @param src           pointer to the first pixel of the image, stored like `dest`
+ * @param src_stride    pixels from a row of `src` to the next
+ * @param w             width of the drawn area
+ * @param h             height of the drawn area
+ * @param opa           the overall opacity
+ * @param mask          NULL or the opacity of the first pixel
+ * @param mask_stride   bytes from a row of `mask` to the next
+ */
+LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_swap16_map(uint16_t * dest, lv_coord_t dest_stride, const uint16_t * src,
+                                                 lv_coord_t src_stride, lv_coord_t w, lv_coord_t h, lv_opa_t opa,
+                                                 const lv_opa_t * mask, lv_coord_t mask_stride);
+
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+/**
+ * The blend function of the software renderer with `LV_USE_DRAW_SW_SWAP16`.
+ * Normal blending goes to `lv_draw_sw_swap16_fill/map()`, everything else to `lv_draw_sw_blend_basic()`.
+ * @param draw_ctx      pointer to a draw context
+ * @param dsc           pointer to an initialized blend descriptor
+ */
+LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_swap16(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
+#endif
+#endif /*LV_USE_DRAW_SW_SWAP16*/
+
 /**********************
  *      MACROS
  **********************/
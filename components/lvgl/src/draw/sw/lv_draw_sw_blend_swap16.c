@@ -0,0 +1,368 @@
+/**
+ * @file lv_draw_sw_blend_swap16.c
+ *
+ * Normal blending of RGB565 stored with swapped bytes (`LV_COLOR_16_SWAP`).
+ * The channels are read from and written to the swapped layout with shifts instead of
+ * through the bitfields of `lv_color_t` (where green is split in two halves).
+ * The results are the same as `lv_color_mix()` gives with the swapped `lv_color_t`.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw.h"
+#include "../../hal/lv_hal_disp.h"
+#include "../../core/lv_refr.h"
+
+#if LV_USE_DRAW_SW_SWAP16
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Two 16 bit lanes*/
+#define LANES_LO    0x00FF00FFU
+#define LANES_ONE   0x00010001U
+#define LANES_R     0x001F001FU
+#define LANES_G     0x003F003FU
+#define LANES_OFS   ((uint32_t)LV_COLOR_MIX_ROUND_OFS * LANES_ONE)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*Swap the bytes of both pixels of a pair. The same operation swaps in and out.*/
+static inline uint32_t swap_pair(uint32_t p)
+{
+    return ((p & LANES_LO) << 8) | ((p >> 8) & LANES_LO);
+}
+
+/*`LV_UDIV255()` of both lanes, exact while a lane is less than 65535*/
+static inline uint32_t div255_lanes(uint32_t v)
+{
+    return ((v + LANES_ONE + ((v >> 8) & LANES_LO)) >> 8) & LANES_LO;
+}
+
+/*Premultiplied foreground of `mix_px()`: red and blue in two lanes, green alone, rounding offset added*/
+typedef struct {
+    uint32_t rb;
+    uint32_t g;
+} px_premult_t;
+
+static inline px_premult_t premult_px(uint16_t fg, uint32_t mix)
+{
+    uint16_t n = (uint16_t)((fg << 8) | (fg >> 8));
+    px_premult_t pm;
+    pm.rb = ((uint32_t)(n >> 11) | ((uint32_t)(n & 0x1F) << 16)) * mix + LANES_OFS;
+    pm.g = ((uint32_t)(n >> 5) & 0x3F) * mix + LV_COLOR_MIX_ROUND_OFS;
+    return pm;
+}
+
+static inline uint16_t mix_px(px_premult_t fg, uint16_t bg, uint32_t mix_inv)
+{
+    uint16_t n = (uint16_t)((bg << 8) | (bg >> 8));
+    uint32_t rb = div255_lanes(fg.rb + ((uint32_t)(n >> 11) | ((uint32_t)(n & 0x1F) << 16)) * mix_inv);
+    uint32_t g = div255_lanes(fg.g + ((uint32_t)(n >> 5) & 0x3F) * mix_inv);
+    n = (uint16_t)((rb << 11) | (g << 5) | (rb >> 16));
+    return (uint16_t)((n << 8) | (n >> 8));
+}
+
+/*Same as `lv_color_mix(fg, bg, mix)`*/
+static inline uint16_t mix_color(uint16_t fg, uint16_t bg, uint32_t mix)
+{
+    return mix_px(premult_px(fg, mix), bg, 255 - mix);
+}
+
+/*Premultiplied foreground of `mix_pair()`: every channel of both pixels in their own lanes*/
+typedef struct {
+    uint32_t r;
+    uint32_t g;
+    uint32_t b;
+} pair_premult_t;
+
+static inline pair_premult_t premult_pair(uint32_t fg2, uint32_t mix)
+{
+    uint32_t n = swap_pair(fg2);
+    pair_premult_t pm;
+    pm.r = ((n >> 11) & LANES_R) * mix + LANES_OFS;
+    pm.g = ((n >> 5) & LANES_G) * mix + LANES_OFS;
+    pm.b = (n & LANES_R) * mix + LANES_OFS;
+    return pm;
+}
+
+/*Mix two pixels with the same ratio: one swap in and out for both*/
+static inline uint32_t mix_pair(pair_premult_t fg, uint32_t bg2, uint32_t mix_inv)
+{
+    uint32_t n = swap_pair(bg2);
+    uint32_t r = div255_lanes(fg.r + ((n >> 11) & LANES_R) * mix_inv);
+    uint32_t g = div255_lanes(fg.g + ((n >> 5) & LANES_G) * mix_inv);
+    uint32_t b = div255_lanes(fg.b + (n & LANES_R) * mix_inv);
+    return swap_pair((r << 11) | (g << 5) | b);
+}
+
+static inline uint32_t load_pair(const uint16_t * p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 16);
+}
+
+static inline void store_pair(uint16_t * p, uint32_t v)
+{
+    p[0] = (uint16_t)v;
+    p[1] = (uint16_t)(v >> 16);
+}
+
+/*Fill a row with 32 bit stores, two of them per iteration*/
+static inline void fill_row(uint16_t * dest, int32_t w, uint16_t color, uint32_t c32)
+{
+    if(w > 0 && ((lv_uintptr_t)dest & 0x3)) {
+        *dest++ = color;
+        w--;
+    }
+    uint32_t * d32 = (uint32_t *)dest;
+    int32_t x;
+    for(x = 0; x + 4 <= w; x += 4) {
+        d32[0] = c32;
+        d32[1] = c32;
+        d32 += 2;
+    }
+    if(x + 2 <= w) {
+        *d32++ = c32;
+        x += 2;
+    }
+    if(x < w) *((uint16_t *)d32) = color;
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_swap16_fill(uint16_t * dest, lv_coord_t dest_stride, lv_coord_t w,
+                                                  lv_coord_t h, uint16_t color, lv_opa_t opa,
+                                                  const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    int32_t x;
+    int32_t y;
+    uint32_t c32 = (uint32_t)color | ((uint32_t)color << 16);
+
+    if(mask == NULL) {
+        if(opa >= LV_OPA_MAX) {
+            for(y = 0; y < h; y++) {
+                fill_row(dest, w, color, c32);
+                dest += dest_stride;
+            }
+            return;
+        }
+
+#if LV_COLOR_MIX_ROUND_OFS == 0
+        /*The same rounding of the opacity as `fill_normal()` of the basic blender with 16 bit colors*/
+        opa = (uint32_t)((uint32_t)opa + 4) >> 3;
+        opa = opa << 3;
+#endif
+        pair_premult_t fg2 = premult_pair(c32, opa);
+        uint32_t opa_inv = 255 - opa;
+        /*Most pairs are the same (e.g. a flat background), reuse the last result*/
+        uint32_t last_dest = swap_pair(0);
+        uint32_t last_res = mix_pair(fg2, last_dest, opa_inv);
+        for(y = 0; y < h; y++) {
+            for(x = 0; x + 1 < w; x += 2) {
+                uint32_t d = load_pair(&dest[x]);
+                if(d != last_dest) {
+                    last_dest = d;
+                    last_res = mix_pair(fg2, d, opa_inv);
+                }
+                store_pair(&dest[x], last_res);
+            }
+            if(x < w) {
+                dest[x] = (uint16_t)mix_pair(fg2, dest[x], opa_inv);
+            }
+            dest += dest_stride;
+        }
+        return;
+    }
+
+    if(opa >= LV_OPA_MAX) {
+        for(y = 0; y < h; y++) {
+            const lv_opa_t * m = mask;
+            for(x = 0; x < w && ((lv_uintptr_t)m & 0x3); x++, m++) {
+                if(*m == LV_OPA_COVER) dest[x] = color;
+                else if(*m) dest[x] = mix_color(color, dest[x], *m);
+            }
+            for(; x + 4 <= w; x += 4, m += 4) {
+                uint32_t mask32 = *((const uint32_t *)m);
+                if(mask32 == 0) continue;
+                if(mask32 == 0xFFFFFFFF) {
+                    fill_row(&dest[x], 4, color, c32);
+                    continue;
+                }
+                int32_t i;
+                for(i = 0; i < 4; i++) {
+                    if(m[i] == LV_OPA_COVER) dest[x + i] = color;
+                    else if(m[i]) dest[x + i] = mix_color(color, dest[x + i], m[i]);
+                }
+            }
+            for(; x < w; x++, m++) {
+                if(*m == LV_OPA_COVER) dest[x] = color;
+                else if(*m) dest[x] = mix_color(color, dest[x], *m);
+            }
+            dest += dest_stride;
+            mask += mask_stride;
+        }
+        return;
+    }
+
+    /*Mask and opacity, the mix ratio changes per pixel so the pixels are mixed one by one*/
+    lv_opa_t last_mask = LV_OPA_TRANSP;
+    lv_opa_t opa_tmp = LV_OPA_TRANSP;
+    px_premult_t fg = premult_px(color, 0);
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            if(mask[x] == 0) continue;
+            if(mask[x] != last_mask) {
+                opa_tmp = mask[x] == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)mask[x] * opa) >> 8;
+                fg = premult_px(color, opa_tmp);
+                last_mask = mask[x];
+            }
+            if(opa_tmp == LV_OPA_COVER) dest[x] = color;
+            else dest[x] = mix_px(fg, dest[x], 255 - opa_tmp);
+        }
+        dest += dest_stride;
+        mask += mask_stride;
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_swap16_map(uint16_t * dest, lv_coord_t dest_stride, const uint16_t * src,
+                                                 lv_coord_t src_stride, lv_coord_t w, lv_coord_t h, lv_opa_t opa,
+                                                 const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    int32_t x;
+    int32_t y;
+
+    if(mask == NULL) {
+        if(opa >= LV_OPA_MAX) {
+            for(y = 0; y < h; y++) {
+                lv_memcpy(dest, src, w * sizeof(uint16_t));
+                dest += dest_stride;
+                src += src_stride;
+            }
+            return;
+        }
+
+        uint32_t opa_inv = 255 - opa;
+        for(y = 0; y < h; y++) {
+            for(x = 0; x + 1 < w; x += 2) {
+                store_pair(&dest[x], mix_pair(premult_pair(load_pair(&src[x]), opa), load_pair(&dest[x]), opa_inv));
+            }
+            if(x < w) {
+                dest[x] = (uint16_t)mix_pair(premult_pair(src[x], opa), dest[x], opa_inv);
+            }
+            dest += dest_stride;
+            src += src_stride;
+        }
+        return;
+    }
+
+    /*Same opacity limit as `map_normal()` of the basic blender*/
+    if(opa > LV_OPA_MAX) {
+        for(y = 0; y < h; y++) {
+            const lv_opa_t * m = mask;
+            for(x = 0; x < w && ((lv_uintptr_t)m & 0x3); x++, m++) {
+                if(*m == LV_OPA_COVER) dest[x] = src[x];
+                else if(*m) dest[x] = mix_color(src[x], dest[x], *m);
+            }
+            for(; x + 4 <= w; x += 4, m += 4) {
+                uint32_t mask32 = *((const uint32_t *)m);
+                if(mask32 == 0) continue;
+                if(mask32 == 0xFFFFFFFF) {
+                    lv_memcpy(&dest[x], &src[x], 4 * sizeof(uint16_t));
+                    continue;
+                }
+                int32_t i;
+                for(i = 0; i < 4; i++) {
+                    if(m[i] == LV_OPA_COVER) dest[x + i] = src[x + i];
+                    else if(m[i]) dest[x + i] = mix_color(src[x + i], dest[x + i], m[i]);
+                }
+            }
+            for(; x < w; x++, m++) {
+                if(*m == LV_OPA_COVER) dest[x] = src[x];
+                else if(*m) dest[x] = mix_color(src[x], dest[x], *m);
+            }
+            dest += dest_stride;
+            src += src_stride;
+            mask += mask_stride;
+        }
+        return;
+    }
+
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            if(mask[x]) {
+                lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
+                dest[x] = mix_color(src[x], dest[x], opa_tmp);
+            }
+        }
+        dest += dest_stride;
+        src += src_stride;
+        mask += mask_stride;
+    }
+}
+
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+
+LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_swap16(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc)
+{
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp->driver->set_px_cb || disp->driver->screen_transp || dsc->blend_mode != LV_BLEND_MODE_NORMAL) {
+        lv_draw_sw_blend_basic(draw_ctx, dsc);
+        return;
+    }
+
+    const lv_opa_t * mask;
+    if(dsc->mask_buf == NULL) mask = NULL;
+    if(dsc->mask_buf && dsc->mask_res == LV_DRAW_MASK_RES_TRANSP) return;
+    else if(dsc->mask_res == LV_DRAW_MASK_RES_FULL_COVER) mask = NULL;
+    else mask = dsc->mask_buf;
+
+    lv_area_t blend_area;
+    if(!_lv_area_intersect(&blend_area, dsc->blend_area, draw_ctx->clip_area)) return;
+
+    lv_coord_t dest_stride = lv_area_get_width(draw_ctx->buf_area);
+    uint16_t * dest_buf = (uint16_t *)draw_ctx->buf;
+    dest_buf += dest_stride * (blend_area.y1 - draw_ctx->buf_area->y1) + (blend_area.x1 - draw_ctx->buf_area->x1);
+
+    lv_coord_t mask_stride = 0;
+    if(mask) {
+        mask_stride = lv_area_get_width(dsc->mask_area);
+        mask += mask_stride * (blend_area.y1 - dsc->mask_area->y1) + (blend_area.x1 - dsc->mask_area->x1);
+    }
+
+    lv_coord_t w = lv_area_get_width(&blend_area);
+    lv_coord_t h = lv_area_get_height(&blend_area);
+    if(dsc->src_buf == NULL) {
+        lv_draw_sw_swap16_fill(dest_buf, dest_stride, w, h, dsc->color.full, dsc->opa, mask, mask_stride);
+    }
+    else {
+        lv_coord_t src_stride = lv_area_get_width(dsc->blend_area);
+        const uint16_t * src_buf = (const uint16_t *)dsc->src_buf;
+        src_buf += src_stride * (blend_area.y1 - dsc->blend_area->y1) + (blend_area.x1 - dsc->blend_area->x1);
+        lv_draw_sw_swap16_map(dest_buf, dest_stride, src_buf, src_stride, w, h, dsc->opa, mask, mask_stride);
+    }
+}
+
+#endif /*LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP*/
+
+#endif /*LV_USE_DRAW_SW_SWAP16*/
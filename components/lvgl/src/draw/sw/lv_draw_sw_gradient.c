@@ -32,41 +32,59 @@
     #error "LV_GRAD_CACHE_DEF_SIZE is too small"
 #endif
 
+/*Don't let the use count of an item grow beyond this so that it can age out in a few evictions*/
+#define GRAD_CACHE_LIFE_MAX 16
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static lv_grad_t * next_in_cache(lv_grad_t * item);
-
-typedef lv_res_t (*op_cache_t)(lv_grad_t * c, void * ctx);
-static lv_res_t iterate_cache(op_cache_t func, void * ctx, lv_grad_t ** out);
 static size_t get_cache_item_size(lv_grad_t * c);
 static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
-static lv_res_t find_oldest_item_life(lv_grad_t * c, void * ctx);
-static lv_res_t kill_oldest_item(lv_grad_t * c, void * ctx);
-static lv_res_t find_item(lv_grad_t * c, void * ctx);
+static void evict_item(void);
+static bool item_match(const lv_grad_t * c, const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h, uint32_t key);
 static void free_item(lv_grad_t * c);
-static  uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
+static uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
 
 
 /**********************
  *   STATIC VARIABLE
  **********************/
-static size_t    grad_cache_size = 0;
+static size_t    grad_cache_size = LV_GRAD_CACHE_DEF_SIZE;
 static uint8_t * grad_cache_end = 0;
+static uint32_t  grad_use_cnt;
+static void * (*grad_alloc_cb)(size_t size) = lv_mem_alloc;
+static void (*grad_free_cb)(void * p) = lv_mem_free;
+static lv_grad_cache_stats_t grad_stats;
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
-union void_cast {
-    const void * ptr;
-    const uint32_t value;
-};
+static uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
+{
+    /*FNV-1a of what the map depends on. The descriptor is usually a copy on the stack,
+     *so its address tells nothing about the gradient*/
+    uint32_t k = 2166136261u;
+    uint8_t i;
+    for(i = 0; i < g->stops_count; i++) {
+        k = (k ^ lv_color_to32(g->stops[i].color)) * 16777619u;
+        k = (k ^ g->stops[i].frac) * 16777619u;
+    }
+    k = (k ^ (g->dir | (g->dither << 3))) * 16777619u;
+    k = (k ^ (uint32_t)w) * 16777619u;
+    return (k ^ (uint32_t)h) * 16777619u;
+}
 
-static uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t size, lv_coord_t w)
+static bool item_match(const lv_grad_t * c, const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h, uint32_t key)
 {
-    union void_cast v;
-    v.ptr = g;
-    return (v.value ^ size ^ (w >> 1)); /*Yes, this is correct, it's like a hash that changes if the width changes*/
+    if(c->key != key || c->w != w || c->h != h) return false;
+    if(c->dsc.stops_count != g->stops_count || c->dsc.dir != g->dir || c->dsc.dither != g->dither) return false;
+
+    uint8_t i;
+    for(i = 0; i < g->stops_count; i++) {
+        if(c->dsc.stops[i].color.full != g->stops[i].color.full || c->dsc.stops[i].frac != g->stops[i].frac) return false;
+    }
+    return true;
 }
 
 static size_t get_cache_item_size(lv_grad_t * c)
@@ -83,35 +101,38 @@ static size_t get_cache_item_size(lv_grad_t * c)
 
 static lv_grad_t * next_in_cache(lv_grad_t * item)
 {
-    if(grad_cache_size == 0) return NULL;
+    if(LV_GC_ROOT(_lv_grad_cache_mem) == NULL) return NULL;
 
-    if(item == NULL)
-        return (lv_grad_t *)LV_GC_ROOT(_lv_grad_cache_mem);
+    if(item == NULL) item = (lv_grad_t *)LV_GC_ROOT(_lv_grad_cache_mem);
+    else item = (lv_grad_t *)((uint8_t *)item + get_cache_item_size(item));
 
-    size_t s = get_cache_item_size(item);
-    /*Compute the size for this cache item*/
-    if((uint8_t *)item + s >= grad_cache_end) return NULL;
-    else return (lv_grad_t *)((uint8_t *)item + s);
+    return (uint8_t *)item < grad_cache_end ? item : NULL;
 }
 
-static lv_res_t iterate_cache(op_cache_t func, void * ctx, lv_grad_t ** out)
+/**
+ * Drop an item to make room. Frequently used items are kept over recently used ones:
+ * the victim is the item used the fewest times and of those the least recently used one.
+ * The use counts are halved on every eviction so an item used a lot long ago can go too.
+ */
+static void evict_item(void)
 {
-    lv_grad_t * first = next_in_cache(NULL);
-    while(first != NULL && first->life) {
-        if((*func)(first, ctx) == LV_RES_OK) {
-            if(out != NULL) *out = first;
-            return LV_RES_OK;
+    lv_grad_t * victim = NULL;
+    lv_grad_t * c;
+    for(c = next_in_cache(NULL); c; c = next_in_cache(c)) {
+        if(victim == NULL || c->life < victim->life ||
+           (c->life == victim->life && (int32_t)(c->last_use - victim->last_use) < 0)) {
+            victim = c;
         }
-        first = next_in_cache(first);
     }
-    return LV_RES_INV;
-}
+    if(victim == NULL) return;
 
-static lv_res_t find_oldest_item_life(lv_grad_t * c, void * ctx)
-{
-    uint32_t * min_life = (uint32_t *)ctx;
-    if(c->life < *min_life) *min_life = c->life;
-    return LV_RES_INV;
+    free_item(victim);
+    grad_stats.evict_cnt++;
+    grad_stats.entry_cnt--;
+
+    for(c = next_in_cache(NULL); c; c = next_in_cache(c)) {
+        c->life = (c->life + 1) / 2;
+    }
 }
 
 static void free_item(lv_grad_t * c)
@@ -120,7 +141,6 @@ static void free_item(lv_grad_t * c)
     size_t next_items_size = (size_t)(grad_cache_end - (uint8_t *)c) - size;
     grad_cache_end -= size;
     if(next_items_size) {
-        uint8_t * old = (uint8_t *)c;
         lv_memcpy(c, ((uint8_t *)c) + size, next_items_size);
         /* Then need to fix all internal pointers too */
         while((uint8_t *)c != grad_cache_end) {
@@ -133,28 +153,9 @@ static void free_item(lv_grad_t * c)
 #endif
             c = (lv_grad_t *)(((uint8_t *)c) + get_cache_item_size(c));
         }
-        lv_memset_00(old + next_items_size, size);
     }
 }
 
-static lv_res_t kill_oldest_item(lv_grad_t * c, void * ctx)
-{
-    uint32_t * min_life = (uint32_t *)ctx;
-    if(c->life == *min_life) {
-        /*Found, let's kill it*/
-        free_item(c);
-        return LV_RES_OK;
-    }
-    return LV_RES_INV;
-}
-
-static lv_res_t find_item(lv_grad_t * c, void * ctx)
-{
-    uint32_t * k = (uint32_t *)ctx;
-    if(c->key == *k) return LV_RES_OK;
-    return LV_RES_INV;
-}
-
 static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
 {
     lv_coord_t size = g->dir == LV_GRAD_DIR_HOR ? w : h;
@@ -169,62 +170,52 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord
 #endif
 #endif
 
-    size_t act_size = (size_t)(grad_cache_end - LV_GC_ROOT(_lv_grad_cache_mem));
+    /*Allocate the whole cache at once to not fragment the heap with maps of every size*/
+    if(req_size <= grad_cache_size && LV_GC_ROOT(_lv_grad_cache_mem) == NULL) {
+        grad_cache_end = LV_GC_ROOT(_lv_grad_cache_mem) = grad_alloc_cb(grad_cache_size);
+        if(grad_cache_end == NULL) LV_LOG_WARN("couldn't allocate %d bytes for the gradient cache", (int)grad_cache_size);
+    }
+
     lv_grad_t * item = NULL;
-    if(req_size + act_size < grad_cache_size) {
+    if(req_size <= grad_cache_size && LV_GC_ROOT(_lv_grad_cache_mem)) {
+        /*Need to evict items from cache until we find enough space to allocate this one */
+        while((size_t)(grad_cache_end - LV_GC_ROOT(_lv_grad_cache_mem)) + req_size > grad_cache_size) {
+            evict_item();
+        }
         item = (lv_grad_t *)grad_cache_end;
         item->not_cached = 0;
+        grad_stats.entry_cnt++;
     }
     else {
-        /*Need to evict items from cache until we find enough space to allocate this one */
-        if(req_size <= grad_cache_size) {
-            while(act_size + req_size > grad_cache_size) {
-                uint32_t oldest_life = UINT32_MAX;
-                iterate_cache(&find_oldest_item_life, &oldest_life, NULL);
-                iterate_cache(&kill_oldest_item, &oldest_life, NULL);
-                act_size = (size_t)(grad_cache_end - LV_GC_ROOT(_lv_grad_cache_mem));
-            }
-            item = (lv_grad_t *)grad_cache_end;
-            item->not_cached = 0;
-        }
-        else {
-            /*The cache is too small. Allocate the item manually and free it later.*/
-            item = lv_mem_alloc(req_size);
-            LV_ASSERT_MALLOC(item);
-            if(item == NULL) return NULL;
-            item->not_cached = 1;
-        }
+        /*The cache is too small. Allocate the item manually and free it later.*/
+        item = lv_mem_alloc(req_size);
+        LV_ASSERT_MALLOC(item);
+        if(item == NULL) return NULL;
+        item->not_cached = 1;
+        grad_stats.skip_cnt++;
     }
 
-    item->key = compute_key(g, size, w);
+    item->key = compute_key(g, w, h);
     item->life = 1;
+    item->last_use = grad_use_cnt;
     item->filled = 0;
     item->alloc_size = map_size;
     item->size = size;
-    if(item->not_cached) {
-        uint8_t * p = (uint8_t *)item;
-        item->map = (lv_color_t *)(p + ALIGN(sizeof(*item)));
-#if _DITHER_GRADIENT
-        item->hmap = (lv_color32_t *)(p + ALIGN(sizeof(*item)) + ALIGN(map_size * sizeof(lv_color_t)));
-#if LV_DITHER_ERROR_DIFFUSION == 1
-        item->error_acc = (lv_scolor24_t *)(p + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_grad_color_t)) +
-                                            ALIGN(map_size * sizeof(lv_color_t)));
-        item->w = w;
-#endif
-#endif
-    }
-    else {
-        item->map = (lv_color_t *)(grad_cache_end + ALIGN(sizeof(*item)));
+    item->w = w;
+    item->h = h;
+    item->dsc = *g;
+
+    uint8_t * p = (uint8_t *)item;
+    item->map = (lv_color_t *)(p + ALIGN(sizeof(*item)));
 #if _DITHER_GRADIENT
-        item->hmap = (lv_color32_t *)(grad_cache_end + ALIGN(sizeof(*item)) + ALIGN(map_size * sizeof(lv_color_t)));
+    item->hmap = (lv_color32_t *)(p + ALIGN(sizeof(*item)) + ALIGN(map_size * sizeof(lv_color_t)));
 #if LV_DITHER_ERROR_DIFFUSION == 1
-        item->error_acc = (lv_scolor24_t *)(grad_cache_end + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_grad_color_t)) +
-                                            ALIGN(map_size * sizeof(lv_color_t)));
-        item->w = w;
+    item->error_acc = (lv_scolor24_t *)(p + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_grad_color_t)) +
+                                        ALIGN(map_size * sizeof(lv_color_t)));
 #endif
 #endif
-        grad_cache_end += req_size;
-    }
+    if(!item->not_cached) grad_cache_end += req_size;
+
     return item;
 }
 
@@ -234,40 +225,64 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord
  **********************/
 void lv_gradient_free_cache(void)
 {
-    lv_mem_free(LV_GC_ROOT(_lv_grad_cache_mem));
+    if(LV_GC_ROOT(_lv_grad_cache_mem)) grad_free_cb(LV_GC_ROOT(_lv_grad_cache_mem));
     LV_GC_ROOT(_lv_grad_cache_mem) = grad_cache_end = NULL;
-    grad_cache_size = 0;
+    grad_stats.entry_cnt = 0;
 }
 
 void lv_gradient_set_cache_size(size_t max_bytes)
 {
-    lv_mem_free(LV_GC_ROOT(_lv_grad_cache_mem));
-    grad_cache_end = LV_GC_ROOT(_lv_grad_cache_mem) = lv_mem_alloc(max_bytes);
-    LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_grad_cache_mem));
-    lv_memset_00(LV_GC_ROOT(_lv_grad_cache_mem), max_bytes);
+    lv_gradient_free_cache();
     grad_cache_size = max_bytes;
 }
 
+void lv_gradient_set_cache_mem_cb(void * (*alloc_cb)(size_t size), void (*free_cb)(void * p))
+{
+    lv_gradient_free_cache();
+    if(alloc_cb == NULL || free_cb == NULL) {
+        grad_alloc_cb = lv_mem_alloc;
+        grad_free_cb = lv_mem_free;
+    }
+    else {
+        grad_alloc_cb = alloc_cb;
+        grad_free_cb = free_cb;
+    }
+}
+
+void lv_gradient_get_cache_stats(lv_grad_cache_stats_t * stats)
+{
+    *stats = grad_stats;
+    stats->used = (uint32_t)(grad_cache_end - LV_GC_ROOT(_lv_grad_cache_mem));
+    stats->budget = (uint32_t)grad_cache_size;
+}
+
+void lv_gradient_reset_cache_stats(void)
+{
+    grad_stats.hit_cnt = 0;
+    grad_stats.miss_cnt = 0;
+    grad_stats.evict_cnt = 0;
+    grad_stats.skip_cnt = 0;
+}
+
 lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
 {
     /* No gradient, no cache */
     if(g->dir == LV_GRAD_DIR_NONE) return NULL;
 
-    /* Step 0: Check if the cache exist (else create it) */
-    static bool inited = false;
-    if(!inited) {
-        lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
-        inited = true;
-    }
-
     /* Step 1: Search cache for the given key */
-    lv_coord_t size = g->dir == LV_GRAD_DIR_HOR ? w : h;
-    uint32_t key = compute_key(g, size, w);
-    lv_grad_t * item = NULL;
-    if(iterate_cache(&find_item, &key, &item) == LV_RES_OK) {
-        item->life++; /* Don't forget to bump the counter */
-        return item;
+    uint32_t key = compute_key(g, w, h);
+    grad_use_cnt++;
+    lv_grad_t * item;
+    for(item = next_in_cache(NULL); item; item = next_in_cache(item)) {
+        if(item_match(item, g, w, h, key)) {
+            /* Don't forget to bump the counters */
+            if(item->life < GRAD_CACHE_LIFE_MAX) item->life++;
+            item->last_use = grad_use_cnt;
+            grad_stats.hit_cnt++;
+            return item;
+        }
     }
+    grad_stats.miss_cnt++;
 
     /* Step 2: Need to allocate an item for it */
     item = allocate_item(g, w, h);
@@ -41,24 +41,38 @@ typedef struct _lv_gradient_cache_t {
     uint32_t        key;          /**< A discriminating key that's built from the drawing operation.
                                    * If the key does not match, the cache item is not used */
     uint32_t        life : 30;    /**< A life counter that's incremented on usage. Higher counter is
-                                   * less likely to be evicted from the cache */
+                                   * less likely to be evicted from the cache. Halved on every eviction */
     uint32_t        filled : 1;   /**< Used to skip dithering in it if already done */
     uint32_t        not_cached: 1; /**< The cache was too small so this item is not managed by the cache*/
     lv_color_t   *  map;          /**< The computed gradient low bitdepth color map, points into the
                                    * cache's buffer, no free needed */
     lv_coord_t      alloc_size;   /**< The map allocated size in colors */
     lv_coord_t      size;         /**< The computed gradient color map size, in colors */
+    lv_coord_t      w;            /**< The width of the area the gradient was computed for.
+                                   * Also the error array width in pixels */
+    lv_coord_t      h;            /**< The height of the area the gradient was computed for */
+    uint32_t        last_use;     /**< When the item was used last time, in gradient lookups */
+    lv_grad_dsc_t   dsc;          /**< The gradient the map was computed for */
 #if _DITHER_GRADIENT
     lv_color32_t  * hmap;         /**< If dithering, we need to store the current, high bitdepth gradient
                                    * map too, points to the cache's buffer, no free needed */
 #if LV_DITHER_ERROR_DIFFUSION == 1
     lv_scolor24_t * error_acc;    /**< Error diffusion dithering algorithm requires storing the last error
                                    * drawn, points to the cache's buffer, no free needed  */
-    lv_coord_t      w;            /**< The error array width in pixels */
 #endif
 #endif
 } lv_grad_t;
 
+typedef struct {
+    uint32_t hit_cnt;       /**< Gradients found in the cache*/
+    uint32_t miss_cnt;      /**< Gradients which had to be computed*/
+    uint32_t evict_cnt;     /**< Items dropped to make room for a new one*/
+    uint32_t skip_cnt;      /**< Computed gradients which were too large to cache or had no buffer*/
+    uint32_t entry_cnt;     /**< Items in the cache now*/
+    uint32_t used;          /**< Bytes used by the items now*/
+    uint32_t budget;        /**< Max. bytes the items can use*/
+} lv_grad_cache_stats_t;
+
 
 /**********************
  *      PROTOTYPES
@@ -73,14 +87,34 @@ LV_ATTRIBUTE_FAST_MEM lv_grad_color_t lv_gradient_calculate(const lv_grad_dsc_t
                                                             lv_coord_t frac);
 
 /**
- * Set the gradient cache size
- * @param max_bytes Max cahce size
+ * Set the gradient cache size. The default is `LV_GRAD_CACHE_DEF_SIZE`. The cache is cleared.
+ * @param max_bytes Max cache size in bytes, 0 disables caching
  */
 void lv_gradient_set_cache_size(size_t max_bytes);
 
+/**
+ * Set where the buffer of the gradient cache is allocated, e.g. in an external RAM.
+ * The whole cache is allocated when the first gradient is cached.
+ * By default `lv_mem_alloc` and `lv_mem_free` are used. The cache is cleared.
+ * @param alloc_cb  allocate memory, NULL to restore the default
+ * @param free_cb   free memory allocated by `alloc_cb`
+ */
+void lv_gradient_set_cache_mem_cb(void * (*alloc_cb)(size_t size), void (*free_cb)(void * p));
+
 /** Free the gradient cache */
 void lv_gradient_free_cache(void);
 
+/**
+ * Get the statistics of the gradient cache
+ * @param stats store the statistics here
+ */
+void lv_gradient_get_cache_stats(lv_grad_cache_stats_t * stats);
+
+/**
+ * Reset the hit, miss, evict and skip counters
+ */
+void lv_gradient_reset_cache_stats(void);
+
 /** Get a gradient cache from the given parameters */
 lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * gradient, lv_coord_t w, lv_coord_t h);
 
@@ -0,0 +1,239 @@
+/**
+ * @file lv_draw_sw_layer_pool.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_layer_pool.h"
+#include "../../misc/lv_mem.h"
+#include "../../misc/lv_log.h"
+#include "../../misc/lv_assert.h"
+#include "../../misc/lv_printf.h"
+#include "../../misc/lv_parallel.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define POOL_TRANSFORM_CNT (LV_LAYER_POOL_TRANSFORM_SIZE > 0 ? 1 : 0)
+#define POOL_CNT (LV_LAYER_POOL_SIMPLE_CNT + POOL_TRANSFORM_CNT)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    void * buf;
+    uint32_t size;
+    bool in_use;
+} pool_buf_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void * get_from_pool(uint32_t first, uint32_t end, uint32_t size);
+static void * alloc_buf(uint32_t size);
+static void reserve_once(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if POOL_CNT > 0
+static pool_buf_t pool[POOL_CNT];   /*The simple buffers, then the transform buffer*/
+#endif
+static void * (*alloc_cb)(size_t size) = lv_mem_alloc;
+static void (*free_cb)(void * p) = lv_mem_free;
+static lv_draw_sw_layer_pool_stats_t stats;
+static uint32_t in_use_cnt;
+static bool reserve_tried;  /*Reserved, tried to or released since the start or the last `set_mem_cb`*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_res_t lv_draw_sw_layer_pool_reserve(void)
+{
+    lv_res_t res = LV_RES_OK;
+    reserve_tried = true;
+#if POOL_CNT > 0
+    uint32_t i;
+    for(i = 0; i < POOL_CNT; i++) {
+        if(pool[i].buf) continue;
+
+        uint32_t size = i < LV_LAYER_POOL_SIMPLE_CNT ? LV_LAYER_SIMPLE_BUF_SIZE : LV_LAYER_POOL_TRANSFORM_SIZE;
+        pool[i].buf = alloc_cb(size);
+        if(pool[i].buf == NULL) {
+            LV_LOG_WARN("couldn't reserve %d bytes for a layer buffer", (int)size);
+            res = LV_RES_INV;
+            continue;
+        }
+        pool[i].size = size;
+        pool[i].in_use = false;
+        stats.reserved += size;
+    }
+#endif
+    return res;
+}
+
+void lv_draw_sw_layer_pool_release(void)
+{
+#if POOL_CNT > 0
+    uint32_t i;
+    for(i = 0; i < POOL_CNT; i++) {
+        if(pool[i].buf == NULL) continue;
+        LV_ASSERT_MSG(!pool[i].in_use, "a layer buffer is released while it's drawn");
+        free_cb(pool[i].buf);
+        pool[i].buf = NULL;
+        pool[i].size = 0;
+    }
+#endif
+    stats.reserved = 0;
+    reserve_tried = true;   /*Released on purpose, the next layer shouldn't reserve it again*/
+}
+
+void lv_draw_sw_layer_pool_set_mem_cb(void * (*new_alloc_cb)(size_t size), void (*new_free_cb)(void * p))
+{
+    lv_draw_sw_layer_pool_release();
+    reserve_tried = false;
+    if(new_alloc_cb == NULL || new_free_cb == NULL) {
+        alloc_cb = lv_mem_alloc;
+        free_cb = lv_mem_free;
+    }
+    else {
+        alloc_cb = new_alloc_cb;
+        free_cb = new_free_cb;
+    }
+}
+
+void lv_draw_sw_layer_pool_get_stats(lv_draw_sw_layer_pool_stats_t * stats_out)
+{
+    *stats_out = stats;
+}
+
+void lv_draw_sw_layer_pool_reset_stats(void)
+{
+    stats.simple_hit_cnt = 0;
+    stats.transform_hit_cnt = 0;
+    stats.alloc_cnt = 0;
+    stats.fallback_cnt = 0;
+    stats.fail_cnt = 0;
+    stats.in_use_max = in_use_cnt;
+}
+
+void * _lv_draw_sw_layer_pool_get_simple(uint32_t * size)
+{
+    /*Both render threads can draw layers*/
+    _lv_parallel_lock();
+    reserve_once();
+    void * buf = get_from_pool(0, LV_LAYER_POOL_SIMPLE_CNT, *size);
+    if(buf) {
+        stats.simple_hit_cnt++;
+    }
+    else {
+        buf = alloc_buf(*size);
+        if(buf == NULL) {
+            LV_LOG_WARN("Cannot allocate %"LV_PRIu32" bytes for layer buffer. Allocating %"LV_PRIu32" bytes instead. (Reduced performance)",
+                        *size, (uint32_t)LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE);
+            if(*size > LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE) *size = LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE;
+            buf = alloc_buf(*size);
+            if(buf) stats.fallback_cnt++;
+            else stats.fail_cnt++;
+        }
+    }
+    _lv_parallel_unlock();
+    return buf;
+}
+
+void * _lv_draw_sw_layer_pool_get_transform(uint32_t size)
+{
+    _lv_parallel_lock();
+    reserve_once();
+    void * buf = get_from_pool(LV_LAYER_POOL_SIMPLE_CNT, POOL_CNT, size);
+    if(buf) {
+        stats.transform_hit_cnt++;
+    }
+    else {
+        buf = alloc_buf(size);
+        if(buf == NULL) stats.fail_cnt++;
+    }
+    _lv_parallel_unlock();
+    return buf;
+}
+
+void _lv_draw_sw_layer_pool_put(void * buf)
+{
+    if(buf == NULL) return;
+
+    _lv_parallel_lock();
+    in_use_cnt--;
+#if POOL_CNT > 0
+    uint32_t i;
+    for(i = 0; i < POOL_CNT; i++) {
+        if(pool[i].buf == buf) {
+            pool[i].in_use = false;
+            _lv_parallel_unlock();
+            return;
+        }
+    }
+#endif
+    lv_mem_free(buf);
+    _lv_parallel_unlock();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Take a free buffer of at least `size` bytes from `pool[first..end)`
+ */
+static void * get_from_pool(uint32_t first, uint32_t end, uint32_t size)
+{
+#if POOL_CNT > 0
+    uint32_t i;
+    for(i = first; i < end; i++) {
+        if(pool[i].buf && !pool[i].in_use && pool[i].size >= size) {
+            pool[i].in_use = true;
+            in_use_cnt++;
+            if(in_use_cnt > stats.in_use_max) stats.in_use_max = in_use_cnt;
+            return pool[i].buf;
+        }
+    }
+#else
+    LV_UNUSED(first);
+    LV_UNUSED(end);
+    LV_UNUSED(size);
+#endif
+    return NULL;
+}
+
+/**
+ * Reserve the pool on the first layer, so no memory is taken if no widget needs a layer.
+ * A failed reservation is not retried on each layer, only by `lv_draw_sw_layer_pool_reserve()`.
+ */
+static void reserve_once(void)
+{
+#if POOL_CNT > 0
+    if(reserve_tried) return;
+    lv_draw_sw_layer_pool_reserve();
+#endif
+}
+
+/**
+ * Allocate a layer buffer which is not in the pool
+ */
+static void * alloc_buf(uint32_t size)
+{
+    void * buf = lv_mem_alloc(size);
+    if(buf == NULL) return NULL;
+
+    stats.alloc_cnt++;
+    in_use_cnt++;
+    if(in_use_cnt > stats.in_use_max) stats.in_use_max = in_use_cnt;
+    return buf;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file lv_draw_sw_layer_pool.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_LAYER_POOL_H
+#define LV_DRAW_SW_LAYER_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf_internal.h"
+#include "../../misc/lv_types.h"
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t simple_hit_cnt;    /**< Simple layers which got a buffer of the pool*/
+    uint32_t transform_hit_cnt; /**< Transformed layers which got the transform buffer of the pool*/
+    uint32_t alloc_cnt;         /**< Layers whose buffer was allocated with `lv_mem_alloc`*/
+    uint32_t fallback_cnt;      /**< Simple layers drawn in `LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE` chunks*/
+    uint32_t fail_cnt;          /**< Layers which got no buffer so the widget wasn't drawn*/
+    uint32_t in_use_max;        /**< Most layer buffers used at the same time (the nesting depth)*/
+    uint32_t reserved;          /**< Bytes reserved by the pool now*/
+} lv_draw_sw_layer_pool_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Reserve the buffers of the layer pool: `LV_LAYER_POOL_SIMPLE_CNT` buffers of `LV_LAYER_SIMPLE_BUF_SIZE` bytes
+ * for the widgets with opacity and one of `LV_LAYER_POOL_TRANSFORM_SIZE` bytes for the transformed widgets.
+ * Layers which find no free buffer large enough in the pool are allocated with `lv_mem_alloc`.
+ * The buffers already reserved are kept. If it wasn't called, the first layer reserves the pool.
+ * @return LV_RES_OK: all the buffers are reserved; LV_RES_INV: some couldn't be allocated
+ */
+lv_res_t lv_draw_sw_layer_pool_reserve(void);
+
+/**
+ * Free the buffers of the layer pool. Call it only while no layer is drawn.
+ * The pool stays empty until `lv_draw_sw_layer_pool_reserve()` is called again.
+ */
+void lv_draw_sw_layer_pool_release(void);
+
+/**
+ * Set where the buffers of the pool are allocated, e.g. in an external RAM.
+ * By default `lv_mem_alloc` and `lv_mem_free` are used. The pool is released and reserved again by the next layer.
+ * @param alloc_cb  allocate memory, NULL to restore the default
+ * @param free_cb   free memory allocated by `alloc_cb`
+ */
+void lv_draw_sw_layer_pool_set_mem_cb(void * (*alloc_cb)(size_t size), void (*free_cb)(void * p));
+
+/**
+ * Get the statistics of the layer buffers
+ * @param stats store the statistics here
+ */
+void lv_draw_sw_layer_pool_get_stats(lv_draw_sw_layer_pool_stats_t * stats);
+
+/**
+ * Reset the counters and the max. buffers in use
+ */
+void lv_draw_sw_layer_pool_reset_stats(void);
+
+/**
+ * Get a buffer for the chunks of a simple layer: a free simple buffer of the pool,
+ * else `size` bytes or `LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE` bytes if it failed.
+ * @param size  the bytes to get, at most `LV_LAYER_SIMPLE_BUF_SIZE`, set to the bytes got
+ * @return      the buffer or NULL
+ */
+void * _lv_draw_sw_layer_pool_get_simple(uint32_t * size);
+
+/**
+ * Get a buffer for the whole area of a transformed layer: the transform buffer of the pool if it's free
+ * and large enough, else it's allocated.
+ * @param size  the bytes required
+ * @return      the buffer or NULL
+ */
+void * _lv_draw_sw_layer_pool_get_transform(uint32_t size);
+
+/**
+ * Give back a buffer got by `_lv_draw_sw_layer_pool_get_simple()` or `_lv_draw_sw_layer_pool_get_transform()`
+ * @param buf   the buffer
+ */
+void _lv_draw_sw_layer_pool_put(void * buf);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_LAYER_POOL_H*/
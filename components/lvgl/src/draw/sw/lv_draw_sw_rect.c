@@ -12,6 +12,8 @@
 #include "../../core/lv_refr.h"
 #include "../../misc/lv_assert.h"
 #include "lv_draw_sw_dither.h"
+#include "lv_draw_sw_shadow_cache.h"
+#include "../../misc/lv_parallel.h"
 
 /*********************
  *      DEFINES
@@ -52,11 +54,6 @@ static void draw_border_simple(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer
 /**********************
  *  STATIC VARIABLES
  **********************/
-#if defined(LV_SHADOW_CACHE_SIZE) && LV_SHADOW_CACHE_SIZE > 0
-    static uint8_t sh_cache[LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE];
-    static int32_t sh_cache_size = -1;
-    static int32_t sh_cache_r = -1;
-#endif
 
 /**********************
  *      MACROS
@@ -167,7 +164,9 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
     blend_dsc.opa = LV_OPA_COVER;
 
 
-    /*Get gradient if appropriate*/
+    /*Get gradient if appropriate. The gradient cache is shared by the render threads, so keep it locked while drawing*/
+    bool grad_lock = dsc->bg_grad.dir != LV_GRAD_DIR_NONE;
+    if(grad_lock) _lv_parallel_lock();
     lv_grad_t * grad = lv_gradient_get(&dsc->bg_grad, coords_bg_w, coords_bg_h);
     if(grad && grad_dir == LV_GRAD_DIR_HOR) {
         blend_dsc.src_buf = grad->map + clipped_coords.x1 - bg_coords.x1;
@@ -323,6 +322,7 @@ bg_clean_up:
     if(grad) {
         lv_gradient_cleanup(grad);
     }
+    if(grad_lock) _lv_parallel_unlock();
 
 #endif
 }
@@ -486,23 +486,21 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(lv_draw_ctx_t * draw_ctx, const lv
     lv_opa_t * sh_buf;
 
 #if LV_SHADOW_CACHE_SIZE
-    if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
-        /*Use the cache if available*/
-        sh_buf = lv_mem_buf_get(corner_size * corner_size);
-        lv_memcpy(sh_buf, sh_cache, corner_size * corner_size);
-    }
-    else {
-        /*A larger buffer is required for calculation*/
-        sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
+    /*The far side of the core affects the corner only if it's closer than `corner_size + r_sh`*/
+    lv_draw_sw_shadow_cache_key_t sh_key;
+    sh_key.sw = dsc->shadow_width;
+    sh_key.r = r_sh;
+    sh_key.w = LV_MIN(lv_area_get_width(&core_area), corner_size + r_sh + 1);
+    sh_key.h = LV_MIN(lv_area_get_height(&core_area), corner_size + r_sh + 1);
+
+    /*A larger buffer is required for calculation*/
+    sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
+    _lv_parallel_lock();
+    if(!_lv_draw_sw_shadow_cache_get(&sh_key, sh_buf)) {
         shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
-
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(sh_cache)) {
-            lv_memcpy(sh_cache, sh_buf, corner_size * corner_size);
-            sh_cache_size = corner_size;
-            sh_cache_r = r_sh;
-        }
+        _lv_draw_sw_shadow_cache_add(&sh_key, sh_buf);
     }
+    _lv_parallel_unlock();
 #else
     sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
     shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
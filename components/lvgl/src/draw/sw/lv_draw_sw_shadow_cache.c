@@ -0,0 +1,176 @@
+/**
+ * @file lv_draw_sw_shadow_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+#include "lv_draw_sw_shadow_cache.h"
+#include "../../misc/lv_mem.h"
+#include "../../misc/lv_log.h"
+
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE > 0
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*The entries are stored back to back in one buffer, each corner right after its header*/
+typedef struct {
+    lv_draw_sw_shadow_cache_key_t key;
+    uint32_t size;      /*Bytes of the entry with its header*/
+    uint32_t life;      /*Value of `life_cnt` when the entry was used last time*/
+} shadow_cache_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void free_entry(shadow_cache_entry_t * e);
+static void free_mem(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint8_t * cache_mem;
+static uint32_t budget = LV_SHADOW_CACHE_BUDGET;
+static uint32_t life_cnt;
+static void * (*alloc_cb)(size_t size) = lv_mem_alloc;
+static void (*free_cb)(void * p) = lv_mem_free;
+static lv_draw_sw_shadow_cache_stats_t stats;
+
+/**********************
+ *      MACROS
+ **********************/
+#define ALIGN(X) (((X) + 3) & ~3)
+#define CORNER_BYTES(key) ((uint32_t)((key)->sw + (key)->r) * ((key)->sw + (key)->r))
+#define ENTRY_DATA(e) ((lv_opa_t *)(e) + sizeof(shadow_cache_entry_t))
+#define ENTRY_NEXT(e) ((shadow_cache_entry_t *)((uint8_t *)(e) + (e)->size))
+#define CACHE_END ((shadow_cache_entry_t *)(cache_mem + stats.used))
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_sw_shadow_cache_set_budget(uint32_t max_bytes)
+{
+    free_mem();
+    budget = max_bytes;
+}
+
+void lv_draw_sw_shadow_cache_set_mem_cb(void * (*new_alloc_cb)(size_t size), void (*new_free_cb)(void * p))
+{
+    free_mem();
+    if(new_alloc_cb == NULL || new_free_cb == NULL) {
+        alloc_cb = lv_mem_alloc;
+        free_cb = lv_mem_free;
+    }
+    else {
+        alloc_cb = new_alloc_cb;
+        free_cb = new_free_cb;
+    }
+}
+
+void lv_draw_sw_shadow_cache_clear(void)
+{
+    free_mem();
+}
+
+void lv_draw_sw_shadow_cache_get_stats(lv_draw_sw_shadow_cache_stats_t * stats_out)
+{
+    *stats_out = stats;
+    stats_out->budget = budget;
+}
+
+void lv_draw_sw_shadow_cache_reset_stats(void)
+{
+    stats.hit_cnt = 0;
+    stats.miss_cnt = 0;
+    stats.evict_cnt = 0;
+    stats.skip_cnt = 0;
+}
+
+bool _lv_draw_sw_shadow_cache_get(const lv_draw_sw_shadow_cache_key_t * key, lv_opa_t * buf)
+{
+    shadow_cache_entry_t * e;
+    for(e = (shadow_cache_entry_t *)cache_mem; e != CACHE_END; e = ENTRY_NEXT(e)) {
+        if(e->key.sw == key->sw && e->key.r == key->r && e->key.w == key->w && e->key.h == key->h) {
+            life_cnt++;
+            e->life = life_cnt;
+            lv_memcpy(buf, ENTRY_DATA(e), CORNER_BYTES(key));
+            stats.hit_cnt++;
+            return true;
+        }
+    }
+
+    stats.miss_cnt++;
+    return false;
+}
+
+void _lv_draw_sw_shadow_cache_add(const lv_draw_sw_shadow_cache_key_t * key, const lv_opa_t * buf)
+{
+    uint32_t size = ALIGN(sizeof(shadow_cache_entry_t) + CORNER_BYTES(key));
+    if(key->sw + key->r > LV_SHADOW_CACHE_SIZE || size > budget) {
+        stats.skip_cnt++;
+        return;
+    }
+
+    /*Allocate the whole budget at once to not fragment the heap with entries of every size*/
+    if(cache_mem == NULL) {
+        cache_mem = alloc_cb(budget);
+        if(cache_mem == NULL) {
+            LV_LOG_WARN("couldn't allocate %d bytes for the shadow cache", (int)budget);
+            stats.skip_cnt++;
+            return;
+        }
+    }
+
+    /*Drop the least recently used entries until the new one fits*/
+    while(stats.used + size > budget) {
+        shadow_cache_entry_t * e;
+        shadow_cache_entry_t * lru = (shadow_cache_entry_t *)cache_mem;
+        for(e = lru; e != CACHE_END; e = ENTRY_NEXT(e)) {
+            if(e->life < lru->life) lru = e;
+        }
+        free_entry(lru);
+        stats.evict_cnt++;
+    }
+
+    shadow_cache_entry_t * e = CACHE_END;
+    e->key = *key;
+    e->size = size;
+    life_cnt++;
+    e->life = life_cnt;
+    lv_memcpy(ENTRY_DATA(e), buf, CORNER_BYTES(key));
+    stats.entry_cnt++;
+    stats.used += size;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*Remove an entry and move the next ones in its place*/
+static void free_entry(shadow_cache_entry_t * e)
+{
+    uint32_t size = e->size;
+    size_t next_entries_size = (size_t)((uint8_t *)CACHE_END - (uint8_t *)e) - size;
+    if(next_entries_size) memmove(e, (uint8_t *)e + size, next_entries_size);
+    stats.used -= size;
+    stats.entry_cnt--;
+}
+
+static void free_mem(void)
+{
+    if(cache_mem) free_cb(cache_mem);
+    cache_mem = NULL;
+    stats.used = 0;
+    stats.entry_cnt = 0;
+}
+
+#endif /*LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE > 0*/
@@ -0,0 +1,108 @@
+/**
+ * @file lv_draw_sw_shadow_cache.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_SHADOW_CACHE_H
+#define LV_DRAW_SW_SHADOW_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../misc/lv_area.h"
+#include "../../misc/lv_color.h"
+
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE > 0
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** The parameters which determine the blurred corner of a shadow*/
+typedef struct {
+    lv_coord_t sw;      /**< Shadow width (blur)*/
+    lv_coord_t r;       /**< Clamped radius of the shadow's core*/
+    lv_coord_t w;       /**< Width of the core (shape size + 2 * spread), clamped to what affects the corner*/
+    lv_coord_t h;       /**< Height of the core, clamped the same way*/
+} lv_draw_sw_shadow_cache_key_t;
+
+typedef struct {
+    uint32_t hit_cnt;       /**< Corners found in the cache*/
+    uint32_t miss_cnt;      /**< Corners which had to be calculated*/
+    uint32_t evict_cnt;     /**< Entries dropped to make room for a new one*/
+    uint32_t skip_cnt;      /**< Calculated corners which were too large to cache or had no buffer*/
+    uint32_t entry_cnt;     /**< Entries in the cache now*/
+    uint32_t used;          /**< Bytes used by the entries now*/
+    uint32_t budget;        /**< Max. bytes the entries can use*/
+} lv_draw_sw_shadow_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Set the size of the buffer of the cached shadow corners. The least recently used corners are dropped
+ * if a new one doesn't fit. The default is `LV_SHADOW_CACHE_BUDGET`. The cache is cleared.
+ * @param max_bytes the budget in bytes, 0 disables caching
+ */
+void lv_draw_sw_shadow_cache_set_budget(uint32_t max_bytes);
+
+/**
+ * Set where the buffer of the cached corners is allocated, e.g. in an external RAM.
+ * The whole budget is allocated when the first corner is cached.
+ * By default `lv_mem_alloc` and `lv_mem_free` are used. The cache is cleared.
+ * @param alloc_cb  allocate memory, NULL to restore the default
+ * @param free_cb   free memory allocated by `alloc_cb`
+ */
+void lv_draw_sw_shadow_cache_set_mem_cb(void * (*alloc_cb)(size_t size), void (*free_cb)(void * p));
+
+/**
+ * Drop all the cached shadow corners and free their buffer
+ */
+void lv_draw_sw_shadow_cache_clear(void);
+
+/**
+ * Get the statistics of the shadow cache
+ * @param stats store the statistics here
+ */
+void lv_draw_sw_shadow_cache_get_stats(lv_draw_sw_shadow_cache_stats_t * stats);
+
+/**
+ * Reset the hit, miss, evict and skip counters
+ */
+void lv_draw_sw_shadow_cache_reset_stats(void);
+
+/**
+ * Copy a cached corner and mark it as the most recently used.
+ * @param key   parameters of the corner
+ * @param buf   copy the `(key->sw + key->r)^2` opacity values here
+ * @return      true: the corner was cached and copied; false: it's not in the cache
+ */
+bool _lv_draw_sw_shadow_cache_get(const lv_draw_sw_shadow_cache_key_t * key, lv_opa_t * buf);
+
+/**
+ * Save a calculated corner, dropping the least recently used ones if required.
+ * @param key   parameters of the corner
+ * @param buf   the `(key->sw + key->r)^2` opacity values of the corner
+ */
+void _lv_draw_sw_shadow_cache_add(const lv_draw_sw_shadow_cache_key_t * key, const lv_opa_t * buf);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE > 0*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_SHADOW_CACHE_H*/
@@ -22,6 +22,7 @@ extern "C" {
 #include "list/lv_list.h"
 #include "menu/lv_menu.h"
 #include "msgbox/lv_msgbox.h"
+#include "numlabel/lv_numlabel.h"
 #include "meter/lv_meter.h"
 #include "spinbox/lv_spinbox.h"
 #include "spinner/lv_spinner.h"
@@ -0,0 +1,420 @@
+/**
+ * @file lv_numlabel.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_numlabel.h"
+#if LV_USE_NUMLABEL
+
+#include "../../../misc/lv_assert.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MY_CLASS &lv_numlabel_class
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void lv_numlabel_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_numlabel_event(const lv_obj_class_t * class_p, lv_event_t * e);
+static void draw_main(lv_event_t * e);
+static void measure_cells(lv_obj_t * obj);
+static void format_cells(lv_numlabel_t * numlabel, char * cells);
+static void invalidate_changed_cells(lv_obj_t * obj, const char * cells);
+static uint32_t get_cell_cnt(const lv_numlabel_t * numlabel);
+static lv_coord_t get_cell_w(const lv_numlabel_t * numlabel, uint32_t i);
+static lv_coord_t get_cells_x(lv_obj_t * obj, const lv_area_t * content, lv_coord_t letter_space);
+static int32_t get_max_value(const lv_numlabel_t * numlabel);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+const lv_obj_class_t lv_numlabel_class  = {
+    .base_class = &lv_obj_class,
+    .constructor_cb = lv_numlabel_constructor,
+    .event_cb = lv_numlabel_event,
+    .width_def = LV_SIZE_CONTENT,
+    .height_def = LV_SIZE_CONTENT,
+    .instance_size = sizeof(lv_numlabel_t),
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_obj_t * lv_numlabel_create(lv_obj_t * parent)
+{
+    LV_LOG_INFO("begin");
+    lv_obj_t * obj = lv_obj_class_create_obj(MY_CLASS, parent);
+    lv_obj_class_init_obj(obj);
+    return obj;
+}
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+void lv_numlabel_set_value(lv_obj_t * obj, int32_t value)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    int32_t max = get_max_value(numlabel);
+    value = LV_CLAMP(numlabel->sign ? -max : 0, value, max);
+    if(numlabel->value == value) return;
+    numlabel->value = value;
+
+    /*The cells have fixed width so only the changed ones need to be redrawn*/
+    char cells[LV_NUMLABEL_MAX_CELL_COUNT];
+    format_cells(numlabel, cells);
+    invalidate_changed_cells(obj, cells);
+}
+
+void lv_numlabel_set_format(lv_obj_t * obj, uint8_t digit_count, uint8_t decimals)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    digit_count = LV_CLAMP(1, digit_count, LV_NUMLABEL_MAX_DIGIT_COUNT);
+    /*Keep at least one digit before the decimal point*/
+    if(decimals >= digit_count) decimals = digit_count - 1;
+
+    numlabel->digit_count = digit_count;
+    numlabel->decimals = decimals;
+
+    int32_t max = get_max_value(numlabel);
+    numlabel->value = LV_CLAMP(numlabel->sign ? -max : 0, numlabel->value, max);
+    format_cells(numlabel, numlabel->cells);
+
+    lv_obj_refresh_self_size(obj);
+    lv_obj_invalidate(obj);
+}
+
+void lv_numlabel_set_signed(lv_obj_t * obj, bool en)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    if(numlabel->sign == en) return;
+    numlabel->sign = en ? 1 : 0;
+    if(!en && numlabel->value < 0) numlabel->value = 0;
+    format_cells(numlabel, numlabel->cells);
+
+    lv_obj_refresh_self_size(obj);
+    lv_obj_invalidate(obj);
+}
+
+void lv_numlabel_set_leading_zeros(lv_obj_t * obj, bool en)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    if(numlabel->leading_zeros == en) return;
+    numlabel->leading_zeros = en ? 1 : 0;
+
+    char cells[LV_NUMLABEL_MAX_CELL_COUNT];
+    format_cells(numlabel, cells);
+    invalidate_changed_cells(obj, cells);
+}
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+int32_t lv_numlabel_get_value(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    return numlabel->value;
+}
+
+uint8_t lv_numlabel_get_digit_count(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    return numlabel->digit_count;
+}
+
+uint8_t lv_numlabel_get_decimals(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    return numlabel->decimals;
+}
+
+void lv_numlabel_get_text(const lv_obj_t * obj, char * buf)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    uint32_t cell_cnt = get_cell_cnt(numlabel);
+    uint32_t i;
+    for(i = 0; i < cell_cnt; i++) {
+        if(numlabel->cells[i] != ' ') *buf++ = numlabel->cells[i];
+    }
+    *buf = '\0';
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void lv_numlabel_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    LV_TRACE_OBJ_CREATE("begin");
+
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    numlabel->value = 0;
+    numlabel->digit_count = 4;
+    numlabel->decimals = 0;
+    numlabel->sign = 0;
+    numlabel->leading_zeros = 0;
+    format_cells(numlabel, numlabel->cells);
+
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+
+    LV_TRACE_OBJ_CREATE("finished");
+}
+
+static void lv_numlabel_event(const lv_obj_class_t * class_p, lv_event_t * e)
+{
+    LV_UNUSED(class_p);
+
+    lv_res_t res;
+
+    /*Call the ancestor's event handler*/
+    res = lv_obj_event_base(MY_CLASS, e);
+    if(res != LV_RES_OK) return;
+
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t * obj = lv_event_get_target(e);
+
+    if(code == LV_EVENT_STYLE_CHANGED) {
+        /*The font might have changed*/
+        measure_cells(obj);
+        lv_obj_refresh_self_size(obj);
+        lv_obj_refresh_ext_draw_size(obj);
+        lv_obj_invalidate(obj);
+    }
+    else if(code == LV_EVENT_REFR_EXT_DRAW_SIZE) {
+        lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+        lv_event_set_ext_draw_size(e, numlabel->overhang);
+    }
+    else if(code == LV_EVENT_GET_SELF_SIZE) {
+        lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+        const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+        lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+        uint32_t cell_cnt = get_cell_cnt(numlabel);
+        lv_coord_t w = letter_space * (lv_coord_t)(cell_cnt - 1);
+        uint32_t i;
+        for(i = 0; i < cell_cnt; i++) w += get_cell_w(numlabel, i);
+
+        lv_point_t * self_size = lv_event_get_param(e);
+        self_size->x = LV_MAX(self_size->x, w);
+        self_size->y = LV_MAX(self_size->y, lv_font_get_line_height(font));
+    }
+    else if(code == LV_EVENT_DRAW_MAIN) {
+        draw_main(e);
+    }
+}
+
+static void draw_main(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
+
+    lv_draw_label_dsc_t label_draw_dsc;
+    lv_draw_label_dsc_init(&label_draw_dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_draw_dsc);
+    if(label_draw_dsc.opa <= LV_OPA_MIN) return;
+
+    lv_area_t content;
+    lv_obj_get_content_coords(obj, &content);
+
+    lv_point_t pos;
+    pos.y = content.y1;
+    lv_coord_t x = get_cells_x(obj, &content, label_draw_dsc.letter_space);
+    lv_coord_t line_h = lv_font_get_line_height(label_draw_dsc.font);
+    if(pos.y > draw_ctx->clip_area->y2 || pos.y + line_h - 1 < draw_ctx->clip_area->y1) return;
+
+    /*Only the cells in the clip area, usually the changed ones, are drawn*/
+    uint32_t cell_cnt = get_cell_cnt(numlabel);
+    uint32_t i;
+    for(i = 0; i < cell_cnt; i++) {
+        lv_coord_t cell_w = get_cell_w(numlabel, i);
+        char c = numlabel->cells[i];
+        if(c != ' ' &&
+           x - numlabel->overhang <= draw_ctx->clip_area->x2 &&
+           x + cell_w - 1 + numlabel->overhang >= draw_ctx->clip_area->x1) {
+            /*Center the glyph in the cell to keep the digits in place*/
+            lv_coord_t letter_w = lv_font_get_glyph_width(label_draw_dsc.font, c, '\0');
+            pos.x = x + (cell_w - letter_w) / 2;
+            lv_draw_letter(draw_ctx, &label_draw_dsc, &pos, c);
+        }
+        x += cell_w + label_draw_dsc.letter_space;
+    }
+}
+
+/**
+ * Get the advance of the cells and how far the glyphs can stick out of them with the current font
+ */
+static void measure_cells(lv_obj_t * obj)
+{
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    static const char chars[] = "0123456789-.";
+
+    numlabel->digit_w = 0;
+    numlabel->overhang = 0;
+    uint32_t i;
+    for(i = 0; chars[i] != '\0'; i++) {
+        lv_font_glyph_dsc_t g;
+        if(!lv_font_get_glyph_dsc(font, &g, chars[i], '\0')) continue;
+        if(chars[i] >= '0' && chars[i] <= '9') numlabel->digit_w = LV_MAX(numlabel->digit_w, (lv_coord_t)g.adv_w);
+        numlabel->overhang = LV_MAX(numlabel->overhang, -g.ofs_x);
+        numlabel->overhang = LV_MAX(numlabel->overhang, g.ofs_x + g.box_w - (lv_coord_t)g.adv_w);
+    }
+
+    numlabel->sign_w = lv_font_get_glyph_width(font, '-', '\0');
+    numlabel->point_w = lv_font_get_glyph_width(font, '.', '\0');
+
+    /*The sign is centered in a digit cell if there are empty leading digits*/
+    if(numlabel->sign_w > numlabel->digit_w) {
+        numlabel->overhang += (numlabel->sign_w - numlabel->digit_w + 1) / 2;
+    }
+}
+
+/**
+ * Convert the value to characters, one per cell, ' ' for the empty cells
+ */
+static void format_cells(lv_numlabel_t * numlabel, char * cells)
+{
+    uint32_t cell_cnt = get_cell_cnt(numlabel);
+    uint32_t abs_value = numlabel->value < 0 ? (uint32_t)(-numlabel->value) : (uint32_t)numlabel->value;
+
+    /*Digits from right to left*/
+    int32_t i = cell_cnt - 1;
+    uint32_t d;
+    for(d = 0; d < numlabel->digit_count; d++) {
+        if(numlabel->decimals && d == numlabel->decimals) {
+            cells[i] = '.';
+            i--;
+        }
+        cells[i] = (char)('0' + abs_value % 10);
+        abs_value /= 10;
+        i--;
+    }
+    if(numlabel->sign) cells[0] = ' ';
+
+    /*Clear the leading zeros but keep the last digit before the decimal point*/
+    int32_t first = numlabel->sign;
+    int32_t last_int = numlabel->sign + numlabel->digit_count - numlabel->decimals - 1;
+    if(!numlabel->leading_zeros) {
+        while(first < last_int && cells[first] == '0') {
+            cells[first] = ' ';
+            first++;
+        }
+    }
+
+    /*The sign is right before the first shown digit*/
+    if(numlabel->value < 0) cells[first - 1] = '-';
+}
+
+/**
+ * Invalidate the cells which differ from the new ones and store the new cells.
+ * Neighboring changed cells are invalidated as one area.
+ */
+static void invalidate_changed_cells(lv_obj_t * obj, const char * cells)
+{
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+
+    lv_area_t content;
+    lv_obj_get_content_coords(obj, &content);
+
+    lv_area_t inv_area;
+    inv_area.y1 = content.y1;
+    inv_area.y2 = content.y1 + lv_font_get_line_height(font) - 1;
+
+    lv_coord_t x = get_cells_x(obj, &content, letter_space);
+    bool in_run = false;
+    uint32_t cell_cnt = get_cell_cnt(numlabel);
+    uint32_t i;
+    for(i = 0; i < cell_cnt; i++) {
+        lv_coord_t cell_w = get_cell_w(numlabel, i);
+        if(cells[i] != numlabel->cells[i]) {
+            if(!in_run) inv_area.x1 = x - numlabel->overhang;
+            inv_area.x2 = x + cell_w - 1 + numlabel->overhang;
+            in_run = true;
+            numlabel->cells[i] = cells[i];
+        }
+        else if(in_run) {
+            lv_obj_invalidate_area(obj, &inv_area);
+            in_run = false;
+        }
+        x += cell_w + letter_space;
+    }
+
+    if(in_run) lv_obj_invalidate_area(obj, &inv_area);
+}
+
+static uint32_t get_cell_cnt(const lv_numlabel_t * numlabel)
+{
+    return numlabel->sign + numlabel->digit_count + (numlabel->decimals ? 1 : 0);
+}
+
+static lv_coord_t get_cell_w(const lv_numlabel_t * numlabel, uint32_t i)
+{
+    if(numlabel->sign && i == 0) return numlabel->sign_w;
+    if(numlabel->decimals && i == (uint32_t)numlabel->sign + numlabel->digit_count - numlabel->decimals) {
+        return numlabel->point_w;
+    }
+    return numlabel->digit_w;
+}
+
+/**
+ * Get the left side of the first cell according to the text align
+ */
+static lv_coord_t get_cells_x(lv_obj_t * obj, const lv_area_t * content, lv_coord_t letter_space)
+{
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    lv_text_align_t align = lv_obj_get_style_text_align(obj, LV_PART_MAIN);
+    if(align != LV_TEXT_ALIGN_CENTER && align != LV_TEXT_ALIGN_RIGHT) return content->x1;
+
+    uint32_t cell_cnt = get_cell_cnt(numlabel);
+    lv_coord_t w = letter_space * (lv_coord_t)(cell_cnt - 1);
+    uint32_t i;
+    for(i = 0; i < cell_cnt; i++) w += get_cell_w(numlabel, i);
+
+    if(align == LV_TEXT_ALIGN_CENTER) return content->x1 + (lv_area_get_width(content) - w) / 2;
+    else return content->x2 - w + 1;
+}
+
+static int32_t get_max_value(const lv_numlabel_t * numlabel)
+{
+    int32_t max = 0;
+    uint32_t i;
+    for(i = 0; i < numlabel->digit_count; i++) {
+        if(max > (INT32_MAX - 9) / 10) return INT32_MAX;
+        max = max * 10 + 9;
+    }
+    return max;
+}
+
+#endif /*LV_USE_NUMLABEL*/
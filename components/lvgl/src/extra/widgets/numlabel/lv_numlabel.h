@@ -0,0 +1,138 @@
+/**
+ * @file lv_numlabel.h
+ *
+ */
+
+#ifndef LV_NUMLABEL_H
+#define LV_NUMLABEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+
+#if LV_USE_NUMLABEL
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_NUMLABEL_MAX_DIGIT_COUNT 10
+
+/*Sign, digits and decimal point*/
+#define LV_NUMLABEL_MAX_CELL_COUNT (LV_NUMLABEL_MAX_DIGIT_COUNT + 2)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Data of numeric label*/
+typedef struct {
+    lv_obj_t obj;
+    int32_t value;
+    uint8_t digit_count : 4;        /**< Digits including the decimals*/
+    uint8_t decimals : 4;           /**< Digits after the decimal point, 0: integer*/
+    uint8_t sign : 1;               /**< Reserve a cell for '-'*/
+    uint8_t leading_zeros : 1;      /**< Show the leading zeros instead of leaving their cells empty*/
+    char cells[LV_NUMLABEL_MAX_CELL_COUNT];  /**< The shown characters, ' ': empty cell*/
+    lv_coord_t digit_w;             /**< Advance of every digit cell, the widest of '0'..'9'*/
+    lv_coord_t sign_w;              /**< Advance of the sign cell*/
+    lv_coord_t point_w;             /**< Advance of the decimal point cell*/
+    lv_coord_t overhang;            /**< How far a glyph can be drawn out of its cell*/
+} lv_numlabel_t;
+
+extern const lv_obj_class_t lv_numlabel_class;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a numeric label object. It shows a fixed-point number in cells of fixed width,
+ * so only the changed digits are redrawn when the value changes.
+ * @param parent pointer to an object, it will be the parent of the new numeric label
+ * @return pointer to the created numeric label
+ */
+lv_obj_t * lv_numlabel_create(lv_obj_t * parent);
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+/**
+ * Set the value of a numeric label
+ * @param obj       pointer to a numeric label
+ * @param value     the number in units of the last decimal, e.g. 235 is shown as "23.5" with 1 decimal.
+ *                  It's clamped to the range which fits in the digits.
+ */
+void lv_numlabel_set_value(lv_obj_t * obj, int32_t value);
+
+/**
+ * Set the number of digits of a numeric label
+ * @param obj           pointer to a numeric label
+ * @param digit_count   number of digits including the decimals, 1..LV_NUMLABEL_MAX_DIGIT_COUNT
+ * @param decimals      number of digits after the decimal point, 0 for integers
+ */
+void lv_numlabel_set_format(lv_obj_t * obj, uint8_t digit_count, uint8_t decimals);
+
+/**
+ * Allow negative values. A cell is reserved for the '-' sign.
+ * @param obj       pointer to a numeric label
+ * @param en        true: allow negative values; false: clamp the value to 0
+ */
+void lv_numlabel_set_signed(lv_obj_t * obj, bool en);
+
+/**
+ * Show the leading zeros of a numeric label, e.g. "007.5" instead of "  7.5"
+ * @param obj       pointer to a numeric label
+ * @param en        true: show the leading zeros; false: leave their cells empty
+ */
+void lv_numlabel_set_leading_zeros(lv_obj_t * obj, bool en);
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+/**
+ * Get the value of a numeric label
+ * @param obj       pointer to a numeric label
+ * @return          the value in units of the last decimal
+ */
+int32_t lv_numlabel_get_value(const lv_obj_t * obj);
+
+/**
+ * Get the number of digits of a numeric label
+ * @param obj       pointer to a numeric label
+ * @return          number of digits including the decimals
+ */
+uint8_t lv_numlabel_get_digit_count(const lv_obj_t * obj);
+
+/**
+ * Get the number of decimals of a numeric label
+ * @param obj       pointer to a numeric label
+ * @return          number of digits after the decimal point
+ */
+uint8_t lv_numlabel_get_decimals(const lv_obj_t * obj);
+
+/**
+ * Get the shown text of a numeric label
+ * @param obj       pointer to a numeric label
+ * @param buf       buffer of at least `LV_NUMLABEL_MAX_CELL_COUNT + 1` bytes, the text is written here
+ *                  without the empty cells
+ */
+void lv_numlabel_get_text(const lv_obj_t * obj, char * buf);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_NUMLABEL*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_NUMLABEL_H*/
@@ -11,6 +11,7 @@
 #include "../misc/lv_utils.h"
 #include "../misc/lv_log.h"
 #include "../misc/lv_assert.h"
+#include "../misc/lv_parallel.h"
 
 /*********************
  *      DEFINES
@@ -23,6 +24,8 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static bool get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                          uint32_t letter_next);
 
 /**********************
  *  STATIC VARIABLES
@@ -49,7 +52,10 @@
 const uint8_t * lv_font_get_glyph_bitmap(const lv_font_t * font_p, uint32_t letter)
 {
     LV_ASSERT_NULL(font_p);
-    return font_p->get_glyph_bitmap(font_p, letter);
+    _lv_parallel_lock();
+    const uint8_t * bitmap = font_p->get_glyph_bitmap(font_p, letter);
+    _lv_parallel_unlock();
+    return bitmap;
 }
 
 /**
@@ -64,7 +70,35 @@ const uint8_t * lv_font_get_glyph_bitmap(const lv_font_t * font_p, uint32_t lett
 bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
                            uint32_t letter_next)
 {
+    /*The font engines can use shared caches*/
+    _lv_parallel_lock();
+    bool found = get_glyph_dsc(font_p, dsc_out, letter, letter_next);
+    _lv_parallel_unlock();
+    return found;
+}
+
+/**
+ * Get the width of a glyph with kerning
+ * @param font pointer to a font
+ * @param letter a UNICODE letter
+ * @param letter_next the next letter after `letter`. Used for kerning
+ * @return the width of the glyph
+ */
+uint16_t lv_font_get_glyph_width(const lv_font_t * font, uint32_t letter, uint32_t letter_next)
+{
+    LV_ASSERT_NULL(font);
+    lv_font_glyph_dsc_t g;
+    lv_font_get_glyph_dsc(font, &g, letter, letter_next);
+    return g.adv_w;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
 
+static bool get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                          uint32_t letter_next)
+{
     LV_ASSERT_NULL(font_p);
     LV_ASSERT_NULL(dsc_out);
 
@@ -125,22 +159,3 @@ bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_o
 
     return false;
 }
-
-/**
- * Get the width of a glyph with kerning
- * @param font pointer to a font
- * @param letter a UNICODE letter
- * @param letter_next the next letter after `letter`. Used for kerning
- * @return the width of the glyph
- */
-uint16_t lv_font_get_glyph_width(const lv_font_t * font, uint32_t letter, uint32_t letter_next)
-{
-    LV_ASSERT_NULL(font);
-    lv_font_glyph_dsc_t g;
-    lv_font_get_glyph_dsc(font, &g, letter, letter_next);
-    return g.adv_w;
-}
-
-/**********************
- *   STATIC FUNCTIONS
- **********************/
@@ -1,4 +1,5 @@
 CSRCS += lv_font.c
+CSRCS += lv_font_cache.c
 CSRCS += lv_font_fmt_txt.c
 CSRCS += lv_font_loader.c
 
@@ -0,0 +1,252 @@
+/**
+ * @file lv_font_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+#include "lv_font_cache.h"
+#include "../misc/lv_mem.h"
+#include "../misc/lv_log.h"
+
+#if LV_FONT_CACHE_BUDGET > 0
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Slots of the hash index, a power of 2. It's kept at most 3/4 full.*/
+#define INDEX_SIZE  256
+#define MAX_ENTRIES (INDEX_SIZE * 3 / 4)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*The entries are stored back to back in one buffer, each bitmap right after its header*/
+typedef struct {
+    const lv_font_t * font;
+    uint32_t letter;
+    uint32_t gid;
+    uint32_t size;      /*Bytes of the entry with its header*/
+    uint32_t life;      /*Value of `life_cnt` when the entry was used last time*/
+} font_cache_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static font_cache_entry_t * find_entry(const lv_font_t * font, uint32_t letter);
+static void index_add(font_cache_entry_t * e);
+static void index_rebuild(void);
+static void free_entry(font_cache_entry_t * e);
+static void free_mem(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint8_t * cache_mem;
+static void * (*alloc_cb)(size_t size) = lv_mem_alloc;
+static void (*free_cb)(void * p) = lv_mem_free;
+static uint32_t budget = LV_FONT_CACHE_BUDGET;
+static uint32_t life_cnt;
+static lv_font_cache_stats_t stats;
+static uint32_t slots[INDEX_SIZE];     /*Offset of the entries in `cache_mem` + 1, 0: empty slot*/
+
+/**********************
+ *      MACROS
+ **********************/
+#define ALIGN(X) (((X) + 3) & ~3)
+#define ENTRY_SIZE(a8_size) ALIGN(sizeof(font_cache_entry_t) + (a8_size))
+#define ENTRY_DATA(e) ((uint8_t *)(e) + sizeof(font_cache_entry_t))
+#define ENTRY_NEXT(e) ((font_cache_entry_t *)((uint8_t *)(e) + (e)->size))
+#define CACHE_END ((font_cache_entry_t *)(cache_mem + stats.used))
+#define HASH(font, letter) ((((uint32_t)(uintptr_t)(font) >> 2) ^ ((letter) * 2654435761U)) & (INDEX_SIZE - 1))
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_font_cache_set_budget(uint32_t max_bytes)
+{
+    free_mem();
+    budget = max_bytes;
+}
+
+void lv_font_cache_set_mem_cb(void * (*new_alloc_cb)(size_t size), void (*new_free_cb)(void * p))
+{
+    free_mem();
+    if(new_alloc_cb == NULL || new_free_cb == NULL) {
+        alloc_cb = lv_mem_alloc;
+        free_cb = lv_mem_free;
+    }
+    else {
+        alloc_cb = new_alloc_cb;
+        free_cb = new_free_cb;
+    }
+}
+
+void lv_font_cache_clear(void)
+{
+    free_mem();
+}
+
+void lv_font_cache_get_stats(lv_font_cache_stats_t * stats_out)
+{
+    *stats_out = stats;
+    stats_out->budget = budget;
+}
+
+void lv_font_cache_reset_stats(void)
+{
+    stats.hit_cnt = 0;
+    stats.miss_cnt = 0;
+    stats.evict_cnt = 0;
+    stats.skip_cnt = 0;
+}
+
+void _lv_font_cache_remove_font(const lv_font_t * font)
+{
+    if(cache_mem == NULL) return;
+
+    font_cache_entry_t * e = (font_cache_entry_t *)cache_mem;
+    while(e != CACHE_END) {
+        /*The next entry is moved in the place of the freed one*/
+        if(e->font == font) free_entry(e);
+        else e = ENTRY_NEXT(e);
+    }
+    index_rebuild();
+}
+
+bool _lv_font_cache_fits(uint32_t a8_size)
+{
+    return a8_size > 0 && ENTRY_SIZE(a8_size) <= budget;
+}
+
+bool _lv_font_cache_reserve(void)
+{
+    if(cache_mem) return true;
+
+    /*Allocate the whole budget at once to not fragment the heap with glyphs of every size*/
+    cache_mem = alloc_cb(budget);
+    if(cache_mem == NULL) {
+        LV_LOG_WARN("couldn't allocate %d bytes for the glyph cache", (int)budget);
+        return false;
+    }
+    return true;
+}
+
+uint32_t _lv_font_cache_get_gid(const lv_font_t * font, uint32_t letter)
+{
+    font_cache_entry_t * e = find_entry(font, letter);
+    return e ? e->gid : 0;
+}
+
+const uint8_t * _lv_font_cache_get_bitmap(const lv_font_t * font, uint32_t letter)
+{
+    font_cache_entry_t * e = find_entry(font, letter);
+    if(e == NULL) {
+        stats.miss_cnt++;
+        return NULL;
+    }
+
+    stats.hit_cnt++;
+    return ENTRY_DATA(e);
+}
+
+uint8_t * _lv_font_cache_add(const lv_font_t * font, uint32_t letter, uint32_t gid, uint32_t a8_size)
+{
+    if(!_lv_font_cache_fits(a8_size) || cache_mem == NULL) {
+        stats.skip_cnt++;
+        return NULL;
+    }
+
+    /*Drop the least recently used entries until the new one fits*/
+    uint32_t size = ENTRY_SIZE(a8_size);
+    if(stats.used + size > budget || stats.entry_cnt >= MAX_ENTRIES) {
+        while(stats.used + size > budget || stats.entry_cnt >= MAX_ENTRIES) {
+            font_cache_entry_t * e;
+            font_cache_entry_t * lru = (font_cache_entry_t *)cache_mem;
+            for(e = lru; e != CACHE_END; e = ENTRY_NEXT(e)) {
+                if(e->life < lru->life) lru = e;
+            }
+            free_entry(lru);
+            stats.evict_cnt++;
+        }
+        /*The entries were moved*/
+        index_rebuild();
+    }
+
+    font_cache_entry_t * e = CACHE_END;
+    e->font = font;
+    e->letter = letter;
+    e->gid = gid;
+    e->size = size;
+    life_cnt++;
+    e->life = life_cnt;
+    stats.entry_cnt++;
+    stats.used += size;
+    index_add(e);
+    return ENTRY_DATA(e);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static font_cache_entry_t * find_entry(const lv_font_t * font, uint32_t letter)
+{
+    if(cache_mem == NULL) return NULL;
+
+    uint32_t i = HASH(font, letter);
+    while(slots[i]) {
+        font_cache_entry_t * e = (font_cache_entry_t *)(cache_mem + slots[i] - 1);
+        if(e->letter == letter && e->font == font) {
+            life_cnt++;
+            e->life = life_cnt;
+            return e;
+        }
+        i = (i + 1) & (INDEX_SIZE - 1);
+    }
+
+    return NULL;
+}
+
+static void index_add(font_cache_entry_t * e)
+{
+    uint32_t i = HASH(e->font, e->letter);
+    while(slots[i]) i = (i + 1) & (INDEX_SIZE - 1);
+    slots[i] = (uint32_t)((uint8_t *)e - cache_mem) + 1;
+}
+
+static void index_rebuild(void)
+{
+    lv_memset_00(slots, sizeof(slots));
+    if(cache_mem == NULL) return;
+
+    font_cache_entry_t * e;
+    for(e = (font_cache_entry_t *)cache_mem; e != CACHE_END; e = ENTRY_NEXT(e)) {
+        index_add(e);
+    }
+}
+
+/*Remove an entry and move the next ones in its place*/
+static void free_entry(font_cache_entry_t * e)
+{
+    uint32_t size = e->size;
+    size_t next_entries_size = (size_t)((uint8_t *)CACHE_END - (uint8_t *)e) - size;
+    if(next_entries_size) memmove(e, (uint8_t *)e + size, next_entries_size);
+    stats.used -= size;
+    stats.entry_cnt--;
+}
+
+static void free_mem(void)
+{
+    if(cache_mem) free_cb(cache_mem);
+    cache_mem = NULL;
+    stats.used = 0;
+    stats.entry_cnt = 0;
+    lv_memset_00(slots, sizeof(slots));
+}
+
+#endif /*LV_FONT_CACHE_BUDGET > 0*/
@@ -0,0 +1,131 @@
+/**
+ * @file lv_font_cache.h
+ *
+ */
+
+#ifndef LV_FONT_CACHE_H
+#define LV_FONT_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_font.h"
+
+#if LV_FONT_CACHE_BUDGET > 0
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t hit_cnt;       /**< Glyph bitmaps found in the cache*/
+    uint32_t miss_cnt;      /**< Glyph bitmaps which had to be unpacked*/
+    uint32_t evict_cnt;     /**< Glyphs dropped to make room for a new one*/
+    uint32_t skip_cnt;      /**< Unpacked glyphs which were too large to cache or had no buffer*/
+    uint32_t entry_cnt;     /**< Glyphs in the cache now*/
+    uint32_t used;          /**< Bytes used by the glyphs now*/
+    uint32_t budget;        /**< Max. bytes the glyphs can use*/
+} lv_font_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Set the size of the buffer of the cached glyphs. The least recently used glyphs are dropped
+ * if a new one doesn't fit. The default is `LV_FONT_CACHE_BUDGET`. The cache is cleared.
+ * @param max_bytes the budget in bytes, 0 disables caching
+ */
+void lv_font_cache_set_budget(uint32_t max_bytes);
+
+/**
+ * Set where the buffer of the cached glyphs is allocated, e.g. in an external RAM.
+ * The whole budget is allocated when the first glyph is looked up for drawing.
+ * By default `lv_mem_alloc` and `lv_mem_free` are used. The cache is cleared.
+ * @param alloc_cb  allocate memory, NULL to restore the default
+ * @param free_cb   free memory allocated by `alloc_cb`
+ */
+void lv_font_cache_set_mem_cb(void * (*alloc_cb)(size_t size), void (*free_cb)(void * p));
+
+/**
+ * Drop all the cached glyphs and free their buffer
+ */
+void lv_font_cache_clear(void);
+
+/**
+ * Get the statistics of the glyph cache
+ * @param stats store the statistics here
+ */
+void lv_font_cache_get_stats(lv_font_cache_stats_t * stats);
+
+/**
+ * Reset the hit, miss, evict and skip counters
+ */
+void lv_font_cache_reset_stats(void);
+
+/**
+ * Drop the cached glyphs of a font, e.g. because it's freed.
+ * @param font pointer to a font
+ */
+void _lv_font_cache_remove_font(const lv_font_t * font);
+
+/**
+ * Tell whether an unpacked glyph can be stored in the cache.
+ * @param a8_size   `box_w * box_h` of the glyph
+ * @return          true: `_lv_font_cache_add` can store it if the buffer is allocated
+ */
+bool _lv_font_cache_fits(uint32_t a8_size);
+
+/**
+ * Allocate the buffer of the cached glyphs if it's not allocated yet.
+ * @return          true: the buffer is allocated; false: there is no memory for it
+ */
+bool _lv_font_cache_reserve(void);
+
+/**
+ * Find the glyph ID of a cached letter and mark it as the most recently used.
+ * @param font      pointer to a font
+ * @param letter    a UNICODE letter
+ * @return          the glyph ID or 0 if the letter is not cached
+ */
+uint32_t _lv_font_cache_get_gid(const lv_font_t * font, uint32_t letter);
+
+/**
+ * Find the unpacked bitmap of a cached letter and mark it as the most recently used.
+ * @param font      pointer to a font
+ * @param letter    a UNICODE letter
+ * @return          1 byte per pixel opacity map or NULL if the letter is not cached.
+ *                  It's valid until the next `_lv_font_cache_add`.
+ */
+const uint8_t * _lv_font_cache_get_bitmap(const lv_font_t * font, uint32_t letter);
+
+/**
+ * Allocate an entry for a letter, dropping the least recently used ones if required.
+ * @param font      pointer to a font
+ * @param letter    a UNICODE letter
+ * @param gid       glyph ID of the letter
+ * @param a8_size   `box_w * box_h` of the glyph
+ * @return          buffer where the 1 byte per pixel opacity map should be written or NULL if it can't be cached,
+ *                  e.g. because `_lv_font_cache_reserve` couldn't allocate the buffer
+ */
+uint8_t * _lv_font_cache_add(const lv_font_t * font, uint32_t letter, uint32_t gid, uint32_t a8_size);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_FONT_CACHE_BUDGET > 0*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_FONT_CACHE_H*/
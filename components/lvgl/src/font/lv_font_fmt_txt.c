@@ -8,6 +8,7 @@
  *********************/
 #include "lv_font.h"
 #include "lv_font_fmt_txt.h"
+#include "lv_font_cache.h"
 #include "../misc/lv_assert.h"
 #include "../misc/lv_types.h"
 #include "../misc/lv_gc.h"
@@ -37,6 +38,12 @@ static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
 static int32_t kern_pair_16_compare(const void * ref, const void * element);
 
+#if LV_FONT_CACHE_BUDGET > 0
+    static bool glyph_cacheable(const lv_font_t * font);
+    static uint32_t get_glyph_dsc_id_cached(const lv_font_t * font, uint32_t letter);
+    static void unpack_a8(const uint8_t * in, uint8_t * out, uint32_t px_cnt, uint8_t bpp);
+#endif /*LV_FONT_CACHE_BUDGET > 0*/
+
 #if LV_USE_FONT_COMPRESSED
     static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp, bool prefilter);
     static inline void decompress_line(uint8_t * out, lv_coord_t w);
@@ -49,6 +56,12 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_FONT_CACHE_BUDGET > 0
+    extern const uint8_t _lv_bpp1_opa_table[2];
+    extern const uint8_t _lv_bpp2_opa_table[4];
+    extern const uint8_t _lv_bpp4_opa_table[16];
+#endif /*LV_FONT_CACHE_BUDGET > 0*/
+
 #if LV_USE_FONT_COMPRESSED
     static uint32_t rle_rdp;
     static const uint8_t * rle_in;
@@ -81,11 +94,50 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
     if(unicode_letter == '\t') unicode_letter = ' ';
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+
+#if LV_FONT_CACHE_BUDGET > 0
+    /*Cached glyphs are already unpacked to 1 byte per pixel*/
+    bool cacheable = glyph_cacheable(font);
+    if(cacheable) {
+        const uint8_t * cached_bitmap = _lv_font_cache_get_bitmap(font, unicode_letter);
+        if(cached_bitmap) return cached_bitmap;
+    }
+#endif
+
     uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
     if(!gid) return NULL;
 
     const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
 
+#if LV_FONT_CACHE_BUDGET > 0
+    /*`lv_font_get_glyph_dsc_fmt_txt` reported 8 bpp for these glyphs if the cache has its buffer,
+     *so unpack them into it, dropping other glyphs if there is no room.
+     *Without the buffer the font's own bitmap is returned below, as the font's bpp was reported.*/
+    uint32_t a8_size = (uint32_t)gdsc->box_w * gdsc->box_h;
+    uint8_t * a8_bitmap = cacheable ? _lv_font_cache_add(font, unicode_letter, gid, a8_size) : NULL;
+    if(a8_bitmap) {
+        const uint8_t * packed_bitmap;
+        if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
+            packed_bitmap = &fdsc->glyph_bitmap[gdsc->bitmap_index];
+        }
+        else {
+#if LV_USE_FONT_COMPRESSED
+            /*Decompress to the end of the glyph's own buffer, it's at least as large as the packed bitmap*/
+            uint32_t packed_size = fdsc->bpp == 8 ? a8_size : (a8_size * (fdsc->bpp == 3 ? 4 : fdsc->bpp) + 7) >> 3;
+            uint8_t * tmp = a8_bitmap + a8_size - packed_size;
+            bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
+            decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], tmp, gdsc->box_w, gdsc->box_h, (uint8_t)fdsc->bpp, prefilter);
+            packed_bitmap = tmp;
+#else
+            LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
+            return NULL;
+#endif
+        }
+        unpack_a8(packed_bitmap, a8_bitmap, a8_size, (uint8_t)fdsc->bpp);
+        return a8_bitmap;
+    }
+#endif
+
     if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
         return &fdsc->glyph_bitmap[gdsc->bitmap_index];
     }
@@ -154,12 +206,20 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
         is_tab = true;
     }
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+#if LV_FONT_CACHE_BUDGET > 0
+    uint32_t gid = get_glyph_dsc_id_cached(font, unicode_letter);
+#else
     uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
+#endif
     if(!gid) return false;
 
     int8_t kvalue = 0;
     if(fdsc->kern_dsc) {
+#if LV_FONT_CACHE_BUDGET > 0
+        uint32_t gid_next = get_glyph_dsc_id_cached(font, unicode_letter_next);
+#else
         uint32_t gid_next = get_glyph_dsc_id(font, unicode_letter_next);
+#endif
         if(gid_next) {
             kvalue = get_kern_value(font, gid, gid_next);
         }
@@ -184,6 +244,15 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     dsc_out->bpp   = (uint8_t)fdsc->bpp;
     dsc_out->is_placeholder = false;
 
+#if LV_FONT_CACHE_BUDGET > 0
+    /*`lv_font_get_bitmap_fmt_txt` returns these glyphs from the cache with 1 byte per pixel.
+     *Only if the buffer of the cache could be allocated, else it returns them with the font's bpp.*/
+    if(glyph_cacheable(font) && _lv_font_cache_fits((uint32_t)gdsc->box_w * gdsc->box_h) &&
+       _lv_font_cache_reserve()) {
+        dsc_out->bpp = 8;
+    }
+#endif
+
     if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
 
     return true;
@@ -206,6 +275,59 @@ void _lv_font_clean_up_fmt_txt(void)
  *   STATIC FUNCTIONS
  **********************/
 
+#if LV_FONT_CACHE_BUDGET > 0
+/*Sub-pixel glyphs are drawn differently, keep their original format*/
+static bool glyph_cacheable(const lv_font_t * font)
+{
+    return font->subpx == LV_FONT_SUBPX_NONE;
+}
+
+static uint32_t get_glyph_dsc_id_cached(const lv_font_t * font, uint32_t letter)
+{
+    if(glyph_cacheable(font)) {
+        uint32_t gid = _lv_font_cache_get_gid(font, letter);
+        if(gid) return gid;
+    }
+
+    return get_glyph_dsc_id(font, letter);
+}
+
+/*Convert a bitmap to opacity values the same way as `lv_draw_sw_letter` does. `out` can overlap the end of `in`.*/
+static void unpack_a8(const uint8_t * in, uint8_t * out, uint32_t px_cnt, uint8_t bpp)
+{
+    if(bpp == 8) {
+        if(out != in) lv_memcpy(out, in, px_cnt);
+        return;
+    }
+
+    /*3 bpp glyphs are stored on 4 bits*/
+    if(bpp == 3) bpp = 4;
+
+    const uint8_t * opa_table;
+    switch(bpp) {
+        case 1:
+            opa_table = _lv_bpp1_opa_table;
+            break;
+        case 2:
+            opa_table = _lv_bpp2_opa_table;
+            break;
+        default:
+            opa_table = _lv_bpp4_opa_table;
+            break;
+    }
+
+    /*The packed data is at the end of `out`, so reading ahead of writing is safe*/
+    uint8_t mask = (1 << bpp) - 1;
+    uint32_t bit_pos = 0;
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        uint8_t shift = 8 - bpp - (bit_pos & 0x7);
+        out[i] = opa_table[(in[bit_pos >> 3] >> shift) & mask];
+        bit_pos += bpp;
+    }
+}
+#endif /*LV_FONT_CACHE_BUDGET > 0*/
+
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 {
     if(letter == '\0') return 0;
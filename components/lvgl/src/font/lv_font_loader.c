@@ -13,6 +13,7 @@
 #include "../lvgl.h"
 #include "../misc/lv_fs.h"
 #include "lv_font_loader.h"
+#include "lv_font_cache.h"
 
 /**********************
  *      TYPEDEFS
@@ -117,6 +118,9 @@ lv_font_t * lv_font_load(const char * font_name)
 void lv_font_free(lv_font_t * font)
 {
     if(NULL != font) {
+#if LV_FONT_CACHE_BUDGET > 0
+        _lv_font_cache_remove_font(font);
+#endif
         lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
         if(NULL != dsc) {
@@ -23,6 +23,7 @@
 #include "../draw/stm32_dma2d/lv_gpu_stm32_dma2d.h"
 #include "../draw/swm341_dma2d/lv_gpu_swm341_dma2d.h"
 #include "../draw/arm2d/lv_gpu_arm2d.h"
+#include "../draw/esp32s3_pie/lv_gpu_esp32s3_pie.h"
 #if LV_USE_GPU_NXP_PXP || LV_USE_GPU_NXP_VG_LITE
     #include "../draw/nxp/lv_gpu_nxp.h"
 #endif
@@ -94,6 +95,8 @@ void lv_disp_drv_init(lv_disp_drv_t * driver)
     driver->antialiasing     = LV_COLOR_DEPTH > 8 ? 1 : 0;
     driver->screen_transp    = 0;
     driver->dpi              = LV_DPI_DEF;
+    driver->join_trans_px    = LV_DISP_DEF_JOIN_TRANS_PX;
+    driver->tile_size        = LV_DISP_DEF_TILE_SIZE;
     driver->color_chroma_key = LV_COLOR_CHROMA_KEY;
 
 
@@ -117,6 +120,10 @@ void lv_disp_drv_init(lv_disp_drv_t * driver)
     driver->draw_ctx_init = lv_draw_arm2d_ctx_init;
     driver->draw_ctx_deinit = lv_draw_arm2d_ctx_init;
     driver->draw_ctx_size = sizeof(lv_draw_arm2d_ctx_t);
+#elif LV_USE_GPU_ESP32S3_PIE && LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+    driver->draw_ctx_init = lv_draw_esp32s3_pie_ctx_init;
+    driver->draw_ctx_deinit = lv_draw_esp32s3_pie_ctx_deinit;
+    driver->draw_ctx_size = sizeof(lv_draw_esp32s3_pie_ctx_t);
 #else
     driver->draw_ctx_init = lv_draw_sw_init_ctx;
     driver->draw_ctx_deinit = lv_draw_sw_init_ctx;
@@ -158,6 +165,10 @@ void lv_disp_draw_buf_init(lv_disp_draw_buf_t * draw_buf, void * buf1, void * bu
  */
 lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver)
 {
+    /*The invalidated areas are snapped to the tiles by masking their coordinates*/
+    LV_ASSERT_MSG(driver->tile_size >= 0 && (driver->tile_size & (driver->tile_size - 1)) == 0,
+                  "tile_size must be 0 or a power of 2");
+
     lv_disp_t * disp = _lv_ll_ins_head(&LV_GC_ROOT(_lv_disp_ll));
     LV_ASSERT_MALLOC(disp);
     if(!disp) {
@@ -101,6 +101,11 @@ typedef struct _lv_disp_drv_t {
 
     uint32_t dpi : 10;              /** DPI (dot per inch) of the display. Default value is `LV_DPI_DEF`.*/
 
+    uint32_t join_trans_px;         /**< Fixed cost of a flush in pixels, 0: join only overlapping areas.
+                                      * Default value is `LV_DISP_DEF_JOIN_TRANS_PX`.*/
+    lv_coord_t tile_size;           /**< Snap invalidated areas to tiles of this size (power of 2), 0: don't snap.
+                                      * Default value is `LV_DISP_DEF_TILE_SIZE`.*/
+
     /** MANDATORY: Write the internal buffer (draw_buf) to the display. 'lv_disp_flush_ready()' has to be
      * called when finished*/
     void (*flush_cb)(struct _lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
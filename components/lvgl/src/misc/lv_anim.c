@@ -408,6 +408,18 @@ static void anim_timer(lv_timer_t * param)
     }
 
     last_timer_run = lv_tick_get();
+
+#if LV_USE_TIMER_HEAP
+    /*If all animations wait for their delay, sleep until the first one starts*/
+    uint32_t wait = UINT32_MAX;
+    a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
+    while(a != NULL && wait > LV_DISP_DEF_REFR_PERIOD) {
+        uint32_t a_wait = a->act_time < 0 ? (uint32_t)(-a->act_time) : 0;
+        if(a_wait < wait) wait = a_wait;
+        a = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
+    }
+    if(wait != UINT32_MAX) lv_timer_set_period(_lv_anim_tmr, LV_MAX(wait, LV_DISP_DEF_REFR_PERIOD));
+#endif
 }
 
 /**
@@ -467,4 +479,8 @@ static void anim_mark_list_change(void)
         lv_timer_pause(_lv_anim_tmr);
     else
         lv_timer_resume(_lv_anim_tmr);
+#if LV_USE_TIMER_HEAP
+    /*A new animation might start at once, `anim_timer` makes it sleep again if not*/
+    lv_timer_set_period(_lv_anim_tmr, LV_DISP_DEF_REFR_PERIOD);
+#endif
 }
@@ -26,12 +26,18 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
-#if LV_IMG_CACHE_DEF_SIZE
+#if LV_IMG_CACHE_DEF_SIZE && !LV_IMG_CACHE_BUDGET
 #    define LV_IMG_CACHE_DEF            1
 #else
 #    define LV_IMG_CACHE_DEF            0
 #endif
 
+#if LV_IMG_CACHE_BUDGET
+#    define LV_IMG_CACHE_BUDGET_DEF     1
+#else
+#    define LV_IMG_CACHE_BUDGET_DEF     0
+#endif
+
 #define LV_DISPATCH(f, t, n)            f(t, n)
 #define LV_DISPATCH_COND(f, t, n, m, v) LV_CONCAT3(LV_DISPATCH, m, v)(f, t, n)
 
@@ -49,10 +55,13 @@ extern "C" {
     LV_DISPATCH(f, lv_ll_t, _lv_group_ll)                                                              \
     LV_DISPATCH(f, lv_ll_t, _lv_img_decoder_ll)                                                        \
     LV_DISPATCH(f, lv_ll_t, _lv_obj_style_trans_ll)                                                    \
+    LV_DISPATCH_COND(f, lv_ll_t, _lv_obj_index_ll, LV_USE_OBJ_INDEX, 1)                                \
     LV_DISPATCH(f, lv_layout_dsc_t *, _lv_layout_list)                                                 \
     LV_DISPATCH_COND(f, _lv_img_cache_entry_t*, _lv_img_cache_array, LV_IMG_CACHE_DEF, 1)              \
     LV_DISPATCH_COND(f, _lv_img_cache_entry_t, _lv_img_cache_single, LV_IMG_CACHE_DEF, 0)              \
+    LV_DISPATCH_COND(f, lv_ll_t, _lv_img_cache_ll, LV_IMG_CACHE_BUDGET_DEF, 1)                         \
     LV_DISPATCH(f, lv_timer_t*, _lv_timer_act)                                                         \
+    LV_DISPATCH_COND(f, lv_timer_t**, _lv_timer_heap, LV_USE_TIMER_HEAP, 1)                            \
     LV_DISPATCH(f, lv_mem_buf_arr_t , lv_mem_buf)                                                      \
     LV_DISPATCH_COND(f, _lv_draw_mask_radius_circle_dsc_arr_t , _lv_circle_cache, LV_DRAW_COMPLEX, 1)  \
     LV_DISPATCH_COND(f, _lv_draw_mask_saved_arr_t , _lv_draw_mask_list, LV_DRAW_COMPLEX, 1)            \
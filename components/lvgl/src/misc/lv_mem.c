@@ -8,10 +8,12 @@
  *      INCLUDES
  *********************/
 #include "lv_mem.h"
+#include "lv_mem_slab.h"
 #include "lv_tlsf.h"
 #include "lv_gc.h"
 #include "lv_assert.h"
 #include "lv_log.h"
+#include "lv_parallel.h"
 
 #if LV_MEM_CUSTOM != 0
     #include LV_MEM_CUSTOM_INCLUDE
@@ -39,6 +41,12 @@
 
 #define ZERO_MEM_SENTINEL  0xa1b2c3d4
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB_SIZE > 0
+    #define USE_SLAB    1
+#else
+    #define USE_SLAB    0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -49,6 +57,7 @@
 #if LV_MEM_CUSTOM == 0
     static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
 #endif
+static void * buf_get(uint32_t size);
 
 /**********************
  *  STATIC VARIABLES
@@ -100,6 +109,13 @@ void lv_mem_init(void)
 #endif
 #endif
 
+#if USE_SLAB
+    /*The pages are a block of the heap, so LV_MEM_SIZE stays the whole budget*/
+    void * arena = lv_tlsf_malloc(tlsf, LV_MEM_SLAB_SIZE);
+    LV_ASSERT_MSG(arena != NULL, "LV_MEM_SLAB_SIZE doesn't fit into LV_MEM_SIZE");
+    _lv_mem_slab_init(arena);
+#endif
+
 #if LV_MEM_ADD_JUNK
     LV_LOG_WARN("LV_MEM_ADD_JUNK is enabled which makes LVGL much slower");
 #endif
@@ -130,7 +146,11 @@ void * lv_mem_alloc(size_t size)
         return &zero_mem;
     }
 
-#if LV_MEM_CUSTOM == 0
+    _lv_parallel_lock();
+#if USE_SLAB
+    void * alloc = _lv_mem_slab_alloc(size);
+    if(alloc == NULL) alloc = lv_tlsf_malloc(tlsf, size);
+#elif LV_MEM_CUSTOM == 0
     void * alloc = lv_tlsf_malloc(tlsf, size);
 #else
     void * alloc = LV_MEM_CUSTOM_ALLOC(size);
@@ -159,6 +179,7 @@ void * lv_mem_alloc(size_t size)
 #endif
         MEM_TRACE("allocated at %p", alloc);
     }
+    _lv_parallel_unlock();
     return alloc;
 }
 
@@ -172,7 +193,17 @@ void lv_mem_free(void * data)
     if(data == &zero_mem) return;
     if(data == NULL) return;
 
-#if LV_MEM_CUSTOM == 0
+    _lv_parallel_lock();
+#if USE_SLAB
+#  if LV_MEM_ADD_JUNK
+    size_t junk_size = _lv_mem_slab_block_size(data);
+    lv_memset(data, 0xbb, junk_size ? junk_size : lv_tlsf_block_size(data));
+#  endif
+    size_t size = _lv_mem_slab_free(data);
+    if(size == 0) size = lv_tlsf_free(tlsf, data);
+    if(cur_used > size) cur_used -= size;
+    else cur_used = 0;
+#elif LV_MEM_CUSTOM == 0
 #  if LV_MEM_ADD_JUNK
     lv_memset(data, 0xbb, lv_tlsf_block_size(data));
 #  endif
@@ -182,6 +213,7 @@ void lv_mem_free(void * data)
 #else
     LV_MEM_CUSTOM_FREE(data);
 #endif
+    _lv_parallel_unlock();
 }
 
 /**
@@ -202,11 +234,31 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
 
     if(data_p == &zero_mem) return lv_mem_alloc(new_size);
 
+#if USE_SLAB
+    /*Keep a block while the new size needs the same block size, move it otherwise*/
+    size_t block_size = _lv_mem_slab_block_size(data_p);
+    if(block_size) {
+        if(new_size <= block_size && (new_size > block_size / 2 || block_size == 16)) return data_p;
+
+        void * moved_p = lv_mem_alloc(new_size);
+        if(moved_p == NULL) {
+            LV_LOG_ERROR("couldn't allocate memory");
+            return NULL;
+        }
+        lv_memcpy(moved_p, data_p, LV_MIN(block_size, new_size));
+        lv_mem_free(data_p);
+        MEM_TRACE("allocated at %p", moved_p);
+        return moved_p;
+    }
+#endif
+
+    _lv_parallel_lock();
 #if LV_MEM_CUSTOM == 0
     void * new_p = lv_tlsf_realloc(tlsf, data_p, new_size);
 #else
     void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
 #endif
+    _lv_parallel_unlock();
     if(new_p == NULL) {
         LV_LOG_ERROR("couldn't allocate memory");
         return NULL;
@@ -234,6 +286,13 @@ lv_res_t lv_mem_test(void)
         return LV_RES_INV;
     }
 #endif
+
+#if USE_SLAB
+    if(_lv_mem_slab_test() != LV_RES_OK) {
+        LV_LOG_WARN("slab pages failed");
+        return LV_RES_INV;
+    }
+#endif
     MEM_TRACE("passed");
     return LV_RES_OK;
 }
@@ -253,7 +312,6 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
     lv_tlsf_walk_pool(lv_tlsf_get_pool(tlsf), lv_mem_walker, mon_p);
 
     mon_p->total_size = LV_MEM_SIZE;
-    mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
     if(mon_p->free_size > 0) {
         mon_p->frag_pct = mon_p->free_biggest_size * 100U / mon_p->free_size;
         mon_p->frag_pct = 100 - mon_p->frag_pct;
@@ -262,6 +320,14 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
         mon_p->frag_pct = 0; /*no fragmentation if all the RAM is used*/
     }
 
+#if USE_SLAB
+    /*The free blocks of the pages are free memory, but not for a large allocation*/
+    _lv_parallel_lock();
+    _lv_mem_slab_monitor(mon_p);
+    _lv_parallel_unlock();
+#endif
+    mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
+
     mon_p->max_used = max_used;
 
     MEM_TRACE("finished");
@@ -279,50 +345,10 @@ void * lv_mem_buf_get(uint32_t size)
 
     MEM_TRACE("begin, getting %d bytes", size);
 
-    /*Try to find a free buffer with suitable size*/
-    int8_t i_guess = -1;
-    for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(lv_mem_buf[i]).used == 0 && LV_GC_ROOT(lv_mem_buf[i]).size >= size) {
-            if(LV_GC_ROOT(lv_mem_buf[i]).size == size) {
-                LV_GC_ROOT(lv_mem_buf[i]).used = 1;
-                return LV_GC_ROOT(lv_mem_buf[i]).p;
-            }
-            else if(i_guess < 0) {
-                i_guess = i;
-            }
-            /*If size of `i` is closer to `size` prefer it*/
-            else if(LV_GC_ROOT(lv_mem_buf[i]).size < LV_GC_ROOT(lv_mem_buf[i_guess]).size) {
-                i_guess = i;
-            }
-        }
-    }
-
-    if(i_guess >= 0) {
-        LV_GC_ROOT(lv_mem_buf[i_guess]).used = 1;
-        MEM_TRACE("returning already allocated buffer (buffer id: %d, address: %p)", i_guess,
-                  LV_GC_ROOT(lv_mem_buf[i_guess]).p);
-        return LV_GC_ROOT(lv_mem_buf[i_guess]).p;
-    }
-
-    /*Reallocate a free buffer*/
-    for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(lv_mem_buf[i]).used == 0) {
-            /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
-            void * buf = lv_mem_realloc(LV_GC_ROOT(lv_mem_buf[i]).p, size);
-            LV_ASSERT_MSG(buf != NULL, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)");
-            if(buf == NULL) return NULL;
-
-            LV_GC_ROOT(lv_mem_buf[i]).used = 1;
-            LV_GC_ROOT(lv_mem_buf[i]).size = size;
-            LV_GC_ROOT(lv_mem_buf[i]).p    = buf;
-            MEM_TRACE("allocated (buffer id: %d, address: %p)", i, LV_GC_ROOT(lv_mem_buf[i]).p);
-            return LV_GC_ROOT(lv_mem_buf[i]).p;
-        }
-    }
-
-    LV_LOG_ERROR("no more buffers. (increase LV_MEM_BUF_MAX_NUM)");
-    LV_ASSERT_MSG(false, "No more buffers. Increase LV_MEM_BUF_MAX_NUM.");
-    return NULL;
+    _lv_parallel_lock();
+    void * buf = buf_get(size);
+    _lv_parallel_unlock();
+    return buf;
 }
 
 /**
@@ -333,12 +359,15 @@ void lv_mem_buf_release(void * p)
 {
     MEM_TRACE("begin (address: %p)", p);
 
+    _lv_parallel_lock();
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
         if(LV_GC_ROOT(lv_mem_buf[i]).p == p) {
             LV_GC_ROOT(lv_mem_buf[i]).used = 0;
+            _lv_parallel_unlock();
             return;
         }
     }
+    _lv_parallel_unlock();
 
     LV_LOG_ERROR("p is not a known buffer");
 }
@@ -547,6 +576,54 @@ LV_ATTRIBUTE_FAST_MEM void lv_memset_ff(void * dst, size_t len)
  *   STATIC FUNCTIONS
  **********************/
 
+static void * buf_get(uint32_t size)
+{
+    /*Try to find a free buffer with suitable size*/
+    int8_t i_guess = -1;
+    for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
+        if(LV_GC_ROOT(lv_mem_buf[i]).used == 0 && LV_GC_ROOT(lv_mem_buf[i]).size >= size) {
+            if(LV_GC_ROOT(lv_mem_buf[i]).size == size) {
+                LV_GC_ROOT(lv_mem_buf[i]).used = 1;
+                return LV_GC_ROOT(lv_mem_buf[i]).p;
+            }
+            else if(i_guess < 0) {
+                i_guess = i;
+            }
+            /*If size of `i` is closer to `size` prefer it*/
+            else if(LV_GC_ROOT(lv_mem_buf[i]).size < LV_GC_ROOT(lv_mem_buf[i_guess]).size) {
+                i_guess = i;
+            }
+        }
+    }
+
+    if(i_guess >= 0) {
+        LV_GC_ROOT(lv_mem_buf[i_guess]).used = 1;
+        MEM_TRACE("returning already allocated buffer (buffer id: %d, address: %p)", i_guess,
+                  LV_GC_ROOT(lv_mem_buf[i_guess]).p);
+        return LV_GC_ROOT(lv_mem_buf[i_guess]).p;
+    }
+
+    /*Reallocate a free buffer*/
+    for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
+        if(LV_GC_ROOT(lv_mem_buf[i]).used == 0) {
+            /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
+            void * buf = lv_mem_realloc(LV_GC_ROOT(lv_mem_buf[i]).p, size);
+            LV_ASSERT_MSG(buf != NULL, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)");
+            if(buf == NULL) return NULL;
+
+            LV_GC_ROOT(lv_mem_buf[i]).used = 1;
+            LV_GC_ROOT(lv_mem_buf[i]).size = size;
+            LV_GC_ROOT(lv_mem_buf[i]).p    = buf;
+            MEM_TRACE("allocated (buffer id: %d, address: %p)", i, LV_GC_ROOT(lv_mem_buf[i]).p);
+            return LV_GC_ROOT(lv_mem_buf[i]).p;
+        }
+    }
+
+    LV_LOG_ERROR("no more buffers. (increase LV_MEM_BUF_MAX_NUM)");
+    LV_ASSERT_MSG(false, "No more buffers. Increase LV_MEM_BUF_MAX_NUM.");
+    return NULL;
+}
+
 #if LV_MEM_CUSTOM == 0
 static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
 {
@@ -17,6 +17,7 @@ extern "C" {
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include "lv_types.h"
@@ -24,23 +25,46 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB_SIZE > 0
+    #define LV_MEM_SLAB_CLASS_NUM 4     /*16, 32, 64 and 128 byte blocks*/
+    #define LV_MEM_SLAB_MAX_SIZE  128   /*Larger allocations are always served by TLSF*/
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB_SIZE > 0
+/**
+ * Occupancy of the pages of a block size
+ */
+typedef struct {
+    uint16_t block_size;
+    uint16_t page_cnt;      /**< Pages holding blocks of this size*/
+    uint32_t used_cnt;      /**< Blocks in use*/
+    uint32_t free_cnt;      /**< Free blocks in the pages*/
+    uint32_t max_used_cnt;
+    uint32_t fallback_cnt;  /**< Allocations of this size served by TLSF as the pages were full*/
+} lv_mem_slab_monitor_t;
+#endif
+
 /**
  * Heap information structure.
  */
 typedef struct {
     uint32_t total_size; /**< Total heap size*/
     uint32_t free_cnt;
-    uint32_t free_size; /**< Size of available memory*/
+    uint32_t free_size; /**< Size of available memory (with the free blocks of the pages)*/
     uint32_t free_biggest_size;
     uint32_t used_cnt;
     uint32_t max_used; /**< Max size of Heap memory used*/
     uint8_t used_pct; /**< Percentage used*/
-    uint8_t frag_pct; /**< Amount of fragmentation*/
+    uint8_t frag_pct; /**< Amount of fragmentation of the TLSF heap*/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB_SIZE > 0
+    lv_mem_slab_monitor_t slab[LV_MEM_SLAB_CLASS_NUM];
+    uint16_t slab_page_free_cnt;    /**< Pages not given to a block size*/
+    uint8_t slab_frag_pct;          /**< Free bytes of the pages given to a block size in percentage of their size*/
+#endif
 } lv_mem_monitor_t;
 
 typedef struct {
@@ -102,6 +126,15 @@ lv_res_t lv_mem_test(void);
 void lv_mem_monitor(lv_mem_monitor_t * mon_p);
 
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB_SIZE > 0
+/**
+ * Serve the small allocations from the pages of equal sized blocks or allocate everything from TLSF.
+ * The blocks already given out stay valid. Enabled by default.
+ * @param en    true: use the pages
+ */
+void lv_mem_slab_set_enabled(bool en);
+#endif
+
 /**
  * Get a temporal buffer with the given size.
  * @param size the required size
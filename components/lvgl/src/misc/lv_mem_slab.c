@@ -0,0 +1,260 @@
+/**
+ * @file lv_mem_slab.c
+ * The arena is cut into pages of `LV_MEM_SLAB_PAGE_SIZE` bytes. A page holds blocks of one size
+ * while any of them is used and goes back to the unused pages when all are freed.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_mem_slab.h"
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB_SIZE > 0
+
+/*********************
+ *      DEFINES
+ *********************/
+#define PAGE_CNT    (LV_MEM_SLAB_SIZE / LV_MEM_SLAB_PAGE_SIZE)
+#define PAGE_NONE   (-1)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    void * free_head;       /*Freed blocks of the page, the first bytes of a free block point to the next one*/
+    int16_t next;           /*Next page of the class with free blocks or the next unused page*/
+    uint16_t used_cnt;
+    uint16_t bump_cnt;      /*Blocks given out at least once, the ones after them were never used*/
+    uint8_t cls;
+    uint8_t listed : 1;     /*In the list of the pages with free blocks of its class*/
+} slab_page_t;
+
+typedef struct {
+    int16_t partial;        /*First page with free blocks*/
+    uint16_t page_cnt;
+    uint32_t used_cnt;
+    uint32_t max_used_cnt;
+    uint32_t fallback_cnt;
+} slab_class_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void page_unlink(slab_class_t * c, int16_t pi);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint8_t * arena;
+static slab_page_t pages[PAGE_CNT];
+static slab_class_t classes[LV_MEM_SLAB_CLASS_NUM];
+static int16_t unused_pages;
+static bool enabled = true;
+
+static const uint16_t class_size[LV_MEM_SLAB_CLASS_NUM] = {16, 32, 64, LV_MEM_SLAB_MAX_SIZE};
+
+/**********************
+ *      MACROS
+ **********************/
+#define IS_IN_ARENA(p) (arena != NULL && (const uint8_t *)(p) >= arena && (const uint8_t *)(p) < arena + LV_MEM_SLAB_SIZE)
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_mem_slab_set_enabled(bool en)
+{
+    enabled = en;
+}
+
+void _lv_mem_slab_init(void * arena_p)
+{
+    arena = arena_p;
+    lv_memset_00(classes, sizeof(classes));
+    lv_memset_00(pages, sizeof(pages));
+
+    uint32_t i;
+    for(i = 0; i < LV_MEM_SLAB_CLASS_NUM; i++) classes[i].partial = PAGE_NONE;
+    for(i = 0; i < PAGE_CNT; i++) pages[i].next = i + 1 < PAGE_CNT ? (int16_t)(i + 1) : PAGE_NONE;
+    unused_pages = arena ? 0 : PAGE_NONE;
+}
+
+void * _lv_mem_slab_alloc(size_t size)
+{
+    if(!enabled || arena == NULL || size > LV_MEM_SLAB_MAX_SIZE) return NULL;
+
+    uint8_t cls = 0;
+    while(class_size[cls] < size) cls++;
+    slab_class_t * c = &classes[cls];
+
+    int16_t pi = c->partial;
+    if(pi == PAGE_NONE) {
+        pi = unused_pages;
+        if(pi == PAGE_NONE) {
+            c->fallback_cnt++;
+            return NULL;
+        }
+        unused_pages = pages[pi].next;
+
+        slab_page_t * page = &pages[pi];
+        page->free_head = NULL;
+        page->used_cnt = 0;
+        page->bump_cnt = 0;
+        page->cls = cls;
+        page->listed = 1;
+        page->next = PAGE_NONE;
+        c->partial = pi;
+        c->page_cnt++;
+    }
+
+    slab_page_t * page = &pages[pi];
+    void * p;
+    if(page->free_head) {
+        p = page->free_head;
+        page->free_head = *(void **)p;
+    }
+    else {
+        p = arena + pi * LV_MEM_SLAB_PAGE_SIZE + page->bump_cnt * class_size[cls];
+        page->bump_cnt++;
+    }
+    page->used_cnt++;
+
+    /*The page is full, it was the first in the list*/
+    if(page->free_head == NULL && page->bump_cnt == LV_MEM_SLAB_PAGE_SIZE / class_size[cls]) {
+        c->partial = page->next;
+        page->listed = 0;
+    }
+
+    c->used_cnt++;
+    if(c->used_cnt > c->max_used_cnt) c->max_used_cnt = c->used_cnt;
+
+    return p;
+}
+
+size_t _lv_mem_slab_free(void * p)
+{
+    if(!IS_IN_ARENA(p)) return 0;
+
+    int16_t pi = (int16_t)(((uint8_t *)p - arena) / LV_MEM_SLAB_PAGE_SIZE);
+    slab_page_t * page = &pages[pi];
+    slab_class_t * c = &classes[page->cls];
+
+    *(void **)p = page->free_head;
+    page->free_head = p;
+    page->used_cnt--;
+    c->used_cnt--;
+
+    if(!page->listed) {
+        page->next = c->partial;
+        c->partial = pi;
+        page->listed = 1;
+    }
+    /*Give the empty page to any size, but keep it if it's the only one of its class with room
+     *so a block allocated and freed in turn doesn't take and return a page every time*/
+    else if(page->used_cnt == 0 && !(c->partial == pi && page->next == PAGE_NONE)) {
+        page_unlink(c, pi);
+        page->listed = 0;
+        page->next = unused_pages;
+        unused_pages = pi;
+        c->page_cnt--;
+    }
+
+    return class_size[page->cls];
+}
+
+size_t _lv_mem_slab_block_size(const void * p)
+{
+    if(!IS_IN_ARENA(p)) return 0;
+
+    return class_size[pages[((const uint8_t *)p - arena) / LV_MEM_SLAB_PAGE_SIZE].cls];
+}
+
+void _lv_mem_slab_monitor(lv_mem_monitor_t * mon_p)
+{
+    if(arena == NULL) return;
+
+    /*The arena is a used block of TLSF, count its blocks instead*/
+    mon_p->used_cnt--;
+
+    uint32_t page_bytes = 0;
+    uint32_t free_bytes = 0;
+    uint32_t i;
+    for(i = 0; i < LV_MEM_SLAB_CLASS_NUM; i++) {
+        slab_class_t * c = &classes[i];
+        lv_mem_slab_monitor_t * m = &mon_p->slab[i];
+        m->block_size = class_size[i];
+        m->page_cnt = c->page_cnt;
+        m->used_cnt = c->used_cnt;
+        m->free_cnt = c->page_cnt * (LV_MEM_SLAB_PAGE_SIZE / class_size[i]) - c->used_cnt;
+        m->max_used_cnt = c->max_used_cnt;
+        m->fallback_cnt = c->fallback_cnt;
+
+        page_bytes += c->page_cnt * LV_MEM_SLAB_PAGE_SIZE;
+        free_bytes += m->free_cnt * class_size[i];
+        mon_p->used_cnt += c->used_cnt;
+    }
+
+    int16_t pi;
+    for(pi = unused_pages; pi != PAGE_NONE; pi = pages[pi].next) mon_p->slab_page_free_cnt++;
+
+    mon_p->free_size += free_bytes + mon_p->slab_page_free_cnt * LV_MEM_SLAB_PAGE_SIZE;
+    mon_p->slab_frag_pct = page_bytes ? (uint8_t)(100 * free_bytes / page_bytes) : 0;
+}
+
+lv_res_t _lv_mem_slab_test(void)
+{
+    if(arena == NULL) return LV_RES_OK;
+
+    uint32_t page_cnt = 0;
+    int16_t pi;
+    for(pi = unused_pages; pi != PAGE_NONE; pi = pages[pi].next) {
+        if(++page_cnt > PAGE_CNT) return LV_RES_INV;
+    }
+
+    uint32_t i;
+    for(i = 0; i < LV_MEM_SLAB_CLASS_NUM; i++) {
+        for(pi = classes[i].partial; pi != PAGE_NONE; pi = pages[pi].next) {
+            slab_page_t * page = &pages[pi];
+            if(page->cls != i || !page->listed) return LV_RES_INV;
+
+            /*Every free block is in the page and on a block boundary*/
+            uint8_t * page_start = arena + pi * LV_MEM_SLAB_PAGE_SIZE;
+            uint32_t free_cnt = 0;
+            void * p;
+            for(p = page->free_head; p != NULL; p = *(void **)p) {
+                uint32_t ofs = (uint32_t)((uint8_t *)p - page_start);
+                if((uint8_t *)p < page_start || ofs >= page->bump_cnt * class_size[i] || ofs % class_size[i]) {
+                    return LV_RES_INV;
+                }
+                if(++free_cnt > page->bump_cnt) return LV_RES_INV;
+            }
+            if(free_cnt + page->used_cnt != page->bump_cnt) return LV_RES_INV;
+            if(++page_cnt > PAGE_CNT) return LV_RES_INV;
+        }
+    }
+
+    return LV_RES_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Remove a page from the list of the pages with free blocks of its class
+ * @param c         the class of the page
+ * @param pi        index of the page
+ */
+static void page_unlink(slab_class_t * c, int16_t pi)
+{
+    if(c->partial == pi) {
+        c->partial = pages[pi].next;
+        return;
+    }
+
+    int16_t prev = c->partial;
+    while(pages[prev].next != pi) prev = pages[prev].next;
+    pages[prev].next = pages[pi].next;
+}
+
+#endif /*LV_MEM_CUSTOM == 0 && LV_MEM_SLAB_SIZE > 0*/
@@ -0,0 +1,87 @@
+/**
+ * @file lv_mem_slab.h
+ * Pages of equal sized blocks in front of TLSF for the small allocations of `lv_mem_alloc()`.
+ * Only used by lv_mem.c.
+ */
+
+#ifndef LV_MEM_SLAB_H
+#define LV_MEM_SLAB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_mem.h"
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB_SIZE > 0
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_MEM_SLAB_PAGE_SIZE   512
+
+#if LV_MEM_SLAB_SIZE % LV_MEM_SLAB_PAGE_SIZE
+    #error "LV_MEM_SLAB_SIZE must be a multiple of 512"
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start using the pages in an arena
+ * @param arena     `LV_MEM_SLAB_SIZE` bytes aligned to 8 bytes, NULL to use no pages
+ */
+void _lv_mem_slab_init(void * arena);
+
+/**
+ * Allocate a block from the pages
+ * @param size      the needed size in bytes
+ * @return          pointer to the block or NULL if `size` is too large or there is no room
+ */
+void * _lv_mem_slab_alloc(size_t size);
+
+/**
+ * Free a block if it's in the pages
+ * @param p         pointer to an allocated memory
+ * @return          the size of the freed block or 0 if `p` isn't in the pages
+ */
+size_t _lv_mem_slab_free(void * p);
+
+/**
+ * Get the size of a block in the pages
+ * @param p         pointer to an allocated memory
+ * @return          the size of the block or 0 if `p` isn't in the pages
+ */
+size_t _lv_mem_slab_block_size(const void * p);
+
+/**
+ * Add the occupancy of the pages to the monitor data of TLSF, the arena isn't counted as a used block
+ * @param mon_p     the monitor data to complete
+ */
+void _lv_mem_slab_monitor(lv_mem_monitor_t * mon_p);
+
+/**
+ * Check the lists of the pages and the free blocks
+ * @return          LV_RES_OK if they are consistent
+ */
+lv_res_t _lv_mem_slab_test(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_MEM_CUSTOM == 0 && LV_MEM_SLAB_SIZE > 0*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_MEM_SLAB_H*/
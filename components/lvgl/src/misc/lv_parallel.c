@@ -0,0 +1,98 @@
+/**
+ * @file lv_parallel.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_parallel.h"
+
+#if LV_USE_PARALLEL_RENDER
+
+#include "lv_mem.h"
+#include "lv_assert.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const lv_parallel_cb_t * parallel_cb;
+static volatile bool active;
+static lv_parallel_stats_t stats;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_parallel_set_cb(const lv_parallel_cb_t * cb)
+{
+    LV_ASSERT_MSG(!active, "Can't change the parallel callbacks while rendering");
+    parallel_cb = cb;
+}
+
+void lv_parallel_get_stats(lv_parallel_stats_t * s)
+{
+    *s = stats;
+}
+
+void lv_parallel_reset_stats(void)
+{
+    lv_memset_00(&stats, sizeof(stats));
+}
+
+bool _lv_parallel_start(uint32_t px_cnt, void (*task_cb)(void * param), void * param)
+{
+    if(parallel_cb == NULL || px_cnt < parallel_cb->min_px) {
+        stats.single_cnt++;
+        return false;
+    }
+
+    /*Set before starting the task to make the second thread use the locks too*/
+    active = true;
+    stats.parallel_cnt++;
+    parallel_cb->run_cb(task_cb, param);
+    return true;
+}
+
+void _lv_parallel_wait(void)
+{
+    parallel_cb->wait_cb();
+    active = false;
+}
+
+bool _lv_parallel_is_active(void)
+{
+    return active;
+}
+
+void _lv_parallel_lock(void)
+{
+    if(active) parallel_cb->lock_cb();
+}
+
+void _lv_parallel_unlock(void)
+{
+    if(active) parallel_cb->unlock_cb();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#endif /*LV_USE_PARALLEL_RENDER*/
@@ -0,0 +1,125 @@
+/**
+ * @file lv_parallel.h
+ * Run parts of the rendering on a second thread (e.g. on the other CPU core)
+ * and guard the state the two threads share while they draw.
+ */
+
+#ifndef LV_PARALLEL_H
+#define LV_PARALLEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_USE_PARALLEL_RENDER == 0 && !defined(LV_PARALLEL_THREAD_LOCAL)
+    #define LV_PARALLEL_THREAD_LOCAL
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+#if LV_USE_PARALLEL_RENDER
+
+typedef struct {
+    /**Call `task_cb(param)` on the second thread and return without waiting for it*/
+    void (*run_cb)(void (*task_cb)(void * param), void * param);
+
+    /**Wait until the `task_cb` started by `run_cb` returns*/
+    void (*wait_cb)(void);
+
+    /**Lock a recursive mutex. It guards the memory and the caches while both threads draw*/
+    void (*lock_cb)(void);
+
+    /**Unlock the mutex locked by `lock_cb`*/
+    void (*unlock_cb)(void);
+
+    /**Areas with fewer pixels are rendered on one thread, the start of the second one would cost more*/
+    uint32_t min_px;
+} lv_parallel_cb_t;
+
+typedef struct {
+    uint32_t parallel_cnt;      /**< Areas rendered on two threads*/
+    uint32_t single_cnt;        /**< Areas rendered on one thread*/
+} lv_parallel_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Set the functions which run the second render thread.
+ * @param cb    pointer to the callbacks, only the pointer is saved so it can't be a local variable.
+ *              NULL to render on one thread.
+ */
+void lv_parallel_set_cb(const lv_parallel_cb_t * cb);
+
+/**
+ * Get the statistics of the parallel rendering
+ * @param stats store the statistics here
+ */
+void lv_parallel_get_stats(lv_parallel_stats_t * stats);
+
+/**
+ * Reset the statistics of the parallel rendering
+ */
+void lv_parallel_reset_stats(void);
+
+/**
+ * Start a task on the second thread if it's set and the area is large enough
+ * @param px_cnt    number of pixels of the area to render
+ * @param task_cb   the function to call on the second thread
+ * @param param     parameter of `task_cb`
+ * @return          true: `task_cb` was started, call `_lv_parallel_wait()`; false: render on one thread
+ */
+bool _lv_parallel_start(uint32_t px_cnt, void (*task_cb)(void * param), void * param);
+
+/**
+ * Wait until the task started by `_lv_parallel_start()` returns
+ */
+void _lv_parallel_wait(void);
+
+/**
+ * Tell whether both threads are drawing now
+ * @return true: both threads draw
+ */
+bool _lv_parallel_is_active(void);
+
+/**
+ * Lock the state shared by the render threads. Does nothing if only one thread draws.
+ */
+void _lv_parallel_lock(void);
+
+/**
+ * Unlock the state shared by the render threads
+ */
+void _lv_parallel_unlock(void);
+
+#else
+
+#define _lv_parallel_is_active() false
+#define _lv_parallel_lock()     ((void)0)
+#define _lv_parallel_unlock()   ((void)0)
+
+#endif /*LV_USE_PARALLEL_RENDER*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_PARALLEL_H*/
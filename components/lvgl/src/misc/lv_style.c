@@ -132,6 +132,9 @@ const uint8_t _lv_style_builtin_prop_flag_lookup_table[_LV_STYLE_NUM_BUILT_IN_PR
 
 uint32_t _lv_style_custom_prop_flag_lookup_table_size = 0;
 
+/*Incremented whenever a property is set or removed*/
+uint32_t _lv_style_change_cnt = 0;
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -155,6 +158,7 @@ void lv_style_init(lv_style_t * style)
     }
 #endif
 
+    _lv_style_change_cnt++;
     lv_memset_00(style, sizeof(lv_style_t));
 #if LV_USE_ASSERT_STYLE
     style->sentinel = LV_STYLE_SENTINEL_VALUE;
@@ -170,6 +174,8 @@ void lv_style_reset(lv_style_t * style)
         return;
     }
 
+    _lv_style_change_cnt++;
+
     if(style->prop_cnt > 1) lv_mem_free(style->v_p.values_and_props);
     lv_memset_00(style, sizeof(lv_style_t));
 #if LV_USE_ASSERT_STYLE
@@ -229,6 +235,8 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
 
     if(style->prop_cnt == 0)  return false;
 
+    _lv_style_change_cnt++;
+
     if(style->prop_cnt == 1) {
         if(LV_STYLE_PROP_ID_MASK(style->prop1) == prop) {
             style->prop1 = LV_STYLE_PROP_INV;
@@ -420,6 +428,8 @@ static void lv_style_set_prop_internal(lv_style_t * style, lv_style_prop_t prop_
         return;
     }
 
+    _lv_style_change_cnt++;
+
     lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(prop_and_meta);
 
     if(style->prop_cnt > 1) {
@@ -576,6 +576,10 @@ static inline bool lv_style_prop_has_flag(lv_style_prop_t prop, uint8_t flag)
  *    GLOBAL VARIABLES
  *************************/
 
+/*A counter of the changes of the styles. It's incremented whenever a property is set or removed,
+ *so anything derived from the styles is up to date while it doesn't change.*/
+extern uint32_t _lv_style_change_cnt;
+
 /**********************
  *      MACROS
  **********************/
@@ -17,6 +17,7 @@
  *********************/
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
+#define HEAP_NONE 0xFFFFFFFF
 
 /**********************
  *      TYPEDEFS
@@ -27,6 +28,17 @@
  **********************/
 static bool lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
+#if LV_USE_TIMER_HEAP
+    static void heap_run(void);
+    static bool heap_insert(lv_timer_t * timer);
+    static void heap_remove(lv_timer_t * timer);
+    static void heap_update(lv_timer_t * timer);
+    static void heap_set(uint32_t i, lv_timer_t * timer);
+    static void heap_sift_up(uint32_t i);
+    static void heap_sift_down(uint32_t i);
+#else
+    #define heap_update(timer) ((void)0)
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -35,6 +47,14 @@ static bool lv_timer_run = false;
 static uint8_t idle_last = 0;
 static bool timer_deleted;
 static bool timer_created;
+#if LV_USE_TIMER_HEAP
+    /*`_lv_timer_heap` is a binary min-heap of the not paused timers by `due` in `[0, heap_cnt)`.
+     *While `lv_timer_handler()` runs, the due timers are moved behind it, to `[heap_cnt, heap_total)`*/
+    static uint32_t heap_cnt;
+    static uint32_t heap_total;
+    static uint32_t heap_size;
+    static bool heap_enabled = true;
+#endif
 
 /**********************
  *      MACROS
@@ -45,6 +65,8 @@ static bool timer_created;
     #define TIMER_TRACE(...)
 #endif
 
+#define HEAP LV_GC_ROOT(_lv_timer_heap)
+
 /**********************
  *   GLOBAL FUNCTIONS
  **********************/
@@ -55,6 +77,12 @@ static bool timer_created;
 void _lv_timer_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_timer_ll), sizeof(lv_timer_t));
+#if LV_USE_TIMER_HEAP
+    HEAP = NULL;
+    heap_cnt = 0;
+    heap_total = 0;
+    heap_size = 0;
+#endif
 
     /*Initially enable the lv_timer handling*/
     lv_timer_enable(true);
@@ -95,41 +123,39 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    do {
-        timer_deleted             = false;
-        timer_created             = false;
-        LV_GC_ROOT(_lv_timer_act) = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-        while(LV_GC_ROOT(_lv_timer_act)) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), LV_GC_ROOT(_lv_timer_act));
-
-            if(lv_timer_exec(LV_GC_ROOT(_lv_timer_act))) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(timer_created || timer_deleted) {
-                    TIMER_TRACE("Start from the first timer again because a timer was created or deleted");
-                    break;
+#if LV_USE_TIMER_HEAP
+    if(heap_enabled) {
+        heap_run();
+    }
+    else
+#endif
+    {
+        /*Run all timer from the list*/
+        lv_timer_t * next;
+        do {
+            timer_deleted             = false;
+            timer_created             = false;
+            LV_GC_ROOT(_lv_timer_act) = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
+            while(LV_GC_ROOT(_lv_timer_act)) {
+                /*The timer might be deleted if it runs only once ('repeat_count = 1')
+                 *So get next element until the current is surely valid*/
+                next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), LV_GC_ROOT(_lv_timer_act));
+
+                if(lv_timer_exec(LV_GC_ROOT(_lv_timer_act))) {
+                    /*If a timer was created or deleted then this or the next item might be corrupted*/
+                    if(timer_created || timer_deleted) {
+                        TIMER_TRACE("Start from the first timer again because a timer was created or deleted");
+                        break;
+                    }
                 }
-            }
-
-            LV_GC_ROOT(_lv_timer_act) = next; /*Load the next timer*/
-        }
-    } while(LV_GC_ROOT(_lv_timer_act));
 
-    uint32_t time_till_next = LV_NO_TIMER_READY;
-    next = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_till_next)
-                time_till_next = delay;
-        }
-
-        next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), next); /*Find the next timer*/
+                LV_GC_ROOT(_lv_timer_act) = next; /*Load the next timer*/
+            }
+        } while(LV_GC_ROOT(_lv_timer_act));
     }
 
+    uint32_t time_till_next = lv_timer_get_time_till_next();
+
     busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(idle_period_start);
     if(idle_period_time >= IDLE_MEAS_PERIOD) {
@@ -179,6 +205,14 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
 
+#if LV_USE_TIMER_HEAP
+    if(!heap_insert(new_timer)) {
+        _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), new_timer);
+        lv_mem_free(new_timer);
+        return NULL;
+    }
+#endif
+
     timer_created = true;
 
     return new_timer;
@@ -201,7 +235,13 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
 void lv_timer_del(lv_timer_t * timer)
 {
     _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), timer);
+#if LV_USE_TIMER_HEAP
+    heap_remove(timer);
+    /*Walking the heap is safe if other timers are deleted, it only needs to know about the running one*/
+    if(!heap_enabled || timer == LV_GC_ROOT(_lv_timer_act)) timer_deleted = true;
+#else
     timer_deleted = true;
+#endif
 
     lv_mem_free(timer);
 }
@@ -212,11 +252,21 @@ void lv_timer_del(lv_timer_t * timer)
  */
 void lv_timer_pause(lv_timer_t * timer)
 {
+#if LV_USE_TIMER_HEAP
+    heap_remove(timer);
+#endif
     timer->paused = true;
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
+#if LV_USE_TIMER_HEAP
+    /*A timer out of the heap would never run, so leave it paused*/
+    if(timer->paused && !heap_insert(timer)) {
+        LV_LOG_ERROR("couldn't add the timer to the timer heap, it stays paused");
+        return;
+    }
+#endif
     timer->paused = false;
 }
 
@@ -228,6 +278,7 @@ void lv_timer_resume(lv_timer_t * timer)
 void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     timer->period = period;
+    heap_update(timer);
 }
 
 /**
@@ -237,6 +288,7 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 void lv_timer_ready(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get() - timer->period - 1;
+    heap_update(timer);
 }
 
 /**
@@ -257,6 +309,7 @@ void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 void lv_timer_reset(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get();
+    heap_update(timer);
 }
 
 /**
@@ -277,6 +330,36 @@ uint8_t lv_timer_get_idle(void)
     return idle_last;
 }
 
+uint32_t lv_timer_get_time_till_next(void)
+{
+#if LV_USE_TIMER_HEAP
+    /*Due timers are waiting behind the heap while the handler runs*/
+    if(heap_total > heap_cnt) return 0;
+    if(heap_cnt == 0) return LV_NO_TIMER_READY;
+    return lv_timer_time_remaining(HEAP[0]);
+#else
+    uint32_t time_till_next = LV_NO_TIMER_READY;
+    lv_timer_t * next = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
+    while(next) {
+        if(!next->paused) {
+            uint32_t delay = lv_timer_time_remaining(next);
+            if(delay < time_till_next)
+                time_till_next = delay;
+        }
+
+        next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), next); /*Find the next timer*/
+    }
+    return time_till_next;
+#endif
+}
+
+#if LV_USE_TIMER_HEAP
+void lv_timer_heap_set_enabled(bool en)
+{
+    heap_enabled = en;
+}
+#endif
+
 /**
  * Iterate through the timers
  * @param timer NULL to start iteration or the previous return value to get the next timer
@@ -309,6 +392,7 @@ static bool lv_timer_exec(lv_timer_t * timer)
         int32_t original_repeat_count = timer->repeat_count;
         if(timer->repeat_count > 0) timer->repeat_count--;
         timer->last_run = lv_tick_get();
+        heap_update(timer);
         TIMER_TRACE("calling timer callback: %p", *((void **)&timer->timer_cb));
         if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
         TIMER_TRACE("timer callback %p finished", *((void **)&timer->timer_cb));
@@ -339,3 +423,150 @@ static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
         return 0;
     return timer->period - elp;
 }
+
+#if LV_USE_TIMER_HEAP
+
+/**
+ * Run the due timers. They are moved behind the heap first, so the timers they create, resume or
+ * reset don't run in this round, then each goes back to the heap after it ran.
+ */
+static void heap_run(void)
+{
+    while(heap_cnt > 0 && lv_timer_time_remaining(HEAP[0]) == 0) {
+        lv_timer_t * timer = HEAP[0];
+        heap_cnt--;
+        heap_set(0, HEAP[heap_cnt]);
+        heap_set(heap_cnt, timer);
+        heap_sift_down(0);
+    }
+
+    while(heap_total > heap_cnt) {
+        lv_timer_t * timer = HEAP[heap_cnt];
+        LV_GC_ROOT(_lv_timer_act) = timer;
+        timer_deleted = false;
+        lv_timer_exec(timer);
+
+        /*Unless it was deleted, paused or resumed, it's still a ready timer, maybe at an other index*/
+        if(!timer_deleted && timer->heap_idx != HEAP_NONE && timer->heap_idx >= heap_cnt) {
+            uint32_t i = timer->heap_idx;
+            heap_set(i, HEAP[heap_cnt]);
+            heap_set(heap_cnt, timer);
+            timer->due = timer->last_run + timer->period;
+            heap_cnt++;
+            heap_sift_up(heap_cnt - 1);
+        }
+    }
+    LV_GC_ROOT(_lv_timer_act) = NULL;
+}
+
+/**
+ * Add a timer to the heap
+ * @param timer pointer to a timer, not in the heap yet
+ * @return true: added, false: out of memory
+ */
+static bool heap_insert(lv_timer_t * timer)
+{
+    if(heap_total == heap_size) {
+        uint32_t new_size = heap_size ? heap_size * 2 : 8;
+        lv_timer_t ** new_heap = lv_mem_realloc(HEAP, new_size * sizeof(lv_timer_t *));
+        LV_ASSERT_MALLOC(new_heap);
+        if(new_heap == NULL) {
+            timer->heap_idx = HEAP_NONE;
+            return false;
+        }
+        HEAP = new_heap;
+        heap_size = new_size;
+    }
+
+    /*Make room at the end of the heap by moving the first ready timer to the end*/
+    if(heap_total > heap_cnt) heap_set(heap_total, HEAP[heap_cnt]);
+    heap_total++;
+
+    timer->due = timer->last_run + timer->period;
+    heap_set(heap_cnt, timer);
+    heap_cnt++;
+    heap_sift_up(heap_cnt - 1);
+    return true;
+}
+
+/**
+ * Remove a timer from the heap or the ready timers
+ * @param timer pointer to a timer
+ */
+static void heap_remove(lv_timer_t * timer)
+{
+    uint32_t i = timer->heap_idx;
+    if(i == HEAP_NONE) return;
+    timer->heap_idx = HEAP_NONE;
+
+    if(i < heap_cnt) {
+        /*Fill the hole with the last element of the heap and restore the order*/
+        heap_cnt--;
+        if(i != heap_cnt) {
+            lv_timer_t * moved = HEAP[heap_cnt];
+            heap_set(i, moved);
+            heap_sift_up(i);
+            heap_sift_down(moved->heap_idx);
+        }
+        /*Now the hole is the first slot of the ready timers*/
+        i = heap_cnt;
+    }
+
+    heap_total--;
+    if(i != heap_total) heap_set(i, HEAP[heap_total]);
+}
+
+/**
+ * Move a timer to its place after `last_run` or `period` changed
+ * @param timer pointer to a timer
+ */
+static void heap_update(lv_timer_t * timer)
+{
+    uint32_t i = timer->heap_idx;
+    /*The ready timers are sorted when they return to the heap*/
+    if(i == HEAP_NONE || i >= heap_cnt) return;
+
+    timer->due = timer->last_run + timer->period;
+    heap_sift_up(i);
+    heap_sift_down(timer->heap_idx);
+}
+
+static void heap_set(uint32_t i, lv_timer_t * timer)
+{
+    HEAP[i] = timer;
+    timer->heap_idx = i;
+}
+
+/*`due` can wrap around, the timer due sooner is the one less than half of the range before the other*/
+static inline bool heap_due_before(const lv_timer_t * a, const lv_timer_t * b)
+{
+    return (int32_t)(a->due - b->due) < 0;
+}
+
+static void heap_sift_up(uint32_t i)
+{
+    lv_timer_t * timer = HEAP[i];
+    while(i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if(!heap_due_before(timer, HEAP[parent])) break;
+        heap_set(i, HEAP[parent]);
+        i = parent;
+    }
+    heap_set(i, timer);
+}
+
+static void heap_sift_down(uint32_t i)
+{
+    lv_timer_t * timer = HEAP[i];
+    while(1) {
+        uint32_t child = 2 * i + 1;
+        if(child >= heap_cnt) break;
+        if(child + 1 < heap_cnt && heap_due_before(HEAP[child + 1], HEAP[child])) child++;
+        if(!heap_due_before(HEAP[child], timer)) break;
+        heap_set(i, HEAP[child]);
+        i = child;
+    }
+    heap_set(i, timer);
+}
+
+#endif /*LV_USE_TIMER_HEAP*/
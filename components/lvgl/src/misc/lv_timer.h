@@ -48,6 +48,10 @@ typedef struct _lv_timer_t {
     void * user_data; /**< Custom user data*/
     int32_t repeat_count; /**< 1: One time;  -1 : infinity;  n>0: residual times*/
     uint32_t paused : 1;
+#if LV_USE_TIMER_HEAP
+    uint32_t due; /**< `last_run + period`, the key of the timer in the heap*/
+    uint32_t heap_idx; /**< Index in the heap or the ready timers of `lv_timer_handler`*/
+#endif
 } lv_timer_t;
 
 /**********************
@@ -165,6 +169,22 @@ void lv_timer_enable(bool en);
  */
 uint8_t lv_timer_get_idle(void);
 
+/**
+ * Get the time until the first timer must run. It's also the return value of `lv_timer_handler()`.
+ * Useful to see how long to sleep after something else created or changed a timer.
+ * @return the time in ms, 0 if a timer is ready or `LV_NO_TIMER_READY` if all timers are paused
+ */
+uint32_t lv_timer_get_time_till_next(void);
+
+#if LV_USE_TIMER_HEAP
+/**
+ * Run the timers in the order of the heap or walk all of them like without `LV_USE_TIMER_HEAP`.
+ * The heap is maintained in both cases. Enabled by default, disable it for comparisons.
+ * @param en true: use the heap
+ */
+void lv_timer_heap_set_enabled(bool en);
+#endif
+
 /**
  * Iterate through the timers
  * @param timer NULL to start iteration or the previous return value to get the next timer
@@ -0,0 +1,230 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#if LV_DRAW_COMPLEX && LV_ARC_MASK_CACHE_SIZE > 0
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "unity/unity.h"
+
+#define UPDATE_CNT  1000
+
+static lv_obj_t * active_screen = NULL;
+static lv_obj_t * arc = NULL;
+static uint8_t ref_buf[800 * 480 * 4];
+
+void setUp(void)
+{
+    active_screen = lv_scr_act();
+    arc = lv_arc_create(active_screen);
+    lv_obj_remove_style(arc, NULL, LV_PART_KNOB);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(active_screen);
+    lv_draw_sw_arc_cache_set_size(LV_ARC_MASK_CACHE_SIZE);
+}
+
+static uint32_t disp_buf_size(void)
+{
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_default()->driver->draw_buf;
+    return draw_buf->size * sizeof(lv_color_t);
+}
+
+static void * disp_buf(void)
+{
+    return lv_disp_get_default()->driver->draw_buf->buf1;
+}
+
+/*Render the screen with and without the cache and compare the results*/
+static void assert_same_as_masked(void)
+{
+    lv_draw_sw_arc_cache_set_size(0);
+    lv_obj_invalidate(active_screen);
+    lv_refr_now(NULL);
+    memcpy(ref_buf, disp_buf(), disp_buf_size());
+
+    lv_draw_sw_arc_cache_set_size(LV_ARC_MASK_CACHE_SIZE);
+    lv_obj_invalidate(active_screen);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, disp_buf(), disp_buf_size());
+}
+
+static uint32_t time_updates(void)
+{
+    struct timespec t1;
+    struct timespec t2;
+    uint32_t i;
+
+    lv_arc_set_value(arc, 0);
+    lv_refr_now(NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    for(i = 0; i < UPDATE_CNT; i++) {
+        lv_arc_set_value(arc, i % 100);
+        lv_refr_now(NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+
+    return (uint32_t)((t2.tv_sec - t1.tv_sec) * 1000000 + (t2.tv_nsec - t1.tv_nsec) / 1000);
+}
+
+void test_arc_mask_cache_should_draw_the_same_as_masks(void)
+{
+    static const lv_coord_t sizes[] = {5, 20, 51, 120, 240, 401};
+    static const lv_coord_t widths[] = {1, 3, 10, 25, 200};
+    static const int16_t angles[][2] = {{0, 360}, {135, 45}, {0, 90}, {89, 91}, {200, 10}, {270, 269}, {10, 300}};
+    uint32_t s, w, a;
+
+    for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        for(w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+            for(a = 0; a < sizeof(angles) / sizeof(angles[0]); a++) {
+                lv_obj_set_size(arc, sizes[s], sizes[s]);
+                lv_obj_set_pos(arc, 13 * a - 20, 7 * w - 10);
+                lv_obj_set_style_arc_width(arc, widths[w], LV_PART_MAIN);
+                lv_obj_set_style_arc_width(arc, widths[w] / 2 + 1, LV_PART_INDICATOR);
+                lv_obj_set_style_arc_rounded(arc, (a & 1) != 0, LV_PART_MAIN);
+                lv_obj_set_style_arc_rounded(arc, (s & 1) != 0, LV_PART_INDICATOR);
+                lv_arc_set_bg_angles(arc, angles[a][0], angles[a][1]);
+                lv_arc_set_value(arc, 37);
+                assert_same_as_masked();
+            }
+        }
+    }
+}
+
+void test_arc_mask_cache_should_fall_back_with_opa_and_masks(void)
+{
+    lv_obj_set_size(arc, 200, 200);
+    lv_obj_set_style_arc_opa(arc, LV_OPA_50, LV_PART_INDICATOR);
+    lv_arc_set_value(arc, 60);
+    assert_same_as_masked();
+
+    /*Clipped by the rounded corner of the parent*/
+    lv_obj_t * cont = lv_obj_create(active_screen);
+    lv_obj_set_size(cont, 150, 150);
+    lv_obj_set_style_radius(cont, 50, 0);
+    lv_obj_set_style_clip_corner(cont, true, 0);
+    lv_obj_set_parent(arc, cont);
+    assert_same_as_masked();
+}
+
+void test_arc_mask_cache_should_reuse_rings(void)
+{
+    lv_draw_sw_arc_cache_stats_t stats;
+
+    lv_obj_set_size(arc, 240, 240);
+    lv_obj_center(arc);
+    lv_refr_now(NULL);
+
+    lv_draw_sw_arc_cache_reset_stats();
+    uint32_t i;
+    for(i = 0; i < 50; i++) {
+        lv_arc_set_value(arc, i * 2);
+        lv_refr_now(NULL);
+    }
+
+    lv_draw_sw_arc_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.miss_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(50, stats.hit_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.size);
+
+    lv_draw_sw_arc_cache_clear();
+    lv_draw_sw_arc_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.size);
+}
+
+static void draw_many_rings(void)
+{
+    /*More rings than the cache can hold*/
+    uint32_t i;
+    for(i = 0; i < 3 * LV_ARC_MASK_CACHE_SIZE; i++) {
+        lv_obj_set_size(arc, 50 + i * 10, 50 + i * 10);
+        lv_refr_now(NULL);
+    }
+    lv_draw_sw_arc_cache_clear();
+}
+
+void test_arc_mask_cache_should_not_leak_memory(void)
+{
+    lv_mem_monitor_t monitor;
+
+    /*Let the draw buffers of `lv_mem_buf_get` grow first*/
+    draw_many_rings();
+    lv_mem_monitor(&monitor);
+    uint32_t initial_free_size = monitor.free_size;
+
+    draw_many_rings();
+    lv_mem_monitor(&monitor);
+    TEST_ASSERT_EQUAL_UINT32(initial_free_size, monitor.free_size);
+}
+
+static uint32_t time_canvas_draws(lv_obj_t * canvas, const lv_draw_arc_dsc_t * dsc)
+{
+    struct timespec t1;
+    struct timespec t2;
+    uint32_t i;
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    for(i = 0; i < UPDATE_CNT; i++) {
+        lv_canvas_draw_arc(canvas, 120, 120, 120, 135, 135 + (i % 270), dsc);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+
+    return (uint32_t)((t2.tv_sec - t1.tv_sec) * 1000000 + (t2.tv_nsec - t1.tv_nsec) / 1000);
+}
+
+static void print_speed_up(const char * name, uint32_t masked_us, uint32_t cached_us)
+{
+    printf("arc mask cache, %s: %d in %d us with masks, %d us cached (%d.%02dx)\n",
+           name, UPDATE_CNT, (int)masked_us, (int)cached_us,
+           (int)(masked_us / cached_us), (int)((masked_us * 100 / cached_us) % 100));
+}
+
+void test_arc_mask_cache_update_time(void)
+{
+    lv_obj_set_size(arc, 240, 240);
+    lv_obj_set_style_arc_width(arc, 20, LV_PART_MAIN);
+    lv_obj_set_style_arc_width(arc, 20, LV_PART_INDICATOR);
+    lv_obj_center(arc);
+
+    lv_draw_sw_arc_cache_set_size(0);
+    uint32_t masked_us = time_updates();
+
+    lv_draw_sw_arc_cache_set_size(LV_ARC_MASK_CACHE_SIZE);
+    uint32_t cached_us = time_updates();
+
+    /*The rest of the refresh (background, widget, flush) is the same in both cases*/
+    print_speed_up("widget updates", masked_us, cached_us);
+    TEST_PASS();
+}
+
+void test_arc_mask_cache_draw_time(void)
+{
+    static lv_color_t cbuf[LV_CANVAS_BUF_SIZE_TRUE_COLOR(240, 240)];
+    lv_obj_t * canvas = lv_canvas_create(active_screen);
+    lv_canvas_set_buffer(canvas, cbuf, 240, 240, LV_IMG_CF_TRUE_COLOR);
+
+    lv_draw_arc_dsc_t dsc;
+    lv_draw_arc_dsc_init(&dsc);
+    dsc.width = 20;
+    dsc.rounded = 1;
+    dsc.color = lv_color_hex(0x2196f3);
+
+    lv_draw_sw_arc_cache_set_size(0);
+    uint32_t masked_us = time_canvas_draws(canvas, &dsc);
+
+    lv_draw_sw_arc_cache_set_size(LV_ARC_MASK_CACHE_SIZE);
+    uint32_t cached_us = time_canvas_draws(canvas, &dsc);
+
+    print_speed_up("arc draws", masked_us, cached_us);
+    TEST_PASS();
+}
+
+#endif
+
+#endif
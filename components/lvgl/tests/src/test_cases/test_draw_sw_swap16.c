@@ -0,0 +1,232 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#if LV_USE_DRAW_SW_SWAP16
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "unity/unity.h"
+
+#define BUF_W       240
+#define BUF_H       240
+#define BENCH_CNT   50
+
+/*The swapped 16 bit color of lv_color.h, blended the way `lv_draw_sw_blend_basic()` does with it*/
+typedef union {
+    struct {
+        uint16_t green_h : 3;
+        uint16_t red : 5;
+        uint16_t blue : 5;
+        uint16_t green_l : 3;
+    } ch;
+    uint16_t full;
+} ref_color_t;
+
+static uint16_t ref_buf[BUF_W * BUF_H];
+static uint16_t test_buf[BUF_W * BUF_H];
+static uint16_t src_buf[BUF_W * BUF_H];
+static lv_opa_t mask_buf[BUF_W * BUF_H];
+static uint32_t rnd_state;
+
+void setUp(void)
+{
+    rnd_state = 12345;
+}
+
+void tearDown(void)
+{
+}
+
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return rnd_state >> 8;
+}
+
+static uint16_t ref_mix(uint16_t fg, uint16_t bg, uint32_t mix)
+{
+    ref_color_t c1;
+    ref_color_t c2;
+    ref_color_t ret;
+    c1.full = fg;
+    c2.full = bg;
+    uint32_t g1 = (c1.ch.green_h << 3) + c1.ch.green_l;
+    uint32_t g2 = (c2.ch.green_h << 3) + c2.ch.green_l;
+    uint32_t g = LV_UDIV255(g1 * mix + g2 * (255 - mix) + LV_COLOR_MIX_ROUND_OFS);
+    ret.ch.red = LV_UDIV255(c1.ch.red * mix + c2.ch.red * (255 - mix) + LV_COLOR_MIX_ROUND_OFS);
+    ret.ch.blue = LV_UDIV255(c1.ch.blue * mix + c2.ch.blue * (255 - mix) + LV_COLOR_MIX_ROUND_OFS);
+    ret.ch.green_h = (g >> 3) & 0x7;
+    ret.ch.green_l = g & 0x7;
+    return ret.full;
+}
+
+static void ref_fill(uint16_t * dest, lv_coord_t dest_stride, lv_coord_t w, lv_coord_t h, uint16_t color,
+                     lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    lv_coord_t x;
+    lv_coord_t y;
+    if(mask == NULL && opa < LV_OPA_MAX) {
+#if LV_COLOR_MIX_ROUND_OFS == 0
+        opa = (uint32_t)((uint32_t)opa + 4) >> 3;
+        opa = opa << 3;
+#endif
+    }
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            if(mask == NULL) {
+                dest[x] = opa >= LV_OPA_MAX ? color : ref_mix(color, dest[x], opa);
+            }
+            else if(mask[x] && opa >= LV_OPA_MAX) {
+                dest[x] = mask[x] == LV_OPA_COVER ? color : ref_mix(color, dest[x], mask[x]);
+            }
+            else if(mask[x]) {
+                lv_opa_t opa_tmp = mask[x] == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)mask[x] * opa) >> 8;
+                dest[x] = opa_tmp == LV_OPA_COVER ? color : ref_mix(color, dest[x], opa_tmp);
+            }
+        }
+        dest += dest_stride;
+        if(mask) mask += mask_stride;
+    }
+}
+
+static void ref_map(uint16_t * dest, lv_coord_t dest_stride, const uint16_t * src, lv_coord_t src_stride,
+                    lv_coord_t w, lv_coord_t h, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            if(mask == NULL) {
+                dest[x] = opa >= LV_OPA_MAX ? src[x] : ref_mix(src[x], dest[x], opa);
+            }
+            else if(mask[x] && opa > LV_OPA_MAX) {
+                dest[x] = mask[x] == LV_OPA_COVER ? src[x] : ref_mix(src[x], dest[x], mask[x]);
+            }
+            else if(mask[x]) {
+                lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
+                dest[x] = ref_mix(src[x], dest[x], opa_tmp);
+            }
+        }
+        dest += dest_stride;
+        src += src_stride;
+        if(mask) mask += mask_stride;
+    }
+}
+
+/*Random pixels and a mask with transparent, covering and anti-aliased runs like the masks of the renderer*/
+static void fill_random(void)
+{
+    uint32_t i;
+    for(i = 0; i < BUF_W * BUF_H; i++) {
+        ref_buf[i] = (uint16_t)rnd();
+        src_buf[i] = (uint16_t)rnd();
+    }
+    memcpy(test_buf, ref_buf, sizeof(ref_buf));
+
+    i = 0;
+    while(i < BUF_W * BUF_H) {
+        uint32_t run = 1 + rnd() % 12;
+        uint32_t kind = rnd() % 3;
+        for(; run > 0 && i < BUF_W * BUF_H; run--, i++) {
+            mask_buf[i] = kind == 0 ? LV_OPA_TRANSP : kind == 1 ? LV_OPA_COVER : (lv_opa_t)rnd();
+        }
+    }
+}
+
+static const lv_opa_t opas[] = {LV_OPA_COVER, 254, LV_OPA_MAX, 252, 200, LV_OPA_50, 77, 3};
+
+void test_draw_sw_swap16_fill_should_match_basic_blend(void)
+{
+    uint32_t o;
+    uint32_t i;
+    for(o = 0; o < sizeof(opas); o++) {
+        for(i = 0; i < 40; i++) {
+            fill_random();
+            /*Odd and even starting pixels, widths and mask offsets*/
+            lv_coord_t w = 1 + rnd() % 37;
+            lv_coord_t h = 1 + rnd() % 9;
+            uint32_t ofs = rnd() % 64;
+            uint32_t mask_ofs = rnd() % 64;
+            uint16_t color = (uint16_t)rnd();
+            const lv_opa_t * mask = (i & 1) ? &mask_buf[mask_ofs] : NULL;
+
+            ref_fill(&ref_buf[ofs], BUF_W, w, h, color, opas[o], mask, 50);
+            lv_draw_sw_swap16_fill(&test_buf[ofs], BUF_W, w, h, color, opas[o], mask, 50);
+            TEST_ASSERT_EQUAL_HEX16_ARRAY(ref_buf, test_buf, BUF_W * 10);
+        }
+    }
+}
+
+void test_draw_sw_swap16_map_should_match_basic_blend(void)
+{
+    uint32_t o;
+    uint32_t i;
+    for(o = 0; o < sizeof(opas); o++) {
+        for(i = 0; i < 40; i++) {
+            fill_random();
+            lv_coord_t w = 1 + rnd() % 37;
+            lv_coord_t h = 1 + rnd() % 9;
+            uint32_t ofs = rnd() % 64;
+            uint32_t src_ofs = rnd() % 64;
+            uint32_t mask_ofs = rnd() % 64;
+            const lv_opa_t * mask = (i & 1) ? &mask_buf[mask_ofs] : NULL;
+
+            ref_map(&ref_buf[ofs], BUF_W, &src_buf[src_ofs], 40, w, h, opas[o], mask, 50);
+            lv_draw_sw_swap16_map(&test_buf[ofs], BUF_W, &src_buf[src_ofs], 40, w, h, opas[o], mask, 50);
+            TEST_ASSERT_EQUAL_HEX16_ARRAY(ref_buf, test_buf, BUF_W * 10);
+        }
+    }
+}
+
+static uint32_t elapsed_us(const struct timespec * t1)
+{
+    struct timespec t2;
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    return (uint32_t)((t2.tv_sec - t1->tv_sec) * 1000000 + (t2.tv_nsec - t1->tv_nsec) / 1000);
+}
+
+/*Blend the whole buffer BENCH_CNT times with both blenders and print the pixel throughput*/
+static void bench(const char * name, bool map, lv_opa_t opa, bool masked)
+{
+    struct timespec t1;
+    const lv_opa_t * mask = masked ? mask_buf : NULL;
+    uint32_t i;
+
+    fill_random();
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    for(i = 0; i < BENCH_CNT; i++) {
+        if(map) ref_map(ref_buf, BUF_W, src_buf, BUF_W, BUF_W, BUF_H, opa, mask, BUF_W);
+        else ref_fill(ref_buf, BUF_W, BUF_W, BUF_H, (uint16_t)i, opa, mask, BUF_W);
+    }
+    uint32_t ref_us = elapsed_us(&t1);
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    for(i = 0; i < BENCH_CNT; i++) {
+        if(map) lv_draw_sw_swap16_map(test_buf, BUF_W, src_buf, BUF_W, BUF_W, BUF_H, opa, mask, BUF_W);
+        else lv_draw_sw_swap16_fill(test_buf, BUF_W, BUF_W, BUF_H, (uint16_t)i, opa, mask, BUF_W);
+    }
+    uint32_t swap16_us = elapsed_us(&t1);
+
+    uint32_t px = BENCH_CNT * BUF_W * BUF_H;
+    printf("swap16 blend, %-18s bitfields %4d Mpx/s, swap16 %4d Mpx/s\n", name,
+           (int)(px / LV_MAX(ref_us, 1)), (int)(px / LV_MAX(swap16_us, 1)));
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(ref_buf, test_buf, BUF_W * BUF_H);
+}
+
+void test_draw_sw_swap16_throughput(void)
+{
+    bench("fill:", false, LV_OPA_COVER, false);
+    bench("fill opa:", false, LV_OPA_50, false);
+    bench("fill mask:", false, LV_OPA_COVER, true);
+    bench("fill mask opa:", false, LV_OPA_50, true);
+    bench("map:", true, LV_OPA_COVER, false);
+    bench("map opa:", true, LV_OPA_50, false);
+    bench("map mask:", true, LV_OPA_COVER, true);
+    bench("map mask opa:", true, LV_OPA_50, true);
+}
+
+#endif
+
+#endif
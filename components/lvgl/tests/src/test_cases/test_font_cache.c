@@ -0,0 +1,308 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#if LV_FONT_CACHE_BUDGET > 0
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "unity/unity.h"
+
+#define UPDATE_CNT  1000
+
+static lv_obj_t * active_screen = NULL;
+static uint8_t ref_buf[800 * 480 * 4];
+
+void setUp(void)
+{
+    active_screen = lv_scr_act();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(active_screen);
+    lv_font_cache_set_budget(LV_FONT_CACHE_BUDGET);
+    lv_font_cache_set_mem_cb(NULL, NULL);
+}
+
+static uint32_t alloc_cnt;
+
+static void * count_alloc(size_t size)
+{
+    alloc_cnt++;
+    return lv_mem_alloc(size);
+}
+
+static uint32_t disp_buf_size(void)
+{
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_default()->driver->draw_buf;
+    return draw_buf->size * sizeof(lv_color_t);
+}
+
+static void * disp_buf(void)
+{
+    return lv_disp_get_default()->driver->draw_buf->buf1;
+}
+
+/*Render the screen without the cache, then with the given budget and compare the results*/
+static void assert_same_as_uncached(uint32_t budget)
+{
+    lv_font_cache_set_budget(0);
+    lv_obj_invalidate(active_screen);
+    lv_refr_now(NULL);
+    memcpy(ref_buf, disp_buf(), disp_buf_size());
+
+    lv_font_cache_set_budget(budget);
+    lv_obj_invalidate(active_screen);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, disp_buf(), disp_buf_size());
+
+    /*Again, from the cache*/
+    lv_obj_invalidate(active_screen);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, disp_buf(), disp_buf_size());
+}
+
+static lv_obj_t * label_create(const lv_font_t * font, const char * text, lv_coord_t y)
+{
+    lv_obj_t * label = lv_label_create(active_screen);
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_label_set_text(label, text);
+    lv_obj_set_y(label, y);
+    return label;
+}
+
+void test_font_cache_should_draw_the_same_as_uncached(void)
+{
+    label_create(&lv_font_montserrat_14, "Temperature: 23.5 \xC2\xB0" "C\tHumidity: 48 %", 0);
+    label_create(&lv_font_montserrat_18, "AVWa To 0123456789", 20);
+    lv_obj_t * label = label_create(&lv_font_montserrat_24, "Kerning: AV Ta Yo", 50);
+    lv_obj_set_style_text_opa(label, LV_OPA_50, 0);
+    lv_obj_set_style_text_color(label, lv_palette_main(LV_PALETTE_RED), 0);
+    label_create(&lv_font_montserrat_28_compressed, "Compressed 0123456789", 90);
+    label_create(&lv_font_montserrat_12_subpx, "Subpixel 0123456789", 130);
+    label = label_create(&lv_font_montserrat_48, "-12.5", 150);
+    lv_obj_set_x(label, -10);
+
+    assert_same_as_uncached(LV_FONT_CACHE_BUDGET);
+}
+
+void test_font_cache_should_evict_the_least_recently_used(void)
+{
+    lv_font_cache_stats_t stats;
+
+    label_create(&lv_font_montserrat_48, "0123456789", 0);
+    lv_obj_t * label = label_create(&lv_font_montserrat_48, "4444", 100);
+
+    /*Room for only a few large digits*/
+    lv_font_cache_set_budget(2048);
+    lv_obj_invalidate(active_screen);
+    lv_refr_now(NULL);
+    lv_font_cache_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.evict_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(stats.budget, stats.used);
+    TEST_ASSERT_EQUAL_UINT32(2048, stats.budget);
+
+    /*The most recently drawn "4" is still there*/
+    lv_font_cache_reset_stats();
+    lv_obj_invalidate(label);
+    lv_refr_now(NULL);
+    lv_font_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.hit_cnt);
+
+    assert_same_as_uncached(2048);
+}
+
+void test_font_cache_should_hit_on_redraw(void)
+{
+    lv_font_cache_stats_t stats;
+
+    label_create(&lv_font_montserrat_24, "12:34:56", 0);
+    lv_refr_now(NULL);
+
+    lv_font_cache_reset_stats();
+    lv_obj_invalidate(active_screen);
+    lv_refr_now(NULL);
+    lv_font_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(8, stats.hit_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.entry_cnt);
+
+    lv_font_cache_clear();
+    lv_font_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.used);
+}
+
+void test_font_cache_should_forget_freed_fonts(void)
+{
+    lv_font_cache_stats_t stats;
+    lv_font_cache_clear();
+
+    lv_font_t * font = lv_font_load("A:src/test_fonts/font_1.fnt");
+    TEST_ASSERT_NOT_NULL(font);
+    label_create(font, "AbC 123", 0);
+    lv_refr_now(NULL);
+    lv_font_cache_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.entry_cnt);
+
+    lv_obj_clean(active_screen);
+    lv_font_free(font);
+    lv_font_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.used);
+}
+
+void test_font_cache_should_not_leak_memory(void)
+{
+    lv_mem_monitor_t monitor;
+    lv_font_cache_clear();
+    lv_mem_monitor(&monitor);
+    uint32_t initial_free_size = monitor.free_size;
+
+    label_create(&lv_font_montserrat_24, "0123456789", 0);
+    lv_refr_now(NULL);
+    lv_obj_clean(active_screen);
+    lv_font_cache_clear();
+
+    lv_mem_monitor(&monitor);
+    TEST_ASSERT_EQUAL_UINT32(initial_free_size, monitor.free_size);
+}
+
+#if LV_MEM_CUSTOM == 0
+/*Allocate all the free memory but about `keep` bytes, the blocks are chained through their first word*/
+static void * hog_all_but(uint32_t keep)
+{
+    void * hogs = NULL;
+    uint32_t size;
+    for(size = 4096; size >= sizeof(void *); size /= 2) {
+        void * p;
+        while((p = lv_mem_alloc(size)) != NULL) {
+            *(void **)p = hogs;
+            hogs = p;
+        }
+    }
+
+    lv_mem_monitor_t monitor;
+    lv_mem_monitor(&monitor);
+    while(hogs && monitor.free_size < keep) {
+        void * next = *(void **)hogs;
+        lv_mem_free(hogs);
+        hogs = next;
+        lv_mem_monitor(&monitor);
+    }
+    return hogs;
+}
+
+static void free_hogs(void * hogs)
+{
+    while(hogs) {
+        void * next = *(void **)hogs;
+        lv_mem_free(hogs);
+        hogs = next;
+    }
+}
+
+void test_font_cache_should_draw_without_memory_for_the_cache(void)
+{
+    label_create(&lv_font_montserrat_14, "Temperature: 23.5 \xC2\xB0" "C", 0);
+    label_create(&lv_font_montserrat_24, "Kerning: AV Ta Yo", 50);
+    label_create(&lv_font_montserrat_48, "-12.5", 150);
+
+    lv_font_cache_set_budget(0);
+    lv_obj_invalidate(active_screen);
+    lv_refr_now(NULL);
+    memcpy(ref_buf, disp_buf(), disp_buf_size());
+
+    /*The buffer of the cache can't be allocated, the glyphs are drawn from the fonts.
+     *Leave a little memory for the draw buffers of the refresh.*/
+    lv_font_cache_set_budget(LV_FONT_CACHE_BUDGET);
+    void * hogs = hog_all_but(LV_FONT_CACHE_BUDGET / 2);
+    lv_mem_monitor_t monitor;
+    lv_mem_monitor(&monitor);
+    TEST_ASSERT_LESS_THAN_UINT32(LV_FONT_CACHE_BUDGET, monitor.free_biggest_size);
+    lv_obj_invalidate(active_screen);
+    lv_refr_now(NULL);
+    lv_font_cache_stats_t stats;
+    lv_font_cache_get_stats(&stats);
+    free_hogs(hogs);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, disp_buf(), disp_buf_size());
+
+    /*Cached again once there is memory*/
+    lv_obj_invalidate(active_screen);
+    lv_refr_now(NULL);
+    lv_font_cache_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, disp_buf(), disp_buf_size());
+}
+#endif
+
+void test_font_cache_mem_cb(void)
+{
+    alloc_cnt = 0;
+    lv_font_cache_set_mem_cb(count_alloc, lv_mem_free);
+    label_create(&lv_font_montserrat_24, "0123456789", 0);
+    lv_refr_now(NULL);
+
+    /*One buffer for the whole budget*/
+    lv_font_cache_stats_t stats;
+    lv_font_cache_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN_UINT32(1, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, alloc_cnt);
+
+    /*The cache is cleared*/
+    lv_font_cache_set_mem_cb(NULL, NULL);
+    lv_font_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+}
+
+static uint32_t time_updates(lv_obj_t * label)
+{
+    struct timespec t1;
+    struct timespec t2;
+    uint32_t i;
+
+    lv_refr_now(NULL);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    for(i = 0; i < UPDATE_CNT; i++) {
+        lv_label_set_text_fmt(label, "%02d:%02d:%02d  %d.%d \xC2\xB0" "C  %d %%",
+                              (int)(i / 3600) % 24, (int)(i / 60) % 60, (int)i % 60, (int)(i % 40), (int)(i % 10), (int)(i % 100));
+        lv_refr_now(NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+
+    return (uint32_t)((t2.tv_sec - t1.tv_sec) * 1000000 + (t2.tv_nsec - t1.tv_nsec) / 1000);
+}
+
+static void print_update_time(const lv_font_t * font, const char * name)
+{
+    lv_obj_t * label = label_create(font, "", 0);
+
+    lv_font_cache_set_budget(0);
+    uint32_t uncached_us = time_updates(label);
+
+    lv_font_cache_set_budget(LV_FONT_CACHE_BUDGET);
+    uint32_t cached_us = time_updates(label);
+
+    lv_font_cache_stats_t stats;
+    lv_font_cache_get_stats(&stats);
+    printf("font cache, %s: %d label updates in %d us uncached, %d us cached (%d.%02dx), %d glyphs in %d bytes\n",
+           name, UPDATE_CNT, (int)uncached_us, (int)cached_us,
+           (int)(uncached_us / cached_us), (int)((uncached_us * 100 / cached_us) % 100),
+           (int)stats.entry_cnt, (int)stats.used);
+
+    lv_obj_del(label);
+}
+
+void test_font_cache_update_time(void)
+{
+    print_update_time(&lv_font_montserrat_24, "montserrat_24");
+    print_update_time(&lv_font_montserrat_28_compressed, "montserrat_28_compressed");
+    TEST_PASS();
+}
+
+#endif
+
+#endif
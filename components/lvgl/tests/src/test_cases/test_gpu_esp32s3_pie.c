@@ -0,0 +1,134 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/esp32s3_pie/lv_gpu_esp32s3_pie.h"
+
+#if LV_USE_GPU_ESP32S3_PIE && LV_USE_DRAW_SW_SWAP16
+
+#include <string.h>
+#include "unity/unity.h"
+
+/*The PIE kernels (their C reference here) against the C blender of swapped RGB565, which is checked against the
+ *bitfields of lv_color_t in test_draw_sw_swap16.c*/
+
+#define BUF_W       256
+#define BUF_H       16
+
+static uint16_t ref_buf[BUF_W * BUF_H];
+static uint16_t test_buf[BUF_W * BUF_H];
+static uint16_t src_buf[BUF_W * BUF_H];
+static lv_opa_t mask_buf[BUF_W * BUF_H];
+static uint32_t rnd_state;
+
+void setUp(void)
+{
+    rnd_state = 54321;
+}
+
+void tearDown(void)
+{
+}
+
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return rnd_state >> 8;
+}
+
+/*Random pixels and a mask with transparent, covering and anti-aliased runs, some of them longer than a chunk*/
+static void fill_random(void)
+{
+    uint32_t i;
+    for(i = 0; i < BUF_W * BUF_H; i++) {
+        ref_buf[i] = (uint16_t)rnd();
+        src_buf[i] = (uint16_t)rnd();
+    }
+    memcpy(test_buf, ref_buf, sizeof(ref_buf));
+
+    i = 0;
+    while(i < BUF_W * BUF_H) {
+        uint32_t run = 1 + rnd() % ((rnd() & 3) ? 12 : 150);
+        uint32_t kind = rnd() % 3;
+        for(; run > 0 && i < BUF_W * BUF_H; run--, i++) {
+            mask_buf[i] = kind == 0 ? LV_OPA_TRANSP : kind == 1 ? LV_OPA_COVER : (lv_opa_t)rnd();
+        }
+    }
+}
+
+static const lv_opa_t opas[] = {LV_OPA_COVER, 254, LV_OPA_MAX, 252, 200, LV_OPA_50, 77, 3};
+
+void test_gpu_esp32s3_pie_kernels_match_reference(void)
+{
+    TEST_ASSERT_TRUE(lv_gpu_esp32s3_pie_check());
+}
+
+void test_gpu_esp32s3_pie_fill_should_match_sw(void)
+{
+    uint32_t o;
+    uint32_t i;
+    for(o = 0; o < sizeof(opas); o++) {
+        for(i = 0; i < 40; i++) {
+            fill_random();
+            /*Every alignment of the first pixel, narrow areas and ones with more than a chunk per row*/
+            lv_coord_t w = 1 + rnd() % ((i & 2) ? 200 : 20);
+            lv_coord_t h = 1 + rnd() % 5;
+            uint32_t ofs = rnd() % 32;
+            uint32_t mask_ofs = rnd() % 32;
+            uint16_t color = (uint16_t)rnd();
+            const lv_opa_t * mask = (i & 1) ? &mask_buf[mask_ofs] : NULL;
+
+            lv_draw_sw_swap16_fill(&ref_buf[ofs], BUF_W, w, h, color, opas[o], mask, 220);
+            lv_gpu_esp32s3_pie_fill(&test_buf[ofs], BUF_W, w, h, color, opas[o], mask, 220);
+            TEST_ASSERT_EQUAL_HEX16_ARRAY(ref_buf, test_buf, BUF_W * BUF_H);
+        }
+    }
+}
+
+void test_gpu_esp32s3_pie_map_should_match_sw(void)
+{
+    uint32_t o;
+    uint32_t i;
+    for(o = 0; o < sizeof(opas); o++) {
+        for(i = 0; i < 40; i++) {
+            fill_random();
+            lv_coord_t w = 1 + rnd() % ((i & 2) ? 200 : 20);
+            lv_coord_t h = 1 + rnd() % 5;
+            uint32_t ofs = rnd() % 32;
+            /*The image aligned like the destination and not*/
+            uint32_t src_ofs = (i & 4) ? ofs : rnd() % 32;
+            uint32_t mask_ofs = rnd() % 32;
+            const lv_opa_t * mask = (i & 1) ? &mask_buf[mask_ofs] : NULL;
+
+            lv_draw_sw_swap16_map(&ref_buf[ofs], BUF_W, &src_buf[src_ofs], 224, w, h, opas[o], mask, 220);
+            lv_gpu_esp32s3_pie_map(&test_buf[ofs], BUF_W, &src_buf[src_ofs], 224, w, h, opas[o], mask, 220);
+            TEST_ASSERT_EQUAL_HEX16_ARRAY(ref_buf, test_buf, BUF_W * BUF_H);
+        }
+    }
+}
+
+/*Every foreground, background and mix ratio of a channel*/
+void test_gpu_esp32s3_pie_mix_every_ratio(void)
+{
+    static const uint16_t colors[] = {0x0000, 0xFFFF, 0x1F00, 0x00F8, 0xE007, 0x5AA5, 0xA55A, 0x0821};
+    uint32_t fg;
+    uint32_t bg;
+    uint32_t opa;
+    for(fg = 0; fg < sizeof(colors) / sizeof(colors[0]); fg++) {
+        for(bg = 0; bg < sizeof(colors) / sizeof(colors[0]); bg++) {
+            for(opa = 0; opa < 256; opa++) {
+                uint32_t i;
+                for(i = 0; i < 24; i++) {
+                    ref_buf[i] = colors[bg];
+                    test_buf[i] = colors[bg];
+                    mask_buf[i] = (lv_opa_t)opa;
+                }
+                lv_draw_sw_swap16_fill(ref_buf, 24, 24, 1, colors[fg], LV_OPA_COVER, mask_buf, 24);
+                lv_gpu_esp32s3_pie_fill(test_buf, 24, 24, 1, colors[fg], LV_OPA_COVER, mask_buf, 24);
+                TEST_ASSERT_EQUAL_HEX16_ARRAY(ref_buf, test_buf, 24);
+            }
+        }
+    }
+}
+
+#endif
+
+#endif
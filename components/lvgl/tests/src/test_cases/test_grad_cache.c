@@ -0,0 +1,154 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#if LV_GRAD_CACHE_DEF_SIZE
+
+#include <string.h>
+#include "unity/unity.h"
+
+static lv_obj_t * active_screen = NULL;
+static uint8_t ref_buf[800 * 480 * 4];
+static uint32_t alloc_cnt;
+
+void setUp(void)
+{
+    active_screen = lv_scr_act();
+    lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
+    lv_gradient_reset_cache_stats();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(active_screen);
+    lv_gradient_set_cache_mem_cb(NULL, NULL);
+    lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
+}
+
+static void * count_alloc(size_t size)
+{
+    alloc_cnt++;
+    return lv_mem_alloc(size);
+}
+
+static uint32_t disp_buf_size(void)
+{
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_default()->driver->draw_buf;
+    return draw_buf->size * sizeof(lv_color_t);
+}
+
+static void * disp_buf(void)
+{
+    return lv_disp_get_default()->driver->draw_buf->buf1;
+}
+
+static void refresh(void)
+{
+    lv_obj_invalidate(active_screen);
+    lv_refr_now(NULL);
+}
+
+static lv_obj_t * grad_obj(lv_coord_t x, lv_color_t c1, lv_color_t c2, lv_grad_dir_t dir)
+{
+    lv_obj_t * obj = lv_obj_create(active_screen);
+    lv_obj_set_pos(obj, x, 10);
+    lv_obj_set_size(obj, 60, 100);
+    lv_obj_set_style_bg_color(obj, c1, 0);
+    lv_obj_set_style_bg_grad_color(obj, c2, 0);
+    lv_obj_set_style_bg_grad_dir(obj, dir, 0);
+    return obj;
+}
+
+static lv_grad_t * get_grad(lv_color_t c1, lv_color_t c2, lv_coord_t w, lv_coord_t h)
+{
+    lv_grad_dsc_t dsc;
+    lv_memset_00(&dsc, sizeof(dsc));
+    dsc.stops[0].color = c1;
+    dsc.stops[1].color = c2;
+    dsc.stops[1].frac = 255;
+    dsc.stops_count = 2;
+    dsc.dir = LV_GRAD_DIR_VER;
+    lv_grad_t * grad = lv_gradient_get(&dsc, w, h);
+    TEST_ASSERT_NOT_NULL(grad);
+    lv_gradient_cleanup(grad);
+    return grad;
+}
+
+void test_grad_cache_same_screenshot(void)
+{
+    /*Same size, other colors: the gradients must not be mixed up*/
+    grad_obj(10, lv_color_hex(0xff0000), lv_color_hex(0x0000ff), LV_GRAD_DIR_VER);
+    grad_obj(80, lv_color_hex(0x00ff00), lv_color_hex(0x000000), LV_GRAD_DIR_VER);
+    grad_obj(150, lv_color_hex(0x00ff00), lv_color_hex(0x000000), LV_GRAD_DIR_HOR);
+
+    lv_gradient_set_cache_size(0);
+    refresh();
+    memcpy(ref_buf, disp_buf(), disp_buf_size());
+
+    /*Twice to draw from the cache*/
+    lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
+    refresh();
+    lv_gradient_reset_cache_stats();
+    refresh();
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, disp_buf(), disp_buf_size());
+
+    lv_grad_cache_stats_t stats;
+    lv_gradient_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.miss_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(3, stats.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.entry_cnt);
+}
+
+void test_grad_cache_eviction(void)
+{
+    get_grad(lv_color_hex(0xff0000), lv_color_hex(0x0000ff), 40, 40);
+    lv_grad_cache_stats_t stats;
+    lv_gradient_get_cache_stats(&stats);
+    uint32_t item_size = stats.used;
+
+    /*Room for 2 gradients*/
+    lv_gradient_set_cache_size(item_size * 2 + item_size / 2);
+    get_grad(lv_color_hex(0xff0000), lv_color_hex(0x0000ff), 40, 40);
+    get_grad(lv_color_hex(0xff0000), lv_color_hex(0x0000ff), 40, 40);
+    get_grad(lv_color_hex(0x00ff00), lv_color_hex(0x0000ff), 40, 40);
+
+    /*The red one is used more so the green one goes even though it's the most recent*/
+    lv_gradient_reset_cache_stats();
+    get_grad(lv_color_hex(0x0000ff), lv_color_hex(0x0000ff), 40, 40);
+    get_grad(lv_color_hex(0xff0000), lv_color_hex(0x0000ff), 40, 40);
+    lv_gradient_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.evict_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(item_size * 2, stats.used);
+
+    /*Too large for the cache: allocated for one draw only*/
+    get_grad(lv_color_hex(0xff0000), lv_color_hex(0x0000ff), 400, 400);
+    lv_gradient_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.skip_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.entry_cnt);
+}
+
+void test_grad_cache_mem_cb(void)
+{
+    alloc_cnt = 0;
+    lv_gradient_set_cache_mem_cb(count_alloc, lv_mem_free);
+    get_grad(lv_color_hex(0xff0000), lv_color_hex(0x0000ff), 40, 40);
+    get_grad(lv_color_hex(0x00ff00), lv_color_hex(0x0000ff), 40, 40);
+
+    /*The whole cache is allocated at once*/
+    TEST_ASSERT_EQUAL_UINT32(1, alloc_cnt);
+
+    lv_grad_cache_stats_t stats;
+    lv_gradient_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(LV_GRAD_CACHE_DEF_SIZE, stats.budget);
+
+    lv_gradient_free_cache();
+    lv_gradient_get_cache_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.used);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,180 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#if LV_IMG_CACHE_BUDGET
+
+#include <string.h>
+#include "unity/unity.h"
+
+#define IMG_SIZE 32
+
+static lv_obj_t * active_screen = NULL;
+static uint8_t ref_buf[800 * 480 * 4];
+static lv_img_dsc_t imgs[3];
+static uint8_t img_data[3][8 + IMG_SIZE * IMG_SIZE / 8];
+static uint32_t alloc_cnt;
+
+void setUp(void)
+{
+    active_screen = lv_scr_act();
+    lv_img_cache_set_budget(LV_IMG_CACHE_BUDGET);
+    lv_img_cache_reset_stats();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(active_screen);
+    lv_img_cache_set_mem_cb(NULL, NULL);
+    lv_img_cache_set_budget(LV_IMG_CACHE_BUDGET);
+}
+
+static void * count_alloc(size_t size)
+{
+    alloc_cnt++;
+    return lv_mem_alloc(size);
+}
+
+/*An indexed image, decoded line by line by the built-in decoder*/
+static const lv_img_dsc_t * indexed_img(uint32_t i)
+{
+    lv_color32_t * palette = (lv_color32_t *)img_data[i];
+    palette[0].full = 0xff000000 | (0x40 * i);
+    palette[1].full = 0xffffff00;
+    uint32_t b;
+    for(b = 8; b < sizeof(img_data[i]); b++) img_data[i][b] = (uint8_t)(0x55 << (b & 1));
+
+    imgs[i].header.always_zero = 0;
+    imgs[i].header.w = IMG_SIZE;
+    imgs[i].header.h = IMG_SIZE;
+    imgs[i].header.cf = LV_IMG_CF_INDEXED_1BIT;
+    imgs[i].data_size = sizeof(img_data[i]);
+    imgs[i].data = img_data[i];
+    return &imgs[i];
+}
+
+static uint32_t disp_buf_size(void)
+{
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_default()->driver->draw_buf;
+    return draw_buf->size * sizeof(lv_color_t);
+}
+
+static void * disp_buf(void)
+{
+    return lv_disp_get_default()->driver->draw_buf->buf1;
+}
+
+static void refresh(void)
+{
+    lv_obj_invalidate(active_screen);
+    lv_refr_now(NULL);
+}
+
+static void open_and_close(const void * src)
+{
+    _lv_img_cache_entry_t * entry = _lv_img_cache_open(src, lv_color_black(), 0);
+    TEST_ASSERT_NOT_NULL(entry);
+    _lv_img_cache_cleanup(entry);
+}
+
+void test_img_cache_decodes_once(void)
+{
+    lv_obj_t * img = lv_img_create(active_screen);
+    lv_img_set_src(img, indexed_img(0));
+    refresh();
+    refresh();
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.decode_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.entry_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(IMG_SIZE * IMG_SIZE * LV_IMG_PX_SIZE_ALPHA_BYTE, stats.used);
+}
+
+void test_img_cache_same_screenshot(void)
+{
+    lv_obj_t * img = lv_img_create(active_screen);
+    lv_img_set_src(img, indexed_img(0));
+    lv_obj_t * img2 = lv_img_create(active_screen);
+    lv_img_set_src(img2, indexed_img(1));
+    lv_obj_set_pos(img2, 100, 100);
+    lv_obj_set_style_img_recolor(img2, lv_color_hex(0x00ff00), 0);
+    lv_obj_set_style_img_recolor_opa(img2, LV_OPA_50, 0);
+
+    /*Read line by line on every draw. Not transformed as the lines can't be*/
+    lv_img_cache_set_budget(0);
+    refresh();
+    memcpy(ref_buf, disp_buf(), disp_buf_size());
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(stats.miss_cnt, stats.skip_cnt);
+
+    /*Twice to draw from the cache*/
+    lv_img_cache_set_budget(LV_IMG_CACHE_BUDGET);
+    refresh();
+    refresh();
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, disp_buf(), disp_buf_size());
+}
+
+void test_img_cache_budget_and_eviction(void)
+{
+    open_and_close(indexed_img(0));
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    uint32_t entry_size = stats.used;
+
+    /*Room for 2 images*/
+    lv_img_cache_set_budget(entry_size * 2 + entry_size / 2);
+    open_and_close(&imgs[0]);
+    open_and_close(&imgs[0]);
+    open_and_close(indexed_img(1));
+
+    /*Image 0 is used more so image 1 goes even though it's the most recent*/
+    lv_img_cache_reset_stats();
+    open_and_close(indexed_img(2));
+    open_and_close(&imgs[0]);
+    open_and_close(&imgs[2]);
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.evict_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.entry_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(stats.budget, stats.used);
+
+    /*Too large for the budget: opened for one draw only*/
+    lv_img_cache_set_budget(entry_size / 2);
+    open_and_close(&imgs[0]);
+    open_and_close(&imgs[0]);
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.skip_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.used);
+}
+
+void test_img_cache_invalidate_and_mem_cb(void)
+{
+    alloc_cnt = 0;
+    lv_img_cache_set_mem_cb(count_alloc, lv_mem_free);
+    open_and_close(indexed_img(0));
+    open_and_close(indexed_img(1));
+    TEST_ASSERT_EQUAL_UINT32(2, alloc_cnt);
+
+    /*A changed image is decoded again*/
+    lv_img_cache_invalidate_src(&imgs[0]);
+    open_and_close(&imgs[0]);
+    open_and_close(&imgs[1]);
+    TEST_ASSERT_EQUAL_UINT32(3, alloc_cnt);
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.entry_cnt);
+    lv_img_cache_invalidate_src(NULL);
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.used);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,235 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#if LV_LAYER_POOL_SIMPLE_CNT > 0
+
+#include <string.h>
+#include "unity/unity.h"
+
+#define HOG_CNT_MAX 512
+
+static lv_obj_t * active_screen = NULL;
+static uint8_t ref_buf[800 * 480 * 4];
+static uint32_t alloc_cnt;
+static void * hogs[HOG_CNT_MAX];
+static uint32_t hog_cnt;
+
+void setUp(void)
+{
+    active_screen = lv_scr_act();
+    lv_draw_sw_layer_pool_reserve();
+    lv_draw_sw_layer_pool_reset_stats();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(active_screen);
+    while(hog_cnt) lv_mem_free(hogs[--hog_cnt]);
+    lv_draw_sw_layer_pool_set_mem_cb(NULL, NULL);
+}
+
+static void * count_alloc(size_t size)
+{
+    alloc_cnt++;
+    return lv_mem_alloc(size);
+}
+
+static uint32_t disp_buf_size(void)
+{
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_default()->driver->draw_buf;
+    return draw_buf->size * sizeof(lv_color_t);
+}
+
+static void * disp_buf(void)
+{
+    return lv_disp_get_default()->driver->draw_buf->buf1;
+}
+
+/*A rectangle covering its layer, the layers need no alpha channel (LV_COLOR_SCREEN_TRANSP is 0)*/
+static lv_obj_t * rect_create(lv_obj_t * parent, lv_coord_t w, lv_coord_t h, lv_color_t color)
+{
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_bg_color(obj, color, 0);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    return obj;
+}
+
+static void hog_mem(uint32_t size)
+{
+    while(hog_cnt < HOG_CNT_MAX && (hogs[hog_cnt] = lv_mem_alloc(size)) != NULL) hog_cnt++;
+    TEST_ASSERT_LESS_THAN_UINT32(HOG_CNT_MAX, hog_cnt);
+}
+
+static void refresh(void)
+{
+    lv_obj_invalidate(active_screen);
+    lv_refr_now(NULL);
+}
+
+/*Containers with opacity in each other, each drawn on its own simple layer*/
+static void create_nested(uint32_t depth)
+{
+    lv_obj_t * parent = active_screen;
+    uint32_t i;
+    for(i = 0; i < depth; i++) {
+        lv_obj_t * cont = rect_create(parent, 400 - i * 60, 300 - i * 60, lv_palette_main(LV_PALETTE_RED + i));
+        lv_obj_set_pos(cont, 20, 20);
+        lv_obj_set_style_opa(cont, LV_OPA_70, 0);
+        lv_obj_t * label = lv_label_create(cont);
+        lv_label_set_text(label, "Layer");
+        lv_obj_align(label, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+        parent = cont;
+    }
+}
+
+void test_layer_pool_nested_same_screenshot(void)
+{
+    create_nested(LV_LAYER_POOL_SIMPLE_CNT);
+
+    lv_draw_sw_layer_pool_release();
+    refresh();
+    memcpy(ref_buf, disp_buf(), disp_buf_size());
+    lv_draw_sw_layer_pool_stats_t stats;
+    lv_draw_sw_layer_pool_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.simple_hit_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.alloc_cnt);
+
+    /*No allocation with a buffer per nesting level*/
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_draw_sw_layer_pool_reserve());
+    lv_draw_sw_layer_pool_reset_stats();
+    refresh();
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, disp_buf(), disp_buf_size());
+    lv_draw_sw_layer_pool_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.simple_hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.alloc_cnt);
+    TEST_ASSERT_EQUAL_UINT32(LV_LAYER_POOL_SIMPLE_CNT, stats.in_use_max);
+}
+
+void test_layer_pool_deeper_than_pool(void)
+{
+    create_nested(LV_LAYER_POOL_SIMPLE_CNT + 1);
+    refresh();
+
+    /*The innermost layers are allocated*/
+    lv_draw_sw_layer_pool_stats_t stats;
+    lv_draw_sw_layer_pool_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.simple_hit_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.alloc_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.fallback_cnt);
+    TEST_ASSERT_EQUAL_UINT32(LV_LAYER_POOL_SIMPLE_CNT + 1, stats.in_use_max);
+}
+
+void test_layer_pool_fallback(void)
+{
+    create_nested(1);
+    lv_draw_sw_layer_pool_release();
+    refresh();
+    memcpy(ref_buf, disp_buf(), disp_buf_size());
+
+    /*Leave less than LV_LAYER_SIMPLE_BUF_SIZE in one block*/
+    hog_mem(LV_LAYER_SIMPLE_BUF_SIZE - 4096);
+    hog_mem(8192);
+    lv_mem_free(hogs[--hog_cnt]);
+
+    lv_draw_sw_layer_pool_reset_stats();
+    refresh();
+    lv_draw_sw_layer_pool_stats_t stats;
+    lv_draw_sw_layer_pool_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.fallback_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.fail_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, disp_buf(), disp_buf_size());
+
+    /*A reserved buffer needs no fallback*/
+    while(hog_cnt) lv_mem_free(hogs[--hog_cnt]);
+    lv_draw_sw_layer_pool_reserve();
+    hog_mem(LV_LAYER_SIMPLE_BUF_SIZE - 4096);
+    hog_mem(8192);
+    lv_mem_free(hogs[--hog_cnt]);
+    lv_draw_sw_layer_pool_reset_stats();
+    refresh();
+    lv_draw_sw_layer_pool_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.fallback_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.simple_hit_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, disp_buf(), disp_buf_size());
+}
+
+#if LV_LAYER_POOL_TRANSFORM_SIZE > 0
+void test_layer_pool_transform(void)
+{
+    lv_obj_t * obj = rect_create(active_screen, 100, 80, lv_palette_main(LV_PALETTE_BLUE));
+    lv_obj_center(obj);
+    lv_obj_set_style_transform_angle(obj, 300, 0);
+    refresh();
+
+    lv_draw_sw_layer_pool_stats_t stats;
+    lv_draw_sw_layer_pool_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.transform_hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.simple_hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.alloc_cnt);
+
+    /*Too large for the transform buffer*/
+    lv_obj_set_size(obj, 400, 300);
+    lv_draw_sw_layer_pool_reset_stats();
+    refresh();
+    lv_draw_sw_layer_pool_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.transform_hit_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.alloc_cnt);
+}
+#endif
+
+void test_layer_pool_mem_cb(void)
+{
+    alloc_cnt = 0;
+    lv_draw_sw_layer_pool_set_mem_cb(count_alloc, lv_mem_free);
+    lv_draw_sw_layer_pool_stats_t stats;
+    lv_draw_sw_layer_pool_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.reserved);
+
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_draw_sw_layer_pool_reserve());
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_draw_sw_layer_pool_reserve());
+    TEST_ASSERT_EQUAL_UINT32(LV_LAYER_POOL_SIMPLE_CNT + (LV_LAYER_POOL_TRANSFORM_SIZE > 0), alloc_cnt);
+    lv_draw_sw_layer_pool_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(LV_LAYER_POOL_SIMPLE_CNT * LV_LAYER_SIMPLE_BUF_SIZE + LV_LAYER_POOL_TRANSFORM_SIZE,
+                             stats.reserved);
+
+    /*Drawing allocates no layer buffer*/
+    create_nested(1);
+    refresh();
+    lv_draw_sw_layer_pool_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.alloc_cnt);
+    TEST_ASSERT_EQUAL_UINT32(LV_LAYER_POOL_SIMPLE_CNT + (LV_LAYER_POOL_TRANSFORM_SIZE > 0), alloc_cnt);
+
+    lv_draw_sw_layer_pool_release();
+    lv_draw_sw_layer_pool_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.reserved);
+}
+
+void test_layer_pool_reserved_by_first_layer(void)
+{
+    lv_draw_sw_layer_pool_set_mem_cb(NULL, NULL);
+    lv_draw_sw_layer_pool_stats_t stats;
+    lv_draw_sw_layer_pool_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.reserved);
+
+    /*Nothing is reserved while no layer is drawn*/
+    rect_create(active_screen, 100, 100, lv_palette_main(LV_PALETTE_GREEN));
+    refresh();
+    lv_draw_sw_layer_pool_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.reserved);
+
+    lv_obj_clean(active_screen);
+    create_nested(1);
+    refresh();
+    lv_draw_sw_layer_pool_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.simple_hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.alloc_cnt);
+    TEST_ASSERT_EQUAL_UINT32(LV_LAYER_POOL_SIMPLE_CNT * LV_LAYER_SIMPLE_BUF_SIZE + LV_LAYER_POOL_TRANSFORM_SIZE,
+                             stats.reserved);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,196 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB_SIZE > 0
+
+#include "unity/unity.h"
+
+#define SLOT_CNT    400
+
+static void * slots[SLOT_CNT];
+static uint16_t slot_size[SLOT_CNT];
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_mem_slab_set_enabled(true);
+}
+
+static uint32_t slab_used(uint32_t cls)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.slab[cls].used_cnt;
+}
+
+static void fill(uint8_t * p, uint32_t size, uint8_t seed)
+{
+    uint32_t i;
+    for(i = 0; i < size; i++) p[i] = (uint8_t)(seed + i);
+}
+
+static void check(const uint8_t * p, uint32_t size, uint8_t seed)
+{
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        if(p[i] != (uint8_t)(seed + i)) TEST_FAIL_MESSAGE("the content of a block changed");
+    }
+}
+
+void test_mem_slab_block_sizes(void)
+{
+    static const uint16_t sizes[] = {1, 16, 17, 32, 33, 64, 65, 128};
+    uint32_t i;
+    for(i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        uint32_t cls = i / 2;
+        uint32_t used = slab_used(cls);
+        void * p = lv_mem_alloc(sizes[i]);
+        TEST_ASSERT_NOT_NULL(p);
+        TEST_ASSERT_EQUAL_UINT32(used + 1, slab_used(cls));
+        lv_mem_free(p);
+        TEST_ASSERT_EQUAL_UINT32(used, slab_used(cls));
+    }
+
+    lv_mem_monitor_t mon1;
+    lv_mem_monitor_t mon2;
+    lv_mem_monitor(&mon1);
+    void * p = lv_mem_alloc(LV_MEM_SLAB_MAX_SIZE + 1);
+    lv_mem_monitor(&mon2);
+    for(i = 0; i < LV_MEM_SLAB_CLASS_NUM; i++) {
+        TEST_ASSERT_EQUAL_UINT32(mon1.slab[i].used_cnt, mon2.slab[i].used_cnt);
+    }
+    TEST_ASSERT_EQUAL_UINT32(mon1.used_cnt + 1, mon2.used_cnt);
+    lv_mem_free(p);
+}
+
+void test_mem_slab_realloc(void)
+{
+    uint8_t * p = lv_mem_alloc(20);
+    fill(p, 20, 1);
+
+    /*Still a 32 byte block*/
+    TEST_ASSERT_EQUAL_PTR(p, lv_mem_realloc(p, 30));
+
+    /*Moves to the 16 byte blocks*/
+    uint32_t used16 = slab_used(0);
+    p = lv_mem_realloc(p, 10);
+    TEST_ASSERT_EQUAL_UINT32(used16 + 1, slab_used(0));
+    check(p, 10, 1);
+
+    /*Moves to the 128 byte blocks, then to TLSF*/
+    p = lv_mem_realloc(p, 100);
+    TEST_ASSERT_EQUAL_UINT32(used16, slab_used(0));
+    check(p, 10, 1);
+    fill(p, 100, 2);
+    p = lv_mem_realloc(p, 1000);
+    check(p, 100, 2);
+
+    lv_mem_free(p);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+}
+
+void test_mem_slab_falls_back_to_tlsf_when_full(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    uint32_t free_size = mon.free_size;
+    uint32_t fallback_cnt = mon.slab[3].fallback_cnt;
+
+    /*More 128 byte blocks than the whole arena can hold*/
+    uint32_t cnt = LV_MEM_SLAB_SIZE / LV_MEM_SLAB_MAX_SIZE + 1;
+    TEST_ASSERT_LESS_OR_EQUAL(SLOT_CNT, cnt);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        slots[i] = lv_mem_alloc(LV_MEM_SLAB_MAX_SIZE);
+        TEST_ASSERT_NOT_NULL(slots[i]);
+    }
+
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT16(0, mon.slab_page_free_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(fallback_cnt, mon.slab[3].fallback_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, mon.slab[3].free_cnt);
+
+    for(i = 0; i < cnt; i++) lv_mem_free(slots[i]);
+
+    /*The emptied pages can hold any block size again*/
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_GREATER_THAN_UINT16(0, mon.slab_page_free_cnt);
+    TEST_ASSERT_EQUAL_UINT32(free_size, mon.free_size);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+}
+
+void test_mem_slab_random_churn(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    uint32_t free_size = mon.free_size;
+
+    lv_memset_00(slots, sizeof(slots));
+    uint32_t i;
+    for(i = 0; i < 20000; i++) {
+        uint32_t s = lv_rand(0, SLOT_CNT - 1);
+        uint32_t size = lv_rand(0, 3) ? lv_rand(1, LV_MEM_SLAB_MAX_SIZE) : lv_rand(1, 1024);
+        uint8_t seed = (uint8_t)s;
+
+        if(slots[s] == NULL) {
+            slots[s] = lv_mem_alloc(size);
+            TEST_ASSERT_NOT_NULL(slots[s]);
+            fill(slots[s], size, seed);
+            slot_size[s] = (uint16_t)size;
+        }
+        else if(lv_rand(0, 1)) {
+            check(slots[s], slot_size[s], seed);
+            slots[s] = lv_mem_realloc(slots[s], size);
+            TEST_ASSERT_NOT_NULL(slots[s]);
+            check(slots[s], LV_MIN(size, slot_size[s]), seed);
+            fill(slots[s], size, seed);
+            slot_size[s] = (uint16_t)size;
+        }
+        else {
+            check(slots[s], slot_size[s], seed);
+            lv_mem_free(slots[s]);
+            slots[s] = NULL;
+        }
+
+        if(i % 1000 == 0) TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+    }
+
+    for(i = 0; i < SLOT_CNT; i++) {
+        if(slots[i]) {
+            check(slots[i], slot_size[i], (uint8_t)i);
+            lv_mem_free(slots[i]);
+            slots[i] = NULL;
+        }
+    }
+
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(free_size, mon.free_size);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+}
+
+void test_mem_slab_disabled(void)
+{
+    lv_mem_slab_set_enabled(false);
+    uint32_t used = slab_used(0);
+    void * p = lv_mem_alloc(8);
+    TEST_ASSERT_EQUAL_UINT32(used, slab_used(0));
+
+    /*A block of the pages is freed after disabling them too*/
+    lv_mem_slab_set_enabled(true);
+    void * q = lv_mem_alloc(8);
+    TEST_ASSERT_EQUAL_UINT32(used + 1, slab_used(0));
+    lv_mem_slab_set_enabled(false);
+    lv_mem_free(q);
+    TEST_ASSERT_EQUAL_UINT32(used, slab_used(0));
+
+    lv_mem_free(p);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+}
+
+#endif
+
+#endif
@@ -0,0 +1,229 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#if LV_USE_NUMLABEL
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "unity/unity.h"
+
+#define UPDATE_CNT  1000
+
+static lv_obj_t * active_screen = NULL;
+static lv_obj_t * numlabel = NULL;
+static uint8_t ref_buf[800 * 480 * 4];
+
+void setUp(void)
+{
+    active_screen = lv_scr_act();
+    numlabel = lv_numlabel_create(active_screen);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(active_screen);
+}
+
+static uint32_t disp_buf_size(void)
+{
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_default()->driver->draw_buf;
+    return draw_buf->size * sizeof(lv_color_t);
+}
+
+static void * disp_buf(void)
+{
+    return lv_disp_get_default()->driver->draw_buf->buf1;
+}
+
+static void assert_text(int32_t value, const char * expected)
+{
+    char text[LV_NUMLABEL_MAX_CELL_COUNT + 1];
+    lv_numlabel_set_value(numlabel, value);
+    lv_numlabel_get_text(numlabel, text);
+    TEST_ASSERT_EQUAL_STRING(expected, text);
+}
+
+void test_numlabel_should_format_fixed_point(void)
+{
+    lv_numlabel_set_format(numlabel, 3, 1);
+    assert_text(235, "23.5");
+    assert_text(5, "0.5");
+    assert_text(0, "0.0");
+    assert_text(-5, "0.0");
+    assert_text(12345, "99.9");
+    TEST_ASSERT_EQUAL_INT32(999, lv_numlabel_get_value(numlabel));
+
+    lv_numlabel_set_signed(numlabel, true);
+    assert_text(-5, "-0.5");
+    assert_text(-235, "-23.5");
+    assert_text(-12345, "-99.9");
+
+    lv_numlabel_set_leading_zeros(numlabel, true);
+    assert_text(-5, "-00.5");
+
+    lv_numlabel_set_format(numlabel, 6, 0);
+    assert_text(2147483647, "999999");
+    lv_numlabel_set_leading_zeros(numlabel, false);
+    assert_text(42, "42");
+
+    /*At least one digit before the decimal point*/
+    lv_numlabel_set_format(numlabel, 2, 5);
+    TEST_ASSERT_EQUAL_UINT8(1, lv_numlabel_get_decimals(numlabel));
+    assert_text(7, "0.7");
+}
+
+void test_numlabel_should_keep_its_width(void)
+{
+    lv_obj_set_style_text_font(numlabel, &lv_font_montserrat_24, 0);
+    lv_numlabel_set_format(numlabel, 3, 1);
+    lv_numlabel_set_signed(numlabel, true);
+    lv_obj_update_layout(numlabel);
+    lv_coord_t w = lv_obj_get_width(numlabel);
+    TEST_ASSERT_GREATER_THAN(0, w);
+    TEST_ASSERT_EQUAL(lv_font_get_line_height(&lv_font_montserrat_24), lv_obj_get_height(numlabel));
+
+    static const int32_t values[] = {-999, -5, 0, 111, 888, 999};
+    uint32_t i;
+    for(i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        lv_numlabel_set_value(numlabel, values[i]);
+        lv_obj_update_layout(numlabel);
+        TEST_ASSERT_EQUAL(w, lv_obj_get_width(numlabel));
+    }
+
+    /*A larger font makes it wider*/
+    lv_obj_set_style_text_font(numlabel, &lv_font_montserrat_48, 0);
+    lv_obj_update_layout(numlabel);
+    TEST_ASSERT_GREATER_THAN(w, lv_obj_get_width(numlabel));
+}
+
+void test_numlabel_should_invalidate_only_the_changed_digits(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+
+    lv_obj_set_style_text_font(numlabel, &lv_font_montserrat_24, 0);
+    lv_numlabel_set_format(numlabel, 3, 1);
+    lv_numlabel_set_value(numlabel, 235);
+    lv_obj_center(numlabel);
+    lv_refr_now(NULL);
+
+    /*"23.5" -> "23.6"*/
+    lv_numlabel_set_value(numlabel, 236);
+    TEST_ASSERT_EQUAL_UINT16(1, disp->inv_p);
+    /*Invalidation adds a few pixels of margin around the area, but it's less than a second digit*/
+    lv_numlabel_t * nl = (lv_numlabel_t *)numlabel;
+    TEST_ASSERT_LESS_THAN(2 * nl->digit_w + 2 * nl->overhang, lv_area_get_width(&disp->inv_areas[0]));
+    lv_refr_now(NULL);
+
+    /*"23.6" -> "24.6": the point is not redrawn*/
+    lv_numlabel_set_value(numlabel, 246);
+    TEST_ASSERT_EQUAL_UINT16(1, disp->inv_p);
+    lv_refr_now(NULL);
+
+    /*"24.6" -> "13.7": two areas*/
+    lv_numlabel_set_value(numlabel, 137);
+    TEST_ASSERT_EQUAL_UINT16(2, disp->inv_p);
+    lv_refr_now(NULL);
+
+    /*The same value*/
+    lv_numlabel_set_value(numlabel, 137);
+    TEST_ASSERT_EQUAL_UINT16(0, disp->inv_p);
+}
+
+void test_numlabel_should_draw_the_same_as_a_full_redraw(void)
+{
+    static const int32_t values[] = {235, 236, 1000, -7, -123, 42};
+    lv_obj_t * numlabels[3];
+    uint32_t i;
+    uint32_t v;
+
+    /*Keep the whole screen in the buffer to compare the partial redraws*/
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    drv->direct_mode = 1;
+
+    lv_obj_del(numlabel);
+    for(i = 0; i < 3; i++) {
+        numlabels[i] = lv_numlabel_create(active_screen);
+        lv_numlabel_set_format(numlabels[i], 4, i);
+        lv_numlabel_set_signed(numlabels[i], true);
+        lv_obj_set_pos(numlabels[i], 10, 10 + i * 60);
+    }
+    lv_obj_set_style_text_font(numlabels[0], &lv_font_montserrat_48, 0);
+    lv_obj_set_style_text_font(numlabels[1], &lv_font_montserrat_28_compressed, 0);
+    lv_obj_set_style_text_opa(numlabels[1], LV_OPA_50, 0);
+    lv_obj_set_style_text_align(numlabels[2], LV_TEXT_ALIGN_RIGHT, 0);
+    lv_obj_set_width(numlabels[2], 200);
+    lv_obj_set_style_bg_opa(numlabels[2], LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(numlabels[2], lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_style_text_letter_space(numlabels[2], 3, 0);
+    lv_refr_now(NULL);
+
+    for(v = 0; v < sizeof(values) / sizeof(values[0]); v++) {
+        for(i = 0; i < 3; i++) lv_numlabel_set_value(numlabels[i], values[v]);
+        lv_refr_now(NULL);
+        memcpy(ref_buf, disp_buf(), disp_buf_size());
+
+        lv_obj_invalidate(active_screen);
+        lv_refr_now(NULL);
+        TEST_ASSERT_EQUAL_MEMORY(ref_buf, disp_buf(), disp_buf_size());
+    }
+
+    drv->direct_mode = 0;
+}
+
+static uint32_t time_label_updates(lv_obj_t * label)
+{
+    struct timespec t1;
+    struct timespec t2;
+    uint32_t i;
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    for(i = 0; i < UPDATE_CNT; i++) {
+        int32_t v = (int32_t)(i * 7 % 1000);
+        lv_label_set_text_fmt(label, "%d.%d", (int)(v / 10), (int)(v % 10));
+        lv_refr_now(NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+
+    return (uint32_t)((t2.tv_sec - t1.tv_sec) * 1000000 + (t2.tv_nsec - t1.tv_nsec) / 1000);
+}
+
+static uint32_t time_numlabel_updates(lv_obj_t * obj)
+{
+    struct timespec t1;
+    struct timespec t2;
+    uint32_t i;
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    for(i = 0; i < UPDATE_CNT; i++) {
+        lv_numlabel_set_value(obj, (int32_t)(i * 7 % 1000));
+        lv_refr_now(NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+
+    return (uint32_t)((t2.tv_sec - t1.tv_sec) * 1000000 + (t2.tv_nsec - t1.tv_nsec) / 1000);
+}
+
+void test_numlabel_update_time(void)
+{
+    lv_obj_set_style_text_font(numlabel, &lv_font_montserrat_24, 0);
+    lv_numlabel_set_format(numlabel, 3, 1);
+    lv_obj_align(numlabel, LV_ALIGN_CENTER, 0, 30);
+
+    lv_obj_t * label = lv_label_create(active_screen);
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_24, 0);
+    lv_obj_align(label, LV_ALIGN_CENTER, 0, -30);
+    lv_refr_now(NULL);
+
+    uint32_t label_us = time_label_updates(label);
+    uint32_t numlabel_us = time_numlabel_updates(numlabel);
+
+    printf("numlabel: %d updates in %d us with lv_label, %d us with lv_numlabel (%d.%02dx)\n",
+           UPDATE_CNT, (int)label_us, (int)numlabel_us,
+           (int)(label_us / numlabel_us), (int)((label_us * 100 / numlabel_us) % 100));
+    TEST_PASS();
+}
+
+#endif
+
+#endif
@@ -0,0 +1,272 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#if LV_USE_OBJ_INDEX
+
+#include "unity/unity.h"
+
+#define QUERY_CNT 600
+
+static lv_obj_t * active_screen = NULL;
+static lv_obj_t * list;
+static lv_obj_t * overflow_cont;
+static lv_point_t points[QUERY_CNT];
+static lv_area_t areas[QUERY_CNT];
+static lv_obj_t * walk_res[QUERY_CNT];
+static uint32_t seed;
+
+void setUp(void)
+{
+    active_screen = lv_scr_act();
+    lv_obj_index_set_enabled(active_screen, true);
+    lv_obj_index_reset_stats();
+    seed = 0x1234;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(active_screen);
+    lv_obj_index_set_enabled(active_screen, false);
+}
+
+static uint32_t rnd(uint32_t max)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) % max;
+}
+
+/*A filled rectangle which can cover an area*/
+static lv_obj_t * rect_create(lv_obj_t * parent, lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h)
+{
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    return obj;
+}
+
+/*Overlapping objects, a scrolled list, a hidden, a disabled and a semi transparent object,
+ *children out of their parent with and without overflow visible and an ext. click area*/
+static void create_scene(void)
+{
+    list = lv_obj_create(active_screen);
+    lv_obj_set_pos(list, 20, 20);
+    lv_obj_set_size(list, 300, 400);
+    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+    uint32_t i;
+    for(i = 0; i < 30; i++) {
+        lv_obj_t * btn = lv_btn_create(list);
+        lv_obj_set_width(btn, lv_pct(100));
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "Item %d", (int)i);
+        if(i == 3) lv_obj_add_flag(btn, LV_OBJ_FLAG_HIDDEN);
+        if(i == 5) lv_obj_add_state(btn, LV_STATE_DISABLED);
+    }
+    lv_obj_scroll_to_y(list, 200, LV_ANIM_OFF);
+
+    lv_obj_t * card = rect_create(active_screen, 280, 100, 250, 200);
+    lv_obj_t * inner = rect_create(card, 20, 20, 100, 100);
+    lv_obj_clear_flag(inner, LV_OBJ_FLAG_CLICKABLE);
+    rect_create(card, 200, 150, 120, 120);  /*Clipped by the card*/
+    lv_obj_t * glass = rect_create(active_screen, 450, 250, 200, 150);
+    lv_obj_set_style_bg_opa(glass, LV_OPA_50, 0);
+    lv_obj_t * faded = rect_create(active_screen, 600, 50, 150, 150);
+    lv_obj_set_style_opa(faded, LV_OPA_70, 0);
+
+    overflow_cont = rect_create(active_screen, 560, 320, 100, 100);
+    lv_obj_add_flag(overflow_cont, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+    rect_create(overflow_cont, 60, 60, 120, 100);
+
+    lv_obj_t * small = rect_create(active_screen, 380, 420, 10, 10);
+    lv_obj_set_ext_click_area(small, 20);
+    rect_create(active_screen, 760, 440, 100, 100);   /*Partly off the display*/
+
+    lv_obj_update_layout(active_screen);
+}
+
+static void random_queries(void)
+{
+    uint32_t i;
+    for(i = 0; i < QUERY_CNT; i++) {
+        points[i].x = rnd(800);
+        points[i].y = rnd(480);
+        areas[i].x1 = rnd(800);
+        areas[i].y1 = rnd(480);
+        areas[i].x2 = LV_MIN(799, areas[i].x1 + rnd(120));
+        areas[i].y2 = LV_MIN(479, areas[i].y1 + rnd(60));
+    }
+}
+
+/*Compare the objects found with the index to what walking the tree finds*/
+static void check_points(void)
+{
+    uint32_t i;
+    lv_obj_index_set_enabled(active_screen, false);
+    for(i = 0; i < QUERY_CNT; i++) walk_res[i] = lv_indev_search_obj(active_screen, &points[i]);
+
+    lv_obj_index_set_enabled(active_screen, true);
+    for(i = 0; i < QUERY_CNT; i++) {
+        TEST_ASSERT_EQUAL_PTR(walk_res[i], lv_indev_search_obj(active_screen, &points[i]));
+    }
+}
+
+static void check_areas(void)
+{
+    uint32_t i;
+    lv_obj_index_set_enabled(active_screen, false);
+    for(i = 0; i < QUERY_CNT; i++) walk_res[i] = _lv_refr_get_top_obj(&areas[i], active_screen);
+
+    lv_obj_index_set_enabled(active_screen, true);
+    for(i = 0; i < QUERY_CNT; i++) {
+        TEST_ASSERT_EQUAL_PTR(walk_res[i], _lv_refr_get_top_obj(&areas[i], active_screen));
+    }
+}
+
+void test_obj_index_point_same_as_walk(void)
+{
+    create_scene();
+    random_queries();
+    check_points();
+
+    lv_obj_index_stats_t stats;
+    lv_obj_index_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(QUERY_CNT, stats.point_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.fallback_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.rebuild_cnt);
+}
+
+void test_obj_index_cover_same_as_walk(void)
+{
+    create_scene();
+    random_queries();
+    check_areas();
+
+    lv_obj_index_stats_t stats;
+    lv_obj_index_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(QUERY_CNT, stats.cover_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.fallback_cnt);
+}
+
+void test_obj_index_after_changes(void)
+{
+    create_scene();
+    random_queries();
+    check_points();
+
+    /*Scroll, move, delete, reorder and reparent*/
+    lv_obj_scroll_by(list, 0, 77, LV_ANIM_OFF);
+    check_points();
+    check_areas();
+
+    lv_obj_set_pos(overflow_cont, 100, 300);
+    lv_obj_set_ext_click_area(overflow_cont, 15);
+    check_points();
+
+    lv_obj_del(lv_obj_get_child(list, 10));
+    lv_obj_update_layout(active_screen);
+    check_points();
+    check_areas();
+
+    lv_obj_move_background(lv_obj_get_child(active_screen, -1));
+    lv_obj_swap(lv_obj_get_child(active_screen, 1), lv_obj_get_child(active_screen, 2));
+    lv_obj_set_parent(lv_obj_get_child(list, 0), overflow_cont);
+    lv_obj_update_layout(active_screen);
+    check_points();
+    check_areas();
+
+    lv_obj_index_stats_t stats;
+    lv_obj_index_reset_stats();
+    lv_obj_set_size(lv_obj_get_child(active_screen, 0), 50, 50);
+    lv_obj_update_layout(active_screen);
+    lv_indev_search_obj(active_screen, &points[0]);
+    lv_indev_search_obj(active_screen, &points[1]);
+    lv_obj_index_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.rebuild_cnt);
+}
+
+void test_obj_index_flags_need_no_rebuild(void)
+{
+    create_scene();
+    random_queries();
+    check_points();
+
+    /*Checked by the queries, not by the index*/
+    lv_obj_index_reset_stats();
+    lv_obj_add_flag(list, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_clear_flag(overflow_cont, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+    lv_obj_add_state(lv_obj_get_child(active_screen, 1), LV_STATE_DISABLED);
+    static lv_obj_t * index_res[QUERY_CNT];
+    uint32_t i;
+    for(i = 0; i < QUERY_CNT; i++) index_res[i] = lv_indev_search_obj(active_screen, &points[i]);
+
+    lv_obj_index_stats_t stats;
+    lv_obj_index_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.rebuild_cnt);
+
+    lv_obj_index_set_enabled(active_screen, false);
+    for(i = 0; i < QUERY_CNT; i++) {
+        TEST_ASSERT_EQUAL_PTR(lv_indev_search_obj(active_screen, &points[i]), index_res[i]);
+    }
+}
+
+void test_obj_index_transform_falls_back(void)
+{
+    create_scene();
+    lv_obj_t * rotated = rect_create(active_screen, 100, 100, 100, 60);
+    lv_obj_set_style_transform_angle(rotated, 300, 0);
+    random_queries();
+    check_points();
+    check_areas();
+
+    lv_obj_index_stats_t stats;
+    lv_obj_index_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.point_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.cover_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2 * QUERY_CNT, stats.fallback_cnt);
+
+    /*Indexed again without the transformation*/
+    lv_obj_set_style_transform_angle(rotated, 0, 0);
+    lv_obj_index_reset_stats();
+    check_points();
+    lv_obj_index_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(QUERY_CNT, stats.point_cnt);
+}
+
+void test_obj_index_point_outside_display(void)
+{
+    create_scene();
+    lv_point_t p = {-5, 100};
+    lv_obj_t * walk = lv_indev_search_obj(active_screen, &p);
+
+    lv_obj_index_stats_t stats;
+    lv_obj_index_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.fallback_cnt);
+    TEST_ASSERT_NULL(walk);
+}
+
+void test_obj_index_screen_delete(void)
+{
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    lv_obj_t * scr = lv_obj_create(NULL);
+    lv_obj_index_set_enabled(scr, true);
+    rect_create(scr, 10, 10, 100, 100);
+    lv_obj_update_layout(scr);
+    lv_point_t p = {50, 50};
+    lv_obj_t * found = NULL;
+    TEST_ASSERT_TRUE(_lv_obj_index_search_point(scr, &p, &found));
+    TEST_ASSERT_EQUAL_PTR(lv_obj_get_child(scr, 0), found);
+
+    lv_obj_del(scr);
+    TEST_ASSERT_FALSE(lv_obj_index_is_enabled(scr));
+
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    TEST_ASSERT_EQUAL_UINT32(mon_start.free_size, mon_end.free_size);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,180 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#if LV_USE_REFR_PROF && LV_REFR_PROF_FRAMES >= 50
+
+#include <string.h>
+#include "unity/unity.h"
+
+/*A clock advancing 10 us on every read*/
+static uint32_t fake_now;
+static char json_buf[64 * 1024];
+static uint32_t json_len;
+
+static uint32_t fake_time_cb(void)
+{
+    fake_now += 10;
+    return fake_now;
+}
+
+void setUp(void)
+{
+    fake_now = 0;
+    lv_refr_prof_set_time_cb(fake_time_cb);
+}
+
+void tearDown(void)
+{
+    lv_refr_prof_set_time_cb(NULL);
+    lv_obj_clean(lv_scr_act());
+}
+
+/*Record a frame which only rendered for `render_us`*/
+static void add_frame(uint32_t render_us)
+{
+    _lv_refr_prof_frame_begin();
+    lv_refr_prof_add(LV_REFR_PROF_RENDER, render_us);
+    _lv_refr_prof_frame_end(1, 100);
+}
+
+static void print_cb(const char * str, void * user_data)
+{
+    LV_UNUSED(user_data);
+    size_t len = strlen(str);
+    TEST_ASSERT_LESS_THAN(sizeof(json_buf), json_len + len);
+    memcpy(&json_buf[json_len], str, len + 1);
+    json_len += len;
+}
+
+void test_refr_prof_percentiles(void)
+{
+    uint32_t i;
+    /*50..1 so the ring isn't sorted*/
+    for(i = 50; i > 0; i--) add_frame(i);
+
+    lv_refr_prof_stats_t stats;
+    lv_refr_prof_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(50, stats.frame_cnt);
+    TEST_ASSERT_EQUAL_UINT32(25, stats.phase[LV_REFR_PROF_RENDER].mean);
+    TEST_ASSERT_EQUAL_UINT32(25, stats.phase[LV_REFR_PROF_RENDER].p50);
+    TEST_ASSERT_EQUAL_UINT32(48, stats.phase[LV_REFR_PROF_RENDER].p95);
+    TEST_ASSERT_EQUAL_UINT32(50, stats.phase[LV_REFR_PROF_RENDER].p99);
+    TEST_ASSERT_EQUAL_UINT32(50, stats.phase[LV_REFR_PROF_RENDER].max);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.phase[LV_REFR_PROF_FLUSH].max);
+    /*Two reads of the clock per frame*/
+    TEST_ASSERT_EQUAL_UINT32(10, stats.total.p99);
+}
+
+void test_refr_prof_ring_keeps_the_latest_frames(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_REFR_PROF_FRAMES + 10; i++) add_frame(i);
+
+    TEST_ASSERT_EQUAL_UINT32(LV_REFR_PROF_FRAMES, lv_refr_prof_get_frame_cnt());
+    TEST_ASSERT_EQUAL_UINT32(10, lv_refr_prof_get_frame(0)->phase_us[LV_REFR_PROF_RENDER]);
+    TEST_ASSERT_EQUAL_UINT32(LV_REFR_PROF_FRAMES + 9,
+                             lv_refr_prof_get_frame(LV_REFR_PROF_FRAMES - 1)->phase_us[LV_REFR_PROF_RENDER]);
+    TEST_ASSERT_NULL(lv_refr_prof_get_frame(LV_REFR_PROF_FRAMES));
+
+    lv_refr_prof_reset();
+    TEST_ASSERT_EQUAL_UINT32(0, lv_refr_prof_get_frame_cnt());
+}
+
+void test_refr_prof_empty_refresh_keeps_idle_time(void)
+{
+    lv_refr_prof_add(LV_REFR_PROF_IDLE, 1000);
+    _lv_refr_prof_frame_begin();
+    lv_refr_prof_add(LV_REFR_PROF_LAYOUT, 7);
+    _lv_refr_prof_frame_end(0, 0);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_refr_prof_get_frame_cnt());
+
+    lv_refr_prof_add(LV_REFR_PROF_IDLE, 500);
+    add_frame(3);
+    const lv_refr_prof_frame_t * f = lv_refr_prof_get_frame(0);
+    TEST_ASSERT_EQUAL_UINT32(1500, f->phase_us[LV_REFR_PROF_IDLE]);
+    TEST_ASSERT_EQUAL_UINT32(0, f->phase_us[LV_REFR_PROF_LAYOUT]);
+    TEST_ASSERT_EQUAL_UINT32(3, f->phase_us[LV_REFR_PROF_RENDER]);
+}
+
+void test_refr_prof_nothing_without_time_cb(void)
+{
+    lv_refr_prof_set_time_cb(NULL);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    add_frame(3);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_refr_prof_get_frame_cnt());
+}
+
+void test_refr_prof_records_a_refresh(void)
+{
+    lv_obj_create(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_refr_prof_reset();
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(1, lv_refr_prof_get_frame_cnt());
+    const lv_refr_prof_frame_t * f = lv_refr_prof_get_frame(0);
+    lv_disp_t * disp = lv_disp_get_default();
+    TEST_ASSERT_EQUAL_UINT32(lv_disp_get_hor_res(disp) * lv_disp_get_ver_res(disp), f->px);
+    TEST_ASSERT_EQUAL_UINT32(1, f->areas);
+    /*The test display has a full screen buffer*/
+    TEST_ASSERT_EQUAL_UINT16(1, f->bands);
+    TEST_ASSERT_EQUAL_UINT32(10, f->phase_us[LV_REFR_PROF_INVALIDATE]);
+    TEST_ASSERT_EQUAL_UINT32(10, f->phase_us[LV_REFR_PROF_LAYOUT]);
+    TEST_ASSERT_EQUAL_UINT32(10, f->phase_us[LV_REFR_PROF_JOIN]);
+    TEST_ASSERT_EQUAL_UINT32(10, f->phase_us[LV_REFR_PROF_FLUSH]);
+    TEST_ASSERT_EQUAL_UINT32(f->phase_us[LV_REFR_PROF_RENDER], f->band_max_us);
+    TEST_ASSERT_GREATER_THAN_UINT32(f->phase_us[LV_REFR_PROF_RENDER], f->total_us);
+}
+
+static void waiting_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    /*Like a port waiting for its DMA in the flush_cb*/
+    fake_now += 1000;
+    lv_refr_prof_add(LV_REFR_PROF_FLUSH_WAIT, 1000);
+    lv_disp_flush_ready(disp_drv);
+}
+
+void test_refr_prof_flush_wait_of_the_port_is_not_flush_time(void)
+{
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    void (*flush_cb)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = drv->flush_cb;
+    drv->flush_cb = waiting_flush_cb;
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    drv->flush_cb = flush_cb;
+
+    const lv_refr_prof_frame_t * f = lv_refr_prof_get_frame(0);
+    /*and the two reads of the clock around the wait for the single buffer before drawing*/
+    TEST_ASSERT_EQUAL_UINT32(1010, f->phase_us[LV_REFR_PROF_FLUSH_WAIT]);
+    TEST_ASSERT_EQUAL_UINT32(10, f->phase_us[LV_REFR_PROF_FLUSH]);
+}
+
+void test_refr_prof_export_json(void)
+{
+    add_frame(42);
+    add_frame(43);
+
+    json_len = 0;
+    json_buf[0] = '\0';
+    lv_refr_prof_export_json(print_cb, NULL);
+
+    TEST_ASSERT_EQUAL_CHAR('{', json_buf[0]);
+    TEST_ASSERT_EQUAL_CHAR('}', json_buf[json_len - 1]);
+    TEST_ASSERT_NOT_NULL(strstr(json_buf, "\"frame_cnt\": 2"));
+    TEST_ASSERT_NOT_NULL(strstr(json_buf, "\"render\": {\"mean\": 42, \"p50\": 42, \"p95\": 43, \"p99\": 43, \"max\": 43}"));
+    TEST_ASSERT_NOT_NULL(strstr(json_buf, "[0, 0, 0, 0, 0, 43, 0, 0, 10, 0, 0, 1, 100]"));
+
+    json_len = 0;
+    lv_refr_prof_dump(print_cb, NULL);
+    TEST_ASSERT_NOT_NULL(strstr(json_buf, "render"));
+}
+
+#endif
+
+#endif
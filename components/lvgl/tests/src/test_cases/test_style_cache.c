@@ -0,0 +1,155 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#if LV_STYLE_CACHE_SIZE
+
+#include "unity/unity.h"
+
+static lv_style_t style;
+
+void setUp(void)
+{
+    lv_style_init(&style);
+    lv_obj_style_cache_reset_stats();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_style_reset(&style);
+    lv_obj_style_cache_set_enabled(true);
+}
+
+void test_style_cache_hit_on_second_read(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x123456), 0);
+    lv_obj_style_cache_reset_stats();
+
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x123456), lv_obj_get_style_bg_color(obj, 0));
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x123456), lv_obj_get_style_bg_color(obj, 0));
+
+    lv_obj_style_cache_stats_t stats;
+    lv_obj_style_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.hit_cnt);
+}
+
+void test_style_cache_local_style_change(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_style_width(obj, 10, 0);
+    TEST_ASSERT_EQUAL(10, lv_obj_get_style_width(obj, 0));
+    lv_obj_set_style_width(obj, 20, 0);
+    TEST_ASSERT_EQUAL(20, lv_obj_get_style_width(obj, 0));
+    lv_obj_remove_local_style_prop(obj, LV_STYLE_WIDTH, 0);
+    TEST_ASSERT_NOT_EQUAL(20, lv_obj_get_style_width(obj, 0));
+}
+
+void test_style_cache_shared_style_change_without_report(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_style_set_radius(&style, 3);
+    lv_obj_add_style(obj, &style, 0);
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_radius(obj, 0));
+
+    /*No lv_obj_report_style_change()*/
+    lv_style_set_radius(&style, 7);
+    TEST_ASSERT_EQUAL(7, lv_obj_get_style_radius(obj, 0));
+
+    lv_obj_remove_style(obj, &style, 0);
+    TEST_ASSERT_NOT_EQUAL(7, lv_obj_get_style_radius(obj, 0));
+}
+
+void test_style_cache_state_change_of_the_parent(void)
+{
+    lv_obj_t * parent = lv_obj_create(lv_scr_act());
+    lv_obj_t * label = lv_label_create(parent);
+    lv_obj_set_style_text_color(parent, lv_color_hex(0x00ff00), LV_STATE_CHECKED);
+    lv_color_t def = lv_obj_get_style_text_color(label, 0);
+    TEST_ASSERT_EQUAL_COLOR(def, lv_obj_get_style_text_color(label, 0));
+
+    /*The label inherits the color of the parent's new state*/
+    lv_obj_add_state(parent, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ff00), lv_obj_get_style_text_color(label, 0));
+    lv_obj_clear_state(parent, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_COLOR(def, lv_obj_get_style_text_color(label, 0));
+}
+
+void test_style_cache_new_parent(void)
+{
+    lv_obj_t * parent1 = lv_obj_create(lv_scr_act());
+    lv_obj_t * parent2 = lv_obj_create(lv_scr_act());
+    lv_obj_set_style_text_letter_space(parent1, 3, 0);
+    lv_obj_set_style_text_letter_space(parent2, 5, 0);
+    lv_obj_t * label = lv_label_create(parent1);
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_text_letter_space(label, 0));
+
+    lv_obj_set_parent(label, parent2);
+    TEST_ASSERT_EQUAL(5, lv_obj_get_style_text_letter_space(label, 0));
+}
+
+void test_style_cache_new_object_at_the_same_address(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_style_line_width(obj, 9, 0);
+    TEST_ASSERT_EQUAL(9, lv_obj_get_style_line_width(obj, 0));
+    lv_obj_del(obj);
+
+    lv_obj_t * obj2 = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj2);
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_line_width(obj2, 0));
+}
+
+void test_style_cache_disabled(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_style_cache_set_enabled(false);
+    lv_obj_style_cache_reset_stats();
+    lv_obj_get_style_bg_opa(obj, 0);
+    lv_obj_get_style_bg_opa(obj, 0);
+
+    lv_obj_style_cache_stats_t stats;
+    lv_obj_style_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.skip_cnt);
+}
+
+void test_style_cache_same_screenshot(void)
+{
+    lv_obj_t * btn = lv_btn_create(lv_scr_act());
+    lv_obj_t * label = lv_label_create(btn);
+    lv_label_set_text(label, "Button");
+    lv_obj_t * slider = lv_slider_create(lv_scr_act());
+    lv_obj_align(slider, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_add_state(slider, LV_STATE_FOCUSED);
+
+    lv_obj_style_cache_set_enabled(false);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_disp_t * disp = lv_disp_get_default();
+    uint32_t px_cnt = lv_disp_get_hor_res(disp) * lv_disp_get_ver_res(disp);
+    lv_color_t * ref = lv_mem_alloc(px_cnt * sizeof(lv_color_t));
+    TEST_ASSERT_NOT_NULL(ref);
+    lv_memcpy(ref, disp->driver->draw_buf->buf_act, px_cnt * sizeof(lv_color_t));
+
+    /*Twice to draw from a filled cache*/
+    lv_obj_style_cache_set_enabled(true);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_obj_style_cache_reset_stats();
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_MEMORY(ref, disp->driver->draw_buf->buf_act, px_cnt * sizeof(lv_color_t));
+
+    lv_obj_style_cache_stats_t stats;
+    lv_obj_style_cache_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN_UINT32(stats.miss_cnt, stats.hit_cnt);
+    lv_mem_free(ref);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,342 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#if LV_USE_TIMER_HEAP
+
+#include "unity/unity.h"
+
+/*Long enough not to be due during a test*/
+#define LONG_PERIOD 1000000
+
+static uint32_t run_cnt;
+static lv_timer_t * other;   /*Created by `create_cb`*/
+
+void setUp(void)
+{
+    run_cnt = 0;
+    other = NULL;
+}
+
+void tearDown(void)
+{
+    lv_timer_heap_set_enabled(true);
+}
+
+static void count_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    run_cnt++;
+}
+
+static void del_other_cb(lv_timer_t * timer)
+{
+    run_cnt++;
+    lv_timer_del(timer->user_data);
+}
+
+static void del_self_cb(lv_timer_t * timer)
+{
+    run_cnt++;
+    lv_timer_del(timer);
+}
+
+static void set_value(void * var, int32_t v)
+{
+    *(int32_t *)var = v;
+}
+
+static void create_cb(lv_timer_t * timer)
+{
+    run_cnt++;
+    other = lv_timer_create(count_cb, 0, NULL);
+    lv_timer_del(timer);
+}
+
+/*The time till the next timer the old way, by walking all of them*/
+static uint32_t time_till_next_by_walk(void)
+{
+    uint32_t min = LV_NO_TIMER_READY;
+    uint32_t now = lv_tick_get();
+    lv_timer_t * timer = NULL;
+    while((timer = lv_timer_get_next(timer)) != NULL) {
+        if(timer->paused) continue;
+        uint32_t elaps = now - timer->last_run;
+        uint32_t remaining = elaps >= timer->period ? 0 : timer->period - elaps;
+        if(remaining < min) min = remaining;
+    }
+    return min;
+}
+
+static void assert_time_till_next(void)
+{
+    uint32_t walk = time_till_next_by_walk();
+    uint32_t heap = lv_timer_get_time_till_next();
+    /*The tick might step between the two*/
+    TEST_ASSERT_UINT32_WITHIN(1, walk, heap);
+}
+
+void test_timer_heap_time_till_next(void)
+{
+    lv_timer_t * t1 = lv_timer_create(count_cb, LONG_PERIOD, NULL);
+    lv_timer_t * t2 = lv_timer_create(count_cb, LONG_PERIOD / 2, NULL);
+    assert_time_till_next();
+
+    lv_timer_ready(t1);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_timer_get_time_till_next());
+
+    lv_timer_pause(t1);
+    assert_time_till_next();
+    lv_timer_set_period(t2, LONG_PERIOD / 4);
+    assert_time_till_next();
+
+    lv_timer_del(t1);
+    lv_timer_del(t2);
+    assert_time_till_next();
+}
+
+void test_timer_heap_runs_due_timers_once(void)
+{
+    lv_timer_t * timers[3];
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        timers[i] = lv_timer_create(count_cb, LONG_PERIOD, NULL);
+    }
+    lv_timer_ready(timers[2]);
+    lv_timer_ready(timers[0]);
+
+    /*A 0 period timer is always due but runs once per call*/
+    lv_timer_t * zero = lv_timer_create(count_cb, 0, NULL);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(3, run_cnt);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(4, run_cnt);
+
+    for(i = 0; i < 3; i++) lv_timer_del(timers[i]);
+    lv_timer_del(zero);
+}
+
+void test_timer_heap_delete_in_callback(void)
+{
+    lv_timer_t * a = lv_timer_create(del_other_cb, LONG_PERIOD, NULL);
+    lv_timer_t * b = lv_timer_create(del_other_cb, LONG_PERIOD, NULL);
+    a->user_data = b;
+    b->user_data = a;
+    lv_timer_ready(a);
+    lv_timer_ready(b);
+    lv_timer_t * self = lv_timer_create(del_self_cb, LONG_PERIOD, NULL);
+    lv_timer_ready(self);
+
+    /*Only one of `a` and `b` runs, it deletes the other*/
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt);
+
+    lv_timer_t * timer = NULL;
+    lv_timer_t * left = NULL;
+    uint32_t left_cnt = 0;
+    while((timer = lv_timer_get_next(timer)) != NULL) {
+        if(timer == self) TEST_FAIL_MESSAGE("the timer deleting itself still exists");
+        if(timer == a || timer == b) {
+            left = timer;
+            left_cnt++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, left_cnt);
+    lv_timer_del(left);
+    assert_time_till_next();
+}
+
+void test_timer_heap_create_in_callback(void)
+{
+    lv_timer_t * t = lv_timer_create(create_cb, LONG_PERIOD, NULL);
+    lv_timer_ready(t);
+
+    /*The new timer is due but waits for the next call*/
+    uint32_t till_next = lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, till_next);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt);
+
+    lv_timer_del(other);
+}
+
+void test_timer_heap_pause_and_repeat_count(void)
+{
+    lv_timer_t * paused = lv_timer_create(count_cb, LONG_PERIOD, NULL);
+    lv_timer_ready(paused);
+    lv_timer_pause(paused);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(0, run_cnt);
+
+    lv_timer_resume(paused);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+    lv_timer_del(paused);
+
+    lv_timer_t * twice = lv_timer_create(count_cb, LONG_PERIOD, NULL);
+    lv_timer_set_repeat_count(twice, 2);
+    lv_timer_ready(twice);
+    lv_timer_handler();
+    lv_timer_ready(twice);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(3, run_cnt);
+
+    /*Deleted after its last run*/
+    lv_timer_t * timer = NULL;
+    while((timer = lv_timer_get_next(timer)) != NULL) {
+        TEST_ASSERT_NOT_EQUAL(twice, timer);
+    }
+}
+
+void test_timer_heap_random_changes(void)
+{
+    static lv_timer_t * timers[300];
+    lv_memset_00(timers, sizeof(timers));
+
+    uint32_t i;
+    for(i = 0; i < 5000; i++) {
+        uint32_t s = lv_rand(0, 299);
+        if(timers[s] == NULL) {
+            timers[s] = lv_timer_create(count_cb, lv_rand(0, 3) ? lv_rand(1000, LONG_PERIOD) : 0, NULL);
+        }
+        else {
+            switch(lv_rand(0, 5)) {
+                case 0:
+                    lv_timer_del(timers[s]);
+                    timers[s] = NULL;
+                    break;
+                case 1:
+                    lv_timer_pause(timers[s]);
+                    break;
+                case 2:
+                    lv_timer_resume(timers[s]);
+                    break;
+                case 3:
+                    lv_timer_set_period(timers[s], lv_rand(0, LONG_PERIOD));
+                    break;
+                case 4:
+                    lv_timer_reset(timers[s]);
+                    break;
+                default:
+                    lv_timer_ready(timers[s]);
+                    break;
+            }
+        }
+        if(i % 50 == 0) lv_timer_handler();
+        assert_time_till_next();
+    }
+
+    for(i = 0; i < 300; i++) {
+        if(timers[i]) lv_timer_del(timers[i]);
+    }
+    assert_time_till_next();
+}
+
+#if LV_MEM_CUSTOM == 0
+/*Allocate all the free memory, the blocks are chained through their first word*/
+static void * hog_all(void)
+{
+    void * hogs = NULL;
+    uint32_t size;
+    for(size = 4096; size >= sizeof(void *); size /= 2) {
+        void * p;
+        while((p = lv_mem_alloc(size)) != NULL) {
+            *(void **)p = hogs;
+            hogs = p;
+        }
+    }
+    return hogs;
+}
+
+static void free_hogs(void * hogs)
+{
+    while(hogs) {
+        void * next = *(void **)hogs;
+        lv_mem_free(hogs);
+        hogs = next;
+    }
+}
+
+void test_timer_heap_resume_out_of_memory(void)
+{
+    /*Fill the heap to a size it never had, so it's full: a power of two above the 300 timers of the other tests*/
+    static lv_timer_t * timers[1024];
+    uint32_t active_cnt = 0;
+    lv_timer_t * timer = NULL;
+    while((timer = lv_timer_get_next(timer)) != NULL) {
+        if(!timer->paused) active_cnt++;
+    }
+    uint32_t cnt = 1024 - active_cnt;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        timers[i] = lv_timer_create(count_cb, LONG_PERIOD, NULL);
+        TEST_ASSERT_NOT_NULL(timers[i]);
+    }
+
+    /*Take the place of the paused timer, then it can't be added back without growing the heap*/
+    lv_timer_pause(timers[0]);
+    lv_timer_t * extra = lv_timer_create(count_cb, LONG_PERIOD, NULL);
+    TEST_ASSERT_NOT_NULL(extra);
+    void * hogs = hog_all();
+    lv_timer_resume(timers[0]);
+    free_hogs(hogs);
+    TEST_ASSERT_TRUE(timers[0]->paused);
+
+    /*It doesn't run while it's out of the heap*/
+    lv_timer_ready(timers[0]);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(0, run_cnt);
+    assert_time_till_next();
+
+    lv_timer_resume(timers[0]);
+    TEST_ASSERT_FALSE(timers[0]->paused);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+
+    lv_timer_del(extra);
+    for(i = 0; i < cnt; i++) {
+        lv_timer_del(timers[i]);
+    }
+    assert_time_till_next();
+}
+#endif
+
+void test_timer_heap_disabled(void)
+{
+    lv_timer_heap_set_enabled(false);
+    test_timer_heap_delete_in_callback();
+    lv_timer_heap_set_enabled(true);
+    assert_time_till_next();
+}
+
+void test_timer_heap_anim_sleeps_until_delay(void)
+{
+    static int32_t value;
+    static int32_t value2;
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &value);
+    lv_anim_set_exec_cb(&a, set_value);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_time(&a, 100);
+    lv_anim_set_delay(&a, 10000);
+    lv_anim_start(&a);
+
+    lv_timer_t * anim_timer = lv_anim_get_timer();
+    lv_timer_ready(anim_timer);
+    lv_timer_handler();
+    TEST_ASSERT_GREATER_THAN_UINT32(LV_DISP_DEF_REFR_PERIOD, anim_timer->period);
+
+    /*A new animation starting at once wakes it up*/
+    lv_anim_set_delay(&a, 0);
+    lv_anim_set_var(&a, &value2);
+    lv_anim_start(&a);
+    TEST_ASSERT_EQUAL_UINT32(LV_DISP_DEF_REFR_PERIOD, anim_timer->period);
+
+    lv_anim_del(&value, NULL);
+    lv_anim_del(&value2, NULL);
+}
+
+#endif
+
+#endif
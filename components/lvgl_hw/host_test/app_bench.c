@@ -0,0 +1,259 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Frame time benchmark of the real UI: runs lvgl_app.c on the virtual panel for a number of
+// refresh cycles (one simulated second each: clock tick, optionally a sensor reading, one frame)
+// and prints every frame as JSON, with the phase times of lv_refr_prof (layout, join, render, flush...)
+// of the refresh cycles under "profile". Exits with 1 if a limit given on the command line is
+// exceeded, so CTest catches a regression.
+//
+//   app_bench [--frames N] [--sensor-period N] [--json FILE]
+//             [--max-mean-us US] [--max-p95-us US] [--max-bytes-per-frame B] [--max-inv-px-per-frame PX]
+
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_app.h"
+#include "host_tick.h"
+
+// Sat Dec 24 2022 08:00:00 UTC, the day of the exam counted down by the app
+#define APP_BENCH_EPOCH 1671868800
+
+typedef struct
+{
+    uint32_t render_us;
+    uint32_t inv_areas;
+    uint32_t inv_px;
+    uint32_t flush_cnt;
+    uint32_t flushed_bytes;
+} app_frame_t;
+
+typedef struct
+{
+    uint32_t frames;
+    uint32_t sensor_period;
+    const char *json_path;
+    uint32_t max_mean_us;
+    uint32_t max_p95_us;
+    uint32_t max_bytes_per_frame;
+    uint32_t max_inv_px_per_frame;
+} app_bench_opts_t;
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t prof_time_cb(void)
+{
+    return (uint32_t)host_time_us();
+}
+
+static void prof_print_cb(const char *str, void *user_data)
+{
+    fputs(str, (FILE *)user_data);
+}
+
+static bool parse_args(int argc, char **argv, app_bench_opts_t *opts)
+{
+    static const struct
+    {
+        const char *name;
+        size_t offset;
+    } u32_opts[] = {
+        {"--frames", offsetof(app_bench_opts_t, frames)},
+        {"--sensor-period", offsetof(app_bench_opts_t, sensor_period)},
+        {"--max-mean-us", offsetof(app_bench_opts_t, max_mean_us)},
+        {"--max-p95-us", offsetof(app_bench_opts_t, max_p95_us)},
+        {"--max-bytes-per-frame", offsetof(app_bench_opts_t, max_bytes_per_frame)},
+        {"--max-inv-px-per-frame", offsetof(app_bench_opts_t, max_inv_px_per_frame)},
+    };
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 >= argc)
+        {
+            return false;
+        }
+        if (strcmp(argv[i], "--json") == 0)
+        {
+            opts->json_path = argv[++i];
+            continue;
+        }
+        bool known = false;
+        for (size_t o = 0; o < sizeof(u32_opts) / sizeof(u32_opts[0]); o++)
+        {
+            if (strcmp(argv[i], u32_opts[o].name) == 0)
+            {
+                *(uint32_t *)((char *)opts + u32_opts[o].offset) = (uint32_t)strtoul(argv[++i], NULL, 0);
+                known = true;
+                break;
+            }
+        }
+        if (!known)
+        {
+            return false;
+        }
+    }
+    return opts->frames > 0;
+}
+
+// readings drifting like a room over the day, in the 0.1 steps of the sensor
+static void sensor_feed(uint32_t frame)
+{
+    float temperature = roundf((24.0f + 3.0f * sinf(frame * 0.065f)) * 10) / 10;
+    float humidity = roundf((50.0f + 10.0f * sinf(frame * 0.048f + 1.0f)) * 10) / 10;
+    host_app_sensor_post(temperature, humidity, temperature + (humidity - 40.0f) * 0.05f);
+}
+
+static app_frame_t run_frame(host_app_t *app)
+{
+    app_frame_t frame = {0};
+    lv_disp_t *disp = app->hd->disp;
+
+    for (uint16_t i = 0; i < disp->inv_p; i++)
+    {
+        frame.inv_px += lv_area_get_size(&disp->inv_areas[i]);
+    }
+    frame.inv_areas = disp->inv_p;
+
+    host_disp_reset_stats(app->hd);
+    uint64_t t0 = host_time_us();
+    lv_refr_now(disp);
+    frame.render_us = (uint32_t)(host_time_us() - t0);
+    frame.flush_cnt = app->hd->stats.flush_cnt;
+    frame.flushed_bytes = app->hd->stats.flushed_bytes;
+    return frame;
+}
+
+static void print_frame(FILE *out, uint32_t i, const app_frame_t *f, bool last)
+{
+    fprintf(out,
+            "    {\"frame\": %u, \"render_us\": %u, \"inv_areas\": %u, \"inv_px\": %u, \"flush_cnt\": %u, "
+            "\"flushed_bytes\": %u}%s\n",
+            (unsigned)i, (unsigned)f->render_us, (unsigned)f->inv_areas, (unsigned)f->inv_px,
+            (unsigned)f->flush_cnt, (unsigned)f->flushed_bytes, last ? "" : ",");
+}
+
+static bool check_limit(const char *what, uint32_t value, uint32_t limit)
+{
+    if (limit != 0 && value > limit)
+    {
+        fprintf(stderr, "app_bench: %s %u is over the limit of %u\n", what, (unsigned)value, (unsigned)limit);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    app_bench_opts_t opts = {
+        .frames = 300,
+        .sensor_period = 1,
+    };
+    if (!parse_args(argc, argv, &opts))
+    {
+        fprintf(stderr, "usage: %s [--frames N] [--sensor-period N] [--json FILE] [--max-mean-us US] "
+                        "[--max-p95-us US] [--max-bytes-per-frame B] [--max-inv-px-per-frame PX]\n",
+                argv[0]);
+        return 2;
+    }
+
+    lv_init();
+    host_app_t app;
+    if (!host_app_create(&app, APP_BENCH_EPOCH))
+    {
+        fprintf(stderr, "app_bench: cannot start the app\n");
+        return 1;
+    }
+
+    // the screen load is a full frame, it is reported apart from the refresh cycles
+    lv_refr_prof_set_time_cb(prof_time_cb);
+    app_frame_t first = run_frame(&app);
+    lv_refr_prof_reset();
+    app_frame_t *frames = calloc(opts.frames, sizeof(app_frame_t));
+    uint32_t *render_us = calloc(opts.frames, sizeof(uint32_t));
+    if (frames == NULL || render_us == NULL)
+    {
+        return 1;
+    }
+
+    uint64_t sum_us = 0;
+    uint64_t sum_bytes = 0;
+    uint64_t sum_inv_px = 0;
+    for (uint32_t i = 0; i < opts.frames; i++)
+    {
+        host_app_tick(&app);
+        if (opts.sensor_period != 0 && i % opts.sensor_period == 0)
+        {
+            sensor_feed(i);
+        }
+        frames[i] = run_frame(&app);
+        render_us[i] = frames[i].render_us;
+        sum_us += frames[i].render_us;
+        sum_bytes += frames[i].flushed_bytes;
+        sum_inv_px += frames[i].inv_px;
+    }
+
+    qsort(render_us, opts.frames, sizeof(uint32_t), cmp_u32);
+    uint32_t mean_us = (uint32_t)(sum_us / opts.frames);
+    uint32_t p50_us = render_us[opts.frames / 2];
+    uint32_t p95_us = render_us[(opts.frames * 95 - 1) / 100];
+    uint32_t bytes_per_frame = (uint32_t)(sum_bytes / opts.frames);
+    uint32_t inv_px_per_frame = (uint32_t)(sum_inv_px / opts.frames);
+
+    FILE *out = stdout;
+    if (opts.json_path != NULL && (out = fopen(opts.json_path, "w")) == NULL)
+    {
+        fprintf(stderr, "app_bench: cannot write %s\n", opts.json_path);
+        return 1;
+    }
+    fprintf(out, "{\n  \"first_frame\": {\"render_us\": %u, \"inv_px\": %u, \"flushed_bytes\": %u},\n",
+            (unsigned)first.render_us, (unsigned)first.inv_px, (unsigned)first.flushed_bytes);
+    fprintf(out, "  \"frames\": [\n");
+    for (uint32_t i = 0; i < opts.frames; i++)
+    {
+        print_frame(out, i, &frames[i], i + 1 == opts.frames);
+    }
+    fprintf(out, "  ],\n");
+    fprintf(out,
+            "  \"summary\": {\"frames\": %u, \"mean_us\": %u, \"p50_us\": %u, \"p95_us\": %u, \"max_us\": %u, "
+            "\"inv_px_per_frame\": %u, \"bytes_per_frame\": %u},\n",
+            (unsigned)opts.frames, (unsigned)mean_us, (unsigned)p50_us, (unsigned)p95_us,
+            (unsigned)render_us[opts.frames - 1], (unsigned)inv_px_per_frame, (unsigned)bytes_per_frame);
+    fprintf(out, "  \"profile\": ");
+    lv_refr_prof_export_json(prof_print_cb, out);
+    fprintf(out, "\n}\n");
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+    fprintf(stderr, "app_bench: %u frames, mean %u us, p95 %u us, %u invalidated px and %u bytes per frame\n",
+            (unsigned)opts.frames, (unsigned)mean_us, (unsigned)p95_us, (unsigned)inv_px_per_frame,
+            (unsigned)bytes_per_frame);
+    lv_refr_prof_dump(prof_print_cb, stderr);
+
+    bool ok = check_limit("mean render time (us)", mean_us, opts.max_mean_us);
+    ok &= check_limit("p95 render time (us)", p95_us, opts.max_p95_us);
+    ok &= check_limit("flushed bytes per frame", bytes_per_frame, opts.max_bytes_per_frame);
+    ok &= check_limit("invalidated px per frame", inv_px_per_frame, opts.max_inv_px_per_frame);
+
+    free(frames);
+    free(render_us);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,27 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// lvgl_app.c reads the wall clock with time(NULL), on the host it follows the simulated clock of
+// host_app.c so every refresh cycle advances the clock labels by exactly one second
+
+#ifndef _HOST_APP_TIME_H
+#define _HOST_APP_TIME_H
+
+#include_next <time.h>
+
+time_t host_app_time(time_t *t);
+
+#define time(t) host_app_time(t)
+
+#endif
@@ -0,0 +1,185 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Renders the main screen on two round panels, one set up like gui_task without CONFIG_LCD_DIRECT_MODE
+// (two partial draw buffers in internal RAM) and one with it (a persistent frame in PSRAM and a bounce
+// buffer), and compares the frames, the internal RAM of the buffers and the render time.
+
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "host_disp.h"
+#include "host_screen.h"
+#include "lvgl_hw_round.h"
+
+#define BENCH_FRAMES 100
+#define BENCH_BATCHES 10
+
+static host_disp_t *buf_disp;
+static host_disp_t *direct_disp;
+static host_screen_t buf_screen;
+static host_screen_t direct_screen;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// pixels of the visible circle which differ, the corners of a round panel hold stale data
+static uint32_t frame_diff(void)
+{
+    uint32_t diff = 0;
+    for (lv_coord_t y = 0; y < HOST_DISP_V_RES; y++)
+    {
+        lvgl_round_span_t span = lvgl_round_get_span(y);
+        for (lv_coord_t x = span.x1; x <= span.x2; x++)
+        {
+            uint32_t i = y * HOST_DISP_H_RES + x;
+            if (buf_disp->fb[i].full != direct_disp->fb[i].full)
+            {
+                diff++;
+            }
+        }
+    }
+    return diff;
+}
+
+static void full_frame(host_disp_t *hd)
+{
+    lv_obj_invalidate(lv_disp_get_scr_act(hd->disp));
+    lv_refr_now(hd->disp);
+}
+
+// what refresh_task_callback and the sensor bindings change, step i
+static void update_values(host_screen_t *s, uint32_t i)
+{
+    char buf[16];
+    lv_arc_set_value(s->humi_arc, (int16_t)(40 + i % 20));
+    lv_arc_set_value(s->temp_arc, (int16_t)(15 + i % 10));
+    lv_snprintf(buf, sizeof(buf), "%d.%d", 20 + (int)(i % 10), (int)(i % 7));
+    lv_label_set_text(s->temp_num, buf);
+    lv_snprintf(buf, sizeof(buf), "12:34:%02d", (int)(i % 60));
+    lv_label_set_text(s->time_label, buf);
+    lv_snprintf(buf, sizeof(buf), "%08d", (int)(1000000 - i));
+    lv_label_set_text(s->count, buf);
+}
+
+static uint64_t bench_batch(host_disp_t *hd, host_screen_t *s, bool full, uint32_t first, uint32_t cnt)
+{
+    uint64_t t0 = host_time_us();
+    for (uint32_t i = first; i < first + cnt; i++)
+    {
+        if (full)
+        {
+            full_frame(hd);
+        }
+        else
+        {
+            update_values(s, i);
+            lv_refr_now(hd->disp);
+        }
+    }
+    return host_time_us() - t0;
+}
+
+// Time of BENCH_FRAMES frames on both panels, from the fastest of BENCH_BATCHES batches (see bench_round.c).
+// The batches alternate between the panels so both see the same state of the host.
+static void bench_frames(bool full, uint64_t *buf_us, uint64_t *direct_us)
+{
+    const uint32_t batch = BENCH_FRAMES / BENCH_BATCHES;
+    uint64_t buf_best = UINT64_MAX;
+    uint64_t direct_best = UINT64_MAX;
+    for (uint32_t done = 0; done < BENCH_FRAMES; done += batch)
+    {
+        uint64_t dt = bench_batch(buf_disp, &buf_screen, full, done, batch);
+        buf_best = dt < buf_best ? dt : buf_best;
+        dt = bench_batch(direct_disp, &direct_screen, full, done, batch);
+        direct_best = dt < direct_best ? dt : direct_best;
+    }
+    *buf_us = buf_best * BENCH_BATCHES;
+    *direct_us = direct_best * BENCH_BATCHES;
+}
+
+void test_direct_frame_matches_buffered(void)
+{
+    full_frame(buf_disp);
+    full_frame(direct_disp);
+    TEST_ASSERT_EQUAL_UINT32(0, frame_diff());
+
+    // only the dirty areas are rendered and sent, the rest of the persistent frame stays valid
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        update_values(&buf_screen, i * 7);
+        update_values(&direct_screen, i * 7);
+        lv_refr_now(buf_disp->disp);
+        lv_refr_now(direct_disp->disp);
+        TEST_ASSERT_EQUAL_UINT32(0, frame_diff());
+    }
+}
+
+void test_direct_sends_only_dirty_areas(void)
+{
+    host_disp_reset_stats(buf_disp);
+    host_disp_reset_stats(direct_disp);
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        update_values(&buf_screen, i * 3);
+        update_values(&direct_screen, i * 3);
+        lv_refr_now(buf_disp->disp);
+        lv_refr_now(direct_disp->disp);
+    }
+    TEST_ASSERT_EQUAL_UINT32(buf_disp->stats.flushed_bytes, direct_disp->stats.flushed_bytes);
+    TEST_ASSERT_TRUE(direct_disp->stats.flushed_px < 10 * HOST_DISP_H_RES * HOST_DISP_V_RES / 2);
+}
+
+void test_direct_bench(void)
+{
+    uint64_t buf_full_us, direct_full_us, buf_upd_us, direct_upd_us;
+    bench_frames(true, &buf_full_us, &direct_full_us);
+    bench_frames(false, &buf_upd_us, &direct_upd_us);
+
+    // the buffers gui_task allocates with MALLOC_CAP_DMA, the frame of direct mode is in PSRAM
+    uint32_t buf_internal = 2 * HOST_DISP_BUF_SIZE * sizeof(lv_color_t);
+    uint32_t direct_internal = HOST_DISP_BUF_SIZE * sizeof(lv_color_t);
+    uint32_t direct_psram = HOST_DISP_H_RES * HOST_DISP_V_RES * sizeof(lv_color_t);
+
+    printf("draw buffers: two partial %u bytes internal RAM, direct mode %u bytes internal + %u bytes PSRAM\n",
+           (unsigned)buf_internal, (unsigned)direct_internal, (unsigned)direct_psram);
+    printf("per frame (%d frames):\n", BENCH_FRAMES);
+    printf("  full frame:     partial %.1f us, direct %.1f us\n", (double)buf_full_us / BENCH_FRAMES,
+           (double)direct_full_us / BENCH_FRAMES);
+    printf("  value updates:  partial %.1f us, direct %.1f us\n", (double)buf_upd_us / BENCH_FRAMES,
+           (double)direct_upd_us / BENCH_FRAMES);
+    TEST_ASSERT_EQUAL_UINT32(0, frame_diff());
+}
+
+int main(void)
+{
+    lv_init();
+    buf_disp = host_disp_create(true);
+    direct_disp = host_disp_create_direct(true);
+    TEST_ASSERT_NOT_NULL(buf_disp);
+    TEST_ASSERT_NOT_NULL(direct_disp);
+    host_screen_create(&buf_screen, buf_disp);
+    host_screen_create(&direct_screen, direct_disp);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_direct_frame_matches_buffered);
+    RUN_TEST(test_direct_sends_only_dirty_areas);
+    RUN_TEST(test_direct_bench);
+    return UNITY_END();
+}
@@ -0,0 +1,396 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Draws a screen of an indexed background image, alpha only icons, an arc filled with a gradient image
+// and gradient bars and buttons with and without the image cache of LV_IMG_CACHE_BUDGET and the
+// gradient cache of LV_GRAD_CACHE_DEF_SIZE. Reports the decode time the caches avoid per frame, timed
+// in the built-in image decoder and by computing the gradient maps of a frame again, the frame times
+// and the statistics of the caches. The caches allocate with malloc() like they use PSRAM on the device.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "unity.h"
+#include "host_disp.h"
+
+#define BENCH_FRAMES 200
+#define BENCH_BATCHES 20
+#define FB_PX (HOST_DISP_H_RES * HOST_DISP_V_RES)
+#define ICON_CNT 6
+#define ICON_SIZE 40
+#define ARC_SIZE 160
+#define GRAD_OBJ_CNT 6
+
+static host_disp_t *hd;
+static lv_color_t *ref_fb;
+static lv_img_dsc_t bg_img;
+static lv_img_dsc_t icon_img;
+static lv_img_dsc_t arc_img;
+static lv_obj_t *center;
+static lv_obj_t *grad_objs[GRAD_OBJ_CNT];
+static uint32_t grad_obj_cnt;
+static uint64_t decode_ns;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static void set_caches(bool en)
+{
+    lv_img_cache_set_budget(en ? LV_IMG_CACHE_BUDGET : 0);
+    lv_gradient_set_cache_size(en ? LV_GRAD_CACHE_DEF_SIZE : 0);
+}
+
+// host_time_us() is too coarse for a line of an image
+static uint64_t time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// The built-in decoder, timed. Registered last so it's tried first.
+static lv_res_t timed_open(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+    uint64_t t0 = time_ns();
+    lv_res_t res = lv_img_decoder_built_in_open(decoder, dsc);
+    decode_ns += time_ns() - t0;
+    return res;
+}
+
+static lv_res_t timed_read_line(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc, lv_coord_t x, lv_coord_t y,
+                                lv_coord_t len, uint8_t *buf)
+{
+    uint64_t t0 = time_ns();
+    lv_res_t res = lv_img_decoder_built_in_read_line(decoder, dsc, x, y, len, buf);
+    decode_ns += time_ns() - t0;
+    return res;
+}
+
+static void timed_close(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+    uint64_t t0 = time_ns();
+    lv_img_decoder_built_in_close(decoder, dsc);
+    decode_ns += time_ns() - t0;
+}
+
+static void create_timed_decoder(void)
+{
+    lv_img_decoder_t *decoder = lv_img_decoder_create();
+    TEST_ASSERT_NOT_NULL(decoder);
+    lv_img_decoder_set_info_cb(decoder, lv_img_decoder_built_in_info);
+    lv_img_decoder_set_open_cb(decoder, timed_open);
+    lv_img_decoder_set_read_line_cb(decoder, timed_read_line);
+    lv_img_decoder_set_close_cb(decoder, timed_close);
+}
+
+static uint8_t *alloc_img(lv_img_dsc_t *img, lv_img_cf_t cf, uint32_t w, uint32_t h, uint32_t data_size)
+{
+    img->header.always_zero = 0;
+    img->header.w = w;
+    img->header.h = h;
+    img->header.cf = cf;
+    img->data_size = data_size;
+    img->data = malloc(data_size);
+    TEST_ASSERT_NOT_NULL(img->data);
+    return (uint8_t *)img->data;
+}
+
+// Images the built-in decoder gives line by line, like the converted assets of a watch face
+static void create_images(void)
+{
+    // 8 bit indexed background with a 256 color palette
+    uint8_t *p = alloc_img(&bg_img, LV_IMG_CF_INDEXED_8BIT, HOST_DISP_H_RES, HOST_DISP_V_RES,
+                           256 * sizeof(lv_color32_t) + FB_PX);
+    lv_color32_t *palette = (lv_color32_t *)p;
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        palette[i].full = 0xff000000 | (i << 16) | ((255 - i) << 8) | (i / 2);
+    }
+    for (uint32_t y = 0; y < HOST_DISP_V_RES; y++)
+    {
+        for (uint32_t x = 0; x < HOST_DISP_H_RES; x++)
+        {
+            p[256 * sizeof(lv_color32_t) + y * HOST_DISP_H_RES + x] = (uint8_t)((x * x + y * y) >> 8);
+        }
+    }
+
+    // 4 bit alpha icon, a soft disc
+    p = alloc_img(&icon_img, LV_IMG_CF_ALPHA_4BIT, ICON_SIZE, ICON_SIZE, ICON_SIZE * ICON_SIZE / 2);
+    for (int32_t y = 0; y < ICON_SIZE; y++)
+    {
+        for (int32_t x = 0; x < ICON_SIZE; x += 2)
+        {
+            int32_t dy = y - ICON_SIZE / 2;
+            int32_t d0 = (x - ICON_SIZE / 2) * (x - ICON_SIZE / 2) + dy * dy;
+            int32_t d1 = (x + 1 - ICON_SIZE / 2) * (x + 1 - ICON_SIZE / 2) + dy * dy;
+            uint8_t a0 = d0 < ICON_SIZE * ICON_SIZE / 4 ? 15 - d0 * 15 / (ICON_SIZE * ICON_SIZE / 4) : 0;
+            uint8_t a1 = d1 < ICON_SIZE * ICON_SIZE / 4 ? 15 - d1 * 15 / (ICON_SIZE * ICON_SIZE / 4) : 0;
+            p[(y * ICON_SIZE + x) / 2] = (uint8_t)(a0 << 4 | a1);
+        }
+    }
+
+    // 4 bit indexed horizontal gradient the arc is filled with
+    p = alloc_img(&arc_img, LV_IMG_CF_INDEXED_4BIT, ARC_SIZE, ARC_SIZE, 16 * sizeof(lv_color32_t) + ARC_SIZE * ARC_SIZE / 2);
+    palette = (lv_color32_t *)p;
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        palette[i].full = 0xff000000 | ((i * 17) << 16) | (255 - i * 17);
+    }
+    for (uint32_t y = 0; y < ARC_SIZE; y++)
+    {
+        for (uint32_t x = 0; x < ARC_SIZE; x += 2)
+        {
+            uint8_t i0 = (uint8_t)(x * 16 / ARC_SIZE);
+            uint8_t i1 = (uint8_t)((x + 1) * 16 / ARC_SIZE);
+            p[16 * sizeof(lv_color32_t) + (y * ARC_SIZE + x) / 2] = (uint8_t)(i0 << 4 | i1);
+        }
+    }
+}
+
+static void create_screen(void)
+{
+    lv_obj_t *scr = lv_disp_get_scr_act(hd->disp);
+    lv_obj_clear_flag(scr, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t *bg = lv_img_create(scr);
+    lv_img_set_src(bg, &bg_img);
+
+    lv_obj_t *arc = lv_arc_create(scr);
+    lv_obj_set_size(arc, ARC_SIZE, ARC_SIZE);
+    lv_obj_center(arc);
+    lv_arc_set_value(arc, 70);
+    lv_obj_set_style_arc_width(arc, 16, LV_PART_INDICATOR);
+    lv_obj_set_style_arc_img_src(arc, &arc_img, LV_PART_INDICATOR);
+    lv_obj_remove_style(arc, NULL, LV_PART_KNOB);
+
+    static const uint32_t colors[ICON_CNT] = {0xff4040, 0x40ff40, 0x4040ff, 0xffff40, 0x40ffff, 0xff40ff};
+    for (uint32_t i = 0; i < ICON_CNT; i++)
+    {
+        lv_obj_t *icon = lv_img_create(scr);
+        lv_img_set_src(icon, &icon_img);
+        lv_obj_set_style_img_recolor(icon, lv_color_hex(colors[i]), 0);
+        lv_obj_set_style_img_recolor_opa(icon, LV_OPA_COVER, 0);
+        lv_obj_align(icon, LV_ALIGN_CENTER, (lv_coord_t)(((int32_t)i % 3 - 1) * 60), i < 3 ? -95 : 95);
+    }
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        lv_obj_t *btn = lv_btn_create(scr);
+        lv_obj_set_size(btn, 56, 40);
+        lv_obj_align(btn, LV_ALIGN_CENTER, i % 2 ? 35 : -35, i < 2 ? -22 : 22);
+        lv_obj_set_style_bg_color(btn, lv_color_hex(colors[i]), 0);
+        lv_obj_set_style_bg_grad_color(btn, lv_color_hex(colors[i + 2]), 0);
+        lv_obj_set_style_bg_grad_dir(btn, i % 2 ? LV_GRAD_DIR_HOR : LV_GRAD_DIR_VER, 0);
+        grad_objs[grad_obj_cnt++] = btn;
+    }
+
+    // full width bars, the gradient map is computed for each of the 24 row strips of a frame without the cache
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        lv_obj_t *bar = lv_obj_create(scr);
+        lv_obj_remove_style_all(bar);
+        lv_obj_set_size(bar, HOST_DISP_H_RES, 36);
+        lv_obj_align(bar, i ? LV_ALIGN_BOTTOM_MID : LV_ALIGN_TOP_MID, 0, 0);
+        lv_obj_set_style_bg_opa(bar, LV_OPA_70, 0);
+        lv_obj_set_style_bg_color(bar, lv_color_hex(colors[i]), 0);
+        lv_obj_set_style_bg_grad_color(bar, lv_color_hex(colors[i + 3]), 0);
+        lv_obj_set_style_bg_grad_dir(bar, LV_GRAD_DIR_HOR, 0);
+        grad_objs[grad_obj_cnt++] = bar;
+    }
+
+    // what a clock or a value updating in the middle redraws
+    center = lv_obj_create(scr);
+    lv_obj_remove_style_all(center);
+    lv_obj_set_size(center, 60, 60);
+    lv_obj_center(center);
+}
+
+static void full_frame(void)
+{
+    lv_obj_invalidate(lv_disp_get_scr_act(hd->disp));
+    lv_refr_now(hd->disp);
+}
+
+static void center_frame(void)
+{
+    lv_obj_invalidate(center);
+    lv_refr_now(hd->disp);
+}
+
+// The fastest of BENCH_BATCHES batches with the caches off and on in us per frame. The batches
+// alternate so a slower period of a shared host hits both (see bench_round.c).
+static void bench(void (*frame)(void), double us[2])
+{
+    const uint32_t batch = BENCH_FRAMES / BENCH_BATCHES;
+    us[0] = us[1] = 1e12;
+    for (uint32_t b = 0; b < BENCH_BATCHES; b++)
+    {
+        for (int on = 0; on < 2; on++)
+        {
+            set_caches(on);
+            frame(); // fills the caches
+
+            uint64_t t0 = host_time_us();
+            for (uint32_t i = 0; i < batch; i++)
+            {
+                frame();
+            }
+            double t = (double)(host_time_us() - t0) / batch;
+            us[on] = t < us[on] ? t : us[on];
+        }
+    }
+    set_caches(true);
+}
+
+// us per frame in the image decoder, the fastest of BENCH_BATCHES
+static double decode_us(void (*frame)(void), bool on)
+{
+    set_caches(on);
+    frame();
+    double us = 1e12;
+    for (uint32_t b = 0; b < BENCH_BATCHES; b++)
+    {
+        decode_ns = 0;
+        frame();
+        us = decode_ns / 1000.0 < us ? decode_ns / 1000.0 : us;
+    }
+    set_caches(true);
+    return us;
+}
+
+// Computes the gradient maps of a full frame without the cache again: lv_draw_sw_rect() gets the map
+// of an object in every strip of HOST_DISP_BUF_SIZE pixels the object is in. The fastest of
+// BENCH_BATCHES in us, `cnt` is set to the maps per frame.
+static double grad_compute_us(uint32_t *cnt)
+{
+    const lv_coord_t strip_h = HOST_DISP_BUF_SIZE / HOST_DISP_H_RES;
+    lv_gradient_set_cache_size(0);
+    double us = 1e12;
+    for (uint32_t b = 0; b < BENCH_BATCHES; b++)
+    {
+        *cnt = 0;
+        uint64_t t0 = time_ns();
+        for (uint32_t i = 0; i < grad_obj_cnt; i++)
+        {
+            lv_draw_rect_dsc_t dsc;
+            lv_draw_rect_dsc_init(&dsc);
+            lv_obj_init_draw_rect_dsc(grad_objs[i], LV_PART_MAIN, &dsc);
+            lv_area_t coords;
+            lv_obj_get_coords(grad_objs[i], &coords);
+            for (lv_coord_t s = coords.y1 / strip_h; s <= coords.y2 / strip_h; s++)
+            {
+                lv_grad_t *grad = lv_gradient_get(&dsc.bg_grad, lv_area_get_width(&coords), lv_area_get_height(&coords));
+                TEST_ASSERT_NOT_NULL(grad);
+                lv_gradient_cleanup(grad);
+                (*cnt)++;
+            }
+        }
+        double t = (time_ns() - t0) / 1000.0;
+        us = t < us ? t : us;
+    }
+    lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
+    return us;
+}
+
+static void report(const char *name, const double frame[2], const double decode[2])
+{
+    printf("%s: frame %.1f us without the caches, %.1f us with them, saved %.1f%%\n", name, frame[0], frame[1],
+           100.0 * (frame[0] - frame[1]) / frame[0]);
+    printf("  image decoding %.1f us without, %.1f us with, avoided %.1f us per frame\n", decode[0], decode[1],
+           decode[0] - decode[1]);
+}
+
+void test_caches_same_frame(void)
+{
+    set_caches(false);
+    full_frame();
+    memcpy(ref_fb, hd->fb, FB_PX * sizeof(lv_color_t));
+
+    set_caches(true);
+    full_frame();
+    full_frame();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, hd->fb, FB_PX * sizeof(lv_color_t));
+}
+
+void test_caches_avoid_decode_time(void)
+{
+    lv_grad_cache_stats_t grad_stats;
+    set_caches(false);
+    lv_gradient_reset_cache_stats();
+    full_frame();
+    lv_gradient_get_cache_stats(&grad_stats);
+    uint32_t grad_maps = grad_stats.miss_cnt;
+
+    set_caches(true);
+    full_frame();
+    lv_img_cache_reset_stats();
+    lv_gradient_reset_cache_stats();
+    full_frame();
+    lv_img_cache_stats_t img_stats;
+    lv_img_cache_get_stats(&img_stats);
+    lv_gradient_get_cache_stats(&grad_stats);
+
+    double full_us[2];
+    double center_us[2];
+    double full_decode_us[2] = {decode_us(full_frame, false), decode_us(full_frame, true)};
+    double center_decode_us[2] = {decode_us(center_frame, false), decode_us(center_frame, true)};
+    uint32_t replayed_maps;
+    double grad_us = grad_compute_us(&replayed_maps);
+    bench(full_frame, full_us);
+    bench(center_frame, center_us);
+
+    printf("images: %u hits, %u misses, %u evictions, %u entries, %u of %u bytes per full frame\n",
+           (unsigned)img_stats.hit_cnt, (unsigned)img_stats.miss_cnt, (unsigned)img_stats.evict_cnt,
+           (unsigned)img_stats.entry_cnt, (unsigned)img_stats.used, (unsigned)img_stats.budget);
+    printf("gradients: %u hits, %u misses, %u evictions, %u entries, %u of %u bytes per full frame\n",
+           (unsigned)grad_stats.hit_cnt, (unsigned)grad_stats.miss_cnt, (unsigned)grad_stats.evict_cnt,
+           (unsigned)grad_stats.entry_cnt, (unsigned)grad_stats.used, (unsigned)grad_stats.budget);
+    report("full frame", full_us, full_decode_us);
+    printf("  gradient maps %.1f us without (%u maps), 0 with, avoided %.1f us per frame\n", grad_us,
+           (unsigned)replayed_maps, grad_us);
+    report("60x60 in the center", center_us, center_decode_us);
+
+    // the times are too noisy on a shared host to assert on
+    TEST_ASSERT_EQUAL_UINT32(0, img_stats.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, grad_stats.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2 + ICON_CNT, img_stats.entry_cnt); // an entry per recolor of the icon
+    TEST_ASSERT_EQUAL_UINT32(GRAD_OBJ_CNT, grad_stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(grad_maps, replayed_maps);
+}
+
+int main(void)
+{
+    lv_init();
+    lv_img_cache_set_mem_cb(malloc, free);
+    lv_gradient_set_cache_mem_cb(malloc, free);
+    hd = host_disp_create(false);
+    ref_fb = malloc(FB_PX * sizeof(lv_color_t));
+    TEST_ASSERT_NOT_NULL(hd);
+    TEST_ASSERT_NOT_NULL(ref_fb);
+    create_timed_decoder();
+    create_images();
+    create_screen();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_caches_same_frame);
+    RUN_TEST(test_caches_avoid_decode_time);
+    free(ref_fb);
+    return UNITY_END();
+}
@@ -0,0 +1,237 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the joining of invalidated areas of LVGL (only overlapping areas whose union is smaller)
+// with the flush cost model of `join_trans_px` and the tile grid of `tile_size`, on the update
+// patterns of the main screen. The SPI time is modeled like the GC9A01 of the device: every pixel
+// costs 16 bits at CONFIG_LCD_PIXEL_CLOCK_HZ and every transfer (CASET, RASET, RAMWR and the DMA
+// setup) a fixed time.
+
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "host_disp.h"
+#include "host_screen.h"
+#include "lvgl_hw_round.h"
+
+#define BENCH_STEPS 60
+// CONFIG_LCD_PIXEL_CLOCK_HZ
+#define BENCH_SPI_HZ 80000000
+// about 50 us per transfer: the command phases are polled, the pixels go with DMA
+#define BENCH_TRANS_US 50.0
+// the same time in pixels, the value for join_trans_px
+#define BENCH_TRANS_PX ((uint32_t)(BENCH_TRANS_US * BENCH_SPI_HZ / 16 / 1000000))
+
+typedef void (*update_cb_t)(host_screen_t *s, uint32_t i);
+
+typedef struct
+{
+    const char *name;
+    update_cb_t update;
+} pattern_t;
+
+typedef struct
+{
+    const char *name;
+    uint32_t join_trans_px;
+    lv_coord_t tile_size;
+} join_cfg_t;
+
+typedef struct
+{
+    uint32_t trans;
+    uint32_t bytes;
+    double spi_us;
+} join_result_t;
+
+static host_disp_t *ref_disp;
+static host_disp_t *test_disp;
+static host_screen_t ref_screen;
+static host_screen_t test_screen;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static void update_clock(host_screen_t *s, uint32_t i)
+{
+    char buf[16];
+    lv_snprintf(buf, sizeof(buf), "12:%02d:%02d", (int)(34 + i / 60), (int)(i % 60));
+    lv_label_set_text(s->time_label, buf);
+    lv_snprintf(buf, sizeof(buf), "%08d", (int)(1000000 - i));
+    lv_label_set_text(s->count, buf);
+}
+
+static void update_sensor(host_screen_t *s, uint32_t i)
+{
+    char buf[16];
+    lv_arc_set_value(s->humi_arc, (int16_t)(40 + i % 20));
+    lv_arc_set_value(s->temp_arc, (int16_t)(15 + i % 10));
+    lv_snprintf(buf, sizeof(buf), "%d.%d", 20 + (int)(i % 10), (int)(i % 7));
+    lv_label_set_text(s->temp_num, buf);
+    lv_snprintf(buf, sizeof(buf), "%d.%d", 50 + (int)(i % 9), (int)(i % 3));
+    lv_label_set_text(s->humi_num, buf);
+    lv_snprintf(buf, sizeof(buf), "%d.%d", 25 + (int)(i % 4), (int)(i % 5));
+    lv_label_set_text(s->btemp_num, buf);
+}
+
+// only the readouts of the sensor, the arcs move rarely
+static void update_readouts(host_screen_t *s, uint32_t i)
+{
+    char buf[16];
+    lv_snprintf(buf, sizeof(buf), "%d.%d", 20 + (int)(i % 10), (int)(i % 7));
+    lv_label_set_text(s->temp_num, buf);
+    lv_snprintf(buf, sizeof(buf), "%d.%d", 50 + (int)(i % 9), (int)(i % 3));
+    lv_label_set_text(s->humi_num, buf);
+    lv_snprintf(buf, sizeof(buf), "%d.%d", 25 + (int)(i % 4), (int)(i % 5));
+    lv_label_set_text(s->btemp_num, buf);
+}
+
+// a new day: every text label of the clock
+static void update_date(host_screen_t *s, uint32_t i)
+{
+    static const char *week_day[7] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    char buf[16];
+    update_clock(s, i);
+    lv_snprintf(buf, sizeof(buf), "2022-12-%02d", (int)(1 + i % 28));
+    lv_label_set_text(s->date_label, buf);
+    lv_label_set_text(s->weekday_label, week_day[i % 7]);
+}
+
+static void update_all(host_screen_t *s, uint32_t i)
+{
+    update_date(s, i);
+    update_sensor(s, i);
+}
+
+static const pattern_t patterns[] = {
+    {"clock tick", update_clock},
+    {"readouts", update_readouts},
+    {"sensor", update_sensor},
+    {"new day", update_date},
+    {"tick+sensor", update_all},
+};
+
+static const join_cfg_t cfgs[] = {
+    {"lvgl", 0, 0},
+    {"cost", BENCH_TRANS_PX, 0},
+    {"tile 16", 0, 16},
+    {"cost+tile 16", BENCH_TRANS_PX, 16},
+};
+
+#define PATTERN_CNT (sizeof(patterns) / sizeof(patterns[0]))
+#define CFG_CNT (sizeof(cfgs) / sizeof(cfgs[0]))
+
+static join_result_t results[PATTERN_CNT][CFG_CNT];
+
+// pixels of the visible circle which differ, the corners of a round panel hold stale data
+static uint32_t frame_diff(void)
+{
+    uint32_t diff = 0;
+    for (lv_coord_t y = 0; y < HOST_DISP_V_RES; y++)
+    {
+        lvgl_round_span_t span = lvgl_round_get_span(y);
+        for (lv_coord_t x = span.x1; x <= span.x2; x++)
+        {
+            uint32_t i = y * HOST_DISP_H_RES + x;
+            if (ref_disp->fb[i].full != test_disp->fb[i].full)
+            {
+                diff++;
+            }
+        }
+    }
+    return diff;
+}
+
+static join_result_t run_pattern(const pattern_t *pattern, const join_cfg_t *cfg)
+{
+    test_disp->drv.join_trans_px = cfg->join_trans_px;
+    test_disp->drv.tile_size = cfg->tile_size;
+    host_disp_reset_stats(test_disp);
+
+    for (uint32_t i = 0; i < BENCH_STEPS; i++)
+    {
+        pattern->update(&ref_screen, i);
+        pattern->update(&test_screen, i);
+        lv_refr_now(ref_disp->disp);
+        lv_refr_now(test_disp->disp);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, frame_diff());
+
+    join_result_t res = {
+        .trans = test_disp->stats.trans_cnt,
+        .bytes = test_disp->stats.flushed_bytes,
+    };
+    res.spi_us = (double)res.bytes * 8 * 1000000 / BENCH_SPI_HZ + res.trans * BENCH_TRANS_US;
+    return res;
+}
+
+void test_join_same_frames(void)
+{
+    for (uint32_t p = 0; p < PATTERN_CNT; p++)
+    {
+        for (uint32_t c = 0; c < CFG_CNT; c++)
+        {
+            results[p][c] = run_pattern(&patterns[p], &cfgs[c]);
+        }
+    }
+}
+
+void test_join_cost_model_saves_spi_time(void)
+{
+    printf("%d updates per pattern, %.0f us (%u px) per transfer, SPI at %d MHz:\n", BENCH_STEPS, BENCH_TRANS_US,
+           (unsigned)BENCH_TRANS_PX, BENCH_SPI_HZ / 1000000);
+    printf("  %-12s %-13s %7s %9s %9s\n", "pattern", "join", "trans", "bytes", "SPI ms");
+    for (uint32_t p = 0; p < PATTERN_CNT; p++)
+    {
+        for (uint32_t c = 0; c < CFG_CNT; c++)
+        {
+            const join_result_t *r = &results[p][c];
+            printf("  %-12s %-13s %7u %9u %9.2f (%+.1f%%)\n", c == 0 ? patterns[p].name : "", cfgs[c].name,
+                   (unsigned)r->trans, (unsigned)r->bytes, r->spi_us / 1000,
+                   100.0 * (r->spi_us - results[p][0].spi_us) / results[p][0].spi_us);
+        }
+    }
+
+    // the model joins only where it expects a gain, so it may not lose on any pattern
+    for (uint32_t p = 0; p < PATTERN_CNT; p++)
+    {
+        TEST_ASSERT_TRUE(results[p][1].spi_us <= results[p][0].spi_us * 1.01);
+    }
+}
+
+int main(void)
+{
+    lv_init();
+    ref_disp = host_disp_create(true);
+    test_disp = host_disp_create(true);
+    TEST_ASSERT_NOT_NULL(ref_disp);
+    TEST_ASSERT_NOT_NULL(test_disp);
+    // the reference joins like upstream LVGL, whatever lv_conf.h sets
+    ref_disp->drv.join_trans_px = 0;
+    ref_disp->drv.tile_size = 0;
+    host_screen_create(&ref_screen, ref_disp);
+    host_screen_create(&test_screen, test_disp);
+    lv_refr_now(ref_disp->disp);
+    lv_refr_now(test_disp->disp);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_join_same_frames);
+    RUN_TEST(test_join_cost_model_saves_spi_time);
+    return UNITY_END();
+}
@@ -0,0 +1,249 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Draws containers with opacity nested 1 to 4 deep, with labels and a rotated card on top, without and
+// with the layer buffers reserved by lv_draw_sw_layer_pool_reserve(), once on a quiet LVGL heap and once
+// on a heap fragmented into 4 KB holes like after a long run. Reports the frame times and per frame the
+// layers, the buffers allocated, the fallbacks to LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE chunks, in which the
+// inner layers are created again for every chunk, and the layers not drawn for lack of a buffer. The pool
+// allocates with malloc() like it uses PSRAM on the device.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "host_disp.h"
+#include "src/draw/sw/lv_draw_sw.h"
+
+#define BENCH_FRAMES 100
+#define BENCH_BATCHES 10
+#define FB_PX (HOST_DISP_H_RES * HOST_DISP_V_RES)
+#define DEPTH_MAX (LV_LAYER_POOL_SIMPLE_CNT + 1)
+#define HOLE_SIZE 4096
+#define HOLE_CNT_MAX 64
+
+static host_disp_t *hd;
+static lv_color_t *ref_fb;
+static lv_obj_t *card;
+static void *holes[HOLE_CNT_MAX];
+static uint32_t hole_cnt;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static void set_pool(bool en)
+{
+    if (en)
+    {
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_draw_sw_layer_pool_reserve());
+    }
+    else
+    {
+        lv_draw_sw_layer_pool_release();
+    }
+}
+
+// A rectangle covers its layer so it needs no alpha channel (LV_COLOR_SCREEN_TRANSP is 0)
+static lv_obj_t *rect_create(lv_obj_t *parent, lv_coord_t w, lv_coord_t h, lv_color_t color)
+{
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_bg_color(obj, color, 0);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    return obj;
+}
+
+static void create_screen(uint32_t depth)
+{
+    lv_obj_t *scr = lv_disp_get_scr_act(hd->disp);
+    lv_obj_clean(scr);
+    lv_obj_t *parent = scr;
+    for (uint32_t i = 0; i < depth; i++)
+    {
+        lv_obj_t *cont = rect_create(parent, 220 - i * 30, 220 - i * 30, lv_palette_main(LV_PALETTE_RED + i * 3));
+        lv_obj_align(cont, LV_ALIGN_CENTER, 0, 0);
+        lv_obj_set_style_opa(cont, LV_OPA_80, 0);
+        lv_obj_t *label = lv_label_create(cont);
+        lv_label_set_text_fmt(label, "Layer %u", (unsigned)i);
+        lv_obj_align(label, LV_ALIGN_TOP_LEFT, 4, 2);
+        parent = cont;
+    }
+
+    card = rect_create(scr, 100, 60, lv_palette_main(LV_PALETTE_TEAL));
+    lv_obj_align(card, LV_ALIGN_BOTTOM_MID, 0, -10);
+    lv_obj_set_style_transform_pivot_x(card, 50, 0);
+    lv_obj_set_style_transform_pivot_y(card, 30, 0);
+    lv_obj_set_style_transform_angle(card, 150, 0);
+    lv_obj_t *label = lv_label_create(card);
+    lv_label_set_text(label, "Rotated");
+    lv_obj_center(label);
+}
+
+// Fill the LVGL heap with HOLE_SIZE blocks and free every second one: no larger block is left
+static void fragment_heap(void)
+{
+    while (hole_cnt < HOLE_CNT_MAX && (holes[hole_cnt] = lv_mem_alloc(HOLE_SIZE)) != NULL)
+    {
+        hole_cnt++;
+    }
+    TEST_ASSERT_LESS_THAN_UINT32(HOLE_CNT_MAX, hole_cnt);
+    for (uint32_t i = 0; i < hole_cnt; i += 2)
+    {
+        lv_mem_free(holes[i]);
+        holes[i] = NULL;
+    }
+}
+
+static void unfragment_heap(void)
+{
+    for (uint32_t i = 0; i < hole_cnt; i++)
+    {
+        if (holes[i] != NULL)
+        {
+            lv_mem_free(holes[i]);
+        }
+    }
+    hole_cnt = 0;
+}
+
+static void frame(void)
+{
+    lv_obj_invalidate(lv_disp_get_scr_act(hd->disp));
+    lv_refr_now(hd->disp);
+}
+
+// The fastest of BENCH_BATCHES batches without and with the pool in us per frame. The batches
+// alternate so a slower period of a shared host hits both (see bench_round.c).
+static void bench(double us[2])
+{
+    const uint32_t batch = BENCH_FRAMES / BENCH_BATCHES;
+    us[0] = us[1] = 1e12;
+    for (uint32_t b = 0; b < BENCH_BATCHES; b++)
+    {
+        for (int pool = 0; pool < 2; pool++)
+        {
+            set_pool(pool);
+            uint64_t t0 = host_time_us();
+            for (uint32_t i = 0; i < batch; i++)
+            {
+                frame();
+            }
+            double t = (double)(host_time_us() - t0) / batch;
+            us[pool] = t < us[pool] ? t : us[pool];
+        }
+    }
+}
+
+// The layer statistics of one frame
+static void frame_stats(bool pool, lv_draw_sw_layer_pool_stats_t *stats)
+{
+    set_pool(pool);
+    lv_draw_sw_layer_pool_reset_stats();
+    frame();
+    lv_draw_sw_layer_pool_get_stats(stats);
+}
+
+static void report(uint32_t depth, const char *heap, const double us[2], const lv_draw_sw_layer_pool_stats_t *off,
+                   const lv_draw_sw_layer_pool_stats_t *on)
+{
+    printf("depth %u, %s heap: %.1f us without the pool, %.1f us with it, saved %.1f%%\n", (unsigned)depth, heap,
+           us[0], us[1], 100.0 * (us[0] - us[1]) / us[0]);
+    printf("  without: %u layers, %u allocated, %u fallbacks, %u failed\n",
+           (unsigned)(off->alloc_cnt + off->fail_cnt), (unsigned)off->alloc_cnt, (unsigned)off->fallback_cnt,
+           (unsigned)off->fail_cnt);
+    printf("  with:    %u layers, %u from the pool, %u allocated, %u fallbacks, %u failed, %u nested\n",
+           (unsigned)(on->simple_hit_cnt + on->transform_hit_cnt + on->alloc_cnt + on->fail_cnt),
+           (unsigned)(on->simple_hit_cnt + on->transform_hit_cnt), (unsigned)on->alloc_cnt,
+           (unsigned)on->fallback_cnt, (unsigned)on->fail_cnt, (unsigned)on->in_use_max);
+}
+
+void test_layer_pool_same_frame(void)
+{
+    create_screen(LV_LAYER_POOL_SIMPLE_CNT);
+    set_pool(false);
+    frame();
+    memcpy(ref_fb, hd->fb, FB_PX * sizeof(lv_color_t));
+
+    set_pool(true);
+    frame();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, hd->fb, FB_PX * sizeof(lv_color_t));
+
+    // the pool needs no contiguous block of the LVGL heap
+    fragment_heap();
+    frame();
+    unfragment_heap();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, hd->fb, FB_PX * sizeof(lv_color_t));
+}
+
+void test_layer_pool_nested(void)
+{
+    for (uint32_t depth = 1; depth <= DEPTH_MAX; depth++)
+    {
+        create_screen(depth);
+        lv_draw_sw_layer_pool_stats_t off;
+        lv_draw_sw_layer_pool_stats_t on;
+        double us[2];
+
+        frame_stats(false, &off);
+        frame_stats(true, &on);
+        bench(us);
+        report(depth, "quiet", us, &off, &on);
+        TEST_ASSERT_EQUAL_UINT32(0, off.fallback_cnt);
+        TEST_ASSERT_EQUAL_UINT32(0, on.fail_cnt);
+        if (depth <= LV_LAYER_POOL_SIMPLE_CNT)
+        {
+            TEST_ASSERT_EQUAL_UINT32(0, on.alloc_cnt);
+        }
+
+        fragment_heap();
+        frame_stats(false, &off);
+        frame_stats(true, &on);
+        // the rotated card gets no buffer without the pool, timed without it to draw the same
+        lv_obj_add_flag(card, LV_OBJ_FLAG_HIDDEN);
+        bench(us);
+        unfragment_heap();
+        report(depth, "fragmented", us, &off, &on);
+        // the times are too noisy on a shared host to assert on
+        TEST_ASSERT_GREATER_THAN_UINT32(0, off.fallback_cnt);
+        TEST_ASSERT_GREATER_THAN_UINT32(0, off.fail_cnt);
+        if (depth <= LV_LAYER_POOL_SIMPLE_CNT)
+        {
+            TEST_ASSERT_EQUAL_UINT32(0, on.alloc_cnt);
+            TEST_ASSERT_EQUAL_UINT32(0, on.fallback_cnt);
+            TEST_ASSERT_EQUAL_UINT32(0, on.fail_cnt);
+        }
+    }
+}
+
+int main(void)
+{
+    lv_init();
+    lv_draw_sw_layer_pool_set_mem_cb(malloc, free);
+    hd = host_disp_create(false);
+    ref_fb = malloc(FB_PX * sizeof(lv_color_t));
+    TEST_ASSERT_NOT_NULL(hd);
+    TEST_ASSERT_NOT_NULL(ref_fb);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_layer_pool_same_frame);
+    RUN_TEST(test_layer_pool_nested);
+    free(ref_fb);
+    return UNITY_END();
+}
@@ -0,0 +1,384 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Heap stress of lv_mem with and without the slab pages of LV_MEM_SLAB_SIZE: lv_demo_stress runs on
+// the virtual panel with its timers fast forwarded, while the random alloc/realloc/free churn of
+// test_mem_slab.c (and the too large realloc of test_mem.c) runs between the steps. Every mode runs in
+// a process of its own on a fresh heap and reports the latency of the churn's calls, the peak
+// fragmentation and the slab occupancy. The default run is short for CTest, for a soak test:
+//
+//   bench_mem --seconds 7200
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "unity.h"
+#include "host_disp.h"
+#include "lv_demos.h"
+
+#define CHURN_SLOTS 64
+#define CHURN_OPS_PER_STEP 32
+#define STEP_MS 5
+#define MONITOR_PERIOD 20
+// 10 ns buckets, slower calls only count in the maximum
+#define LAT_BUCKET_NS 10
+#define LAT_BUCKETS 2000
+
+typedef struct
+{
+    uint32_t p50_ns;
+    uint32_t p99_ns;
+    uint32_t max_ns;
+} lat_t;
+
+typedef struct
+{
+    bool ok;
+    uint64_t ops;
+    uint32_t sim_s;
+    uint32_t alloc_fail_cnt;
+    lat_t alloc;
+    lat_t free;
+    uint8_t peak_frag_pct;
+    uint8_t peak_used_pct;
+    uint32_t min_biggest_free;
+    uint8_t peak_slab_frag_pct;
+    uint32_t slab_max_used[LV_MEM_SLAB_CLASS_NUM];
+    uint32_t slab_fallback_cnt[LV_MEM_SLAB_CLASS_NUM];
+} mem_result_t;
+
+static uint32_t run_seconds = 2;
+static mem_result_t tlsf_res;
+static mem_result_t slab_res;
+
+static uint32_t alloc_hist[LAT_BUCKETS];
+static uint32_t free_hist[LAT_BUCKETS];
+static uint32_t alloc_max_ns;
+static uint32_t free_max_ns;
+
+static uint8_t *slots[CHURN_SLOTS];
+static uint16_t slot_size[CHURN_SLOTS];
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void lat_add(uint32_t *hist, uint32_t *max_ns, uint64_t ns)
+{
+    uint64_t b = ns / LAT_BUCKET_NS;
+    hist[b < LAT_BUCKETS ? b : LAT_BUCKETS - 1]++;
+    if (ns > *max_ns)
+    {
+        *max_ns = (uint32_t)ns;
+    }
+}
+
+static uint32_t lat_percentile(const uint32_t *hist, uint64_t cnt, uint32_t pct)
+{
+    uint64_t rank = (cnt * pct + 99) / 100;
+    uint64_t seen = 0;
+    for (uint32_t b = 0; b < LAT_BUCKETS; b++)
+    {
+        seen += hist[b];
+        if (seen >= rank && rank > 0)
+        {
+            return b * LAT_BUCKET_NS;
+        }
+    }
+    return LAT_BUCKETS * LAT_BUCKET_NS;
+}
+
+static lat_t lat_get(const uint32_t *hist, uint32_t max_ns)
+{
+    uint64_t cnt = 0;
+    for (uint32_t b = 0; b < LAT_BUCKETS; b++)
+    {
+        cnt += hist[b];
+    }
+    lat_t l = {
+        .p50_ns = lat_percentile(hist, cnt, 50),
+        .p99_ns = lat_percentile(hist, cnt, 99),
+        .max_ns = max_ns,
+    };
+    return l;
+}
+
+static void fill(uint8_t *p, uint32_t size, uint8_t seed)
+{
+    for (uint32_t i = 0; i < size; i++)
+    {
+        p[i] = (uint8_t)(seed + i);
+    }
+}
+
+static bool check(const uint8_t *p, uint32_t size, uint8_t seed)
+{
+    for (uint32_t i = 0; i < size; i++)
+    {
+        if (p[i] != (uint8_t)(seed + i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// mostly label texts and style lists, sometimes a larger buffer
+static uint32_t churn_size(void)
+{
+    return lv_rand(0, 7) ? lv_rand(1, LV_MEM_SLAB_MAX_SIZE) : lv_rand(LV_MEM_SLAB_MAX_SIZE + 1, 512);
+}
+
+static bool churn_op(mem_result_t *res)
+{
+    uint32_t s = lv_rand(0, CHURN_SLOTS - 1);
+    uint32_t size = churn_size();
+    uint8_t seed = (uint8_t)(s * 7);
+    uint64_t t0;
+
+    if (slots[s] == NULL)
+    {
+        t0 = now_ns();
+        slots[s] = lv_mem_alloc(size);
+        lat_add(alloc_hist, &alloc_max_ns, now_ns() - t0);
+        if (slots[s] == NULL)
+        {
+            res->alloc_fail_cnt++;
+            return true;
+        }
+        fill(slots[s], size, seed);
+        slot_size[s] = (uint16_t)size;
+    }
+    else if (lv_rand(0, 1))
+    {
+        if (!check(slots[s], slot_size[s], seed))
+        {
+            return false;
+        }
+        t0 = now_ns();
+        uint8_t *p = lv_mem_realloc(slots[s], size);
+        lat_add(alloc_hist, &alloc_max_ns, now_ns() - t0);
+        if (p == NULL)
+        {
+            res->alloc_fail_cnt++;
+            return true;
+        }
+        if (!check(p, size < slot_size[s] ? size : slot_size[s], seed))
+        {
+            return false;
+        }
+        slots[s] = p;
+        fill(p, size, seed);
+        slot_size[s] = (uint16_t)size;
+    }
+    else
+    {
+        if (!check(slots[s], slot_size[s], seed))
+        {
+            return false;
+        }
+        t0 = now_ns();
+        lv_mem_free(slots[s]);
+        lat_add(free_hist, &free_max_ns, now_ns() - t0);
+        slots[s] = NULL;
+    }
+    res->ops++;
+    return true;
+}
+
+// #3324 of test_mem.c: a realloc which can't be served leaves the block alone
+static bool too_large_realloc(void)
+{
+    for (uint32_t s = 0; s < CHURN_SLOTS; s++)
+    {
+        if (slots[s])
+        {
+            return lv_mem_realloc(slots[s], LV_MEM_SIZE + 16384) == NULL &&
+                   check(slots[s], slot_size[s], (uint8_t)(s * 7));
+        }
+    }
+    return true;
+}
+
+static void monitor(mem_result_t *res)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    res->peak_frag_pct = LV_MAX(res->peak_frag_pct, mon.frag_pct);
+    res->peak_used_pct = LV_MAX(res->peak_used_pct, mon.used_pct);
+    res->min_biggest_free = LV_MIN(res->min_biggest_free, mon.free_biggest_size);
+    res->peak_slab_frag_pct = LV_MAX(res->peak_slab_frag_pct, mon.slab_frag_pct);
+    for (uint32_t i = 0; i < LV_MEM_SLAB_CLASS_NUM; i++)
+    {
+        res->slab_max_used[i] = mon.slab[i].max_used_cnt;
+        res->slab_fallback_cnt[i] = mon.slab[i].fallback_cnt;
+    }
+}
+
+// the body of the child process, on a heap of its own
+static void stress(bool slab, mem_result_t *res)
+{
+    memset(res, 0, sizeof(*res));
+    res->min_biggest_free = UINT32_MAX;
+
+    lv_mem_slab_set_enabled(slab);
+    lv_init();
+    if (host_disp_create(false) == NULL)
+    {
+        return;
+    }
+    lv_demo_stress();
+
+    uint64_t end_us = host_time_us() + (uint64_t)run_seconds * 1000000;
+    uint32_t sim_ms = 0;
+    for (uint32_t step = 0; host_time_us() < end_us; step++)
+    {
+        host_tick_advance(STEP_MS);
+        sim_ms += STEP_MS;
+        lv_timer_handler();
+
+        for (uint32_t i = 0; i < CHURN_OPS_PER_STEP; i++)
+        {
+            if (!churn_op(res))
+            {
+                return;
+            }
+        }
+        if (step % MONITOR_PERIOD == 0)
+        {
+            monitor(res);
+            if (lv_mem_test() != LV_RES_OK || !too_large_realloc())
+            {
+                return;
+            }
+        }
+    }
+
+    monitor(res);
+    res->sim_s = sim_ms / 1000;
+    res->alloc = lat_get(alloc_hist, alloc_max_ns);
+    res->free = lat_get(free_hist, free_max_ns);
+    res->ok = lv_mem_test() == LV_RES_OK;
+}
+
+// a fresh heap and a fresh lv_demo_stress (it keeps its state in statics) for every mode
+static bool run_mode(bool slab, mem_result_t *res)
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        return false;
+    }
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        return false;
+    }
+    if (pid == 0)
+    {
+        close(fds[0]);
+        mem_result_t child_res;
+        stress(slab, &child_res);
+        ssize_t n = write(fds[1], &child_res, sizeof(child_res));
+        _exit(n == (ssize_t)sizeof(child_res) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    ssize_t n = read(fds[0], res, sizeof(*res));
+    close(fds[0]);
+    int status;
+    waitpid(pid, &status, 0);
+    return n == (ssize_t)sizeof(*res) && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+static void print_result(const char *name, const mem_result_t *res)
+{
+    printf("%s: %llu ops in %u simulated s, %u failed allocations\n", name, (unsigned long long)res->ops,
+           (unsigned)res->sim_s, (unsigned)res->alloc_fail_cnt);
+    printf("  alloc/realloc:  p50 %u ns, p99 %u ns, max %u ns\n", (unsigned)res->alloc.p50_ns,
+           (unsigned)res->alloc.p99_ns, (unsigned)res->alloc.max_ns);
+    printf("  free:           p50 %u ns, p99 %u ns, max %u ns\n", (unsigned)res->free.p50_ns,
+           (unsigned)res->free.p99_ns, (unsigned)res->free.max_ns);
+    printf("  peak:           frag %u %%, used %u %%, smallest biggest free block %u bytes\n",
+           (unsigned)res->peak_frag_pct, (unsigned)res->peak_used_pct, (unsigned)res->min_biggest_free);
+    printf("  slab:           peak frag %u %%, max used/fallbacks", (unsigned)res->peak_slab_frag_pct);
+    for (uint32_t i = 0; i < LV_MEM_SLAB_CLASS_NUM; i++)
+    {
+        printf(" %u:%u/%u", 16u << i, (unsigned)res->slab_max_used[i], (unsigned)res->slab_fallback_cnt[i]);
+    }
+    printf("\n");
+}
+
+void test_mem_stress_tlsf_only(void)
+{
+    TEST_ASSERT_TRUE(run_mode(false, &tlsf_res));
+    print_result("TLSF only", &tlsf_res);
+    TEST_ASSERT_TRUE(tlsf_res.ok);
+    TEST_ASSERT_GREATER_THAN_UINT64(0, tlsf_res.ops);
+}
+
+void test_mem_stress_slab(void)
+{
+    TEST_ASSERT_TRUE(run_mode(true, &slab_res));
+    print_result("slab pages + TLSF", &slab_res);
+    TEST_ASSERT_TRUE(slab_res.ok);
+    TEST_ASSERT_GREATER_THAN_UINT64(0, slab_res.ops);
+    uint32_t max_used = 0;
+    for (uint32_t i = 0; i < LV_MEM_SLAB_CLASS_NUM; i++)
+    {
+        max_used += slab_res.slab_max_used[i];
+    }
+    TEST_ASSERT_GREATER_THAN_UINT32(0, max_used);
+
+    // the timings are too noisy on a shared host to assert on
+    printf("slab vs TLSF only: alloc p99 %u/%u ns, free p99 %u/%u ns, peak frag %u/%u %%\n",
+           (unsigned)slab_res.alloc.p99_ns, (unsigned)tlsf_res.alloc.p99_ns, (unsigned)slab_res.free.p99_ns,
+           (unsigned)tlsf_res.free.p99_ns, (unsigned)slab_res.peak_frag_pct, (unsigned)tlsf_res.peak_frag_pct);
+}
+
+int main(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+        {
+            run_seconds = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--seconds N] (per mode, 2 by default)\n", argv[0]);
+            return 2;
+        }
+    }
+
+    UNITY_BEGIN();
+    RUN_TEST(test_mem_stress_tlsf_only);
+    RUN_TEST(test_mem_stress_slab);
+    return UNITY_END();
+}
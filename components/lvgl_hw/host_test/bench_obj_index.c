@@ -0,0 +1,258 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Finds the object under a point like lv_indev_search_obj() and the top object covering an area like
+// the refresh does among 2000 objects, by walking the tree and in the grid of LV_USE_OBJ_INDEX. Two
+// screens: 2025 tiles straight on the screen and a scrolled list of 400 rows of 5 objects, most of
+// them out of the display. Reports the time of a query, the objects the index tests per query, the
+// time to build the index again and, as it's built again every frame while the list scrolls, the
+// frame time of scrolling. Built with a 2 MB LVGL heap, see CMakeLists.txt.
+
+#include <stdio.h>
+#include "unity.h"
+#include "host_disp.h"
+
+#define TILE_SIZE 5
+#define TILE_CNT 45 // per row and column
+#define ROW_CNT 400
+#define QUERY_CNT 2000
+#define REBUILD_CNT 200
+#define SCROLL_FRAMES 20
+#define BENCH_BATCHES 10
+
+static host_disp_t *hd;
+static lv_obj_t *scr;
+static lv_obj_t *list;
+static lv_style_t tile_style;
+static lv_point_t points[QUERY_CNT];
+static lv_area_t areas[QUERY_CNT];
+static lv_obj_t *res[2][QUERY_CNT];
+
+void setUp(void)
+{
+    scr = lv_scr_act();
+    lv_obj_index_set_enabled(scr, true);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(scr);
+    lv_obj_index_set_enabled(scr, false);
+}
+
+static uint32_t obj_cnt(lv_obj_t *obj)
+{
+    uint32_t cnt = 1;
+    for (uint32_t i = 0; i < lv_obj_get_child_cnt(obj); i++)
+    {
+        cnt += obj_cnt(lv_obj_get_child(obj, i));
+    }
+    return cnt;
+}
+
+static void create_tiles(void)
+{
+    for (uint32_t i = 0; i < TILE_CNT * TILE_CNT; i++)
+    {
+        lv_obj_t *tile = lv_obj_create(scr);
+        lv_obj_remove_style_all(tile);
+        lv_obj_add_style(tile, &tile_style, 0);
+        lv_obj_set_pos(tile, (i % TILE_CNT) * TILE_SIZE + 7, (i / TILE_CNT) * TILE_SIZE + 7);
+        lv_obj_set_size(tile, TILE_SIZE - 1, TILE_SIZE - 1);
+    }
+    lv_obj_update_layout(scr);
+}
+
+static void create_list(void)
+{
+    list = lv_obj_create(scr);
+    lv_obj_set_size(list, lv_pct(100), lv_pct(100));
+    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+    for (uint32_t i = 0; i < ROW_CNT; i++)
+    {
+        lv_obj_t *row = lv_obj_create(list);
+        lv_obj_set_size(row, lv_pct(100), 40);
+        lv_obj_set_style_pad_all(row, 4, 0);
+        lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
+        lv_obj_t *icon = lv_obj_create(row);
+        lv_obj_remove_style_all(icon);
+        lv_obj_add_style(icon, &tile_style, 0);
+        lv_obj_set_size(icon, 24, 24);
+        lv_label_set_text_fmt(lv_label_create(row), "Row %u", (unsigned)i);
+        lv_label_set_text(lv_label_create(row), "42");
+        lv_obj_set_size(lv_switch_create(row), 40, 24);
+    }
+    lv_obj_scroll_to_y(list, ROW_CNT * 20, LV_ANIM_OFF);
+    lv_obj_update_layout(scr);
+}
+
+// the same points and areas every time, the areas up to the size of a band of the draw buffer
+static void random_queries(void)
+{
+    uint32_t seed = 0x1234;
+    for (uint32_t i = 0; i < QUERY_CNT; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        points[i].x = (seed >> 8) % HOST_DISP_H_RES;
+        points[i].y = (seed >> 20) % HOST_DISP_V_RES;
+        seed = seed * 1103515245 + 12345;
+        areas[i].x1 = (seed >> 8) % HOST_DISP_H_RES;
+        areas[i].y1 = (seed >> 20) % HOST_DISP_V_RES;
+        areas[i].x2 = LV_MIN(HOST_DISP_H_RES - 1, areas[i].x1 + (seed >> 4) % 16);
+        areas[i].y2 = LV_MIN(HOST_DISP_V_RES - 1, areas[i].y1 + (seed >> 12) % 16);
+    }
+}
+
+// ns per query, the objects found are kept in `res[on]`
+static double time_points(int on)
+{
+    uint64_t t0 = host_time_us();
+    for (uint32_t i = 0; i < QUERY_CNT; i++)
+    {
+        res[on][i] = lv_indev_search_obj(scr, &points[i]);
+    }
+    return 1000.0 * (double)(host_time_us() - t0) / QUERY_CNT;
+}
+
+static double time_areas(int on)
+{
+    uint64_t t0 = host_time_us();
+    for (uint32_t i = 0; i < QUERY_CNT; i++)
+    {
+        res[on][i] = _lv_refr_get_top_obj(&areas[i], scr);
+    }
+    return 1000.0 * (double)(host_time_us() - t0) / QUERY_CNT;
+}
+
+// us per frame, the list scrolled back and forth by 3 px
+static double time_scroll(int on)
+{
+    uint64_t t0 = host_time_us();
+    for (uint32_t i = 0; i < SCROLL_FRAMES; i++)
+    {
+        lv_obj_scroll_by(list, 0, i % 2 ? 3 : -3, LV_ANIM_OFF);
+        lv_refr_now(hd->disp);
+    }
+    return (double)(host_time_us() - t0) / SCROLL_FRAMES;
+}
+
+// The fastest of BENCH_BATCHES with the walk and the index. The batches alternate so a slower period
+// of a shared host hits both (see bench_round.c).
+static void bench(double (*fn)(int on), double t[2])
+{
+    t[0] = t[1] = 1e12;
+    for (uint32_t b = 0; b < BENCH_BATCHES; b++)
+    {
+        for (int on = 0; on < 2; on++)
+        {
+            lv_obj_index_set_enabled(scr, on);
+            fn(on); // builds the index
+            double dt = fn(on);
+            t[on] = dt < t[on] ? dt : t[on];
+        }
+    }
+    lv_obj_index_set_enabled(scr, true);
+}
+
+// us to build the index again after a change, with the query which builds it
+static double time_rebuild(void)
+{
+    double t = 1e12;
+    for (uint32_t b = 0; b < BENCH_BATCHES; b++)
+    {
+        uint64_t t0 = host_time_us();
+        for (uint32_t i = 0; i < REBUILD_CNT; i++)
+        {
+            _lv_obj_index_invalidate(scr);
+            lv_indev_search_obj(scr, &points[i]);
+        }
+        double dt = (double)(host_time_us() - t0) / REBUILD_CNT;
+        t = dt < t ? dt : t;
+    }
+    return t;
+}
+
+static void report(const char *name)
+{
+    random_queries();
+    lv_obj_index_reset_stats();
+
+    double point_ns[2];
+    bench(time_points, point_ns);
+    TEST_ASSERT_EQUAL_PTR_ARRAY(res[0], res[1], QUERY_CNT);
+
+    lv_obj_index_stats_t stats;
+    lv_obj_index_get_stats(&stats);
+    uint32_t point_candidates = stats.candidate_cnt;
+    TEST_ASSERT_EQUAL_UINT32(0, stats.fallback_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2 * BENCH_BATCHES * QUERY_CNT, stats.point_cnt);
+
+    lv_obj_index_reset_stats();
+    double area_ns[2];
+    bench(time_areas, area_ns);
+    TEST_ASSERT_EQUAL_PTR_ARRAY(res[0], res[1], QUERY_CNT);
+    lv_obj_index_get_stats(&stats);
+    uint32_t area_candidates = stats.candidate_cnt;
+    TEST_ASSERT_EQUAL_UINT32(0, stats.fallback_cnt);
+
+    double rebuild_us = time_rebuild();
+
+    printf("%s, %u objects, %u px cells:\n", name, (unsigned)obj_cnt(scr), (unsigned)LV_OBJ_INDEX_CELL_SIZE);
+    printf("  object under a point:  walk %7.0f ns, index %5.0f ns, saved %.1f%%, %.1f objects tested\n",
+           point_ns[0], point_ns[1], 100.0 * (point_ns[0] - point_ns[1]) / point_ns[0],
+           (double)point_candidates / (2.0 * BENCH_BATCHES * QUERY_CNT));
+    printf("  top object of an area: walk %7.0f ns, index %5.0f ns, saved %.1f%%, %.1f objects tested\n",
+           area_ns[0], area_ns[1], 100.0 * (area_ns[0] - area_ns[1]) / area_ns[0],
+           (double)area_candidates / (2.0 * BENCH_BATCHES * QUERY_CNT));
+    printf("  building the index again: %.1f us\n", rebuild_us);
+    // the times are too noisy on a shared host to assert on
+}
+
+void test_obj_index_tiles(void)
+{
+    create_tiles();
+    report("tiles on the screen");
+}
+
+void test_obj_index_list(void)
+{
+    create_list();
+    report("scrolled list");
+
+    lv_obj_index_reset_stats();
+    double frame_us[2];
+    bench(time_scroll, frame_us);
+    lv_obj_index_stats_t stats;
+    lv_obj_index_get_stats(&stats);
+    printf("  scrolling frame: walk %.1f us, index %.1f us, saved %.1f%%, %.1f cover queries per frame\n",
+           frame_us[0], frame_us[1], 100.0 * (frame_us[0] - frame_us[1]) / frame_us[0],
+           (double)stats.cover_cnt / (2.0 * BENCH_BATCHES * SCROLL_FRAMES));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.cover_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.fallback_cnt);
+}
+
+int main(void)
+{
+    lv_init();
+    hd = host_disp_create(false);
+    TEST_ASSERT_NOT_NULL(hd);
+    lv_style_init(&tile_style);
+    lv_style_set_bg_opa(&tile_style, LV_OPA_COVER);
+    lv_style_set_bg_color(&tile_style, lv_palette_main(LV_PALETTE_BLUE));
+
+    UNITY_BEGIN();
+    RUN_TEST(test_obj_index_tiles);
+    RUN_TEST(test_obj_index_list);
+    return UNITY_END();
+}
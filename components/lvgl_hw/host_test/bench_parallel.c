@@ -0,0 +1,327 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Renders the main screen and a screen of every kind of drawing on one and on two threads
+// (LV_USE_PARALLEL_RENDER with the pthread of host_parallel.c), checks that the pixels match and
+// compares the render time. The speed-up needs a second free CPU core, with one core the second
+// thread only adds its start and the locking.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "unity.h"
+#include "host_disp.h"
+#include "host_screen.h"
+#include "host_parallel.h"
+#include "lvgl_hw_round.h"
+
+#define BENCH_FRAMES 40
+#define BENCH_BATCHES 10
+#define FB_PX (HOST_DISP_H_RES * HOST_DISP_V_RES)
+
+static host_disp_t *app_disp;
+static host_disp_t *mix_disp;
+static host_screen_t screen;
+static lv_obj_t *mix_arc;
+static lv_obj_t *mix_label;
+static lv_img_dsc_t *snapshot;
+static lv_color_t *ref_fb;
+static const lv_parallel_cb_t *parallel_cb;
+
+void setUp(void)
+{
+    lv_parallel_set_cb(NULL);
+    lv_parallel_reset_stats();
+}
+
+void tearDown(void)
+{
+    lv_parallel_set_cb(NULL);
+}
+
+static void full_frame(host_disp_t *hd)
+{
+    lv_obj_invalidate(lv_disp_get_scr_act(hd->disp));
+    lv_refr_now(hd->disp);
+}
+
+// pixels which differ from ref_fb, only the visible circle of a round panel
+static uint32_t frame_diff(host_disp_t *hd)
+{
+    uint32_t diff = 0;
+    for (lv_coord_t y = 0; y < HOST_DISP_V_RES; y++)
+    {
+        lv_coord_t x1 = 0;
+        lv_coord_t x2 = HOST_DISP_H_RES - 1;
+        if (hd->round)
+        {
+            lvgl_round_span_t span = lvgl_round_get_span(y);
+            x1 = span.x1;
+            x2 = span.x2;
+        }
+        for (lv_coord_t x = x1; x <= x2; x++)
+        {
+            uint32_t i = y * HOST_DISP_H_RES + x;
+            if (hd->fb[i].full != ref_fb[i].full)
+            {
+                diff++;
+            }
+        }
+    }
+    return diff;
+}
+
+// Gradients, radius masks, shadows, text, arcs, lines, images from the cache and raw ones, and
+// the layers of opacity, clipped corners and transformation
+static void mix_screen_create(void)
+{
+    static const lv_point_t line_points[] = {{0, 0}, {60, 25}, {20, 50}, {90, 70}};
+
+    lv_disp_set_default(mix_disp->disp);
+    lv_obj_t *scr = lv_obj_create(NULL);
+    lv_obj_clear_flag(scr, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_style_bg_color(scr, lv_palette_lighten(LV_PALETTE_GREY, 3), 0);
+    lv_obj_set_style_bg_grad_color(scr, lv_palette_main(LV_PALETTE_TEAL), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_VER, 0);
+
+    lv_obj_t *card = lv_obj_create(scr);
+    lv_obj_remove_style_all(card);
+    lv_obj_set_pos(card, 10, 10);
+    lv_obj_set_size(card, 110, 100);
+    lv_obj_set_style_radius(card, 18, 0);
+    lv_obj_set_style_bg_opa(card, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(card, lv_palette_main(LV_PALETTE_ORANGE), 0);
+    lv_obj_set_style_bg_grad_color(card, lv_palette_main(LV_PALETTE_PURPLE), 0);
+    lv_obj_set_style_bg_grad_dir(card, LV_GRAD_DIR_HOR, 0);
+    lv_obj_set_style_shadow_width(card, 16, 0);
+    lv_obj_set_style_shadow_ofs_y(card, 4, 0);
+    lv_obj_set_style_border_width(card, 3, 0);
+    lv_obj_set_style_border_color(card, lv_color_white(), 0);
+    lv_obj_set_style_clip_corner(card, true, 0);
+
+    lv_obj_t *child = lv_obj_create(card);
+    lv_obj_remove_style_all(child);
+    lv_obj_set_pos(child, -20, 60);
+    lv_obj_set_size(child, 90, 60);
+    lv_obj_set_style_bg_opa(child, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(child, lv_palette_main(LV_PALETTE_LIME), 0);
+
+    mix_label = lv_label_create(scr);
+    lv_obj_set_style_text_font(mix_label, &lv_font_montserrat_24, 0);
+    lv_obj_set_style_text_opa(mix_label, LV_OPA_80, 0);
+    lv_label_set_text(mix_label, "Parallel\nrender 0");
+    lv_obj_set_pos(mix_label, 130, 14);
+
+    lv_obj_t *faded = lv_obj_create(scr);
+    lv_obj_set_pos(faded, 130, 75);
+    lv_obj_set_size(faded, 100, 50);
+    lv_obj_set_style_opa(faded, LV_OPA_60, 0);
+    // square: a layer with alpha needs LV_COLOR_SCREEN_TRANSP which the host build does not have
+    lv_obj_set_style_radius(faded, 0, 0);
+    lv_obj_t *faded_label = lv_label_create(faded);
+    lv_label_set_text(faded_label, LV_SYMBOL_WIFI " layer");
+    lv_obj_center(faded_label);
+
+    mix_arc = lv_arc_create(scr);
+    lv_obj_set_pos(mix_arc, 10, 125);
+    lv_obj_set_size(mix_arc, 100, 100);
+    lv_arc_set_value(mix_arc, 35);
+
+    lv_obj_t *line = lv_line_create(scr);
+    lv_line_set_points(line, line_points, sizeof(line_points) / sizeof(line_points[0]));
+    lv_obj_set_pos(line, 120, 130);
+    lv_obj_set_style_line_width(line, 5, 0);
+    lv_obj_set_style_line_rounded(line, true, 0);
+
+    // a raw TRUE_COLOR image of the line, drawn rotated (transformed layer) and straight; the card
+    // would not leave room for the gradients in the 64K host heap
+    lv_refr_now(mix_disp->disp);
+    snapshot = lv_snapshot_take(line, LV_IMG_CF_TRUE_COLOR);
+    lv_obj_t *img = lv_img_create(scr);
+    lv_img_set_src(img, snapshot);
+    lv_img_set_zoom(img, 192);
+    lv_obj_set_pos(img, 150, 170);
+    lv_obj_t *rotated = lv_img_create(scr);
+    lv_img_set_src(rotated, snapshot);
+    lv_img_set_zoom(rotated, 160);
+    lv_img_set_angle(rotated, 300);
+    lv_obj_set_pos(rotated, 90, 160);
+    // an image decoded by the (locked) image decoder
+    lv_obj_t *symbol = lv_img_create(scr);
+    lv_img_set_src(symbol, LV_SYMBOL_OK);
+    lv_obj_set_pos(symbol, 215, 10);
+
+    lv_obj_t *spun = lv_obj_create(scr);
+    lv_obj_set_pos(spun, 185, 120);
+    lv_obj_set_size(spun, 40, 40);
+    lv_obj_set_style_transform_angle(spun, 200, 0);
+    lv_obj_set_style_bg_color(spun, lv_palette_main(LV_PALETTE_RED), 0);
+
+    lv_disp_load_scr(scr);
+}
+
+// what the sensor bindings change, step i
+static void update_screens(uint32_t i)
+{
+    lv_arc_set_value(screen.humi_arc, (int16_t)(40 + i % 20));
+    lv_arc_set_value(screen.temp_arc, (int16_t)(15 + i % 10));
+    lv_label_set_text_fmt(screen.temp_num, "%d.%d", (int)(20 + i % 7), (int)(i % 10));
+    lv_label_set_text_fmt(screen.count, "%08d", (int)i);
+    lv_arc_set_value(mix_arc, (int16_t)(i * 7 % 100));
+    lv_label_set_text_fmt(mix_label, "Parallel\nrender %d", (int)i);
+}
+
+// a full frame on two threads matches the one on one thread
+static void check_full_frame(host_disp_t *hd)
+{
+    full_frame(hd);
+    memcpy(ref_fb, hd->fb, FB_PX * sizeof(lv_color_t));
+
+    lv_parallel_set_cb(parallel_cb);
+    full_frame(hd);
+    TEST_ASSERT_EQUAL_UINT32(0, frame_diff(hd));
+
+    lv_parallel_stats_t stats;
+    lv_parallel_get_stats(&stats);
+    TEST_ASSERT_TRUE(stats.parallel_cnt > 0);
+}
+
+void test_parallel_app_full_frame(void)
+{
+    check_full_frame(app_disp);
+}
+
+void test_parallel_mix_full_frame(void)
+{
+    check_full_frame(mix_disp);
+}
+
+// the partial redraws of two threads match a full redraw on one thread
+void test_parallel_updates(void)
+{
+    host_disp_t *disps[] = {app_disp, mix_disp};
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        update_screens(i);
+        for (uint32_t d = 0; d < sizeof(disps) / sizeof(disps[0]); d++)
+        {
+            lv_parallel_set_cb(parallel_cb);
+            lv_refr_now(disps[d]->disp);
+            memcpy(ref_fb, disps[d]->fb, FB_PX * sizeof(lv_color_t));
+
+            lv_parallel_set_cb(NULL);
+            full_frame(disps[d]);
+            TEST_ASSERT_EQUAL_UINT32(0, frame_diff(disps[d]));
+        }
+    }
+}
+
+void test_parallel_min_px(void)
+{
+    const lv_parallel_cb_t *large = host_parallel_init(HOST_DISP_BUF_SIZE + 1);
+    lv_parallel_set_cb(large);
+    full_frame(mix_disp);
+
+    lv_parallel_stats_t stats;
+    lv_parallel_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.parallel_cnt);
+    TEST_ASSERT_TRUE(stats.single_cnt > 0);
+    parallel_cb = host_parallel_init(0);
+}
+
+// Time of BENCH_FRAMES frames, from the fastest of BENCH_BATCHES batches (see bench_round.c)
+static uint64_t bench_frames(host_disp_t *hd, bool full)
+{
+    const uint32_t batch = BENCH_FRAMES / BENCH_BATCHES;
+    uint64_t best_us = UINT64_MAX;
+    for (uint32_t done = 0; done < BENCH_FRAMES; done += batch)
+    {
+        uint64_t t0 = host_time_us();
+        for (uint32_t i = done; i < done + batch; i++)
+        {
+            if (full)
+            {
+                full_frame(hd);
+            }
+            else
+            {
+                update_screens(i);
+                lv_refr_now(hd->disp);
+            }
+        }
+        uint64_t dt = host_time_us() - t0;
+        best_us = dt < best_us ? dt : best_us;
+    }
+    return best_us * BENCH_BATCHES;
+}
+
+static void bench_disp(const char *name, host_disp_t *hd)
+{
+    uint64_t us[2][2];
+    for (uint32_t p = 0; p < 2; p++)
+    {
+        lv_parallel_set_cb(p ? parallel_cb : NULL);
+        us[p][0] = bench_frames(hd, true);
+        us[p][1] = bench_frames(hd, false);
+    }
+    printf("  %-12s full frame %8.1f -> %8.1f us (%.2fx), update %8.1f -> %8.1f us (%.2fx)\n", name,
+           (double)us[0][0] / BENCH_FRAMES, (double)us[1][0] / BENCH_FRAMES, (double)us[0][0] / (double)us[1][0],
+           (double)us[0][1] / BENCH_FRAMES, (double)us[1][1] / BENCH_FRAMES, (double)us[0][1] / (double)us[1][1]);
+}
+
+void test_parallel_render_time(void)
+{
+    printf("one thread -> two threads, per frame (%d frames, %ld CPU cores online):\n", BENCH_FRAMES,
+           sysconf(_SC_NPROCESSORS_ONLN));
+    bench_disp("main screen", app_disp);
+    bench_disp("mix screen", mix_disp);
+
+    // the times are too noisy on a shared host to assert on
+    lv_parallel_stats_t stats;
+    lv_parallel_get_stats(&stats);
+    TEST_ASSERT_TRUE(stats.parallel_cnt > 0);
+}
+
+int main(void)
+{
+    lv_init();
+    app_disp = host_disp_create(true);
+    mix_disp = host_disp_create(false);
+    ref_fb = malloc(FB_PX * sizeof(lv_color_t));
+    parallel_cb = host_parallel_init(0);
+    TEST_ASSERT_NOT_NULL(app_disp);
+    TEST_ASSERT_NOT_NULL(mix_disp);
+    TEST_ASSERT_NOT_NULL(ref_fb);
+    TEST_ASSERT_NOT_NULL(parallel_cb);
+
+    // like gui_task: the caches don't fit into the LVGL heap
+    lv_draw_sw_shadow_cache_set_mem_cb(malloc, free);
+    lv_draw_sw_arc_cache_set_mem_cb(malloc, free);
+    lv_font_cache_set_mem_cb(malloc, free);
+    host_screen_create(&screen, app_disp);
+    mix_screen_create();
+    TEST_ASSERT_NOT_NULL(snapshot);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_parallel_app_full_frame);
+    RUN_TEST(test_parallel_mix_full_frame);
+    RUN_TEST(test_parallel_updates);
+    RUN_TEST(test_parallel_min_px);
+    RUN_TEST(test_parallel_render_time);
+    lv_snapshot_free(snapshot);
+    free(ref_fb);
+    return UNITY_END();
+}
@@ -0,0 +1,123 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Renders a screen shaped like ui_Screen1 on a rectangular and on a round virtual panel and
+// reports the bytes sent and the render time saved per full frame by the round panel mode.
+
+#include <stdio.h>
+#include "unity.h"
+#include "host_disp.h"
+#include "host_screen.h"
+#include "lvgl_hw_round.h"
+
+#define BENCH_FRAMES 100
+#define BENCH_BATCHES 10
+
+static host_disp_t *rect_disp;
+static host_disp_t *round_disp;
+static host_screen_t rect_screen;
+static host_screen_t round_screen;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// Time of `frames` full frames, from the fastest of BENCH_BATCHES batches: the host is shared
+// and the least disturbed batch is the most repeatable
+static uint64_t bench_full_frames(host_disp_t *hd, uint32_t frames)
+{
+    host_disp_reset_stats(hd);
+    uint32_t batch = frames >= BENCH_BATCHES ? frames / BENCH_BATCHES : 1;
+    uint64_t best_us = UINT64_MAX;
+    for (uint32_t done = 0; done < frames; done += batch)
+    {
+        uint64_t t0 = host_time_us();
+        for (uint32_t i = 0; i < batch; i++)
+        {
+            lv_obj_invalidate(lv_disp_get_scr_act(hd->disp));
+            lv_refr_now(hd->disp);
+        }
+        uint64_t dt = host_time_us() - t0;
+        best_us = dt < best_us ? dt : best_us;
+    }
+    return best_us * frames / batch;
+}
+
+void test_round_frame_matches_rect_inside_circle(void)
+{
+    bench_full_frames(rect_disp, 1);
+    bench_full_frames(round_disp, 1);
+
+    uint32_t diff = 0;
+    for (lv_coord_t y = 0; y < HOST_DISP_V_RES; y++)
+    {
+        lvgl_round_span_t span = lvgl_round_get_span(y);
+        for (lv_coord_t x = span.x1; x <= span.x2; x++)
+        {
+            uint32_t i = y * HOST_DISP_H_RES + x;
+            if (rect_disp->fb[i].full != round_disp->fb[i].full)
+            {
+                diff++;
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, diff);
+}
+
+void test_round_saves_bytes_and_time(void)
+{
+    uint64_t rect_us = bench_full_frames(rect_disp, BENCH_FRAMES);
+    host_disp_stats_t rect = rect_disp->stats;
+    uint64_t round_us = bench_full_frames(round_disp, BENCH_FRAMES);
+    host_disp_stats_t round = round_disp->stats;
+
+    uint32_t rect_bytes = rect.flushed_bytes / BENCH_FRAMES;
+    uint32_t round_bytes = round.flushed_bytes / BENCH_FRAMES;
+    uint32_t visible_bytes = lvgl_round_get_visible_px() * sizeof(lv_color_t);
+
+    printf("round panel, per full frame (%d frames):\n", BENCH_FRAMES);
+    printf("  bytes sent:   rect %u, round %u (visible %u), saved %u (%.1f%%)\n",
+           (unsigned)rect_bytes, (unsigned)round_bytes, (unsigned)visible_bytes, (unsigned)(rect_bytes - round_bytes),
+           100.0 * (rect_bytes - round_bytes) / rect_bytes);
+    printf("  transfers:    rect %u, round %u\n",
+           (unsigned)(rect.trans_cnt / BENCH_FRAMES), (unsigned)(round.trans_cnt / BENCH_FRAMES));
+    printf("  render+flush: rect %.1f us, round %.1f us, saved %.1f%%\n",
+           (double)rect_us / BENCH_FRAMES, (double)round_us / BENCH_FRAMES,
+           100.0 * ((double)rect_us - (double)round_us) / (double)rect_us);
+
+    TEST_ASSERT_EQUAL_UINT32(HOST_DISP_H_RES * HOST_DISP_V_RES * sizeof(lv_color_t), rect_bytes);
+    TEST_ASSERT_TRUE(round_bytes >= visible_bytes);
+    // the corners are ~21% of the square, the bands keep a few of them
+    TEST_ASSERT_TRUE(round_bytes < rect_bytes * 85 / 100);
+}
+
+int main(void)
+{
+    lv_init();
+    rect_disp = host_disp_create(false);
+    round_disp = host_disp_create(true);
+    TEST_ASSERT_NOT_NULL(rect_disp);
+    TEST_ASSERT_NOT_NULL(round_disp);
+    host_screen_create(&rect_screen, rect_disp);
+    host_screen_create(&round_screen, round_disp);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_round_frame_matches_rect_inside_circle);
+    RUN_TEST(test_round_saves_bytes_and_time);
+    return UNITY_END();
+}
@@ -0,0 +1,312 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Checks that the shadow cache of LV_SHADOW_CACHE_BUDGET draws the same pixels as calculating every
+// shadow, and redraws the arc screen with glowing rings and knobs to compare the cache budgets.
+//
+// The arcs of the main screen draw no shadow: `shadow_spread` of the indicator has no effect without a
+// `shadow_width`, and only the main part and the knob of an arc can have a shadow. So the benchmark
+// gives those a shadow.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "host_disp.h"
+#include "host_screen.h"
+#include "lvgl_hw_round.h"
+#include "src/draw/sw/lv_draw_sw.h"
+
+#define BENCH_FRAMES 40
+#define BENCH_BATCHES 10
+#define FB_PX (HOST_DISP_H_RES * HOST_DISP_V_RES)
+// the (20 + 120)^2 corner of the rings and the entry's header, no room left for the knobs
+#define RING_ONLY_BUDGET (140 * 140 + 64)
+
+static host_disp_t *arc_disp;
+static host_disp_t *shape_disp;
+static host_screen_t screen;
+static lv_obj_t *shape_scr;
+static lv_color_t *ref_fb;
+
+void setUp(void)
+{
+    lv_draw_sw_shadow_cache_set_budget(LV_SHADOW_CACHE_BUDGET);
+    lv_draw_sw_shadow_cache_clear();
+    lv_draw_sw_shadow_cache_reset_stats();
+}
+
+void tearDown(void)
+{
+}
+
+static void full_frame(host_disp_t *hd)
+{
+    lv_obj_invalidate(lv_disp_get_scr_act(hd->disp));
+    lv_refr_now(hd->disp);
+}
+
+// pixels which differ from ref_fb, only the visible circle of a round panel
+static uint32_t frame_diff(host_disp_t *hd)
+{
+    uint32_t diff = 0;
+    for (lv_coord_t y = 0; y < HOST_DISP_V_RES; y++)
+    {
+        lv_coord_t x1 = 0;
+        lv_coord_t x2 = HOST_DISP_H_RES - 1;
+        if (hd->round)
+        {
+            lvgl_round_span_t span = lvgl_round_get_span(y);
+            x1 = span.x1;
+            x2 = span.x2;
+        }
+        for (lv_coord_t x = x1; x <= x2; x++)
+        {
+            uint32_t i = y * HOST_DISP_H_RES + x;
+            if (hd->fb[i].full != ref_fb[i].full)
+            {
+                diff++;
+            }
+        }
+    }
+    return diff;
+}
+
+// Shadows of every kind of corner: a far side close enough to change the blur, spread, no radius,
+// and pairs which only differ in a size that doesn't affect the corner, so they share an entry
+static void shape_screen_create(void)
+{
+    static const struct
+    {
+        lv_coord_t w, h, radius, sw, spread;
+    } shapes[] = {
+        {8, 8, 0, 12, 0},     {10, 30, 5, 6, 0},    {30, 10, 5, 6, 0},  {40, 40, LV_RADIUS_CIRCLE, 10, 0},
+        {20, 20, 4, 15, 3},   {24, 24, 12, 1, 2},   {60, 20, 8, 10, 0}, {90, 20, 8, 10, 0},
+        {50, 50, 0, 20, -10}, {12, 50, 30, 9, 0},   {45, 16, 3, 2, 1},  {16, 45, 3, 2, 1},
+    };
+
+    lv_disp_set_default(shape_disp->disp);
+    shape_scr = lv_obj_create(NULL);
+    lv_obj_clear_flag(shape_scr, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_style_bg_color(shape_scr, lv_color_white(), 0);
+    for (uint32_t i = 0; i < sizeof(shapes) / sizeof(shapes[0]); i++)
+    {
+        lv_obj_t *obj = lv_obj_create(shape_scr);
+        lv_obj_remove_style_all(obj);
+        lv_obj_set_pos(obj, 25 + (i % 4) * 55, 25 + (i / 4) * 75);
+        lv_obj_set_size(obj, shapes[i].w, shapes[i].h);
+        lv_obj_set_style_radius(obj, shapes[i].radius, 0);
+        lv_obj_set_style_bg_opa(obj, i % 2 ? LV_OPA_50 : LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_BLUE), 0);
+        lv_obj_set_style_shadow_width(obj, shapes[i].sw, 0);
+        lv_obj_set_style_shadow_spread(obj, shapes[i].spread, 0);
+        lv_obj_set_style_shadow_ofs_x(obj, (lv_coord_t)(i % 3) - 1, 0);
+        lv_obj_set_style_shadow_color(obj, lv_color_black(), 0);
+    }
+    lv_disp_load_scr(shape_scr);
+}
+
+// a glow around the rings and the knobs of the arcs
+static void arc_glow_add(lv_obj_t *arc)
+{
+    lv_obj_set_style_radius(arc, LV_RADIUS_CIRCLE, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_shadow_width(arc, 20, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_shadow_color(arc, lv_palette_main(LV_PALETTE_BLUE), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_shadow_width(arc, 12, LV_PART_KNOB | LV_STATE_DEFAULT);
+    lv_obj_set_style_shadow_color(arc, lv_color_white(), LV_PART_KNOB | LV_STATE_DEFAULT);
+}
+
+// the shadow of a calculated, then cached corner looks the same as always calculating it
+static void check_matches_uncached(host_disp_t *hd)
+{
+    lv_draw_sw_shadow_cache_set_budget(0);
+    full_frame(hd);
+    memcpy(ref_fb, hd->fb, FB_PX * sizeof(lv_color_t));
+
+    lv_draw_sw_shadow_cache_set_budget(LV_SHADOW_CACHE_BUDGET);
+    full_frame(hd);
+    TEST_ASSERT_EQUAL_UINT32(0, frame_diff(hd));
+    full_frame(hd);
+    TEST_ASSERT_EQUAL_UINT32(0, frame_diff(hd));
+
+    lv_draw_sw_shadow_cache_stats_t stats;
+    lv_draw_sw_shadow_cache_get_stats(&stats);
+    TEST_ASSERT_TRUE(stats.hit_cnt > 0);
+    TEST_ASSERT_TRUE(stats.used <= stats.budget);
+}
+
+void test_shadow_shapes_match_uncached(void)
+{
+    check_matches_uncached(shape_disp);
+}
+
+void test_shadow_arcs_match_uncached(void)
+{
+    check_matches_uncached(arc_disp);
+}
+
+void test_shadow_lru_eviction(void)
+{
+    // the knobs take the place of the rings and the other way around
+    lv_draw_sw_shadow_cache_set_budget(RING_ONLY_BUDGET);
+    full_frame(arc_disp);
+    full_frame(arc_disp);
+
+    lv_draw_sw_shadow_cache_stats_t stats;
+    lv_draw_sw_shadow_cache_get_stats(&stats);
+    TEST_ASSERT_TRUE(stats.evict_cnt > 0);
+    TEST_ASSERT_TRUE(stats.used <= stats.budget);
+
+    lv_draw_sw_shadow_cache_clear();
+    lv_draw_sw_shadow_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.used);
+}
+
+static uint32_t alloc_cnt;
+
+static void *count_alloc(size_t size)
+{
+    alloc_cnt++;
+    return malloc(size);
+}
+
+void test_shadow_mem_cb(void)
+{
+    // like the PSRAM allocator of gui_task
+    alloc_cnt = 0;
+    lv_draw_sw_shadow_cache_set_mem_cb(count_alloc, free);
+    full_frame(arc_disp);
+    lv_draw_sw_shadow_cache_stats_t stats;
+    lv_draw_sw_shadow_cache_get_stats(&stats);
+    TEST_ASSERT_TRUE(stats.entry_cnt > 1);
+    // one buffer for the whole budget
+    TEST_ASSERT_EQUAL_UINT32(1, alloc_cnt);
+
+    lv_draw_sw_shadow_cache_set_mem_cb(malloc, free);
+    lv_draw_sw_shadow_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+}
+
+// what refresh_task_callback and the sensor bindings change on the arcs, step i
+static void update_arcs(uint32_t i)
+{
+    lv_arc_set_value(screen.humi_arc, (int16_t)(40 + i % 20));
+    lv_arc_set_value(screen.temp_arc, (int16_t)(15 + i % 10));
+}
+
+// Time of BENCH_FRAMES frames, from the fastest of BENCH_BATCHES batches (see bench_round.c)
+static uint64_t bench_frames(bool full)
+{
+    const uint32_t batch = BENCH_FRAMES / BENCH_BATCHES;
+    uint64_t best_us = UINT64_MAX;
+    for (uint32_t done = 0; done < BENCH_FRAMES; done += batch)
+    {
+        uint64_t t0 = host_time_us();
+        for (uint32_t i = done; i < done + batch; i++)
+        {
+            if (full)
+            {
+                full_frame(arc_disp);
+            }
+            else
+            {
+                update_arcs(i);
+                lv_refr_now(arc_disp->disp);
+            }
+        }
+        uint64_t dt = host_time_us() - t0;
+        best_us = dt < best_us ? dt : best_us;
+    }
+    return best_us * BENCH_BATCHES;
+}
+
+typedef struct
+{
+    const char *name;
+    uint32_t budget;
+    uint64_t full_us;
+    uint64_t upd_us;
+    lv_draw_sw_shadow_cache_stats_t stats;
+} bench_mode_t;
+
+static void bench_mode(bench_mode_t *mode)
+{
+    lv_draw_sw_shadow_cache_set_budget(mode->budget);
+    lv_draw_sw_shadow_cache_clear();
+    full_frame(arc_disp);
+    lv_draw_sw_shadow_cache_reset_stats();
+
+    mode->full_us = bench_frames(true);
+    mode->upd_us = bench_frames(false);
+    lv_draw_sw_shadow_cache_get_stats(&mode->stats);
+
+    printf("  %-10s full frame %8.1f us, arc update %8.1f us, %5u hits, %5u misses, %4u evictions, %4u skipped, %5u bytes\n",
+           mode->name, (double)mode->full_us / BENCH_FRAMES, (double)mode->upd_us / BENCH_FRAMES,
+           (unsigned)mode->stats.hit_cnt, (unsigned)mode->stats.miss_cnt, (unsigned)mode->stats.evict_cnt, (unsigned)mode->stats.skip_cnt,
+           (unsigned)mode->stats.used);
+}
+
+void test_shadow_cache_saves_time(void)
+{
+    bench_mode_t modes[] = {
+        {.name = "off", .budget = 0},
+        {.name = "one entry", .budget = RING_ONLY_BUDGET},
+        {.name = "budget", .budget = LV_SHADOW_CACHE_BUDGET},
+    };
+
+    printf("glowing arc screen, per frame (%d frames):\n", BENCH_FRAMES);
+    for (uint32_t i = 0; i < sizeof(modes) / sizeof(modes[0]); i++)
+    {
+        bench_mode(&modes[i]);
+    }
+    printf("  saved %.1f%% per full frame, %.1f%% per arc update\n",
+           100.0 * ((double)modes[0].full_us - (double)modes[2].full_us) / (double)modes[0].full_us,
+           100.0 * ((double)modes[0].upd_us - (double)modes[2].upd_us) / (double)modes[0].upd_us);
+
+    // the times are too noisy on a shared host to assert on, count the calculated corners instead
+    TEST_ASSERT_EQUAL_UINT32(0, modes[0].stats.hit_cnt);
+    TEST_ASSERT_TRUE(modes[1].stats.miss_cnt > 0);
+    TEST_ASSERT_EQUAL_UINT32(0, modes[2].stats.miss_cnt);
+    TEST_ASSERT_TRUE(modes[2].stats.hit_cnt > 0);
+}
+
+int main(void)
+{
+    lv_init();
+    arc_disp = host_disp_create(true);
+    shape_disp = host_disp_create(false);
+    ref_fb = malloc(FB_PX * sizeof(lv_color_t));
+    TEST_ASSERT_NOT_NULL(arc_disp);
+    TEST_ASSERT_NOT_NULL(shape_disp);
+    TEST_ASSERT_NOT_NULL(ref_fb);
+
+    // the caches don't fit into the LVGL heap next to the large shadows, gui_task doesn't use it either
+    lv_draw_sw_shadow_cache_set_mem_cb(malloc, free);
+    lv_draw_sw_arc_cache_set_mem_cb(malloc, free);
+    lv_font_cache_set_mem_cb(malloc, free);
+    host_screen_create(&screen, arc_disp);
+    arc_glow_add(screen.humi_arc);
+    arc_glow_add(screen.temp_arc);
+    shape_screen_create();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_shadow_shapes_match_uncached);
+    RUN_TEST(test_shadow_arcs_match_uncached);
+    RUN_TEST(test_shadow_lru_eviction);
+    RUN_TEST(test_shadow_mem_cb);
+    RUN_TEST(test_shadow_cache_saves_time);
+    free(ref_fb);
+    return UNITY_END();
+}
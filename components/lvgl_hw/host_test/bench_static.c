@@ -0,0 +1,202 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Renders the main screen on two round panels, one drawing its static part from the pre-rendered
+// layer of CONFIG_LVGL_STATIC_LAYER, and compares the frames and the render time.
+
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "host_disp.h"
+#include "host_screen.h"
+#include "lvgl_hw_round.h"
+#include "lvgl_hw_static.h"
+
+#define BENCH_FRAMES 100
+#define BENCH_BATCHES 10
+
+static host_disp_t *live_disp;
+static host_disp_t *cached_disp;
+static host_screen_t live_screen;
+static host_screen_t cached_screen;
+static lvgl_static_layer_t layer;
+static lvgl_static_part_t static_parts[HOST_SCREEN_STATIC_LABELS + 1];
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// pixels of the visible circle which differ, the corners of a round panel hold stale data
+static uint32_t frame_diff(void)
+{
+    uint32_t diff = 0;
+    for (lv_coord_t y = 0; y < HOST_DISP_V_RES; y++)
+    {
+        lvgl_round_span_t span = lvgl_round_get_span(y);
+        for (lv_coord_t x = span.x1; x <= span.x2; x++)
+        {
+            uint32_t i = y * HOST_DISP_H_RES + x;
+            if (live_disp->fb[i].full != cached_disp->fb[i].full)
+            {
+                diff++;
+            }
+        }
+    }
+    return diff;
+}
+
+static void full_frame(host_disp_t *hd)
+{
+    lv_obj_invalidate(lv_disp_get_scr_act(hd->disp));
+    lv_refr_now(hd->disp);
+}
+
+// what refresh_task_callback and the sensor bindings change, step i
+static void update_values(host_screen_t *s, uint32_t i)
+{
+    char buf[16];
+    lv_arc_set_value(s->humi_arc, (int16_t)(40 + i % 20));
+    lv_arc_set_value(s->temp_arc, (int16_t)(15 + i % 10));
+    lv_snprintf(buf, sizeof(buf), "%d.%d", 20 + (int)(i % 10), (int)(i % 7));
+    lv_label_set_text(s->temp_num, buf);
+    lv_snprintf(buf, sizeof(buf), "12:34:%02d", (int)(i % 60));
+    lv_label_set_text(s->time_label, buf);
+    lv_snprintf(buf, sizeof(buf), "%08d", (int)(1000000 - i));
+    lv_label_set_text(s->count, buf);
+}
+
+static uint32_t static_label_draws;
+
+static void count_draw_cb(lv_event_t *e)
+{
+    static_label_draws++;
+}
+
+// Time of BENCH_FRAMES frames, from the fastest of BENCH_BATCHES batches (see bench_round.c)
+static uint64_t bench_frames(host_disp_t *hd, host_screen_t *s, bool full)
+{
+    const uint32_t batch = BENCH_FRAMES / BENCH_BATCHES;
+    uint64_t best_us = UINT64_MAX;
+    for (uint32_t done = 0; done < BENCH_FRAMES; done += batch)
+    {
+        uint64_t t0 = host_time_us();
+        for (uint32_t i = done; i < done + batch; i++)
+        {
+            if (full)
+            {
+                full_frame(hd);
+            }
+            else
+            {
+                update_values(s, i);
+                lv_refr_now(hd->disp);
+            }
+        }
+        uint64_t dt = host_time_us() - t0;
+        best_us = dt < best_us ? dt : best_us;
+    }
+    return best_us * BENCH_BATCHES;
+}
+
+void test_static_frame_matches_live(void)
+{
+    full_frame(live_disp);
+    full_frame(cached_disp);
+    TEST_ASSERT_EQUAL_UINT32(0, frame_diff());
+
+    // the dynamic parts drawn over the image still match after some updates
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        update_values(&live_screen, i * 7);
+        update_values(&cached_screen, i * 7);
+        lv_refr_now(live_disp->disp);
+        lv_refr_now(cached_disp->disp);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, frame_diff());
+}
+
+void test_static_switch_off_restores_objects(void)
+{
+    lvgl_static_layer_set_enabled(&layer, false);
+    TEST_ASSERT_TRUE(lv_obj_has_flag(layer.img, LV_OBJ_FLAG_HIDDEN));
+    TEST_ASSERT_FALSE(lv_obj_has_flag(cached_screen.static_labels[0], LV_OBJ_FLAG_HIDDEN));
+    lv_refr_now(cached_disp->disp);
+    full_frame(live_disp);
+    TEST_ASSERT_EQUAL_UINT32(0, frame_diff());
+
+    lvgl_static_layer_set_enabled(&layer, true);
+    TEST_ASSERT_TRUE(lv_obj_has_flag(cached_screen.static_labels[0], LV_OBJ_FLAG_HIDDEN));
+    TEST_ASSERT_TRUE(lvgl_static_layer_update(&layer));
+    full_frame(cached_disp);
+    TEST_ASSERT_EQUAL_UINT32(0, frame_diff());
+}
+
+void test_static_saves_time(void)
+{
+    lv_obj_add_event_cb(cached_screen.static_labels[0], count_draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    lvgl_static_layer_set_enabled(&layer, false);
+    static_label_draws = 0;
+    uint64_t off_full_us = bench_frames(cached_disp, &cached_screen, true);
+    uint64_t off_upd_us = bench_frames(cached_disp, &cached_screen, false);
+    uint32_t off_draws = static_label_draws;
+
+    lvgl_static_layer_set_enabled(&layer, true);
+    static_label_draws = 0;
+    uint64_t on_full_us = bench_frames(cached_disp, &cached_screen, true);
+    uint64_t on_upd_us = bench_frames(cached_disp, &cached_screen, false);
+    uint32_t on_draws = static_label_draws;
+
+    printf("static layer (%u bytes), per frame (%d frames):\n", (unsigned)layer.buf_size, BENCH_FRAMES);
+    printf("  full frame:     off %.1f us, on %.1f us, saved %.1f%%\n", (double)off_full_us / BENCH_FRAMES,
+           (double)on_full_us / BENCH_FRAMES, 100.0 * ((double)off_full_us - (double)on_full_us) / (double)off_full_us);
+    printf("  value updates:  off %.1f us, on %.1f us, saved %.1f%%\n", (double)off_upd_us / BENCH_FRAMES,
+           (double)on_upd_us / BENCH_FRAMES, 100.0 * ((double)off_upd_us - (double)on_upd_us) / (double)off_upd_us);
+
+    // the times are too noisy on a shared host to assert on, the static objects must not be drawn at all
+    TEST_ASSERT_TRUE(off_draws >= BENCH_FRAMES);
+    TEST_ASSERT_EQUAL_UINT32(0, on_draws);
+}
+
+int main(void)
+{
+    lv_init();
+    live_disp = host_disp_create(true);
+    cached_disp = host_disp_create(true);
+    TEST_ASSERT_NOT_NULL(live_disp);
+    TEST_ASSERT_NOT_NULL(cached_disp);
+    host_screen_create(&live_screen, live_disp);
+    host_screen_create(&cached_screen, cached_disp);
+
+    // the parts lvgl_app.c registers: the fixed labels and the background of the humidity arc
+    for (uint32_t i = 0; i < HOST_SCREEN_STATIC_LABELS; i++)
+    {
+        static_parts[i].obj = cached_screen.static_labels[i];
+        static_parts[i].part = LV_PART_ANY;
+    }
+    static_parts[HOST_SCREEN_STATIC_LABELS].obj = cached_screen.humi_arc;
+    static_parts[HOST_SCREEN_STATIC_LABELS].part = LV_PART_MAIN;
+    TEST_ASSERT_TRUE(lvgl_static_layer_create(&layer, cached_screen.scr, static_parts,
+                                              sizeof(static_parts) / sizeof(static_parts[0])));
+
+    UNITY_BEGIN();
+    RUN_TEST(test_static_frame_matches_live);
+    RUN_TEST(test_static_switch_off_restores_objects);
+    RUN_TEST(test_static_saves_time);
+    return UNITY_END();
+}
@@ -0,0 +1,198 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Draws the lv_demo_widgets screen with and without the style cache of LV_STYLE_CACHE_SIZE and
+// reports the style lookups per frame, the share served from the cache, the time of a lookup and
+// the full frame time.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "host_disp.h"
+#include "host_tick.h"
+#include "lv_demos.h"
+
+#define BENCH_FRAMES 200
+#define BENCH_BATCHES 20
+#define LOOKUP_ROUNDS 20
+#define FB_PX (HOST_DISP_H_RES * HOST_DISP_V_RES)
+
+static host_disp_t *hd;
+static lv_color_t *ref_fb;
+
+void setUp(void)
+{
+    lv_obj_style_cache_set_enabled(true);
+}
+
+void tearDown(void)
+{
+}
+
+static void full_frame(void)
+{
+    lv_obj_invalidate(lv_disp_get_scr_act(hd->disp));
+    lv_refr_now(hd->disp);
+}
+
+// The properties lv_obj_draw() and the layout read from the main part
+static const lv_style_prop_t draw_props[] = {
+    LV_STYLE_BG_COLOR,      LV_STYLE_BG_OPA,       LV_STYLE_BG_GRAD_DIR,     LV_STYLE_BG_IMG_SRC,
+    LV_STYLE_BORDER_WIDTH,  LV_STYLE_BORDER_COLOR, LV_STYLE_BORDER_OPA,      LV_STYLE_BORDER_SIDE,
+    LV_STYLE_OUTLINE_WIDTH, LV_STYLE_SHADOW_WIDTH, LV_STYLE_RADIUS,          LV_STYLE_CLIP_CORNER,
+    LV_STYLE_PAD_TOP,       LV_STYLE_PAD_LEFT,     LV_STYLE_OPA,             LV_STYLE_TEXT_FONT,
+    LV_STYLE_TEXT_COLOR,    LV_STYLE_BLEND_MODE,   LV_STYLE_TRANSFORM_WIDTH, LV_STYLE_TRANSLATE_X,
+};
+
+static lv_obj_t *visible_objs[512];
+static uint32_t visible_cnt;
+
+// the objects from `obj` a redraw draws
+static void collect_visible(lv_obj_t *obj)
+{
+    if (!lv_obj_is_visible(obj) || visible_cnt == sizeof(visible_objs) / sizeof(visible_objs[0]))
+    {
+        return;
+    }
+    visible_objs[visible_cnt++] = obj;
+    for (uint32_t i = 0; i < lv_obj_get_child_cnt(obj); i++)
+    {
+        collect_visible(lv_obj_get_child(obj, i));
+    }
+}
+
+static uint64_t time_frames(uint32_t cnt)
+{
+    uint64_t t0 = host_time_us();
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+        full_frame();
+    }
+    return host_time_us() - t0;
+}
+
+// the draw properties of the visible objects, the reads of a redraw
+static uint64_t time_lookups(uint32_t rounds, uint32_t *cnt)
+{
+    uint64_t t0 = host_time_us();
+    for (uint32_t r = 0; r < rounds; r++)
+    {
+        for (uint32_t i = 0; i < visible_cnt; i++)
+        {
+            for (uint32_t p = 0; p < sizeof(draw_props) / sizeof(draw_props[0]); p++)
+            {
+                lv_obj_get_style_prop(visible_objs[i], LV_PART_MAIN, draw_props[p]);
+            }
+        }
+    }
+    *cnt += rounds * visible_cnt * (sizeof(draw_props) / sizeof(draw_props[0]));
+    return host_time_us() - t0;
+}
+
+// The fastest of BENCH_BATCHES batches with the cache off and on. The batches alternate so a
+// slower period of a shared host hits both (see bench_round.c).
+static void bench(uint64_t frame_us[2], double lookup_ns[2])
+{
+    const uint32_t batch = BENCH_FRAMES / BENCH_BATCHES;
+    frame_us[0] = frame_us[1] = UINT64_MAX;
+    lookup_ns[0] = lookup_ns[1] = 1e9;
+    for (uint32_t b = 0; b < BENCH_BATCHES; b++)
+    {
+        for (int on = 0; on < 2; on++)
+        {
+            lv_obj_style_cache_set_enabled(on);
+            full_frame(); // fills the cache
+
+            uint64_t dt = time_frames(batch);
+            frame_us[on] = dt < frame_us[on] ? dt : frame_us[on];
+
+            uint32_t cnt = 0;
+            dt = time_lookups(LOOKUP_ROUNDS, &cnt);
+            double ns = 1000.0 * (double)dt / (double)cnt;
+            lookup_ns[on] = ns < lookup_ns[on] ? ns : lookup_ns[on];
+        }
+    }
+    frame_us[0] *= BENCH_BATCHES;
+    frame_us[1] *= BENCH_BATCHES;
+}
+
+void test_style_cache_same_frame(void)
+{
+    lv_obj_style_cache_set_enabled(false);
+    full_frame();
+    memcpy(ref_fb, hd->fb, FB_PX * sizeof(lv_color_t));
+
+    lv_obj_style_cache_set_enabled(true);
+    full_frame();
+    full_frame();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, hd->fb, FB_PX * sizeof(lv_color_t));
+}
+
+void test_style_cache_saves_lookup_time(void)
+{
+    lv_obj_style_cache_stats_t stats;
+
+    // lv_refr_now() runs the animations of the demo, with a frozen tick all the frames draw the same objects
+    // once the first one caught up with the time before the freeze
+    host_tick_freeze(true);
+    full_frame();
+    lv_obj_style_cache_set_enabled(false);
+    lv_obj_style_cache_reset_stats();
+    full_frame();
+    lv_obj_style_cache_get_stats(&stats);
+    uint32_t lookups = stats.skip_cnt;
+
+    lv_obj_style_cache_set_enabled(true);
+    full_frame();
+    lv_obj_style_cache_reset_stats();
+    full_frame();
+    lv_obj_style_cache_get_stats(&stats);
+    host_tick_freeze(false);
+
+    collect_visible(lv_disp_get_scr_act(hd->disp));
+    uint64_t frame_us[2];
+    double lookup_ns[2];
+    bench(frame_us, lookup_ns);
+
+    uint32_t cached = stats.hit_cnt + stats.miss_cnt;
+    printf("lv_demo_widgets, %u visible objects, %u style lookups per full frame, %u%% from the cache (%u entries)\n",
+           (unsigned)visible_cnt, (unsigned)lookups, (unsigned)(cached ? 100 * stats.hit_cnt / cached : 0), (unsigned)LV_STYLE_CACHE_SIZE);
+    printf("  lookup of a draw property:  off %.1f ns, on %.1f ns, saved %.1f%%\n", lookup_ns[0], lookup_ns[1],
+           100.0 * (lookup_ns[0] - lookup_ns[1]) / lookup_ns[0]);
+    printf("  full frame:                 off %.1f us, on %.1f us, saved %.1f%%\n", (double)frame_us[0] / BENCH_FRAMES,
+           (double)frame_us[1] / BENCH_FRAMES, 100.0 * ((double)frame_us[0] - (double)frame_us[1]) / (double)frame_us[0]);
+
+    // the times are too noisy on a shared host to assert on
+    TEST_ASSERT_EQUAL_UINT32(lookups, stats.hit_cnt + stats.miss_cnt + stats.skip_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(stats.miss_cnt, stats.hit_cnt);
+}
+
+int main(void)
+{
+    lv_init();
+    hd = host_disp_create(false);
+    ref_fb = malloc(FB_PX * sizeof(lv_color_t));
+    TEST_ASSERT_NOT_NULL(hd);
+    TEST_ASSERT_NOT_NULL(ref_fb);
+    // like gui_task: the glyph cache doesn't fit into the LVGL heap next to the demo
+    lv_font_cache_set_mem_cb(malloc, free);
+    lv_demo_widgets();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_style_cache_same_frame);
+    RUN_TEST(test_style_cache_saves_lookup_time);
+    free(ref_fb);
+    return UNITY_END();
+}
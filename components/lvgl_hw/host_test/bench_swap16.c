@@ -0,0 +1,121 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Renders the main screen with the basic SW blender and with the one of LV_USE_DRAW_SW_SWAP16 and
+// compares the frames and the render time.
+
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "host_disp.h"
+#include "host_screen.h"
+#include "src/draw/sw/lv_draw_sw.h"
+
+#define BENCH_FRAMES 100
+#define BENCH_BATCHES 10
+#define FB_PX (HOST_DISP_H_RES * HOST_DISP_V_RES)
+
+static host_disp_t *hd;
+static host_screen_t screen;
+static lv_color_t basic_fb[FB_PX];
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static void set_blend(void (*blend)(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc))
+{
+    ((lv_draw_sw_ctx_t *)hd->drv.draw_ctx)->blend = blend;
+}
+
+static void full_frame(void)
+{
+    lv_obj_invalidate(screen.scr);
+    lv_refr_now(hd->disp);
+}
+
+// what refresh_task_callback and the sensor bindings change, step i
+static void update_values(uint32_t i)
+{
+    char buf[16];
+    lv_arc_set_value(screen.humi_arc, (int16_t)(40 + i % 20));
+    lv_arc_set_value(screen.temp_arc, (int16_t)(15 + i % 10));
+    lv_snprintf(buf, sizeof(buf), "%d.%d", 20 + (int)(i % 10), (int)(i % 7));
+    lv_label_set_text(screen.temp_num, buf);
+    lv_snprintf(buf, sizeof(buf), "12:34:%02d", (int)(i % 60));
+    lv_label_set_text(screen.time_label, buf);
+}
+
+void test_swap16_frame_matches_basic(void)
+{
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        update_values(i * 7);
+        set_blend(lv_draw_sw_blend_basic);
+        full_frame();
+        memcpy(basic_fb, hd->fb, sizeof(basic_fb));
+
+        set_blend(lv_draw_sw_blend_swap16);
+        full_frame();
+        TEST_ASSERT_EQUAL_HEX16_ARRAY((uint16_t *)basic_fb, (uint16_t *)hd->fb, FB_PX);
+    }
+}
+
+// Time of BENCH_FRAMES full frames, from the fastest of BENCH_BATCHES batches (see bench_round.c)
+// alternating the blenders per batch
+void test_swap16_bench(void)
+{
+    const uint32_t batch = BENCH_FRAMES / BENCH_BATCHES;
+    uint64_t basic_us = UINT64_MAX;
+    uint64_t swap16_us = UINT64_MAX;
+    for (uint32_t done = 0; done < BENCH_FRAMES; done += batch)
+    {
+        set_blend(lv_draw_sw_blend_basic);
+        uint64_t t0 = host_time_us();
+        for (uint32_t i = 0; i < batch; i++)
+        {
+            full_frame();
+        }
+        uint64_t dt = host_time_us() - t0;
+        basic_us = dt < basic_us ? dt : basic_us;
+
+        set_blend(lv_draw_sw_blend_swap16);
+        t0 = host_time_us();
+        for (uint32_t i = 0; i < batch; i++)
+        {
+            full_frame();
+        }
+        dt = host_time_us() - t0;
+        swap16_us = dt < swap16_us ? dt : swap16_us;
+    }
+    printf("full frame: basic blender %.1f us, swap16 blender %.1f us\n", (double)basic_us / batch,
+           (double)swap16_us / batch);
+}
+
+int main(void)
+{
+    lv_init();
+    hd = host_disp_create(false);
+    TEST_ASSERT_NOT_NULL(hd);
+    host_screen_create(&screen, hd);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_swap16_frame_matches_basic);
+    RUN_TEST(test_swap16_bench);
+    return UNITY_END();
+}
@@ -0,0 +1,186 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Runs lv_timer_handler() over 100 and 800 timers with the heap of LV_USE_TIMER_HEAP and with the
+// walk of the timer list, once while no timer is due and once through simulated seconds with 20 ms
+// to 2 s periods, and compares the time of a call. 800 timers nearly fill the 64 KB heap of the
+// host, 1000 don't fit.
+
+#include <stdio.h>
+#include "unity.h"
+#include "host_tick.h"
+#include "lvgl.h"
+
+#define TIMER_CNT_MAX 800
+#define IDLE_CALLS 2000
+#define RUN_MS 5000
+#define BENCH_BATCHES 10
+
+static const uint32_t timer_cnts[] = {100, TIMER_CNT_MAX};
+static lv_timer_t *timers[TIMER_CNT_MAX];
+static uint32_t timer_cnt;
+static uint32_t run_cnt;
+
+void setUp(void)
+{
+    lv_timer_heap_set_enabled(true);
+}
+
+void tearDown(void)
+{
+}
+
+static void count_cb(lv_timer_t *timer)
+{
+    run_cnt++;
+}
+
+static void create_timers(uint32_t cnt, uint32_t min_period, uint32_t max_period)
+{
+    // the same periods every time
+    uint32_t seed = 0x1234;
+    timer_cnt = cnt;
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        timers[i] = lv_timer_create(count_cb, min_period + (seed >> 8) % (max_period - min_period + 1), NULL);
+        TEST_ASSERT_NOT_NULL(timers[i]);
+    }
+}
+
+static void del_timers(void)
+{
+    for (uint32_t i = 0; i < timer_cnt; i++)
+    {
+        lv_timer_del(timers[i]);
+    }
+}
+
+// ns per lv_timer_handler() call while nothing is due
+static double time_idle(void)
+{
+    uint64_t t0 = host_time_us();
+    for (uint32_t i = 0; i < IDLE_CALLS; i++)
+    {
+        lv_timer_handler();
+    }
+    return 1000.0 * (double)(host_time_us() - t0) / IDLE_CALLS;
+}
+
+// ns per lv_timer_handler() call, one call per simulated ms
+static double time_run(void)
+{
+    uint64_t t0 = host_time_us();
+    for (uint32_t i = 0; i < RUN_MS; i++)
+    {
+        host_tick_advance(1);
+        lv_timer_handler();
+    }
+    return 1000.0 * (double)(host_time_us() - t0) / RUN_MS;
+}
+
+// The fastest of BENCH_BATCHES with the list walk and the heap. The batches alternate so a slower
+// period of a shared host hits both (see bench_round.c).
+static void bench(double (*fn)(void), double ns[2])
+{
+    ns[0] = ns[1] = 1e12;
+    for (uint32_t b = 0; b < BENCH_BATCHES; b++)
+    {
+        for (int heap = 0; heap < 2; heap++)
+        {
+            lv_timer_heap_set_enabled(heap);
+            double t = fn();
+            ns[heap] = t < ns[heap] ? t : ns[heap];
+        }
+    }
+}
+
+// The time till the next timer by walking all of them, what lv_timer_handler() returned before
+static uint32_t time_till_next_by_walk(void)
+{
+    uint32_t min = LV_NO_TIMER_READY;
+    uint32_t now = lv_tick_get();
+    lv_timer_t *timer = NULL;
+    while ((timer = lv_timer_get_next(timer)) != NULL)
+    {
+        if (timer->paused)
+        {
+            continue;
+        }
+        uint32_t elaps = now - timer->last_run;
+        uint32_t remaining = elaps >= timer->period ? 0 : timer->period - elaps;
+        min = remaining < min ? remaining : min;
+    }
+    return min;
+}
+
+void test_timer_idle_calls(void)
+{
+    for (uint32_t c = 0; c < sizeof(timer_cnts) / sizeof(timer_cnts[0]); c++)
+    {
+        create_timers(timer_cnts[c], 1000000, 2000000);
+        double ns[2];
+        bench(time_idle, ns);
+        printf("%3u timers, none due:    list %6.0f ns, heap %4.0f ns per lv_timer_handler(), saved %.1f%%\n",
+               (unsigned)timer_cnt, ns[0], ns[1], 100.0 * (ns[0] - ns[1]) / ns[0]);
+        del_timers();
+    }
+}
+
+void test_timer_running(void)
+{
+    for (uint32_t c = 0; c < sizeof(timer_cnts) / sizeof(timer_cnts[0]); c++)
+    {
+        create_timers(timer_cnts[c], 20, 2000);
+        double ns[2];
+        run_cnt = 0;
+        bench(time_run, ns);
+        printf("%3u timers, 20 ms..2 s:  list %6.0f ns, heap %4.0f ns per lv_timer_handler(), saved %.1f%%, "
+               "%.2f callbacks per call\n",
+               (unsigned)timer_cnt, ns[0], ns[1], 100.0 * (ns[0] - ns[1]) / ns[0],
+               (double)run_cnt / (2.0 * BENCH_BATCHES * RUN_MS));
+        TEST_ASSERT_GREATER_THAN_UINT32(0, run_cnt);
+
+        // the heap finds the same next deadline the walk does, the tick might step between the two
+        uint32_t walk = time_till_next_by_walk();
+        TEST_ASSERT_UINT32_WITHIN(1, walk, lv_timer_get_time_till_next());
+
+        uint64_t t0 = host_time_us();
+        for (uint32_t i = 0; i < IDLE_CALLS; i++)
+        {
+            time_till_next_by_walk();
+        }
+        double walk_ns = 1000.0 * (double)(host_time_us() - t0) / IDLE_CALLS;
+        t0 = host_time_us();
+        for (uint32_t i = 0; i < IDLE_CALLS; i++)
+        {
+            lv_timer_get_time_till_next();
+        }
+        double heap_ns = 1000.0 * (double)(host_time_us() - t0) / IDLE_CALLS;
+        printf("%3u timers, next deadline: walk %6.0f ns, lv_timer_get_time_till_next() %.0f ns\n",
+               (unsigned)timer_cnt, walk_ns, heap_ns);
+
+        del_timers();
+    }
+}
+
+int main(void)
+{
+    lv_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_timer_idle_calls);
+    RUN_TEST(test_timer_running);
+    return UNITY_END();
+}
@@ -0,0 +1,233 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Builds ui_Screen1 from the code tools/lvgl_ui_gen.py generates out of ui/ui_Screen1.json: the
+// const styles and object table lvgl_app.c uses, and the lv_obj_set_style_*() calls the screen was
+// hand written with before. Checks that both render the same frame and reports the time to create
+// the screen, to load it (created, loaded and rendered once) and the LVGL heap the screen takes.
+
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "host_disp.h"
+#include "ui_Screen1.h"
+#include "ui_Screen1_calls.h"
+
+#define BENCH_LOADS 20
+#define BENCH_BATCHES 10
+
+static host_disp_t *hd;
+static lv_obj_t *base;
+static lv_color_t frame[HOST_DISP_H_RES * HOST_DISP_V_RES];
+
+typedef struct
+{
+    const char *name;
+    void (*init)(void);
+    lv_obj_t **scr;
+} screen_build_t;
+
+static const screen_build_t builds[2] = {
+    {"lv_obj_set_style_*() calls", ui_Screen1_screen_init_calls, &ui_Screen1_calls},
+    {"const styles and table", ui_Screen1_screen_init, &ui_Screen1},
+};
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static lv_obj_t *load(const screen_build_t *b)
+{
+    b->init();
+    lv_disp_load_scr(*b->scr);
+    lv_refr_now(hd->disp);
+    return *b->scr;
+}
+
+static void unload(lv_obj_t *scr)
+{
+    lv_disp_load_scr(base);
+    lv_obj_del(scr);
+    lv_refr_now(hd->disp);
+}
+
+// local styles of the objects on a screen, lv_disp_load_scr() gives the screen itself one
+static uint32_t local_style_cnt(lv_obj_t *parent)
+{
+    uint32_t cnt = 0;
+    for (uint32_t i = 0; i < lv_obj_get_child_cnt(parent); i++)
+    {
+        lv_obj_t *obj = lv_obj_get_child(parent, i);
+        for (uint32_t s = 0; s < obj->style_cnt; s++)
+        {
+            cnt += obj->styles[s].is_local;
+        }
+        cnt += local_style_cnt(obj);
+    }
+    return cnt;
+}
+
+// what the bindings of lvgl_app.c change first, the labels with a static text get a copy
+static void update_values(void)
+{
+    lv_label_set_text(ui_count_calls, "00012345");
+    lv_label_set_text(ui_count, "00012345");
+    lv_label_set_text(ui_timeLabel_calls, "12:34:56");
+    lv_label_set_text(ui_timeLabel, "12:34:56");
+    lv_numlabel_set_value(ui_tempLabelnum_calls, -53);
+    lv_numlabel_set_value(ui_tempLabelnum, -53);
+    lv_arc_set_value(ui_humiArc_calls, 67);
+    lv_arc_set_value(ui_humiArc, 67);
+}
+
+void test_ui_gen_same_frame(void)
+{
+    lv_obj_t *calls_scr = load(&builds[0]);
+    memcpy(frame, hd->fb, sizeof(frame));
+    lv_obj_t *const_scr = load(&builds[1]);
+    TEST_ASSERT_EQUAL_MEMORY(frame, hd->fb, sizeof(frame));
+    TEST_ASSERT_EQUAL_UINT32(16, lv_obj_get_child_cnt(const_scr));
+    TEST_ASSERT_EQUAL_UINT32(0, local_style_cnt(const_scr));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, local_style_cnt(calls_scr));
+
+    update_values();
+    lv_disp_load_scr(calls_scr);
+    lv_obj_invalidate(calls_scr);
+    lv_refr_now(hd->disp);
+    memcpy(frame, hd->fb, sizeof(frame));
+    lv_disp_load_scr(const_scr);
+    lv_obj_invalidate(const_scr);
+    lv_refr_now(hd->disp);
+    TEST_ASSERT_EQUAL_MEMORY(frame, hd->fb, sizeof(frame));
+
+    unload(calls_scr);
+    unload(const_scr);
+}
+
+// a full humidity, 1000 in tenths, needs the blank leading cell of the format
+void test_ui_gen_humidity_full(void)
+{
+    char text[LV_NUMLABEL_MAX_CELL_COUNT + 1];
+    for (int i = 0; i < 2; i++)
+    {
+        builds[i].init();
+        lv_obj_t *label = i == 0 ? ui_humiLabelnum_calls : ui_humiLabelnum;
+        lv_numlabel_set_value(label, 1000);
+        lv_numlabel_get_text(label, text);
+        TEST_ASSERT_EQUAL_STRING("100.0", text);
+        lv_numlabel_set_value(label, 67);
+        lv_numlabel_get_text(label, text);
+        TEST_ASSERT_EQUAL_STRING("6.7", text);
+        lv_obj_del(*builds[i].scr);
+    }
+}
+
+// heap of a screen, created but not rendered yet
+static void heap_used(const screen_build_t *b, uint32_t *bytes, uint32_t *blocks)
+{
+    lv_mem_monitor_t before;
+    lv_mem_monitor_t after;
+    lv_mem_monitor(&before);
+    b->init();
+    lv_mem_monitor(&after);
+    *bytes = (before.free_size - after.free_size);
+    *blocks = after.used_cnt - before.used_cnt;
+    lv_obj_del(*b->scr);
+}
+
+void test_ui_gen_heap(void)
+{
+    uint32_t bytes[2];
+    uint32_t blocks[2];
+    for (int i = 0; i < 2; i++)
+    {
+        heap_used(&builds[i], &bytes[i], &blocks[i]);
+    }
+    printf("ui_Screen1 in the LVGL heap:\n");
+    for (int i = 0; i < 2; i++)
+    {
+        printf("  %-28s %6u bytes in %4u blocks\n", builds[i].name, (unsigned)bytes[i], (unsigned)blocks[i]);
+    }
+    printf("  saved %.1f%% of the bytes\n", 100.0 * ((double)bytes[0] - (double)bytes[1]) / (double)bytes[0]);
+    TEST_ASSERT_LESS_THAN_UINT32(bytes[0], bytes[1]);
+    TEST_ASSERT_LESS_THAN_UINT32(blocks[0], blocks[1]);
+}
+
+// us to create the screen and to load it, the fastest of BENCH_BATCHES batches. The batches alternate
+// so a slower period of a shared host hits both (see bench_round.c).
+void test_ui_gen_load_time(void)
+{
+    double create_us[2] = {1e12, 1e12};
+    double load_us[2] = {1e12, 1e12};
+    for (uint32_t batch = 0; batch < BENCH_BATCHES; batch++)
+    {
+        for (int i = 0; i < 2; i++)
+        {
+            // one at a time, a few of them fill the heap
+            uint64_t create_total = 0;
+            for (uint32_t n = 0; n < BENCH_LOADS; n++)
+            {
+                uint64_t t0 = host_time_us();
+                builds[i].init();
+                create_total += host_time_us() - t0;
+                lv_obj_del(*builds[i].scr);
+            }
+            double dt = (double)create_total / BENCH_LOADS;
+            create_us[i] = dt < create_us[i] ? dt : create_us[i];
+
+            uint64_t load_total = 0;
+            for (uint32_t n = 0; n < BENCH_LOADS; n++)
+            {
+                uint64_t t1 = host_time_us();
+                lv_obj_t *scr = load(&builds[i]);
+                load_total += host_time_us() - t1;
+                unload(scr);
+            }
+            dt = (double)load_total / BENCH_LOADS;
+            load_us[i] = dt < load_us[i] ? dt : load_us[i];
+        }
+    }
+    printf("ui_Screen1 (%d loads):\n", BENCH_LOADS);
+    for (int i = 0; i < 2; i++)
+    {
+        printf("  %-28s create %6.1f us, load with the first frame %7.1f us\n", builds[i].name, create_us[i],
+               load_us[i]);
+    }
+    printf("  saved %.1f%% of the create, %.1f%% of the load\n",
+           100.0 * (create_us[0] - create_us[1]) / create_us[0], 100.0 * (load_us[0] - load_us[1]) / load_us[0]);
+    // the times are too noisy on a shared host to assert on
+}
+
+int main(void)
+{
+    lv_init();
+    hd = host_disp_create(false);
+    TEST_ASSERT_NOT_NULL(hd);
+    // the theme of ui_init()
+    lv_theme_t *theme = lv_theme_default_init(hd->disp, lv_palette_main(LV_PALETTE_BLUE),
+                                              lv_palette_main(LV_PALETTE_RED), false, LV_FONT_DEFAULT);
+    lv_disp_set_theme(hd->disp, theme);
+    base = lv_scr_act();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_ui_gen_same_frame);
+    RUN_TEST(test_ui_gen_humidity_full);
+    RUN_TEST(test_ui_gen_heap);
+    RUN_TEST(test_ui_gen_load_time);
+    return UNITY_END();
+}
@@ -0,0 +1,131 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Runs lvgl_app.c unchanged: idf_stubs replace the ESP-IDF headers it includes, the functions of
+// the GUI task and the sensor hub it calls are implemented here.
+
+// setenv() and tzset()
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <time.h>
+#include "iot_sensor_hub.h"
+#include "lvgl_hw_main_task.h"
+#include "lvgl_app.h"
+#include "host_app.h"
+
+#define HOST_APP_MAX_TIMERS 16
+
+static time_t app_clock;
+static all_signals_t app_signals;
+static sensor_event_handler_t humiture_handler;
+static void *humiture_handler_args;
+
+time_t host_app_time(time_t *t)
+{
+    if (t != NULL)
+    {
+        *t = app_clock;
+    }
+    return app_clock;
+}
+
+// the host app is single threaded, LVGL is always free
+bool gui_lock(uint32_t timeout_ms)
+{
+    return true;
+}
+
+void gui_unlock(void)
+{
+}
+
+esp_err_t iot_sensor_handler_register_with_type(sensor_type_t sensor_type, int32_t event_id,
+                                                sensor_event_handler_t handler, void *handler_args,
+                                                sensor_event_handler_instance_t *context)
+{
+    if (sensor_type != HUMITURE_ID || event_id != SENSOR_TEMP_HUMI_DATA_READY)
+    {
+        return ESP_FAIL;
+    }
+    humiture_handler = handler;
+    humiture_handler_args = handler_args;
+    return ESP_OK;
+}
+
+bool host_app_create(host_app_t *app, int64_t epoch)
+{
+    lv_timer_t *timers[HOST_APP_MAX_TIMERS];
+    uint32_t timer_cnt = 0;
+
+    // localtime() of refresh_task_callback shows UTC, whatever the zone of the host is
+    setenv("TZ", "UTC0", 1);
+    tzset();
+    app_clock = (time_t)epoch;
+
+#ifdef CONFIG_LCD_ROUND_PANEL
+    app->hd = host_disp_create(true);
+#else
+    app->hd = host_disp_create(false);
+#endif
+    if (app->hd == NULL)
+    {
+        return false;
+    }
+    lv_disp_set_default(app->hd->disp);
+
+    // ui_init() creates the refresh timer, it is the one which was not there before
+    for (lv_timer_t *t = lv_timer_get_next(NULL); t != NULL && timer_cnt < HOST_APP_MAX_TIMERS; t = lv_timer_get_next(t))
+    {
+        timers[timer_cnt++] = t;
+    }
+    ui_init(&app_signals);
+    app->refresh_timer = NULL;
+    for (lv_timer_t *t = lv_timer_get_next(NULL); t != NULL && app->refresh_timer == NULL; t = lv_timer_get_next(t))
+    {
+        app->refresh_timer = t;
+        for (uint32_t i = 0; i < timer_cnt; i++)
+        {
+            if (timers[i] == t)
+            {
+                app->refresh_timer = NULL;
+            }
+        }
+    }
+    return app->refresh_timer != NULL;
+}
+
+void host_app_tick(host_app_t *app)
+{
+    app_clock++;
+    app->refresh_timer->timer_cb(app->refresh_timer);
+}
+
+void host_app_sensor_post(float temperature, float humidity, float body_temperature)
+{
+    sensor_data_t data = {
+        .sensor_id = HUMITURE_ID,
+        .event_id = SENSOR_TEMP_HUMI_DATA_READY,
+        .humiture = {
+            .temperature = temperature,
+            .humidity = humidity,
+            .body_temperature = body_temperature,
+        },
+    };
+
+    if (humiture_handler != NULL)
+    {
+        humiture_handler(humiture_handler_args, NULL, SENSOR_TEMP_HUMI_DATA_READY, &data);
+    }
+}
@@ -0,0 +1,60 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _HOST_APP_H
+#define _HOST_APP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "host_disp.h"
+
+    /**
+     * @brief lvgl_app.c running on a virtual panel, with a simulated clock and sensor feed
+     */
+    typedef struct
+    {
+        host_disp_t *hd;
+        lv_timer_t *refresh_timer; /*!< timer of refresh_task_callback */
+    } host_app_t;
+
+    /**
+     * @brief Create the panel of the device (round if CONFIG_LCD_ROUND_PANEL) and run ui_init() on it
+     *
+     * @param app the app to start
+     * @param epoch initial wall clock in seconds since 1970 (UTC)
+     * @return false if out of memory
+     */
+    bool host_app_create(host_app_t *app, int64_t epoch);
+
+    /**
+     * @brief Advance the clock by a second and run the refresh timer of the app, like its 1 s period does
+     */
+    void host_app_tick(host_app_t *app);
+
+    /**
+     * @brief Send a reading of the humiture sensor to the app, like SENSOR_TEMP_HUMI_DATA_READY does
+     */
+    void host_app_sensor_post(float temperature, float humidity, float body_temperature);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,169 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+#include <string.h>
+#include "host_disp.h"
+#include "lvgl_hw_round.h"
+
+// rows per flush band, same as CONFIG_LCD_ROUND_FLUSH_BAND_ROWS of the device
+#define HOST_DISP_ROUND_FLUSH_BAND_ROWS 16
+
+static void host_disp_band_cb(const lv_area_t *band, const lv_color_t *color_map, void *user_ctx)
+{
+    host_disp_t *hd = (host_disp_t *)user_ctx;
+    lv_coord_t w = lv_area_get_width(band);
+
+    for (lv_coord_t y = band->y1; y <= band->y2; y++)
+    {
+        memcpy(&hd->fb[y * HOST_DISP_H_RES + band->x1], color_map, w * sizeof(lv_color_t));
+        color_map += w;
+    }
+    hd->stats.trans_cnt++;
+    hd->stats.flushed_px += lv_area_get_size(band);
+    hd->stats.flushed_bytes += lv_area_get_size(band) * sizeof(lv_color_t);
+}
+
+static void host_disp_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    host_disp_t *hd = (host_disp_t *)drv->user_data;
+
+    hd->stats.flush_cnt++;
+    if (hd->round)
+    {
+        lvgl_round_flush_bands(area, color_map, HOST_DISP_ROUND_FLUSH_BAND_ROWS, host_disp_band_cb, hd);
+    }
+    else
+    {
+        host_disp_band_cb(area, color_map, hd);
+    }
+    lv_disp_flush_ready(drv);
+}
+
+// the bounce buffer is sent synchronously, a slice is on the panel as soon as it is queued
+static void host_disp_send_cb(lvgl_flush_slice_t *slice, void *user_ctx)
+{
+    host_disp_t *hd = (host_disp_t *)user_ctx;
+    host_disp_band_cb(&slice->area, slice->buf, hd);
+    lvgl_flush_queue_done(&hd->queue);
+}
+
+static void host_disp_wait_cb(void *user_ctx)
+{
+}
+
+static void host_disp_direct_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    host_disp_t *hd = (host_disp_t *)drv->user_data;
+    // LVGL passes the whole frame, the area just rendered is the clip area
+    const lv_area_t *dirty = drv->draw_ctx->clip_area;
+
+    hd->stats.flush_cnt++;
+    if (hd->round)
+    {
+        lv_area_t band;
+        for (lv_coord_t by1 = dirty->y1; by1 <= dirty->y2; by1 += HOST_DISP_ROUND_FLUSH_BAND_ROWS)
+        {
+            if (lvgl_round_get_band(dirty, HOST_DISP_ROUND_FLUSH_BAND_ROWS, by1, &band))
+            {
+                lvgl_flush_queue_push_fb(&hd->queue, &band, color_map, HOST_DISP_H_RES);
+            }
+        }
+    }
+    else
+    {
+        lvgl_flush_queue_push_fb(&hd->queue, dirty, color_map, HOST_DISP_H_RES);
+    }
+    lv_disp_flush_ready(drv);
+}
+
+static host_disp_t *host_disp_create_mode(bool round, bool direct)
+{
+    host_disp_t *hd = calloc(1, sizeof(host_disp_t));
+    if (hd == NULL)
+    {
+        return NULL;
+    }
+    hd->round = round;
+    hd->direct = direct;
+    uint32_t buf1_px = direct ? HOST_DISP_H_RES * HOST_DISP_V_RES : HOST_DISP_BUF_SIZE;
+    hd->buf1 = calloc(buf1_px, sizeof(lv_color_t));
+    hd->buf2 = malloc(HOST_DISP_BUF_SIZE * sizeof(lv_color_t));
+    hd->fb = calloc(HOST_DISP_H_RES * HOST_DISP_V_RES, sizeof(lv_color_t));
+    if (hd->buf1 == NULL || hd->buf2 == NULL || hd->fb == NULL)
+    {
+        goto err;
+    }
+    if (direct)
+    {
+        // one slice, the bus of the host is done at once
+        if (!lvgl_flush_queue_init(&hd->queue, hd->buf2, HOST_DISP_BUF_SIZE, 1, HOST_DISP_H_RES,
+                                   host_disp_send_cb, host_disp_wait_cb, hd))
+        {
+            goto err;
+        }
+        lv_disp_draw_buf_init(&hd->draw_buf, hd->buf1, NULL, buf1_px);
+    }
+    else
+    {
+        lv_disp_draw_buf_init(&hd->draw_buf, hd->buf1, hd->buf2, HOST_DISP_BUF_SIZE);
+    }
+
+    lv_disp_drv_init(&hd->drv);
+    hd->drv.hor_res = HOST_DISP_H_RES;
+    hd->drv.ver_res = HOST_DISP_V_RES;
+    hd->drv.flush_cb = direct ? host_disp_direct_flush_cb : host_disp_flush_cb;
+    hd->drv.direct_mode = direct;
+    hd->drv.draw_buf = &hd->draw_buf;
+    hd->drv.user_data = hd;
+    if (round)
+    {
+        if (!lvgl_round_init(HOST_DISP_H_RES, HOST_DISP_V_RES))
+        {
+            goto err;
+        }
+        hd->drv.rounder_cb = lvgl_round_rounder_cb;
+        hd->drv.draw_ctx_init = lvgl_round_draw_ctx_init;
+        hd->drv.draw_ctx_deinit = lvgl_round_draw_ctx_deinit;
+        hd->drv.draw_ctx_size = sizeof(lvgl_round_draw_ctx_t);
+    }
+    hd->disp = lv_disp_drv_register(&hd->drv);
+    if (hd->disp == NULL)
+    {
+        goto err;
+    }
+    return hd;
+
+err:
+    free(hd->buf1);
+    free(hd->buf2);
+    free(hd->fb);
+    free(hd);
+    return NULL;
+}
+
+host_disp_t *host_disp_create(bool round)
+{
+    return host_disp_create_mode(round, false);
+}
+
+host_disp_t *host_disp_create_direct(bool round)
+{
+    return host_disp_create_mode(round, true);
+}
+
+void host_disp_reset_stats(host_disp_t *hd)
+{
+    memset(&hd->stats, 0, sizeof(hd->stats));
+}
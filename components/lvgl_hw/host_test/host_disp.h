@@ -0,0 +1,86 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _HOST_DISP_H
+#define _HOST_DISP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "host_tick.h"
+#include "lvgl_hw_flush.h"
+
+#define HOST_DISP_H_RES 240
+#define HOST_DISP_V_RES 240
+// same as CONFIG_DISP_BUF_SIZE of the device
+#define HOST_DISP_BUF_SIZE 5760
+
+    /**
+     * @brief What reached the virtual panel
+     */
+    typedef struct
+    {
+        uint32_t flush_cnt; /*!< flush_cb calls */
+        uint32_t trans_cnt; /*!< color transfers, a round panel sends several bands per flush */
+        uint32_t flushed_px;
+        uint32_t flushed_bytes;
+    } host_disp_stats_t;
+
+    typedef struct
+    {
+        lv_disp_drv_t drv;
+        lv_disp_draw_buf_t draw_buf;
+        lv_disp_t *disp;
+        lv_color_t *buf1; /*!< in direct mode the full frame LVGL renders into (PSRAM on the device) */
+        lv_color_t *buf2; /*!< in direct mode the bounce buffer of `queue` */
+        lv_color_t *fb;   /*!< content of the panel */
+        bool round;
+        bool direct;
+        lvgl_flush_queue_t queue; /*!< copies the dirty areas of the frame to the panel in direct mode */
+        host_disp_stats_t stats;
+    } host_disp_t;
+
+    /**
+     * @brief Register a virtual HOST_DISP_H_RES x HOST_DISP_V_RES RGB565 panel, set up like gui_task does
+     *
+     * @param round clip rendering and flushing to the visible circle (CONFIG_LCD_ROUND_PANEL)
+     * @return the panel, NULL if out of memory
+     */
+    host_disp_t *host_disp_create(bool round);
+
+    /**
+     * @brief Register a virtual panel in LVGL's direct mode like gui_task does with CONFIG_LCD_DIRECT_MODE.
+     *        LVGL renders the dirty areas in place into a persistent frame and every area is copied to the
+     *        panel through a HOST_DISP_BUF_SIZE bounce buffer.
+     *
+     * @param round clip rendering and flushing to the visible circle (CONFIG_LCD_ROUND_PANEL)
+     * @return the panel, NULL if out of memory
+     */
+    host_disp_t *host_disp_create_direct(bool round);
+
+    /**
+     * @brief Zero the statistics of a panel
+     */
+    void host_disp_reset_stats(host_disp_t *hd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,107 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <pthread.h>
+#include <stdbool.h>
+#include "host_parallel.h"
+
+static pthread_t worker;
+static pthread_mutex_t job_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t job_cond = PTHREAD_COND_INITIALIZER;
+static void (*job_cb)(void *param) = NULL;
+static void *job_param = NULL;
+static bool job_done = true;
+static pthread_mutex_t render_mutex;
+static lv_parallel_cb_t parallel_cb;
+static bool inited = false;
+
+static void *worker_thread(void *arg)
+{
+    pthread_mutex_lock(&job_mutex);
+    while (1)
+    {
+        while (job_cb == NULL)
+        {
+            pthread_cond_wait(&job_cond, &job_mutex);
+        }
+        void (*cb)(void *param) = job_cb;
+        void *param = job_param;
+        job_cb = NULL;
+        pthread_mutex_unlock(&job_mutex);
+
+        cb(param);
+
+        pthread_mutex_lock(&job_mutex);
+        job_done = true;
+        pthread_cond_broadcast(&job_cond);
+    }
+    return NULL;
+}
+
+static void host_run_cb(void (*task_cb)(void *param), void *param)
+{
+    pthread_mutex_lock(&job_mutex);
+    job_param = param;
+    job_cb = task_cb;
+    job_done = false;
+    pthread_cond_broadcast(&job_cond);
+    pthread_mutex_unlock(&job_mutex);
+}
+
+static void host_wait_cb(void)
+{
+    pthread_mutex_lock(&job_mutex);
+    while (!job_done)
+    {
+        pthread_cond_wait(&job_cond, &job_mutex);
+    }
+    pthread_mutex_unlock(&job_mutex);
+}
+
+static void host_lock_cb(void)
+{
+    pthread_mutex_lock(&render_mutex);
+}
+
+static void host_unlock_cb(void)
+{
+    pthread_mutex_unlock(&render_mutex);
+}
+
+const lv_parallel_cb_t *host_parallel_init(uint32_t min_px)
+{
+    parallel_cb.min_px = min_px;
+    if (inited)
+    {
+        return &parallel_cb;
+    }
+
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&render_mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    if (pthread_create(&worker, NULL, worker_thread, NULL) != 0)
+    {
+        return NULL;
+    }
+    parallel_cb.run_cb = host_run_cb;
+    parallel_cb.wait_cb = host_wait_cb;
+    parallel_cb.lock_cb = host_lock_cb;
+    parallel_cb.unlock_cb = host_unlock_cb;
+    inited = true;
+    return &parallel_cb;
+}
@@ -0,0 +1,38 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef _HOST_PARALLEL_H
+#define _HOST_PARALLEL_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "lvgl.h"
+
+    /**
+     * @brief Start a pthread as the second render thread, like the render worker of gui_task on core 0
+     *
+     * @param min_px `min_px` of the returned callbacks
+     * @return the callbacks for `lv_parallel_set_cb()`, NULL if the thread can't be started
+     */
+    const lv_parallel_cb_t *host_parallel_init(uint32_t min_px);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,78 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "host_screen.h"
+
+static lv_obj_t *host_arc_create(lv_obj_t *scr, int16_t min, int16_t max, int16_t value, uint16_t start, uint16_t end)
+{
+    lv_obj_t *arc = lv_arc_create(scr);
+    lv_obj_set_size(arc, 240, 240);
+    lv_obj_set_align(arc, LV_ALIGN_CENTER);
+    lv_obj_clear_flag(arc, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_PRESS_LOCK | LV_OBJ_FLAG_CLICK_FOCUSABLE |
+                               LV_OBJ_FLAG_GESTURE_BUBBLE);
+    lv_arc_set_range(arc, min, max);
+    lv_arc_set_value(arc, value);
+    lv_arc_set_bg_angles(arc, start, end);
+
+    lv_obj_set_style_arc_opa(arc, 255, LV_PART_INDICATOR | LV_STATE_DEFAULT);
+    lv_obj_set_style_bg_color(arc, lv_color_hex(0xFFFFFF), LV_PART_KNOB | LV_STATE_DEFAULT);
+    lv_obj_set_style_bg_opa(arc, 255, LV_PART_KNOB | LV_STATE_DEFAULT);
+    lv_obj_set_style_pad_all(arc, 0, LV_PART_KNOB | LV_STATE_DEFAULT);
+    return arc;
+}
+
+static lv_obj_t *host_label_create(lv_obj_t *scr, const char *txt, const lv_font_t *font, lv_coord_t x, lv_coord_t y)
+{
+    lv_obj_t *label = lv_label_create(scr);
+    lv_label_set_text(label, txt);
+    if (font != NULL)
+    {
+        lv_obj_set_style_text_font(label, font, LV_PART_MAIN | LV_STATE_DEFAULT);
+    }
+    lv_obj_align(label, LV_ALIGN_CENTER, x, y);
+    return label;
+}
+
+void host_screen_create(host_screen_t *s, host_disp_t *hd)
+{
+    lv_disp_set_default(hd->disp);
+    lv_theme_t *theme = lv_theme_default_init(hd->disp, lv_palette_main(LV_PALETTE_BLUE), lv_palette_main(LV_PALETTE_RED),
+                                              false, LV_FONT_DEFAULT);
+    lv_disp_set_theme(hd->disp, theme);
+
+    s->scr = lv_obj_create(NULL);
+    lv_obj_clear_flag(s->scr, LV_OBJ_FLAG_SCROLLABLE);
+
+    s->humi_arc = host_arc_create(s->scr, 0, 100, 60, 270, 90);
+    lv_obj_set_style_shadow_spread(s->humi_arc, 120, LV_PART_INDICATOR | LV_STATE_DEFAULT);
+    s->temp_arc = host_arc_create(s->scr, -25, 60, 24, 90, 270);
+    lv_obj_set_style_arc_color(s->temp_arc, lv_color_hex(0x00D3FF), LV_PART_INDICATOR | LV_STATE_DEFAULT);
+
+    s->static_labels[0] = host_label_create(s->scr, "humi", &lv_font_montserrat_24, 41, -45);
+    s->static_labels[1] = host_label_create(s->scr, "temp", &lv_font_montserrat_24, -40, -45);
+    s->temp_num = host_label_create(s->scr, "20.0", &lv_font_montserrat_20, -39, 0);
+    s->humi_num = host_label_create(s->scr, "50.0", &lv_font_montserrat_20, 43, 0);
+    s->static_labels[2] = host_label_create(s->scr, "C", &lv_font_dejavu_16_persian_hebrew, -2, 8);
+    s->static_labels[3] = host_label_create(s->scr, "%", NULL, 80, 8);
+    s->static_labels[4] = host_label_create(s->scr, "Feels Like", NULL, 0, 30);
+    s->btemp_num = host_label_create(s->scr, "25.0", &lv_font_montserrat_18, 2, 53);
+    s->static_labels[5] = host_label_create(s->scr, "C", NULL, 48, 53);
+    s->time_label = host_label_create(s->scr, "12:34:56", NULL, 3, -62);
+    s->date_label = host_label_create(s->scr, "2022-12-24", NULL, 10, -80);
+    s->weekday_label = host_label_create(s->scr, "Sat", NULL, 70, -62);
+    s->count = host_label_create(s->scr, "00000000", NULL, -7, 74);
+    s->static_labels[6] = host_label_create(s->scr, "sec", NULL, 50, 73);
+
+    lv_disp_load_scr(s->scr);
+}
@@ -0,0 +1,56 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _HOST_SCREEN_H
+#define _HOST_SCREEN_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "lvgl.h"
+#include "host_disp.h"
+
+// "humi", "temp", "C", "%", "Feels Like", "C", "sec"
+#define HOST_SCREEN_STATIC_LABELS 7
+
+    /**
+     * @brief Copy of ui_Screen1 of lvgl_app.c, which needs FreeRTOS and the sensor hub
+     */
+    typedef struct
+    {
+        lv_obj_t *scr;
+        lv_obj_t *humi_arc;
+        lv_obj_t *temp_arc;
+        lv_obj_t *temp_num;
+        lv_obj_t *humi_num;
+        lv_obj_t *btemp_num;
+        lv_obj_t *time_label;
+        lv_obj_t *date_label;
+        lv_obj_t *weekday_label;
+        lv_obj_t *count;
+        lv_obj_t *static_labels[HOST_SCREEN_STATIC_LABELS];
+    } host_screen_t;
+
+    /**
+     * @brief Build the screen on a panel with the theme of ui_init() and load it
+     */
+    void host_screen_create(host_screen_t *s, host_disp_t *hd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,61 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <time.h>
+#include "host_tick.h"
+
+uint64_t host_time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static uint32_t advance_ms;
+static bool frozen;
+static uint32_t frozen_ms;
+
+void host_tick_advance(uint32_t ms)
+{
+    advance_ms += ms;
+}
+
+static uint32_t real_ms(void)
+{
+    static uint64_t start_us = 0;
+    if (start_us == 0)
+    {
+        start_us = host_time_us();
+    }
+    return (uint32_t)((host_time_us() - start_us) / 1000);
+}
+
+void host_tick_freeze(bool freeze)
+{
+    if (freeze && !frozen)
+    {
+        frozen_ms = real_ms();
+    }
+    else if (!freeze && frozen)
+    {
+        // go on from the frozen tick instead of jumping over the time it was frozen
+        advance_ms -= real_ms() - frozen_ms;
+    }
+    frozen = freeze;
+}
+
+uint32_t host_tick_get(void)
+{
+    return (frozen ? frozen_ms : real_ms()) + advance_ms;
+}
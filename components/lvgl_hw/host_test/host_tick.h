@@ -0,0 +1,51 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _HOST_TICK_H
+#define _HOST_TICK_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+    /**
+     * @brief Milliseconds since the first call, LVGL's tick source on the host
+     */
+    uint32_t host_tick_get(void);
+
+    /**
+     * @brief Move the tick of host_tick_get() forward, to run LVGL's timers and animations faster than real time
+     */
+    void host_tick_advance(uint32_t ms);
+
+    /**
+     * @brief Stop host_tick_get() following the real time, so animations and timers don't move between two frames
+     *        of a test. host_tick_advance() still moves it.
+     */
+    void host_tick_freeze(bool freeze);
+
+    /**
+     * @brief Monotonic time in microseconds
+     */
+    uint64_t host_time_us(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,53 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef _HOST_ESP_CHECK_H
+#define _HOST_ESP_CHECK_H
+
+#include "esp_err.h"
+#include "esp_log.h"
+
+#define ESP_GOTO_ON_FALSE(a, err_code, goto_tag, log_tag, format, ...) \
+    do                                                                 \
+    {                                                                  \
+        if (!(a))                                                      \
+        {                                                              \
+            ESP_LOGE(log_tag, format, ##__VA_ARGS__);                  \
+            ret = err_code;                                            \
+            goto goto_tag;                                             \
+        }                                                              \
+    } while (0)
+
+#define ESP_GOTO_ON_ERROR(x, goto_tag, log_tag, format, ...) \
+    do                                                       \
+    {                                                        \
+        esp_err_t err_rc_ = (x);                             \
+        if (err_rc_ != ESP_OK)                               \
+        {                                                    \
+            ESP_LOGE(log_tag, format, ##__VA_ARGS__);        \
+            ret = err_rc_;                                   \
+            goto goto_tag;                                   \
+        }                                                    \
+    } while (0)
+
+#define ESP_RETURN_ON_FALSE(a, err_code, log_tag, format, ...) \
+    do                                                         \
+    {                                                          \
+        if (!(a))                                              \
+        {                                                      \
+            ESP_LOGE(log_tag, format, ##__VA_ARGS__);          \
+            return err_code;                                   \
+        }                                                      \
+    } while (0)
+
+#endif
@@ -0,0 +1,38 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// MIPI DCS commands of ESP-IDF's esp_lcd_panel_commands.h which the panel drivers use
+
+#ifndef _HOST_ESP_LCD_PANEL_COMMANDS_H
+#define _HOST_ESP_LCD_PANEL_COMMANDS_H
+
+#define LCD_CMD_SWRESET 0x01
+#define LCD_CMD_SLPOUT 0x11
+#define LCD_CMD_INVOFF 0x20
+#define LCD_CMD_INVON 0x21
+#define LCD_CMD_DISPOFF 0x28
+#define LCD_CMD_DISPON 0x29
+#define LCD_CMD_CASET 0x2A
+#define LCD_CMD_RASET 0x2B
+#define LCD_CMD_RAMWR 0x2C
+#define LCD_CMD_MADCTL 0x36
+#define LCD_CMD_COLMOD 0x3A
+
+#define LCD_CMD_MH_BIT (1 << 2)
+#define LCD_CMD_BGR_BIT (1 << 3)
+#define LCD_CMD_ML_BIT (1 << 4)
+#define LCD_CMD_MV_BIT (1 << 5)
+#define LCD_CMD_MX_BIT (1 << 6)
+#define LCD_CMD_MY_BIT (1 << 7)
+
+#endif
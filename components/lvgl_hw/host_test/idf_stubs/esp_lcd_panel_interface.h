@@ -0,0 +1,44 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef _HOST_ESP_LCD_PANEL_INTERFACE_H
+#define _HOST_ESP_LCD_PANEL_INTERFACE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "esp_lcd_types.h"
+
+// from the sys/cdefs.h of newlib, glibc has none
+#ifndef __containerof
+#define __containerof(ptr, type, member) ((type *)((char *)(ptr) - offsetof(type, member)))
+#endif
+
+struct esp_lcd_panel_t
+{
+    esp_err_t (*reset)(struct esp_lcd_panel_t *panel);
+    esp_err_t (*init)(struct esp_lcd_panel_t *panel);
+    esp_err_t (*del)(struct esp_lcd_panel_t *panel);
+    esp_err_t (*draw_bitmap)(struct esp_lcd_panel_t *panel, int x_start, int y_start, int x_end, int y_end,
+                             const void *color_data);
+    esp_err_t (*mirror)(struct esp_lcd_panel_t *panel, bool x_axis, bool y_axis);
+    esp_err_t (*swap_xy)(struct esp_lcd_panel_t *panel, bool swap_axes);
+    esp_err_t (*set_gap)(struct esp_lcd_panel_t *panel, int x_gap, int y_gap);
+    esp_err_t (*invert_color)(struct esp_lcd_panel_t *panel, bool invert_color_data);
+    esp_err_t (*disp_on_off)(struct esp_lcd_panel_t *panel, bool on_off);
+    void *user_data;
+};
+
+typedef struct esp_lcd_panel_t esp_lcd_panel_t;
+
+#endif
@@ -0,0 +1,42 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// The interface of a panel IO like in ESP-IDF, mock_panel_io.h implements one which records the commands
+
+#ifndef _HOST_ESP_LCD_PANEL_IO_H
+#define _HOST_ESP_LCD_PANEL_IO_H
+
+#include <stddef.h>
+#include "esp_err.h"
+#include "esp_lcd_types.h"
+
+struct esp_lcd_panel_io_t
+{
+    esp_err_t (*tx_param)(struct esp_lcd_panel_io_t *io, int lcd_cmd, const void *param, size_t param_size);
+    esp_err_t (*tx_color)(struct esp_lcd_panel_io_t *io, int lcd_cmd, const void *color, size_t color_size);
+    esp_err_t (*del)(struct esp_lcd_panel_io_t *io);
+};
+
+static inline esp_err_t esp_lcd_panel_io_tx_param(esp_lcd_panel_io_handle_t io, int lcd_cmd, const void *param,
+                                                  size_t param_size)
+{
+    return io->tx_param(io, lcd_cmd, param, param_size);
+}
+
+static inline esp_err_t esp_lcd_panel_io_tx_color(esp_lcd_panel_io_handle_t io, int lcd_cmd, const void *color,
+                                                  size_t color_size)
+{
+    return io->tx_color(io, lcd_cmd, color, color_size);
+}
+
+#endif
@@ -0,0 +1,32 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef _HOST_ESP_LCD_PANEL_VENDOR_H
+#define _HOST_ESP_LCD_PANEL_VENDOR_H
+
+#include "esp_err.h"
+#include "esp_lcd_types.h"
+
+typedef struct
+{
+    int reset_gpio_num;
+    esp_lcd_color_space_t color_space;
+    unsigned int bits_per_pixel;
+    struct
+    {
+        unsigned int reset_active_high : 1;
+    } flags;
+    void *vendor_config;
+} esp_lcd_panel_dev_config_t;
+
+#endif
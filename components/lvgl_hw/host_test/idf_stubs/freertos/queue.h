@@ -0,0 +1,31 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _HOST_FREERTOS_QUEUE_H
+#define _HOST_FREERTOS_QUEUE_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct host_queue *QueueHandle_t;
+
+// the host app has no sensor task, so no reading is waiting when the UI starts
+static inline BaseType_t xQueuePeek(QueueHandle_t queue, void *buf, TickType_t ticks_to_wait)
+{
+    (void)queue;
+    (void)buf;
+    (void)ticks_to_wait;
+    return pdFALSE;
+}
+
+#endif
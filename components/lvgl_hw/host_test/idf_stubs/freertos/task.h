@@ -0,0 +1,27 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef _HOST_FREERTOS_TASK_H
+#define _HOST_FREERTOS_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+// nothing on the host waits for real hardware
+static inline void vTaskDelay(TickType_t ticks)
+{
+    (void)ticks;
+}
+
+#endif
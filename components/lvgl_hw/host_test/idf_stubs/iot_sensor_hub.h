@@ -0,0 +1,34 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// The part of the sensor hub API lvgl_app.c uses. host_app.c keeps the registered handler and
+// calls it with the readings of the fake sensor feed.
+
+#ifndef _HOST_IOT_SENSOR_HUB_H
+#define _HOST_IOT_SENSOR_HUB_H
+
+#include "esp_err.h"
+#include "sensor_type.h"
+
+typedef const char *esp_event_base_t;
+typedef void *sensor_event_handler_instance_t;
+typedef const char *sensor_event_base_t;
+typedef void (*sensor_event_handler_t)(void *event_handler_arg, sensor_event_base_t event_base, int32_t event_id,
+                                       void *event_data);
+
+esp_err_t iot_sensor_handler_register_with_type(sensor_type_t sensor_type, int32_t event_id,
+                                                sensor_event_handler_t handler, void *handler_args,
+                                                sensor_event_handler_instance_t *context);
+
+#endif
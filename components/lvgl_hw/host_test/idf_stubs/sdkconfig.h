@@ -0,0 +1,27 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Options of /sdkconfig which lvgl_app.c depends on, for the host build of the app
+
+#ifndef _HOST_SDKCONFIG_H
+#define _HOST_SDKCONFIG_H
+
+#define CONFIG_LCD_H_RES 240
+#define CONFIG_LCD_V_RES 240
+#define CONFIG_LCD_ROUND_PANEL 1
+#define CONFIG_LVGL_STATIC_LAYER 1
+#define CONFIG_LVGL_SCREEN_MIN_FREE 4096
+#define CONFIG_LVGL_SCREEN_PREWARM_PERIOD_MS 500
+
+#endif
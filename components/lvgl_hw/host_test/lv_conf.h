@@ -0,0 +1,92 @@
+/**
+ * @file lv_conf.h
+ * LVGL configuration of the host build, mirrors the LVGL part of the project's sdkconfig
+ */
+
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+#include <stdint.h>
+
+/*GC9A01: RGB565, big endian on the bus*/
+#define LV_COLOR_DEPTH 16
+#define LV_COLOR_16_SWAP 1
+
+/*32 KB on the device, doubled to make up for the 64 bit pointers of the host.
+ *bench_obj_index builds LVGL with a larger one.*/
+#ifndef LV_MEM_SIZE
+#define LV_MEM_SIZE (64U * 1024U)
+#endif
+/*4 KB of the heap on the device, doubled like the heap*/
+#define LV_MEM_SLAB_SIZE (8U * 1024U)
+
+#define LV_DISP_DEF_REFR_PERIOD 100
+#define LV_INDEV_DEF_READ_PERIOD 30
+#define LV_DPI_DEF 130
+#define LV_DISP_DEF_JOIN_TRANS_PX 250
+#define LV_DISP_DEF_TILE_SIZE 0
+#define LV_USE_TIMER_HEAP 1
+
+#define LV_TICK_CUSTOM 1
+#define LV_TICK_CUSTOM_INCLUDE "host_tick.h"
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR (host_tick_get())
+
+#define LV_DRAW_COMPLEX 1
+#define LV_SHADOW_CACHE_SIZE 160
+#define LV_SHADOW_CACHE_BUDGET (32 * 1024)
+#define LV_CIRCLE_CACHE_SIZE 4
+#define LV_ARC_MASK_CACHE_SIZE 4
+#define LV_LAYER_SIMPLE_BUF_SIZE (24 * 1024)
+#define LV_LAYER_POOL_SIMPLE_CNT 3
+#define LV_LAYER_POOL_TRANSFORM_SIZE (64 * 1024)
+#define LV_IMG_CACHE_DEF_SIZE 0
+#define LV_IMG_CACHE_BUDGET (384 * 1024)
+#define LV_GRADIENT_MAX_STOPS 2
+#define LV_GRAD_CACHE_DEF_SIZE (16 * 1024)
+#define LV_DISP_ROT_MAX_BUF (10 * 1024)
+#define LV_USE_DRAW_SW_SWAP16 1
+/*The C reference of the PIE kernels, like on the device but slower*/
+#define LV_USE_GPU_ESP32S3_PIE 1
+#define LV_FONT_CACHE_BUDGET (8 * 1024)
+/*Only renders on two threads after lv_parallel_set_cb(), see host_parallel.h*/
+#define LV_USE_PARALLEL_RENDER 1
+
+#define LV_USE_LOG 0
+#define LV_USE_ASSERT_NULL 1
+#define LV_USE_ASSERT_MALLOC 1
+#define LV_USE_ASSERT_STYLE 1
+
+/*The overlay would be part of every measured frame*/
+#define LV_USE_PERF_MONITOR 0
+
+/*Phase times of app_bench, the ring holds its default run*/
+#define LV_USE_REFR_PROF 1
+#define LV_REFR_PROF_FRAMES 300
+
+#define LV_SPRINTF_USE_FLOAT 1
+#define LV_USE_USER_DATA 1
+#define LV_STYLE_CACHE_SIZE 1024
+#define LV_USE_OBJ_INDEX 1
+#define LV_OBJ_INDEX_CELL_SIZE 32
+
+/*12 and 18 for lv_demo_widgets on a small display*/
+#define LV_FONT_MONTSERRAT_12 1
+#define LV_FONT_MONTSERRAT_14 1
+#define LV_FONT_MONTSERRAT_18 1
+#define LV_FONT_MONTSERRAT_20 1
+#define LV_FONT_MONTSERRAT_24 1
+#define LV_FONT_DEJAVU_16_PERSIAN_HEBREW 1
+#define LV_FONT_DEFAULT &lv_font_montserrat_14
+#define LV_USE_FONT_SUBPX 1
+
+#define LV_USE_SNAPSHOT 1
+
+#define LV_USE_THEME_DEFAULT 1
+#define LV_THEME_DEFAULT_DARK 1
+
+/*The churn of bench_mem*/
+#define LV_USE_DEMO_STRESS 1
+/*The screen of bench_style*/
+#define LV_USE_DEMO_WIDGETS 1
+
+#endif /*LV_CONF_H*/
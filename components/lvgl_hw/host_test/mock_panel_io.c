@@ -0,0 +1,78 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "esp_lcd_panel_interface.h"
+#include "mock_panel_io.h"
+
+static mock_panel_io_cmd_t *mock_panel_io_add(struct esp_lcd_panel_io_t *base, int lcd_cmd, size_t size)
+{
+    mock_panel_io_t *io = __containerof(base, mock_panel_io_t, base);
+    if (io->cmd_cnt >= MOCK_PANEL_IO_MAX_CMDS)
+    {
+        io->dropped++;
+        return NULL;
+    }
+    mock_panel_io_cmd_t *c = &io->cmds[io->cmd_cnt++];
+    memset(c, 0, sizeof(*c));
+    c->cmd = lcd_cmd;
+    c->size = size;
+    return c;
+}
+
+static esp_err_t mock_panel_io_tx_param(struct esp_lcd_panel_io_t *base, int lcd_cmd, const void *param,
+                                        size_t param_size)
+{
+    if (param_size > MOCK_PANEL_IO_MAX_PARAMS)
+    {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    mock_panel_io_cmd_t *c = mock_panel_io_add(base, lcd_cmd, param_size);
+    if (c != NULL && param_size > 0)
+    {
+        memcpy(c->param, param, param_size);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t mock_panel_io_tx_color(struct esp_lcd_panel_io_t *base, int lcd_cmd, const void *color,
+                                        size_t color_size)
+{
+    mock_panel_io_cmd_t *c = mock_panel_io_add(base, lcd_cmd, color_size);
+    if (c != NULL)
+    {
+        c->color = true;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t mock_panel_io_del(struct esp_lcd_panel_io_t *base)
+{
+    return ESP_OK;
+}
+
+esp_lcd_panel_io_handle_t mock_panel_io_init(mock_panel_io_t *io)
+{
+    memset(io, 0, sizeof(*io));
+    io->base.tx_param = mock_panel_io_tx_param;
+    io->base.tx_color = mock_panel_io_tx_color;
+    io->base.del = mock_panel_io_del;
+    return &io->base;
+}
+
+void mock_panel_io_clear(mock_panel_io_t *io)
+{
+    io->cmd_cnt = 0;
+    io->dropped = 0;
+}
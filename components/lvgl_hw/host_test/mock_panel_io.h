@@ -0,0 +1,68 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _MOCK_PANEL_IO_H
+#define _MOCK_PANEL_IO_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_lcd_panel_io.h"
+
+#define MOCK_PANEL_IO_MAX_CMDS 128
+#define MOCK_PANEL_IO_MAX_PARAMS 16
+
+    /**
+     * @brief A command as it went over the bus
+     */
+    typedef struct
+    {
+        int cmd;
+        bool color;                               /*!< sent with tx_color, the parameters are pixels */
+        uint8_t param[MOCK_PANEL_IO_MAX_PARAMS];  /*!< parameters of tx_param */
+        size_t size;                              /*!< bytes of parameters or pixels */
+    } mock_panel_io_cmd_t;
+
+    /**
+     * @brief Panel IO recording the commands instead of sending them
+     */
+    typedef struct
+    {
+        struct esp_lcd_panel_io_t base;
+        mock_panel_io_cmd_t cmds[MOCK_PANEL_IO_MAX_CMDS];
+        uint32_t cmd_cnt;
+        uint32_t dropped; /*!< commands which did not fit into `cmds` */
+    } mock_panel_io_t;
+
+    /**
+     * @brief Initialize a mock panel IO
+     *
+     * @return handle to create a panel driver with
+     */
+    esp_lcd_panel_io_handle_t mock_panel_io_init(mock_panel_io_t *io);
+
+    /**
+     * @brief Forget the recorded commands
+     */
+    void mock_panel_io_clear(mock_panel_io_t *io);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
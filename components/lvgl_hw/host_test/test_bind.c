@@ -0,0 +1,186 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Checks that the widget bindings of lvgl_app only invalidate when the shown value changes,
+// and replays a noisy sensor feed to report how many invalidations they save.
+
+#include <stdio.h>
+#include "unity.h"
+#include "host_disp.h"
+#include "lvgl_hw_bind.h"
+
+static host_disp_t *hd;
+static lv_obj_t *label;
+static lv_obj_t *arc;
+
+void setUp(void)
+{
+    lv_obj_clean(lv_scr_act());
+    label = lv_label_create(lv_scr_act());
+    arc = lv_arc_create(lv_scr_act());
+    lv_arc_set_range(arc, -25, 60);
+    lv_refr_now(hd->disp);
+    lvgl_bind_reset_stats();
+}
+
+void tearDown(void)
+{
+}
+
+// true if something waits to be redrawn
+static bool disp_invalidated(void)
+{
+    return hd->disp->inv_p != 0;
+}
+
+static void test_label_follows_resolution(void)
+{
+    lvgl_bind_t bind;
+    lvgl_bind_init(&bind, label, "%.1f", 0.1f);
+
+    TEST_ASSERT_TRUE(lvgl_bind_set_float(&bind, 23.4567f));
+    TEST_ASSERT_EQUAL_STRING("23.5", lv_label_get_text(label));
+    TEST_ASSERT_TRUE(disp_invalidated());
+    lv_refr_now(hd->disp);
+
+    // below the resolution: nothing is formatted or invalidated
+    TEST_ASSERT_FALSE(lvgl_bind_set_float(&bind, 23.46f));
+    TEST_ASSERT_FALSE(lvgl_bind_set_float(&bind, 23.5f));
+    TEST_ASSERT_FALSE(disp_invalidated());
+    TEST_ASSERT_EQUAL_STRING("23.5", lv_label_get_text(label));
+
+    TEST_ASSERT_TRUE(lvgl_bind_set_float(&bind, -0.26f));
+    TEST_ASSERT_EQUAL_STRING("-0.3", lv_label_get_text(label));
+    TEST_ASSERT_TRUE(disp_invalidated());
+
+    lvgl_bind_stats_t stats;
+    lvgl_bind_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.updates);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.invalidations);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.suppressed);
+}
+
+static void test_label_text_compare(void)
+{
+    lvgl_bind_t bind;
+    lvgl_bind_init(&bind, label, NULL, 1);
+
+    TEST_ASSERT_TRUE(lvgl_bind_set_text(&bind, "Mon"));
+    lv_refr_now(hd->disp);
+    TEST_ASSERT_FALSE(lvgl_bind_set_text(&bind, "Mon"));
+    TEST_ASSERT_FALSE(disp_invalidated());
+    TEST_ASSERT_TRUE(lvgl_bind_set_text(&bind, "Tue"));
+    TEST_ASSERT_EQUAL_STRING("Tue", lv_label_get_text(label));
+    TEST_ASSERT_TRUE(disp_invalidated());
+}
+
+static void test_label_without_fmt(void)
+{
+    lvgl_bind_t bind;
+    lvgl_bind_init(&bind, label, NULL, 0.1f);
+
+    TEST_ASSERT_TRUE(lvgl_bind_set_float(&bind, 23.4567f));
+    TEST_ASSERT_EQUAL_STRING("23.5", lv_label_get_text(label));
+    TEST_ASSERT_TRUE(lvgl_bind_set_float(&bind, 100.0f));
+    TEST_ASSERT_EQUAL_STRING("100", lv_label_get_text(label));
+}
+
+static void test_arc_rounds_to_integers(void)
+{
+    lvgl_bind_t bind;
+    lvgl_bind_init(&bind, arc, NULL, 1);
+
+    TEST_ASSERT_TRUE(lvgl_bind_set_float(&bind, 24.6f));
+    TEST_ASSERT_EQUAL_INT16(25, lv_arc_get_value(arc));
+    lv_refr_now(hd->disp);
+
+    TEST_ASSERT_FALSE(lvgl_bind_set_float(&bind, 25.2f));
+    TEST_ASSERT_FALSE(disp_invalidated());
+    TEST_ASSERT_TRUE(lvgl_bind_set_float(&bind, 25.6f));
+    TEST_ASSERT_EQUAL_INT16(26, lv_arc_get_value(arc));
+}
+
+static void test_non_finite_is_ignored(void)
+{
+    lvgl_bind_t bind;
+    lvgl_bind_init(&bind, label, "%.1f", 0.1f);
+
+    TEST_ASSERT_TRUE(lvgl_bind_set_float(&bind, 20.0f));
+    TEST_ASSERT_FALSE(lvgl_bind_set_float(&bind, NAN));
+    TEST_ASSERT_EQUAL_STRING("20.0", lv_label_get_text(label));
+}
+
+static void test_numlabel_gets_steps(void)
+{
+    lvgl_bind_t bind;
+    lv_obj_t *numlabel = lv_numlabel_create(lv_scr_act());
+    lv_numlabel_set_format(numlabel, 3, 1);
+    lv_numlabel_set_signed(numlabel, true);
+    lvgl_bind_init(&bind, numlabel, NULL, 0.1f);
+
+    TEST_ASSERT_TRUE(lvgl_bind_set_float(&bind, 23.4567f));
+    TEST_ASSERT_EQUAL_INT32(235, lv_numlabel_get_value(numlabel));
+    lv_refr_now(hd->disp);
+
+    TEST_ASSERT_FALSE(lvgl_bind_set_float(&bind, 23.46f));
+    TEST_ASSERT_FALSE(disp_invalidated());
+    TEST_ASSERT_TRUE(lvgl_bind_set_float(&bind, -0.26f));
+    TEST_ASSERT_EQUAL_INT32(-3, lv_numlabel_get_value(numlabel));
+    TEST_ASSERT_TRUE(disp_invalidated());
+}
+
+// SHT3x readings drift by a few hundredths between samples, like the feed of the sensor hub
+static void test_noisy_feed_is_mostly_suppressed(void)
+{
+    lvgl_bind_t temp_num, humi_num, temp_arc;
+    lvgl_bind_init(&temp_num, label, "%.1f", 0.1f);
+    lvgl_bind_init(&humi_num, lv_label_create(lv_scr_act()), "%.1f", 0.1f);
+    lvgl_bind_init(&temp_arc, arc, NULL, 1);
+
+    uint32_t seed = 1;
+    for (int i = 0; i < 1000; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        float noise = (float)((seed >> 16) % 5) * 0.01f - 0.02f;
+        float temperature = 24.0f + (float)i * 0.002f + noise;
+        lvgl_bind_set_float(&temp_num, temperature);
+        lvgl_bind_set_float(&humi_num, 55.0f - noise);
+        lvgl_bind_set_float(&temp_arc, temperature);
+    }
+
+    lvgl_bind_stats_t stats;
+    lvgl_bind_get_stats(&stats);
+    printf("bind: %u updates, %u invalidations, %u suppressed (%.1f%%)\n", (unsigned)stats.updates,
+           (unsigned)stats.invalidations, (unsigned)stats.suppressed, 100.0 * stats.suppressed / stats.updates);
+
+    TEST_ASSERT_EQUAL_UINT32(stats.updates, stats.invalidations + stats.suppressed);
+    TEST_ASSERT_TRUE(stats.suppressed > stats.updates * 8 / 10);
+}
+
+int main(void)
+{
+    lv_init();
+    hd = host_disp_create(false);
+    TEST_ASSERT_NOT_NULL(hd);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_label_follows_resolution);
+    RUN_TEST(test_label_text_compare);
+    RUN_TEST(test_label_without_fmt);
+    RUN_TEST(test_arc_rounds_to_integers);
+    RUN_TEST(test_non_finite_is_ignored);
+    RUN_TEST(test_numlabel_gets_steps);
+    RUN_TEST(test_noisy_feed_is_mostly_suppressed);
+    return UNITY_END();
+}
@@ -0,0 +1,265 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Checks the DMA slice queue of LCD_FLUSH_QUEUE against a virtual SPI bus which copies a slice to
+// the panel only when its transfer is done, so a slice reused too early shows up as wrong pixels.
+
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "host_disp.h"
+#include "host_screen.h"
+#include "lvgl_hw_flush.h"
+#include "lvgl_hw_round.h"
+
+#define FB_PX (HOST_DISP_H_RES * HOST_DISP_V_RES)
+
+static lvgl_flush_queue_t queue;
+static lv_color_t dma_buf[HOST_DISP_BUF_SIZE];
+static lv_color_t panel_fb[FB_PX];
+static lv_color_t src[FB_PX];
+
+// slices sent and not done yet, oldest first
+static lvgl_flush_slice_t *bus[LVGL_FLUSH_MAX_SLICES + 1];
+static uint32_t bus_cnt;
+static uint32_t bus_max;
+
+static void bus_send_cb(lvgl_flush_slice_t *slice, void *user_ctx)
+{
+    TEST_ASSERT_TRUE(bus_cnt < queue.slice_cnt);
+    bus[bus_cnt++] = slice;
+    bus_max = bus_cnt > bus_max ? bus_cnt : bus_max;
+}
+
+// the oldest transfer is done: its pixels reach the panel and the slice is released
+static void bus_complete_one(void)
+{
+    TEST_ASSERT_TRUE(bus_cnt > 0);
+    lvgl_flush_slice_t *slice = bus[0];
+    lv_coord_t w = lv_area_get_width(&slice->area);
+    const lv_color_t *p = slice->buf;
+    for (lv_coord_t y = slice->area.y1; y <= slice->area.y2; y++)
+    {
+        memcpy(&panel_fb[y * HOST_DISP_H_RES + slice->area.x1], p, w * sizeof(lv_color_t));
+        p += w;
+    }
+    memmove(&bus[0], &bus[1], (bus_cnt - 1) * sizeof(bus[0]));
+    bus_cnt--;
+    lvgl_flush_queue_done(&queue);
+}
+
+static void bus_wait_cb(void *user_ctx)
+{
+    bus_complete_one();
+}
+
+static void bus_drain(void)
+{
+    while (bus_cnt > 0)
+    {
+        bus_complete_one();
+    }
+}
+
+static void fill_src(void)
+{
+    for (uint32_t i = 0; i < FB_PX; i++)
+    {
+        src[i].full = (uint16_t)(i * 2654435761u >> 16);
+    }
+}
+
+// pixels of an area packed like LVGL's draw buffer
+static void pack_area(const lv_area_t *area, lv_color_t *out)
+{
+    for (lv_coord_t y = area->y1; y <= area->y2; y++)
+    {
+        memcpy(out, &src[y * HOST_DISP_H_RES + area->x1], lv_area_get_width(area) * sizeof(lv_color_t));
+        out += lv_area_get_width(area);
+    }
+}
+
+static void check_area_on_panel(const lv_area_t *area)
+{
+    for (lv_coord_t y = area->y1; y <= area->y2; y++)
+    {
+        TEST_ASSERT_EQUAL_MEMORY(&src[y * HOST_DISP_H_RES + area->x1], &panel_fb[y * HOST_DISP_H_RES + area->x1],
+                                 lv_area_get_width(area) * sizeof(lv_color_t));
+    }
+}
+
+void setUp(void)
+{
+    memset(panel_fb, 0, sizeof(panel_fb));
+    bus_cnt = 0;
+    bus_max = 0;
+    fill_src();
+    TEST_ASSERT_TRUE(lvgl_flush_queue_init(&queue, dma_buf, HOST_DISP_BUF_SIZE, 4, HOST_DISP_H_RES,
+                                           bus_send_cb, bus_wait_cb, NULL));
+}
+
+void tearDown(void)
+{
+}
+
+void test_slices_hold_a_row(void)
+{
+    lvgl_flush_queue_t q;
+    TEST_ASSERT_FALSE(lvgl_flush_queue_init(&q, dma_buf, HOST_DISP_BUF_SIZE, 0, HOST_DISP_H_RES,
+                                            bus_send_cb, bus_wait_cb, NULL));
+    TEST_ASSERT_FALSE(lvgl_flush_queue_init(&q, dma_buf, HOST_DISP_BUF_SIZE, LVGL_FLUSH_MAX_SLICES + 1,
+                                            HOST_DISP_H_RES, bus_send_cb, bus_wait_cb, NULL));
+    TEST_ASSERT_FALSE(lvgl_flush_queue_init(&q, dma_buf, HOST_DISP_H_RES * 2 - 1, 2, HOST_DISP_H_RES,
+                                            bus_send_cb, bus_wait_cb, NULL));
+    TEST_ASSERT_TRUE(lvgl_flush_queue_init(&q, dma_buf, HOST_DISP_H_RES * 2, 2, HOST_DISP_H_RES,
+                                           bus_send_cb, bus_wait_cb, NULL));
+    TEST_ASSERT_EQUAL_UINT32(HOST_DISP_H_RES, q.slice_px);
+}
+
+// a full draw buffer fills the slices exactly, without waiting
+void test_full_buffer_fills_all_slices(void)
+{
+    static lv_color_t area_buf[HOST_DISP_BUF_SIZE];
+    lv_area_t area = {0, 48, HOST_DISP_H_RES - 1, 48 + HOST_DISP_BUF_SIZE / HOST_DISP_H_RES - 1};
+    pack_area(&area, area_buf);
+
+    lvgl_flush_queue_push(&queue, &area, area_buf);
+    TEST_ASSERT_EQUAL_UINT32(4, bus_cnt);
+    TEST_ASSERT_EQUAL_INT(6, lv_area_get_height(&bus[0]->area));
+    TEST_ASSERT_FALSE(lvgl_flush_queue_is_idle(&queue));
+
+    // the draw buffer is free again before anything was sent
+    memset(area_buf, 0, sizeof(area_buf));
+    bus_drain();
+    TEST_ASSERT_TRUE(lvgl_flush_queue_is_idle(&queue));
+    check_area_on_panel(&area);
+
+    lvgl_flush_stats_t stats;
+    lvgl_flush_queue_get_stats(&queue, &stats);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.slices);
+    TEST_ASSERT_EQUAL_UINT32(lv_area_get_size(&area) * sizeof(lv_color_t), stats.bytes);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.waits);
+}
+
+// the next flush waits for the oldest slices only, one at a time, and never overwrites one in flight
+void test_waits_per_slice(void)
+{
+    static lv_color_t area_buf[HOST_DISP_BUF_SIZE];
+    lv_area_t first = {0, 0, HOST_DISP_H_RES - 1, 23};
+    lv_area_t second = {0, 24, HOST_DISP_H_RES - 1, 35};
+
+    pack_area(&first, area_buf);
+    lvgl_flush_queue_push(&queue, &first, area_buf);
+    pack_area(&second, area_buf);
+    lvgl_flush_queue_push(&queue, &second, area_buf);
+
+    lvgl_flush_stats_t stats;
+    lvgl_flush_queue_get_stats(&queue, &stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.waits);
+    TEST_ASSERT_EQUAL_UINT32(4, bus_max);
+
+    bus_drain();
+    check_area_on_panel(&first);
+    check_area_on_panel(&second);
+}
+
+// narrow areas (e.g. the bands of a round panel) get more rows per slice
+void test_narrow_area_more_rows(void)
+{
+    static lv_color_t area_buf[HOST_DISP_BUF_SIZE];
+    lv_area_t area = {70, 100, 169, 139};
+    pack_area(&area, area_buf);
+
+    lvgl_flush_queue_push(&queue, &area, area_buf);
+    TEST_ASSERT_EQUAL_UINT32(3, bus_cnt);
+    TEST_ASSERT_EQUAL_INT(14, lv_area_get_height(&bus[0]->area));
+    TEST_ASSERT_EQUAL_INT(139, bus[2]->area.y2);
+
+    bus_drain();
+    check_area_on_panel(&area);
+}
+
+// an area cut out of a full frame (direct mode) reaches the panel like a packed one
+void test_push_from_frame(void)
+{
+    lv_area_t area = {70, 100, 169, 139};
+
+    lvgl_flush_queue_push_fb(&queue, &area, src, HOST_DISP_H_RES);
+    TEST_ASSERT_EQUAL_UINT32(3, bus_cnt);
+    TEST_ASSERT_EQUAL_INT(14, lv_area_get_height(&bus[0]->area));
+
+    bus_drain();
+    check_area_on_panel(&area);
+    TEST_ASSERT_EQUAL_UINT16(0, panel_fb[100 * HOST_DISP_H_RES + 69].full);
+    TEST_ASSERT_EQUAL_UINT16(0, panel_fb[100 * HOST_DISP_H_RES + 170].full);
+}
+
+static void queue_band_cb(const lv_area_t *band, const lv_color_t *color_map, void *user_ctx)
+{
+    lvgl_flush_queue_push(&queue, band, color_map);
+}
+
+static void queue_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    lvgl_round_flush_bands(area, color_map, 16, queue_band_cb, NULL);
+    lv_disp_flush_ready(drv);
+}
+
+// the round main screen through the queue looks the same as through direct transfers
+void test_round_screen_through_queue(void)
+{
+    host_disp_t *hd = host_disp_create(true);
+    TEST_ASSERT_NOT_NULL(hd);
+    static host_screen_t screen;
+    host_screen_create(&screen, hd);
+    host_disp_reset_stats(hd);
+    lv_refr_now(hd->disp);
+    uint32_t direct_bytes = hd->stats.flushed_bytes;
+
+    hd->drv.flush_cb = queue_flush_cb;
+    lv_obj_invalidate(screen.scr);
+    lv_refr_now(hd->disp);
+    bus_drain();
+
+    for (lv_coord_t y = 0; y < HOST_DISP_V_RES; y++)
+    {
+        lvgl_round_span_t span = lvgl_round_get_span(y);
+        if (span.x1 > span.x2)
+        {
+            continue;
+        }
+        TEST_ASSERT_EQUAL_MEMORY(&hd->fb[y * HOST_DISP_H_RES + span.x1], &panel_fb[y * HOST_DISP_H_RES + span.x1],
+                                 (span.x2 - span.x1 + 1) * sizeof(lv_color_t));
+    }
+
+    lvgl_flush_stats_t stats;
+    lvgl_flush_queue_get_stats(&queue, &stats);
+    printf("round full frame: %u slices, %u bytes, the renderer waited %u times for a slice\n",
+           (unsigned)stats.slices, (unsigned)stats.bytes, (unsigned)stats.waits);
+    TEST_ASSERT_EQUAL_UINT32(direct_bytes, stats.bytes);
+}
+
+int main(void)
+{
+    lv_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_slices_hold_a_row);
+    RUN_TEST(test_full_buffer_fills_all_slices);
+    RUN_TEST(test_waits_per_slice);
+    RUN_TEST(test_narrow_area_more_rows);
+    RUN_TEST(test_push_from_frame);
+    RUN_TEST(test_round_screen_through_queue);
+    return UNITY_END();
+}
@@ -0,0 +1,205 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Checks the command stream of the GC9A01 driver on a mock panel IO: the address window is only
+// sent where it changes, bands below each other continue with RAMWR-continue.
+
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_lcd_panel_ops.h"
+#include "esp_lcd_panel_commands.h"
+#include "lvgl_hw_gc9a01.h"
+#include "lvgl_hw_flush.h"
+#include "mock_panel_io.h"
+
+#define CMD_RAMWRC 0x3C
+
+static mock_panel_io_t mock;
+static esp_lcd_panel_handle_t panel;
+static uint16_t pixels[240 * 24];
+
+static void assert_cmd(uint32_t i, int cmd, const uint8_t *param, size_t size)
+{
+    TEST_ASSERT_TRUE(i < mock.cmd_cnt);
+    TEST_ASSERT_EQUAL_HEX8(cmd, mock.cmds[i].cmd);
+    TEST_ASSERT_EQUAL_UINT32(size, mock.cmds[i].size);
+    if (param != NULL)
+    {
+        TEST_ASSERT_FALSE(mock.cmds[i].color);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(param, mock.cmds[i].param, size);
+    }
+    else
+    {
+        TEST_ASSERT_TRUE(mock.cmds[i].color);
+    }
+}
+
+static void assert_caset(uint32_t i, int x1, int x2)
+{
+    assert_cmd(i, LCD_CMD_CASET, (uint8_t[]){x1 >> 8, x1 & 0xFF, x2 >> 8, x2 & 0xFF}, 4);
+}
+
+// the window reaches the last row so the next band can continue
+static void assert_raset(uint32_t i, int y1)
+{
+    assert_cmd(i, LCD_CMD_RASET, (uint8_t[]){y1 >> 8, y1 & 0xFF, 0, 239}, 4);
+}
+
+void setUp(void)
+{
+    esp_lcd_panel_dev_config_t panel_config = {
+        .reset_gpio_num = -1,
+        .color_space = ESP_LCD_COLOR_SPACE_BGR,
+        .bits_per_pixel = 16,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_lcd_new_panel_gc9a01(mock_panel_io_init(&mock), &panel_config, &panel));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_lcd_panel_reset(panel));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_lcd_panel_init(panel));
+    mock_panel_io_clear(&mock);
+}
+
+void tearDown(void)
+{
+    esp_lcd_panel_del(panel);
+}
+
+void test_first_flush_sets_window(void)
+{
+    esp_lcd_panel_draw_bitmap(panel, 10, 20, 110, 36, pixels);
+    TEST_ASSERT_EQUAL_UINT32(3, mock.cmd_cnt);
+    assert_caset(0, 10, 109);
+    assert_raset(1, 20);
+    assert_cmd(2, LCD_CMD_RAMWR, NULL, 100 * 16 * 2);
+}
+
+void test_band_below_continues(void)
+{
+    esp_lcd_panel_draw_bitmap(panel, 0, 0, 240, 6, pixels);
+    esp_lcd_panel_draw_bitmap(panel, 0, 6, 240, 12, pixels);
+    esp_lcd_panel_draw_bitmap(panel, 0, 12, 240, 13, pixels);
+    TEST_ASSERT_EQUAL_UINT32(5, mock.cmd_cnt);
+    assert_cmd(2, LCD_CMD_RAMWR, NULL, 240 * 6 * 2);
+    assert_cmd(3, CMD_RAMWRC, NULL, 240 * 6 * 2);
+    assert_cmd(4, CMD_RAMWRC, NULL, 240 * 1 * 2);
+}
+
+void test_same_columns_elsewhere_sets_rows(void)
+{
+    esp_lcd_panel_draw_bitmap(panel, 40, 100, 80, 120, pixels);
+    esp_lcd_panel_draw_bitmap(panel, 40, 50, 80, 60, pixels);
+    TEST_ASSERT_EQUAL_UINT32(5, mock.cmd_cnt);
+    assert_raset(3, 50);
+    assert_cmd(4, LCD_CMD_RAMWR, NULL, 40 * 10 * 2);
+}
+
+void test_other_columns_set_window(void)
+{
+    esp_lcd_panel_draw_bitmap(panel, 40, 100, 80, 120, pixels);
+    esp_lcd_panel_draw_bitmap(panel, 30, 120, 90, 136, pixels);
+    TEST_ASSERT_EQUAL_UINT32(6, mock.cmd_cnt);
+    assert_caset(3, 30, 89);
+    assert_raset(4, 120);
+    assert_cmd(5, LCD_CMD_RAMWR, NULL, 60 * 16 * 2);
+}
+
+void test_other_commands_break_continue(void)
+{
+    esp_lcd_panel_draw_bitmap(panel, 0, 0, 240, 6, pixels);
+    esp_lcd_panel_mirror(panel, true, false);
+    esp_lcd_panel_draw_bitmap(panel, 0, 6, 240, 12, pixels);
+    esp_lcd_panel_disp_on_off(panel, true);
+    esp_lcd_panel_draw_bitmap(panel, 0, 12, 240, 18, pixels);
+    TEST_ASSERT_EQUAL_UINT32(11, mock.cmd_cnt);
+    assert_cmd(3, LCD_CMD_MADCTL, (uint8_t[]){LCD_CMD_BGR_BIT | LCD_CMD_MX_BIT}, 1);
+    assert_caset(4, 0, 239);
+    assert_raset(5, 6);
+    assert_cmd(6, LCD_CMD_RAMWR, NULL, 240 * 6 * 2);
+    assert_caset(8, 0, 239);
+    assert_raset(9, 12);
+}
+
+void test_gap_moves_window(void)
+{
+    esp_lcd_panel_set_gap(panel, 0, 40);
+    esp_lcd_panel_draw_bitmap(panel, 0, 0, 240, 6, pixels);
+    esp_lcd_panel_draw_bitmap(panel, 0, 6, 240, 12, pixels);
+    assert_raset(1, 40);
+    assert_cmd(3, CMD_RAMWRC, NULL, 240 * 6 * 2);
+}
+
+void test_stats(void)
+{
+    esp_lcd_panel_draw_bitmap(panel, 0, 0, 240, 6, pixels);
+    esp_lcd_panel_draw_bitmap(panel, 0, 6, 240, 12, pixels);
+    esp_lcd_panel_draw_bitmap(panel, 0, 50, 240, 56, pixels);
+
+    gc9a01_panel_stats_t stats;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_lcd_panel_gc9a01_get_stats(panel, &stats));
+    TEST_ASSERT_EQUAL_UINT32(3, stats.flushes);
+    TEST_ASSERT_EQUAL_UINT32(mock.cmd_cnt, stats.transactions);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.caset_skipped);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.raset_skipped);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_lcd_panel_gc9a01_get_stats(panel, NULL));
+}
+
+static void flush_send_cb(lvgl_flush_slice_t *slice, void *user_ctx)
+{
+    esp_lcd_panel_draw_bitmap(panel, slice->area.x1, slice->area.y1, slice->area.x2 + 1, slice->area.y2 + 1,
+                              slice->buf);
+}
+
+static void flush_wait_cb(void *user_ctx)
+{
+    lvgl_flush_queue_t *queue = (lvgl_flush_queue_t *)user_ctx;
+    lvgl_flush_queue_done(queue);
+}
+
+// the DMA slices of LCD_FLUSH_QUEUE: an area costs one window and a command per slice
+void test_flush_queue_slices_continue(void)
+{
+    static lvgl_flush_queue_t queue;
+    static lv_color_t dma_buf[240 * 24];
+    static lv_color_t area_buf[240 * 24];
+    TEST_ASSERT_TRUE(lvgl_flush_queue_init(&queue, dma_buf, 240 * 24, 4, 240, flush_send_cb, flush_wait_cb, &queue));
+
+    lv_area_t area = {0, 96, 239, 119};
+    lvgl_flush_queue_push(&queue, &area, area_buf);
+
+    TEST_ASSERT_EQUAL_UINT32(2 + 4, mock.cmd_cnt);
+    assert_caset(0, 0, 239);
+    assert_raset(1, 96);
+    assert_cmd(2, LCD_CMD_RAMWR, NULL, 240 * 6 * 2);
+    for (uint32_t i = 3; i < 6; i++)
+    {
+        assert_cmd(i, CMD_RAMWRC, NULL, 240 * 6 * 2);
+    }
+    printf("24 rows in 4 slices: %u transactions, 12 without the window cache\n", (unsigned)mock.cmd_cnt);
+}
+
+int main(void)
+{
+    lv_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_first_flush_sets_window);
+    RUN_TEST(test_band_below_continues);
+    RUN_TEST(test_same_columns_elsewhere_sets_rows);
+    RUN_TEST(test_other_columns_set_window);
+    RUN_TEST(test_other_commands_break_continue);
+    RUN_TEST(test_gap_moves_window);
+    RUN_TEST(test_stats);
+    RUN_TEST(test_flush_queue_slices_continue);
+    return UNITY_END();
+}
@@ -0,0 +1,405 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Checks the screen manager of lvgl_hw_screen.c: screens built on their first show, pre-warmed
+// while idle and the least recently used ones deleted when the LVGL heap runs short. Reports the
+// heap of the screens and the time of a switch to a screen which has to be built, which is still
+// built and which was pre-warmed.
+
+#include <stdio.h>
+#include "unity.h"
+#include "host_disp.h"
+#include "lvgl_hw_screen.h"
+
+#define SWITCHES 20
+// the local style lv_scr_load_anim() gives a screen, at most
+#define LOAD_STYLE_SIZE 256
+
+enum
+{
+    SCR_MAIN,
+    SCR_SETTINGS,
+    SCR_HISTORY,
+    SCR_WIFI,
+    SCR_CNT,
+};
+
+static host_disp_t *hd;
+static lv_obj_t *base;
+static lvgl_screen_mgr_t mgr;
+static uint32_t builds[SCR_CNT];
+static uint32_t releases[SCR_CNT];
+
+// screens of about the same size, `user_data` is the id
+static lv_obj_t *build_cb(void *user_data)
+{
+    int id = (int)(intptr_t)user_data;
+    builds[id]++;
+    lv_obj_t *scr = lv_obj_create(NULL);
+    lv_obj_t *title = lv_label_create(scr);
+    lv_label_set_text_fmt(title, "screen %d", id);
+    if (id == SCR_HISTORY)
+    {
+        lv_obj_t *chart = lv_chart_create(scr);
+        lv_obj_set_size(chart, 200, 150);
+        lv_obj_center(chart);
+        lv_chart_set_point_count(chart, 60);
+        lv_chart_series_t *ser = lv_chart_add_series(chart, lv_palette_main(LV_PALETTE_RED), LV_CHART_AXIS_PRIMARY_Y);
+        for (int i = 0; i < 60; i++)
+        {
+            lv_chart_set_next_value(chart, ser, (i * 37) % 100);
+        }
+    }
+    lv_obj_t *list = lv_obj_create(scr);
+    lv_obj_set_size(list, 200, 160);
+    lv_obj_set_y(list, 40);
+    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+    for (int i = 0; i < (id == SCR_MAIN ? 2 : id == SCR_HISTORY ? 4 : 10); i++)
+    {
+        lv_obj_t *btn = lv_btn_create(list);
+        lv_label_set_text_fmt(lv_label_create(btn), "item %d", i);
+    }
+    return scr;
+}
+
+static void release_cb(lv_obj_t *scr, void *user_data)
+{
+    releases[(int)(intptr_t)user_data]++;
+}
+
+static uint32_t heap_free(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.free_size;
+}
+
+// `min_free` is set by the tests once the screens were measured
+static void mgr_create(uint32_t min_free)
+{
+    static const char *names[SCR_CNT] = {"main", "settings", "history", "wifi"};
+    lvgl_screen_mgr_init(&mgr, min_free);
+    for (int i = 0; i < SCR_CNT; i++)
+    {
+        lvgl_screen_desc_t desc = {
+            .name = names[i],
+            .build = build_cb,
+            .release = release_cb,
+            .user_data = (void *)(intptr_t)i,
+            .next = i == SCR_MAIN ? SCR_SETTINGS : LVGL_SCREEN_NONE,
+            .pinned = i == SCR_MAIN,
+        };
+        TEST_ASSERT_EQUAL_INT(i, lvgl_screen_register(&mgr, &desc));
+    }
+}
+
+void setUp(void)
+{
+    memset(builds, 0, sizeof(builds));
+    memset(releases, 0, sizeof(releases));
+    mgr_create(0);
+}
+
+// back to the screen of the display, all the screens deleted
+void tearDown(void)
+{
+    lvgl_screen_set_prewarm_period(&mgr, 0, 0);
+    lv_disp_load_scr(base);
+    for (int i = 0; i < SCR_CNT; i++)
+    {
+        if (lvgl_screen_get(&mgr, i) != NULL)
+        {
+            lv_obj_del(lvgl_screen_get(&mgr, i));
+        }
+    }
+}
+
+// heap of each screen, built and deleted once
+static void measure(uint32_t size[SCR_CNT])
+{
+    for (int i = 0; i < SCR_CNT; i++)
+    {
+        TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, i, LV_SCR_LOAD_ANIM_NONE, 0));
+        size[i] = mgr.screens[i].mem_size;
+        TEST_ASSERT_GREATER_THAN_UINT32(1000, size[i]);
+    }
+    lv_disp_load_scr(base);
+    for (int i = 0; i < SCR_CNT; i++)
+    {
+        lvgl_screen_evict(&mgr, i);
+    }
+    mgr.active = LVGL_SCREEN_NONE;
+    lvgl_screen_reset_stats(&mgr);
+    memset(builds, 0, sizeof(builds));
+    memset(releases, 0, sizeof(releases));
+}
+
+void test_screen_built_on_first_show(void)
+{
+    uint32_t free_start = heap_free();
+    for (int i = 0; i < SCR_CNT; i++)
+    {
+        TEST_ASSERT_NULL(lvgl_screen_get(&mgr, i));
+    }
+    TEST_ASSERT_EQUAL_UINT32(free_start, heap_free());
+
+    TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, SCR_MAIN, LV_SCR_LOAD_ANIM_NONE, 0));
+    TEST_ASSERT_EQUAL_PTR(lvgl_screen_get(&mgr, SCR_MAIN), lv_scr_act());
+    TEST_ASSERT_NULL(lvgl_screen_get(&mgr, SCR_SETTINGS));
+    // lv_scr_load_anim() gives the screens a local style for their position, after the build
+    TEST_ASSERT_UINT32_WITHIN(LOAD_STYLE_SIZE, free_start - mgr.screens[SCR_MAIN].mem_size, heap_free());
+
+    TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, SCR_SETTINGS, LV_SCR_LOAD_ANIM_NONE, 0));
+    TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, SCR_MAIN, LV_SCR_LOAD_ANIM_NONE, 0));
+    TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, SCR_SETTINGS, LV_SCR_LOAD_ANIM_NONE, 0));
+    TEST_ASSERT_EQUAL_UINT32(1, builds[SCR_MAIN]);
+    TEST_ASSERT_EQUAL_UINT32(1, builds[SCR_SETTINGS]);
+    TEST_ASSERT_EQUAL_UINT32(0, builds[SCR_HISTORY]);
+
+    lvgl_screen_stats_t stats;
+    lvgl_screen_get_stats(&mgr, &stats);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.shows);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.builds);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.evictions);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.resident);
+    TEST_ASSERT_UINT32_WITHIN(2 * LOAD_STYLE_SIZE, free_start - heap_free(), stats.resident_bytes);
+    TEST_ASSERT_FALSE(lvgl_screen_show(&mgr, SCR_CNT, LV_SCR_LOAD_ANIM_NONE, 0));
+}
+
+void test_screen_lru_evicted(void)
+{
+    uint32_t size[SCR_CNT];
+    measure(size);
+    TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, SCR_MAIN, LV_SCR_LOAD_ANIM_NONE, 0));
+
+    // room for the main screen and two others: wifi doesn't fit beside settings and history
+    uint32_t free_main = heap_free();
+    mgr.min_free = free_main - size[SCR_SETTINGS] - size[SCR_HISTORY] - size[SCR_WIFI] + size[SCR_SETTINGS] / 2;
+    TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, SCR_SETTINGS, LV_SCR_LOAD_ANIM_NONE, 0));
+    TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, SCR_HISTORY, LV_SCR_LOAD_ANIM_NONE, 0));
+    TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, SCR_MAIN, LV_SCR_LOAD_ANIM_NONE, 0));
+    TEST_ASSERT_NOT_NULL(lvgl_screen_get(&mgr, SCR_SETTINGS));
+    TEST_ASSERT_NOT_NULL(lvgl_screen_get(&mgr, SCR_HISTORY));
+
+    // settings was used longest ago
+    TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, SCR_WIFI, LV_SCR_LOAD_ANIM_NONE, 0));
+    TEST_ASSERT_NULL(lvgl_screen_get(&mgr, SCR_SETTINGS));
+    TEST_ASSERT_NOT_NULL(lvgl_screen_get(&mgr, SCR_HISTORY));
+    TEST_ASSERT_EQUAL_UINT32(1, releases[SCR_SETTINGS]);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(mgr.min_free, heap_free());
+
+    // built again, now history goes
+    TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, SCR_SETTINGS, LV_SCR_LOAD_ANIM_NONE, 0));
+    TEST_ASSERT_EQUAL_UINT32(2, builds[SCR_SETTINGS]);
+    TEST_ASSERT_NULL(lvgl_screen_get(&mgr, SCR_HISTORY));
+    TEST_ASSERT_NOT_NULL(lvgl_screen_get(&mgr, SCR_WIFI));
+    TEST_ASSERT_NOT_NULL(lvgl_screen_get(&mgr, SCR_MAIN));
+
+    lvgl_screen_stats_t stats;
+    lvgl_screen_get_stats(&mgr, &stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.evictions);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.resident);
+    TEST_ASSERT_EQUAL_UINT32(releases[SCR_SETTINGS] + releases[SCR_HISTORY], stats.evictions);
+}
+
+void test_screen_pinned_shown_and_animated_stay(void)
+{
+    // no heap is ever enough: only what may not go stays
+    mgr.min_free = UINT32_MAX;
+    TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, SCR_MAIN, LV_SCR_LOAD_ANIM_NONE, 0));
+    TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, SCR_SETTINGS, LV_SCR_LOAD_ANIM_NONE, 0));
+    TEST_ASSERT_NOT_NULL(lvgl_screen_get(&mgr, SCR_MAIN));
+    TEST_ASSERT_NOT_NULL(lvgl_screen_get(&mgr, SCR_SETTINGS));
+    TEST_ASSERT_EQUAL_UINT32(0, lvgl_screen_trim(&mgr));
+
+    // settings slides out while history slides in, both stay until the animation is over
+    TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, SCR_HISTORY, LV_SCR_LOAD_ANIM_MOVE_LEFT, 100));
+    TEST_ASSERT_NOT_NULL(lvgl_screen_get(&mgr, SCR_SETTINGS));
+    TEST_ASSERT_FALSE(lvgl_screen_evict(&mgr, SCR_SETTINGS));
+    TEST_ASSERT_FALSE(lvgl_screen_evict(&mgr, SCR_HISTORY));
+    for (int i = 0; i < 20; i++)
+    {
+        host_tick_advance(10);
+        lv_timer_handler();
+    }
+    TEST_ASSERT_EQUAL_PTR(lvgl_screen_get(&mgr, SCR_HISTORY), lv_scr_act());
+    TEST_ASSERT_EQUAL_UINT32(1, lvgl_screen_trim(&mgr));
+    TEST_ASSERT_NULL(lvgl_screen_get(&mgr, SCR_SETTINGS));
+    TEST_ASSERT_NOT_NULL(lvgl_screen_get(&mgr, SCR_MAIN));
+
+    // only an explicit evict deletes a pinned screen
+    TEST_ASSERT_TRUE(lvgl_screen_evict(&mgr, SCR_MAIN));
+    TEST_ASSERT_NULL(lvgl_screen_get(&mgr, SCR_MAIN));
+}
+
+void test_screen_prewarm(void)
+{
+    uint32_t size[SCR_CNT];
+    measure(size);
+    TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, SCR_MAIN, LV_SCR_LOAD_ANIM_NONE, 0));
+
+    // not when settings wouldn't fit beside min_free, and nothing is evicted for it
+    uint32_t free_main = heap_free();
+    mgr.min_free = free_main - size[SCR_SETTINGS] / 2;
+    TEST_ASSERT_FALSE(lvgl_screen_prewarm(&mgr));
+    TEST_ASSERT_EQUAL_UINT32(0, builds[SCR_SETTINGS]);
+    TEST_ASSERT_EQUAL_UINT32(free_main, heap_free());
+
+    mgr.min_free = 1024;
+    TEST_ASSERT_TRUE(lvgl_screen_prewarm(&mgr));
+    TEST_ASSERT_FALSE(lvgl_screen_prewarm(&mgr));
+    TEST_ASSERT_EQUAL_UINT32(1, builds[SCR_SETTINGS]);
+    TEST_ASSERT_EQUAL_PTR(lvgl_screen_get(&mgr, SCR_MAIN), lv_scr_act());
+
+    TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, SCR_SETTINGS, LV_SCR_LOAD_ANIM_NONE, 0));
+    TEST_ASSERT_EQUAL_UINT32(1, builds[SCR_SETTINGS]);
+    lvgl_screen_stats_t stats;
+    lvgl_screen_get_stats(&mgr, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.prewarms);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.prewarm_hits);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.builds);
+
+    // settings has no next
+    TEST_ASSERT_FALSE(lvgl_screen_prewarm(&mgr));
+}
+
+void test_screen_prewarm_first_build_too_big(void)
+{
+    TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, SCR_MAIN, LV_SCR_LOAD_ANIM_NONE, 0));
+    uint32_t free_main = heap_free();
+
+    // the size of settings is unknown before its first build, it's deleted again as it didn't fit
+    mgr.min_free = free_main - 100;
+    TEST_ASSERT_FALSE(lvgl_screen_prewarm(&mgr));
+    TEST_ASSERT_EQUAL_UINT32(1, builds[SCR_SETTINGS]);
+    TEST_ASSERT_EQUAL_UINT32(1, releases[SCR_SETTINGS]);
+    TEST_ASSERT_NULL(lvgl_screen_get(&mgr, SCR_SETTINGS));
+    TEST_ASSERT_EQUAL_UINT32(free_main, heap_free());
+
+    // now known, it isn't tried again
+    TEST_ASSERT_FALSE(lvgl_screen_prewarm(&mgr));
+    TEST_ASSERT_EQUAL_UINT32(1, builds[SCR_SETTINGS]);
+}
+
+void test_screen_prewarm_timer(void)
+{
+    mgr.min_free = 1024;
+    TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, SCR_MAIN, LV_SCR_LOAD_ANIM_NONE, 0));
+    lvgl_screen_set_prewarm_period(&mgr, 50, 0);
+    for (int i = 0; i < 10 && lvgl_screen_get(&mgr, SCR_SETTINGS) == NULL; i++)
+    {
+        host_tick_advance(20);
+        lv_timer_handler();
+    }
+    TEST_ASSERT_NOT_NULL(lvgl_screen_get(&mgr, SCR_SETTINGS));
+    TEST_ASSERT_EQUAL_PTR(lvgl_screen_get(&mgr, SCR_MAIN), lv_scr_act());
+
+    // over 100 % idle never happens
+    lvgl_screen_evict(&mgr, SCR_SETTINGS);
+    lvgl_screen_set_prewarm_period(&mgr, 50, 101);
+    for (int i = 0; i < 10; i++)
+    {
+        host_tick_advance(20);
+        lv_timer_handler();
+    }
+    TEST_ASSERT_NULL(lvgl_screen_get(&mgr, SCR_SETTINGS));
+}
+
+void test_screen_no_leak(void)
+{
+    uint32_t free_start = heap_free();
+    mgr.min_free = 1024;
+    for (int round = 0; round < 3; round++)
+    {
+        for (int i = 0; i < SCR_CNT; i++)
+        {
+            TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, i, LV_SCR_LOAD_ANIM_NONE, 0));
+            lv_refr_now(hd->disp);
+        }
+        TEST_ASSERT_TRUE(lvgl_screen_prewarm(&mgr) || lvgl_screen_get(&mgr, SCR_SETTINGS) != NULL);
+        lv_disp_load_scr(base);
+        for (int i = 0; i < SCR_CNT; i++)
+        {
+            lvgl_screen_evict(&mgr, i);
+        }
+        TEST_ASSERT_EQUAL_UINT32(free_start, heap_free());
+    }
+}
+
+// us of a switch as lvgl_screen_show() measures it, and of the switch with its first frame
+static void time_switches(int id, bool evict, bool prewarm, double *show_us, double *frame_us)
+{
+    uint64_t total = 0;
+    lvgl_screen_reset_stats(&mgr);
+    for (int i = 0; i < SWITCHES; i++)
+    {
+        TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, SCR_MAIN, LV_SCR_LOAD_ANIM_NONE, 0));
+        lv_refr_now(hd->disp);
+        if (evict)
+        {
+            lvgl_screen_evict(&mgr, id);
+        }
+        if (prewarm)
+        {
+            TEST_ASSERT_TRUE(lvgl_screen_prewarm(&mgr));
+        }
+        uint64_t t0 = host_time_us();
+        TEST_ASSERT_TRUE(lvgl_screen_show(&mgr, id, LV_SCR_LOAD_ANIM_NONE, 0));
+        lv_refr_now(hd->disp);
+        total += host_time_us() - t0;
+    }
+    lvgl_screen_stats_t stats;
+    lvgl_screen_get_stats(&mgr, &stats);
+    *show_us = (double)stats.total_switch_us / stats.shows;
+    *frame_us = (double)total / SWITCHES;
+}
+
+void test_screen_report(void)
+{
+    uint32_t size[SCR_CNT];
+    measure(size);
+    mgr.min_free = 1024;
+
+    double cold_show, cold_frame, warm_show, warm_frame, pre_show, pre_frame;
+    time_switches(SCR_WIFI, true, false, &cold_show, &cold_frame);
+    time_switches(SCR_WIFI, false, false, &warm_show, &warm_frame);
+    time_switches(SCR_SETTINGS, true, true, &pre_show, &pre_frame);
+
+    printf("screens in the LVGL heap: main %u, settings %u, history %u, wifi %u bytes\n", (unsigned)size[SCR_MAIN],
+           (unsigned)size[SCR_SETTINGS], (unsigned)size[SCR_HISTORY], (unsigned)size[SCR_WIFI]);
+    printf("switch from main (show / show with the first frame, mean of %d):\n", SWITCHES);
+    printf("  built on the show:  %6.1f us / %6.1f us\n", cold_show, cold_frame);
+    printf("  still built:        %6.1f us / %6.1f us\n", warm_show, warm_frame);
+    printf("  pre-warmed:         %6.1f us / %6.1f us\n", pre_show, pre_frame);
+    // the times are too noisy on a shared host to assert on
+}
+
+int main(void)
+{
+    lv_init();
+    hd = host_disp_create(false);
+    TEST_ASSERT_NOT_NULL(hd);
+    base = lv_scr_act();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_screen_built_on_first_show);
+    RUN_TEST(test_screen_lru_evicted);
+    RUN_TEST(test_screen_pinned_shown_and_animated_stay);
+    RUN_TEST(test_screen_prewarm);
+    RUN_TEST(test_screen_prewarm_first_build_too_big);
+    RUN_TEST(test_screen_prewarm_timer);
+    RUN_TEST(test_screen_no_leak);
+    RUN_TEST(test_screen_report);
+    return UNITY_END();
+}
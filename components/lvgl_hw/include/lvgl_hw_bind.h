@@ -0,0 +1,95 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _LVGL_HW_BIND_H
+#define _LVGL_HW_BIND_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+
+// longest text of a bound label, including the terminator
+#define LVGL_BIND_TEXT_LEN 24
+// format of a label bound without one, e.g. a numeric label built as a plain label when LV_USE_NUMLABEL is 0
+#define LVGL_BIND_DEFAULT_FMT "%g"
+
+    /**
+     * @brief A value shown by a label, a numeric label or an arc. The widget is touched only when what it shows changes.
+     */
+    typedef struct
+    {
+        lv_obj_t *obj;
+        const char *fmt;  /*!< printf format of a label, takes one double */
+        float resolution; /*!< smallest change worth showing, e.g. 0.1 for 0.1 °C */
+        int32_t steps;    /*!< last shown value in units of resolution */
+        bool valid;       /*!< false until the widget was set the first time */
+        char text[LVGL_BIND_TEXT_LEN];
+    } lvgl_bind_t;
+
+    /**
+     * @brief Counters of all bindings
+     */
+    typedef struct
+    {
+        uint32_t updates;       /*!< values written to bindings */
+        uint32_t invalidations; /*!< updates which changed a widget */
+        uint32_t suppressed;    /*!< updates dropped because the widget would look the same */
+    } lvgl_bind_stats_t;
+
+    /**
+     * @brief Bind a label, a numeric label or an arc
+     *
+     * @param bind binding to initialize
+     * @param obj label, numeric label or arc
+     * @param fmt printf format of the value for a label, e.g. "%.1f", NULL for LVGL_BIND_DEFAULT_FMT.
+     *            Ignored for a numeric label and an arc.
+     * @param resolution display resolution of the value, 1 for an arc showing integers. A numeric label is
+     *                   given the value in steps of the resolution, so it should be 0.1 for 1 decimal.
+     */
+    void lvgl_bind_init(lvgl_bind_t *bind, lv_obj_t *obj, const char *fmt, float resolution);
+
+    /**
+     * @brief Show a new value, rounded to the resolution of the binding
+     *
+     * @return true if the widget was changed and invalidated
+     */
+    bool lvgl_bind_set_float(lvgl_bind_t *bind, float value);
+
+    /**
+     * @brief Show a new text on a bound label
+     *
+     * @return true if the label was changed and invalidated
+     */
+    bool lvgl_bind_set_text(lvgl_bind_t *bind, const char *text);
+
+    /**
+     * @brief Get the counters of all bindings
+     */
+    void lvgl_bind_get_stats(lvgl_bind_stats_t *stats);
+
+    /**
+     * @brief Zero the counters of all bindings
+     */
+    void lvgl_bind_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
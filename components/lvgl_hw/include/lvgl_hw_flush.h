@@ -0,0 +1,134 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _LVGL_HW_FLUSH_H
+#define _LVGL_HW_FLUSH_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+
+// most slices a flush queue can carve its DMA buffer into
+#define LVGL_FLUSH_MAX_SLICES 8
+
+    /**
+     * @brief Rows of a flushed area copied to a DMA slice, sent as one SPI transaction
+     */
+    typedef struct
+    {
+        lv_area_t area;  /*!< panel window of the pixels */
+        lv_color_t *buf; /*!< packed pixels of the window */
+    } lvgl_flush_slice_t;
+
+    /**
+     * @brief Send a slice to the panel. The slice is owned by the sender until `lvgl_flush_queue_done()`.
+     */
+    typedef void (*lvgl_flush_send_cb_t)(lvgl_flush_slice_t *slice, void *user_ctx);
+
+    /**
+     * @brief Wait a little for a slice to be done, called while all slices are in flight
+     */
+    typedef void (*lvgl_flush_wait_cb_t)(void *user_ctx);
+
+    /**
+     * @brief Counters of a flush queue since its initialization
+     */
+    typedef struct
+    {
+        uint32_t slices; /*!< slices whose transfer is done */
+        uint32_t bytes;  /*!< pixel bytes of these slices */
+        uint32_t waits;  /*!< calls of the wait callback because no slice was free */
+    } lvgl_flush_stats_t;
+
+    /**
+     * @brief Ring of DMA slices between the renderer and the SPI bus. The renderer copies a flushed
+     *        area into free slices and can draw the next one while the slices are transmitted.
+     */
+    typedef struct
+    {
+        lvgl_flush_slice_t slices[LVGL_FLUSH_MAX_SLICES];
+        uint32_t slice_cnt;
+        uint32_t slice_px;
+        volatile uint32_t queued; /*!< slices given to the sender, written by the renderer */
+        volatile uint32_t done;   /*!< slices transmitted, written by the transfer done callback */
+        lvgl_flush_send_cb_t send_cb;
+        lvgl_flush_wait_cb_t wait_cb;
+        void *user_ctx;
+        lvgl_flush_stats_t stats;
+    } lvgl_flush_queue_t;
+
+    /**
+     * @brief Carve a DMA buffer into slices
+     *
+     * @param queue queue to initialize
+     * @param buf DMA capable buffer
+     * @param buf_px length of `buf` in pixels
+     * @param slice_cnt number of slices, 1 to LVGL_FLUSH_MAX_SLICES
+     * @param hor_res horizontal resolution of the panel, a slice holds at least one row
+     * @param send_cb sends a slice
+     * @param wait_cb waits for a slice to be done
+     * @param user_ctx passed to the callbacks
+     * @return false if the slices would be smaller than a row
+     */
+    bool lvgl_flush_queue_init(lvgl_flush_queue_t *queue, lv_color_t *buf, uint32_t buf_px, uint32_t slice_cnt,
+                               lv_coord_t hor_res, lvgl_flush_send_cb_t send_cb, lvgl_flush_wait_cb_t wait_cb,
+                               void *user_ctx);
+
+    /**
+     * @brief Copy the pixels of an area into slices of whole rows and send them in order.
+     *        Waits only if all slices are in flight, the area can be reused on return.
+     *
+     * @param queue the queue
+     * @param area window of the pixels
+     * @param color_map packed pixels of the area
+     */
+    void lvgl_flush_queue_push(lvgl_flush_queue_t *queue, const lv_area_t *area, const lv_color_t *color_map);
+
+    /**
+     * @brief Copy an area of a full frame buffer (LVGL's direct mode) into slices of whole rows and send them.
+     *        The slices double as the bounce buffer between a frame buffer the DMA can't read and the bus.
+     *
+     * @param queue the queue
+     * @param area window of the pixels, in frame buffer coordinates
+     * @param fb the frame buffer
+     * @param fb_w width of the frame buffer in pixels
+     */
+    void lvgl_flush_queue_push_fb(lvgl_flush_queue_t *queue, const lv_area_t *area, const lv_color_t *fb,
+                                  lv_coord_t fb_w);
+
+    /**
+     * @brief Release the oldest slice in flight, call it from the transfer done callback (ISR)
+     */
+    void lvgl_flush_queue_done(lvgl_flush_queue_t *queue);
+
+    /**
+     * @brief Tell whether every pushed slice is transmitted
+     */
+    bool lvgl_flush_queue_is_idle(const lvgl_flush_queue_t *queue);
+
+    /**
+     * @brief Get the counters, they only grow so a caller can take the difference of two calls
+     */
+    void lvgl_flush_queue_get_stats(const lvgl_flush_queue_t *queue, lvgl_flush_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
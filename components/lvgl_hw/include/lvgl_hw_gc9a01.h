@@ -33,6 +33,29 @@ extern "C"
      */
     esp_err_t esp_lcd_new_panel_gc9a01(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *panel_dev_config, esp_lcd_panel_handle_t *ret_panel);
 
+    /**
+     * @brief Counters of draw_bitmap since the panel was created
+     */
+    typedef struct
+    {
+        uint32_t flushes;       /*!< draw_bitmap calls */
+        uint32_t transactions;  /*!< commands sent, each with its parameters or pixels */
+        uint32_t caset_skipped; /*!< CASET left out because the columns did not change */
+        uint32_t raset_skipped; /*!< RASET left out because the band followed the last one (RAMWR-continue) */
+        uint64_t busy_us;       /*!< time spent in draw_bitmap, with the wait for the previous pixels */
+    } gc9a01_panel_stats_t;
+
+    /**
+     * @brief Get the counters of a GC9A01 panel, they only grow so a caller can take the difference of two calls
+     *
+     * @param[in] panel panel created by esp_lcd_new_panel_gc9a01()
+     * @param[out] stats the counters
+     * @return
+     *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+     *          - ESP_OK                on success
+     */
+    esp_err_t esp_lcd_panel_gc9a01_get_stats(esp_lcd_panel_handle_t panel, gc9a01_panel_stats_t *stats);
+
 
 #ifdef __cplusplus
 }
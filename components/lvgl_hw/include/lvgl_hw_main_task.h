@@ -16,11 +16,58 @@
 extern "C"
 {
 #endif
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
 #include "driver/ledc.h"
 
+    /**
+     * @brief Activity of the GUI task over the last complete second
+     */
+    typedef struct
+    {
+        uint32_t wakeups;           /*!< times the task woke up to run lv_timer_handler */
+        uint32_t busy_us;           /*!< time spent in lv_timer_handler, including waiting for the mutex */
+        uint32_t frames;            /*!< refreshed frames */
+        uint32_t spi_util_permille; /*!< share of the time the SPI bus carried pixels, in 1/1000 */
+        uint32_t flush_waits;       /*!< times the renderer waited for a free DMA slice (LCD_FLUSH_QUEUE) */
+        uint32_t panel_flushes;     /*!< draw_bitmap calls of the panel driver */
+        uint32_t spi_trans;         /*!< commands sent by draw_bitmap, each a SPI transaction */
+        uint32_t panel_us;          /*!< time spent in draw_bitmap */
+    } gui_task_stats_t;
+
     void gui_task(void *pvParameters);
     void change_backlight(ledc_channel_t ledc_channel, double duty);
 
+    /**
+     * @brief Wake the GUI task before its next LVGL deadline, e.g. after new input
+     */
+    void gui_task_wakeup(void);
+
+    /**
+     * @brief ISR version of gui_task_wakeup()
+     *
+     * @param[out] high_task_wakeup set to pdTRUE if a context switch should be requested
+     */
+    void gui_task_wakeup_from_isr(BaseType_t *high_task_wakeup);
+
+    /**
+     * @brief Take the LVGL mutex to touch LVGL objects from another task
+     *
+     * @param timeout_ms time to wait for the mutex
+     * @return true if the mutex was taken
+     */
+    bool gui_lock(uint32_t timeout_ms);
+
+    /**
+     * @brief Release the LVGL mutex and wake the GUI task to redraw what was invalidated
+     */
+    void gui_unlock(void);
+
+    /**
+     * @brief Get the wakeups and busy time of the GUI task in the last second
+     */
+    void gui_task_get_stats(gui_task_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,154 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _LVGL_HW_ROUND_H
+#define _LVGL_HW_ROUND_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "src/draw/sw/lv_draw_sw.h"
+#include "src/draw/esp32s3_pie/lv_gpu_esp32s3_pie.h"
+
+    /**
+     * @brief Visible pixels of one row of a round panel, inclusive. The row is empty if x1 > x2.
+     */
+    typedef struct
+    {
+        lv_coord_t x1;
+        lv_coord_t x2;
+    } lvgl_round_span_t;
+
+    /**
+     * @brief SW draw context which clips every draw and blend to the visible circle
+     */
+    typedef struct
+    {
+        lv_draw_sw_ctx_t sw_ctx;
+        // draw functions of the wrapped SW context
+        void (*parent_draw_rect)(lv_draw_ctx_t *draw_ctx, const lv_draw_rect_dsc_t *dsc, const lv_area_t *coords);
+        void (*parent_draw_bg)(lv_draw_ctx_t *draw_ctx, const lv_draw_rect_dsc_t *dsc, const lv_area_t *coords);
+        void (*parent_draw_arc)(lv_draw_ctx_t *draw_ctx, const lv_draw_arc_dsc_t *dsc, const lv_point_t *center,
+                                uint16_t radius, uint16_t start_angle, uint16_t end_angle);
+        void (*parent_draw_img_decoded)(lv_draw_ctx_t *draw_ctx, const lv_draw_img_dsc_t *dsc,
+                                        const lv_area_t *coords, const uint8_t *map_p, lv_img_cf_t color_format);
+        void (*parent_draw_line)(lv_draw_ctx_t *draw_ctx, const lv_draw_line_dsc_t *dsc, const lv_point_t *point1,
+                                 const lv_point_t *point2);
+        void (*parent_draw_polygon)(lv_draw_ctx_t *draw_ctx, const lv_draw_rect_dsc_t *dsc,
+                                    const lv_point_t *points, uint16_t point_cnt);
+        void (*parent_blend)(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc);
+    } lvgl_round_draw_ctx_t;
+
+    /**
+     * @brief Called for every row band sent by `lvgl_round_flush_bands()`
+     *
+     * @param band area of the band in display coordinates
+     * @param color_map packed pixels of the band, `lv_area_get_size(band)` long
+     * @param user_ctx user context passed to `lvgl_round_flush_bands()`
+     */
+    typedef void (*lvgl_round_band_cb_t)(const lv_area_t *band, const lv_color_t *color_map, void *user_ctx);
+
+    /**
+     * @brief Build the per-row span table of the circle inscribed in the display
+     *
+     * @param hor_res horizontal resolution of the display
+     * @param ver_res vertical resolution of the display
+     * @return true on success, false if out of memory
+     */
+    bool lvgl_round_init(lv_coord_t hor_res, lv_coord_t ver_res);
+
+    /**
+     * @brief Free the span table
+     */
+    void lvgl_round_deinit(void);
+
+    /**
+     * @brief Get the visible span of a row
+     *
+     * @param y row index
+     * @return span of the row, empty for rows outside the display
+     */
+    lvgl_round_span_t lvgl_round_get_span(lv_coord_t y);
+
+    /**
+     * @brief Number of visible pixels of the whole panel
+     */
+    uint32_t lvgl_round_get_visible_px(void);
+
+    /**
+     * @brief Shrink an area to the bounding box of its visible part
+     *
+     * @param area area to clip, left unchanged if nothing of it is visible
+     * @return true if some part of the area is visible
+     */
+    bool lvgl_round_clip_area(lv_area_t *area);
+
+    /**
+     * @brief `rounder_cb` of the display driver, clips invalidated areas to the visible circle
+     */
+    void lvgl_round_rounder_cb(lv_disp_drv_t *disp_drv, lv_area_t *area);
+
+    /**
+     * @brief `draw_ctx_init` of the display driver. Set `draw_ctx_size` to `sizeof(lvgl_round_draw_ctx_t)`.
+     */
+    void lvgl_round_draw_ctx_init(lv_disp_drv_t *disp_drv, lv_draw_ctx_t *draw_ctx);
+
+    /**
+     * @brief `draw_ctx_deinit` of the display driver
+     */
+    void lvgl_round_draw_ctx_deinit(lv_disp_drv_t *disp_drv, lv_draw_ctx_t *draw_ctx);
+
+    /**
+     * @brief Count the bands `lvgl_round_flush_bands()` will emit for an area
+     *
+     * @param area flushed area
+     * @param band_rows height of a band
+     * @return number of bands with visible pixels
+     */
+    uint32_t lvgl_round_count_bands(const lv_area_t *area, lv_coord_t band_rows);
+
+    /**
+     * @brief Get a band of `lvgl_round_flush_bands()` without touching any pixels
+     *
+     * @param area flushed area
+     * @param band_rows height of a band
+     * @param by1 first row of the band, `area->y1` plus a multiple of `band_rows`
+     * @param band the band trimmed to its visible rows and columns
+     * @return false if nothing of the band is visible
+     */
+    bool lvgl_round_get_band(const lv_area_t *area, lv_coord_t band_rows, lv_coord_t by1, lv_area_t *band);
+
+    /**
+     * @brief Split a flushed area into row bands and pack each band to its visible columns in place
+     *
+     * @param area flushed area
+     * @param color_map rendered pixels of the area, overwritten by the packed bands
+     * @param band_rows height of a band
+     * @param band_cb called for every band with visible pixels, in top to bottom order
+     * @param user_ctx passed to `band_cb`
+     * @return number of bands passed to `band_cb`
+     */
+    uint32_t lvgl_round_flush_bands(const lv_area_t *area, lv_color_t *color_map, lv_coord_t band_rows,
+                                    lvgl_round_band_cb_t band_cb, void *user_ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
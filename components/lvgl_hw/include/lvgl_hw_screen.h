@@ -0,0 +1,179 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _LVGL_HW_SCREEN_H
+#define _LVGL_HW_SCREEN_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+
+// screens a manager can register
+#define LVGL_SCREEN_MAX 8
+// id of no screen, e.g. the `next` of a screen without a likely successor
+#define LVGL_SCREEN_NONE (-1)
+
+    /**
+     * @brief Build the screen with lv_obj_create(NULL) and its children, also bindings and the like
+     *
+     * @return the screen, NULL if it could not be built
+     */
+    typedef lv_obj_t *(*lvgl_screen_build_cb_t)(void *user_data);
+
+    /**
+     * @brief Drop what refers to the objects of a screen, called right before the screen is deleted
+     */
+    typedef void (*lvgl_screen_release_cb_t)(lv_obj_t *scr, void *user_data);
+
+    /**
+     * @brief A screen of the manager, built on first use and deleted again under memory pressure
+     */
+    typedef struct
+    {
+        const char *name;
+        lvgl_screen_build_cb_t build;
+        lvgl_screen_release_cb_t release; /*!< NULL if nothing refers to the objects */
+        void *user_data;
+        int next;    /*!< the screen likely shown after this one, built ahead while idle, or LVGL_SCREEN_NONE */
+        bool pinned; /*!< never evicted, e.g. the main screen with the sensor bindings */
+    } lvgl_screen_desc_t;
+
+    /**
+     * @brief A registered screen
+     */
+    typedef struct
+    {
+        lvgl_screen_desc_t desc;
+        lv_obj_t *scr;      /*!< NULL while not built */
+        uint32_t last_used; /*!< show sequence number of the last show, for the LRU eviction */
+        uint32_t mem_size;  /*!< LVGL heap the last build took, 0 if never built */
+        uint32_t build_us;  /*!< time of the last build */
+        bool prewarmed;     /*!< built by lvgl_screen_prewarm() and not shown since */
+    } lvgl_screen_t;
+
+    /**
+     * @brief Counters of a manager
+     */
+    typedef struct
+    {
+        uint32_t shows;          /*!< lvgl_screen_show() calls */
+        uint32_t builds;         /*!< screens built by a show, the first show or one after an eviction */
+        uint32_t prewarms;       /*!< screens built ahead by lvgl_screen_prewarm() */
+        uint32_t prewarm_hits;   /*!< shows of a pre-warmed screen */
+        uint32_t evictions;      /*!< screens deleted to keep the heap free */
+        uint32_t build_fails;    /*!< builds which returned NULL */
+        uint32_t last_switch_us; /*!< time of the last show: the build if needed and the load */
+        uint32_t max_switch_us;
+        uint64_t total_switch_us;
+        uint32_t resident;       /*!< screens built now */
+        uint32_t resident_bytes; /*!< LVGL heap of the screens built now, as measured at their build */
+    } lvgl_screen_stats_t;
+
+    /**
+     * @brief Builds the screens when they are first shown and deletes the least recently used ones when
+     *        the LVGL heap runs short
+     */
+    typedef struct
+    {
+        lvgl_screen_t screens[LVGL_SCREEN_MAX];
+        uint32_t cnt;
+        uint32_t min_free;     /*!< free LVGL heap to keep, in bytes */
+        uint32_t seq;          /*!< show sequence number */
+        int active;            /*!< the screen shown last, LVGL_SCREEN_NONE before the first show */
+        lv_timer_t *prewarm_timer;
+        uint8_t prewarm_idle;  /*!< lowest lv_timer_get_idle() in % to pre-warm at */
+        lvgl_screen_stats_t stats;
+    } lvgl_screen_mgr_t;
+
+    /**
+     * @brief Initialize a manager with no screens
+     *
+     * @param mgr manager to initialize
+     * @param min_free free LVGL heap in bytes to keep after a build, screens are evicted to get it
+     */
+    void lvgl_screen_mgr_init(lvgl_screen_mgr_t *mgr, uint32_t min_free);
+
+    /**
+     * @brief Register a screen, it's built on its first show
+     *
+     * @return the id of the screen, LVGL_SCREEN_NONE if LVGL_SCREEN_MAX are registered
+     */
+    int lvgl_screen_register(lvgl_screen_mgr_t *mgr, const lvgl_screen_desc_t *desc);
+
+    /**
+     * @brief Build a screen if it isn't and load it. Evicts the least recently used screens before
+     *        the build until the heap it took last time and `min_free` are free, and after it until
+     *        `min_free` is free. The screen shown and the screens of a running load animation stay.
+     *
+     * @param anim animation of lv_scr_load_anim(), the previous screen is kept
+     * @param time time of the animation in ms, 0 to load at once
+     * @return false if the screen could not be built
+     */
+    bool lvgl_screen_show(lvgl_screen_mgr_t *mgr, int id, lv_scr_load_anim_t anim, uint32_t time);
+
+    /**
+     * @brief Build the `next` of the shown screen if it isn't built and fits into the heap beside
+     *        `min_free` without evicting anything
+     *
+     * @return true if a screen was built
+     */
+    bool lvgl_screen_prewarm(lvgl_screen_mgr_t *mgr);
+
+    /**
+     * @brief Call lvgl_screen_prewarm() from an LVGL timer while LVGL is idle
+     *
+     * @param period_ms period of the timer, 0 to delete the timer
+     * @param min_idle lowest lv_timer_get_idle() in % to pre-warm at
+     */
+    void lvgl_screen_set_prewarm_period(lvgl_screen_mgr_t *mgr, uint32_t period_ms, uint8_t min_idle);
+
+    /**
+     * @brief Evict the least recently used screens until `min_free` is free
+     *
+     * @return the number of screens evicted
+     */
+    uint32_t lvgl_screen_trim(lvgl_screen_mgr_t *mgr);
+
+    /**
+     * @brief Delete a screen now, unless it's shown or in a load animation. Pinned screens too.
+     *
+     * @return true if the screen was deleted
+     */
+    bool lvgl_screen_evict(lvgl_screen_mgr_t *mgr, int id);
+
+    /**
+     * @brief Get a screen, NULL while it isn't built
+     */
+    lv_obj_t *lvgl_screen_get(lvgl_screen_mgr_t *mgr, int id);
+
+    /**
+     * @brief Get the counters of a manager
+     */
+    void lvgl_screen_get_stats(lvgl_screen_mgr_t *mgr, lvgl_screen_stats_t *stats);
+
+    /**
+     * @brief Zero the counters of a manager
+     */
+    void lvgl_screen_reset_stats(lvgl_screen_mgr_t *mgr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
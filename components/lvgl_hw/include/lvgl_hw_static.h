@@ -0,0 +1,88 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _LVGL_HW_STATIC_H
+#define _LVGL_HW_STATIC_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+
+    /**
+     * @brief A part of a screen that never changes after the screen is built
+     */
+    typedef struct
+    {
+        lv_obj_t *obj; /*!< direct child of the screen */
+        lv_part_t part; /*!< the static part, LV_PART_ANY for the whole object with its children */
+    } lvgl_static_part_t;
+
+    /**
+     * @brief The background of a screen and its static parts, rendered once into an image.
+     *
+     * While enabled, the static objects are hidden and the static parts of the other objects are
+     * made transparent. A refresh blits the image and draws only the dynamic parts on top of it.
+     * The frame is identical as long as no dynamic part overlaps a static one above it.
+     */
+    typedef struct
+    {
+        lv_obj_t *scr;
+        const lvgl_static_part_t *parts;
+        uint32_t part_cnt;
+        lv_obj_t *img;     /*!< shows the pre-rendered image as the bottom child of the screen */
+        lv_img_dsc_t dsc;
+        void *buf;
+        uint32_t buf_size;
+        bool enabled;
+    } lvgl_static_layer_t;
+
+    /**
+     * @brief Render the static parts of a screen and enable the layer
+     *
+     * @param layer layer to initialize
+     * @param scr screen with its static objects already created
+     * @param parts static parts, must stay valid while the layer exists
+     * @param part_cnt number of static parts
+     * @return true on success, false if out of memory
+     */
+    bool lvgl_static_layer_create(lvgl_static_layer_t *layer, lv_obj_t *scr, const lvgl_static_part_t *parts,
+                                  uint32_t part_cnt);
+
+    /**
+     * @brief Render the static parts again, e.g. after a theme change
+     *
+     * @return true on success
+     */
+    bool lvgl_static_layer_update(lvgl_static_layer_t *layer);
+
+    /**
+     * @brief Draw the screen from the pre-rendered image or draw every object as usual
+     */
+    void lvgl_static_layer_set_enabled(lvgl_static_layer_t *layer, bool en);
+
+    /**
+     * @brief Restore the screen and free the image
+     */
+    void lvgl_static_layer_delete(lvgl_static_layer_t *layer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
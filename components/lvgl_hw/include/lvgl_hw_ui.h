@@ -0,0 +1,70 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _LVGL_HW_UI_H
+#define _LVGL_HW_UI_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include "lvgl.h"
+
+// deepest nesting of the objects of a table, the screen is at depth 0
+#define LVGL_UI_MAX_DEPTH 8
+
+    /**
+     * @brief A const style of an object, see LV_STYLE_CONST_INIT()
+     */
+    typedef struct
+    {
+        const lv_style_t *style;      /*!< in flash, LVGL only reads it */
+        lv_style_selector_t selector; /*!< part and state the style is added for */
+    } lvgl_ui_style_t;
+
+    /**
+     * @brief An object of a screen table generated by tools/lvgl_ui_gen.py from ui/<screen>.json
+     */
+    typedef struct
+    {
+        lv_obj_t *(*create)(lv_obj_t *parent); /*!< e.g. lv_label_create, lv_obj_create for a screen */
+        lv_obj_t **var;                        /*!< where the object is stored, NULL if it has no name */
+        const lvgl_ui_style_t *styles;         /*!< added in this order after the styles of the theme */
+        uint8_t style_cnt;
+        uint8_t depth;                         /*!< the parent is the closest object before it one level up */
+        lv_obj_flag_t flags_add;
+        lv_obj_flag_t flags_clear;
+        void (*init)(lv_obj_t *obj); /*!< the settings of the widget (text, range, value...), NULL if none */
+    } lvgl_ui_obj_t;
+
+    /**
+     * @brief Create the objects of a table in order, parents before their children.
+     *
+     * The geometry and the styles of every object are const styles, so no local style is allocated.
+     * They are added with the style refresh off and the object is refreshed once, instead of once per
+     * property like lv_obj_set_style_*() does.
+     *
+     * @param objs the objects, the first one is the screen (depth 0)
+     * @param cnt number of objects
+     * @return the screen
+     */
+    lv_obj_t *lvgl_ui_create(const lvgl_ui_obj_t *objs, uint32_t cnt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -12,47 +12,62 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <inttypes.h>
 #include "math.h"
 #include "time.h"
+#include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
 #include "sensor_type.h"
+#include "iot_sensor_hub.h"
+#include "lvgl_hw_bind.h"
+#include "lvgl_hw_main_task.h"
+#include "lvgl_hw_screen.h"
+#include "lvgl_hw_static.h"
 #include "lvgl_app.h"
+// generated from ui/ui_Screen1.json by tools/lvgl_ui_gen.py
+#include "ui_Screen1.h"
 
+// how long the sensor event loop may wait for the GUI task to finish a frame
+#define UI_SENSOR_LOCK_TIMEOUT_MS 1000
+// lowest LVGL idle time in % at which the next screen is built ahead
+#define UI_PREWARM_MIN_IDLE 50
 
-///////////////////// VARIABLES ////////////////////
-lv_obj_t *ui_Screen1;
-lv_obj_t *ui_humiLabel;
-lv_obj_t *ui_tempLabel;
-lv_obj_t *ui_Labeldegree;
-lv_obj_t *ui_Labelpercent;
-lv_obj_t *ui_btempLabel;
-lv_obj_t *ui_timeLabel;
-lv_obj_t *ui_btempLabeldegree;
-lv_obj_t *ui_count;
-lv_obj_t *ui_countss;
+static const char *TAG = "lvgl_app";
 
 typedef struct _lv_refresh_detail
 {
     struct _lv_clock_detail
     {
-        lv_obj_t *time_label;
-        lv_obj_t *date_label;
-        lv_obj_t *weekday_label;
+        lvgl_bind_t time;
+        lvgl_bind_t date;
+        lvgl_bind_t weekday;
+        lvgl_bind_t count;
     } lv_clock;
     struct _lv_humiture_detail
     {
-        lv_obj_t *ui_humiArc;
-        lv_obj_t *ui_tempArc;
-        lv_obj_t *ui_tempLabelnum;
-        lv_obj_t *ui_humiLabelnum;
-        lv_obj_t *ui_btempLabelnum;
+        lvgl_bind_t humi_arc;
+        lvgl_bind_t temp_arc;
+        lvgl_bind_t temp_num;
+        lvgl_bind_t humi_num;
+        lvgl_bind_t btemp_num;
     } lv_humiture;
     all_signals_t *signal;
 } lv_refresh_t;
 
 static lv_refresh_t lv_refresh = {0};
 
+// the screens are built on their first show, see lvgl_hw_screen.h
+static lvgl_screen_mgr_t ui_screens;
+static int ui_Screen1_id = LVGL_SCREEN_NONE;
+
+#ifdef CONFIG_LVGL_STATIC_LAYER
+static lvgl_static_layer_t ui_Screen1_static;
+// Parts of ui_Screen1 which never change. The track of the temperature arc is left out:
+// its rounded ends are drawn over the start of the humidity indicator.
+static lvgl_static_part_t ui_Screen1_static_parts[8];
+#endif
+
 static void refresh_task_callback(lv_timer_t *timer)
 {
 
@@ -60,6 +75,7 @@ static void refresh_task_callback(lv_timer_t *timer)
     static time_t current_time;
     static time_t examtime = 1671843600;
     static struct tm *time_info;
+    char text[LVGL_BIND_TEXT_LEN];
 
     current_time = time(NULL);
 
@@ -73,300 +89,96 @@ static void refresh_task_callback(lv_timer_t *timer)
     int minutes = time_info->tm_min;
     int second = time_info->tm_sec;
 
-    static sensor_data_t lvgl_recv_data ;
     lv_refresh_t *refresh = (lv_refresh_t *)(timer->user_data);
-    xQueuePeekFromISR(refresh->signal->xQueueSenData, &lvgl_recv_data);
 
     if (timer != NULL && refresh != NULL)
     {
-        lv_label_set_text_fmt(refresh->lv_clock.time_label, "%02d:%02d:%02d", hour, minutes, second);
-        lv_label_set_text_fmt(refresh->lv_clock.date_label, "%d-%02d-%02d", year, month, day);
-        lv_label_set_text_fmt(refresh->lv_clock.weekday_label, "%s", week_day[weekday]);
-        lv_label_set_text_fmt(ui_count, "%ld", (uint32_t)difftime(examtime, current_time));
-
-        lv_label_set_text_fmt(refresh->lv_humiture.ui_tempLabelnum, "%0.3f", lvgl_recv_data.humiture.temperature);
-        lv_label_set_text_fmt(refresh->lv_humiture.ui_humiLabelnum, "%0.3f", lvgl_recv_data.humiture.humidity);
-        lv_label_set_text_fmt(refresh->lv_humiture.ui_btempLabelnum, "%0.3f", lvgl_recv_data.humiture.body_temperature); 
-        lv_arc_set_value(refresh->lv_humiture.ui_tempArc, (int)lvgl_recv_data.humiture.temperature);
-        lv_arc_set_value(refresh->lv_humiture.ui_humiArc, (int)lvgl_recv_data.humiture.humidity);
-
+        // only the clock is polled, the bindings drop what did not change (date, weekday)
+        lv_snprintf(text, sizeof(text), "%02d:%02d:%02d", hour, minutes, second);
+        lvgl_bind_set_text(&refresh->lv_clock.time, text);
+        lv_snprintf(text, sizeof(text), "%d-%02d-%02d", year, month, day);
+        lvgl_bind_set_text(&refresh->lv_clock.date, text);
+        lvgl_bind_set_text(&refresh->lv_clock.weekday, week_day[weekday]);
+        lv_snprintf(text, sizeof(text), "%" PRIu32, (uint32_t)difftime(examtime, current_time));
+        lvgl_bind_set_text(&refresh->lv_clock.count, text);
     }
 }
 
-void ui_Screen1_screen_init(void)
+static void ui_humiture_refresh(lv_refresh_t *refresh, const humiture_t *humiture)
 {
+    lvgl_bind_set_float(&refresh->lv_humiture.temp_num, humiture->temperature);
+    lvgl_bind_set_float(&refresh->lv_humiture.humi_num, humiture->humidity);
+    lvgl_bind_set_float(&refresh->lv_humiture.btemp_num, humiture->body_temperature);
+    lvgl_bind_set_float(&refresh->lv_humiture.temp_arc, humiture->temperature);
+    lvgl_bind_set_float(&refresh->lv_humiture.humi_arc, humiture->humidity);
+}
 
-    // ui_Screen1
-
-    ui_Screen1 = lv_obj_create(NULL);
-
-    lv_obj_clear_flag(ui_Screen1, LV_OBJ_FLAG_SCROLLABLE);
-
-    // ui_humiArc
-
-    lv_refresh.lv_humiture.ui_humiArc = lv_arc_create(ui_Screen1);
-
-    lv_obj_set_width(lv_refresh.lv_humiture.ui_humiArc, 240);
-    lv_obj_set_height(lv_refresh.lv_humiture.ui_humiArc, 240);
-
-    lv_obj_set_x(lv_refresh.lv_humiture.ui_humiArc, 0);
-    lv_obj_set_y(lv_refresh.lv_humiture.ui_humiArc, 0);
-
-    lv_obj_set_align(lv_refresh.lv_humiture.ui_humiArc, LV_ALIGN_CENTER);
-
-    lv_obj_clear_flag(lv_refresh.lv_humiture.ui_humiArc, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_PRESS_LOCK | LV_OBJ_FLAG_CLICK_FOCUSABLE |
-                                                             LV_OBJ_FLAG_GESTURE_BUBBLE);
-
-    lv_arc_set_range(lv_refresh.lv_humiture.ui_humiArc, 0, 100);
-    lv_arc_set_value(lv_refresh.lv_humiture.ui_humiArc, 10);
-    lv_arc_set_bg_angles(lv_refresh.lv_humiture.ui_humiArc, 270, 90);
-
-    lv_obj_set_style_shadow_spread(lv_refresh.lv_humiture.ui_humiArc, 120, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    // lv_obj_set_style_arc_color(lv_refresh.lv_humiture.ui_humiArc, lv_color_hex(0x00FF68), LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_arc_opa(lv_refresh.lv_humiture.ui_humiArc, 255, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-
-    lv_obj_set_style_bg_color(lv_refresh.lv_humiture.ui_humiArc, lv_color_hex(0xFFFFFF), LV_PART_KNOB | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(lv_refresh.lv_humiture.ui_humiArc, 255, LV_PART_KNOB | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_left(lv_refresh.lv_humiture.ui_humiArc, 0, LV_PART_KNOB | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_right(lv_refresh.lv_humiture.ui_humiArc, 0, LV_PART_KNOB | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_top(lv_refresh.lv_humiture.ui_humiArc, 0, LV_PART_KNOB | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_bottom(lv_refresh.lv_humiture.ui_humiArc, 0, LV_PART_KNOB | LV_STATE_DEFAULT);
-
-    // ui_tempArc
-
-    lv_refresh.lv_humiture.ui_tempArc = lv_arc_create(ui_Screen1);
-
-    lv_obj_set_width(lv_refresh.lv_humiture.ui_tempArc, 240);
-    lv_obj_set_height(lv_refresh.lv_humiture.ui_tempArc, 240);
-
-    lv_obj_set_x(lv_refresh.lv_humiture.ui_tempArc, 0);
-    lv_obj_set_y(lv_refresh.lv_humiture.ui_tempArc, 0);
-
-    lv_obj_set_align(lv_refresh.lv_humiture.ui_tempArc, LV_ALIGN_CENTER);
-
-    lv_obj_clear_flag(lv_refresh.lv_humiture.ui_tempArc, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_PRESS_LOCK | LV_OBJ_FLAG_CLICK_FOCUSABLE |
-                                      LV_OBJ_FLAG_GESTURE_BUBBLE);
-
-    lv_arc_set_range(lv_refresh.lv_humiture.ui_tempArc, -25, 60);
-    lv_arc_set_value(lv_refresh.lv_humiture.ui_tempArc, -20);
-    lv_arc_set_bg_angles(lv_refresh.lv_humiture.ui_tempArc, 90, 270);
-
-    lv_obj_set_style_arc_color(lv_refresh.lv_humiture.ui_tempArc, lv_color_hex(0x00D3FF), LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_arc_opa(lv_refresh.lv_humiture.ui_tempArc, 255, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-
-    lv_obj_set_style_bg_color(lv_refresh.lv_humiture.ui_tempArc, lv_color_hex(0xFFFFFF), LV_PART_KNOB | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(lv_refresh.lv_humiture.ui_tempArc, 255, LV_PART_KNOB | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_left(lv_refresh.lv_humiture.ui_tempArc, 0, LV_PART_KNOB | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_right(lv_refresh.lv_humiture.ui_tempArc, 0, LV_PART_KNOB | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_top(lv_refresh.lv_humiture.ui_tempArc, 0, LV_PART_KNOB | LV_STATE_DEFAULT);
-    lv_obj_set_style_pad_bottom(lv_refresh.lv_humiture.ui_tempArc, 0, LV_PART_KNOB | LV_STATE_DEFAULT);
-
-    // ui_humiLabel
-
-    ui_humiLabel = lv_label_create(ui_Screen1);
-
-    lv_obj_set_width(ui_humiLabel, LV_SIZE_CONTENT);
-    lv_obj_set_height(ui_humiLabel, LV_SIZE_CONTENT);
-
-    lv_obj_set_x(ui_humiLabel, 41);
-    lv_obj_set_y(ui_humiLabel, -45);
-
-    lv_obj_set_align(ui_humiLabel, LV_ALIGN_CENTER);
-
-    lv_label_set_text(ui_humiLabel, "humi");
-
-    lv_obj_clear_flag(ui_humiLabel, LV_OBJ_FLAG_PRESS_LOCK | LV_OBJ_FLAG_CLICK_FOCUSABLE | LV_OBJ_FLAG_GESTURE_BUBBLE |
-                                        LV_OBJ_FLAG_SNAPPABLE);
-
-    lv_obj_set_style_text_font(ui_humiLabel, &lv_font_montserrat_24, LV_PART_MAIN | LV_STATE_DEFAULT);
-
-    // ui_tempLabel
-
-    ui_tempLabel = lv_label_create(ui_Screen1);
-
-    lv_obj_set_width(ui_tempLabel, LV_SIZE_CONTENT);
-    lv_obj_set_height(ui_tempLabel, LV_SIZE_CONTENT);
-
-    lv_obj_set_x(ui_tempLabel, -40);
-    lv_obj_set_y(ui_tempLabel, -45);
-
-    lv_obj_set_align(ui_tempLabel, LV_ALIGN_CENTER);
-
-    lv_label_set_text(ui_tempLabel, "temp");
-
-    lv_obj_clear_flag(ui_tempLabel, LV_OBJ_FLAG_PRESS_LOCK | LV_OBJ_FLAG_CLICK_FOCUSABLE | LV_OBJ_FLAG_GESTURE_BUBBLE |
-                                        LV_OBJ_FLAG_SNAPPABLE);
-
-    lv_obj_set_style_text_font(ui_tempLabel, &lv_font_montserrat_24, LV_PART_MAIN | LV_STATE_DEFAULT);
-
-    // ui_tempLabelnum
-
-    lv_refresh.lv_humiture.ui_tempLabelnum = lv_label_create(ui_Screen1);
-
-    lv_obj_set_width(lv_refresh.lv_humiture.ui_tempLabelnum, 40);
-    lv_obj_set_height(lv_refresh.lv_humiture.ui_tempLabelnum, 50);
-
-    lv_obj_set_x(lv_refresh.lv_humiture.ui_tempLabelnum, -39);
-    lv_obj_set_y(lv_refresh.lv_humiture.ui_tempLabelnum, 0);
-
-    lv_obj_set_align(lv_refresh.lv_humiture.ui_tempLabelnum, LV_ALIGN_CENTER);
-
-    lv_label_set_text(lv_refresh.lv_humiture.ui_tempLabelnum, "20.000");
-
-    lv_obj_clear_flag(lv_refresh.lv_humiture.ui_tempLabelnum, LV_OBJ_FLAG_PRESS_LOCK | LV_OBJ_FLAG_CLICK_FOCUSABLE | LV_OBJ_FLAG_GESTURE_BUBBLE |
-                                           LV_OBJ_FLAG_SNAPPABLE);
-
-    lv_obj_set_style_text_font(lv_refresh.lv_humiture.ui_tempLabelnum, &lv_font_montserrat_20, LV_PART_MAIN | LV_STATE_DEFAULT);
-
-    // ui_humiLabelnum
-
-    lv_refresh.lv_humiture.ui_humiLabelnum = lv_label_create(ui_Screen1);
-
-    lv_obj_set_width(lv_refresh.lv_humiture.ui_humiLabelnum, 40);
-    lv_obj_set_height(lv_refresh.lv_humiture.ui_humiLabelnum, 50);
-
-    lv_obj_set_x(lv_refresh.lv_humiture.ui_humiLabelnum, 43);
-    lv_obj_set_y(lv_refresh.lv_humiture.ui_humiLabelnum, 0);
-
-    lv_obj_set_align(lv_refresh.lv_humiture.ui_humiLabelnum, LV_ALIGN_CENTER);
-
-    lv_label_set_text(lv_refresh.lv_humiture.ui_humiLabelnum, "50.000");
-
-    lv_obj_set_style_text_font(lv_refresh.lv_humiture.ui_humiLabelnum, &lv_font_montserrat_20, LV_PART_MAIN | LV_STATE_DEFAULT);
-
-    // ui_Labeldegree
-
-    ui_Labeldegree = lv_label_create(ui_Screen1);
-
-    lv_obj_set_width(ui_Labeldegree, LV_SIZE_CONTENT);
-    lv_obj_set_height(ui_Labeldegree, LV_SIZE_CONTENT);
-
-    lv_obj_set_x(ui_Labeldegree, -2);
-    lv_obj_set_y(ui_Labeldegree, 8);
-
-    lv_obj_set_align(ui_Labeldegree, LV_ALIGN_CENTER);
-
-    lv_label_set_text(ui_Labeldegree, "C");
-    lv_obj_set_style_text_font(ui_Labeldegree, &lv_font_dejavu_16_persian_hebrew, LV_PART_MAIN | LV_STATE_DEFAULT);
-
-    // ui_Labelpercent
-
-    ui_Labelpercent = lv_label_create(ui_Screen1);
-
-    lv_obj_set_width(ui_Labelpercent, LV_SIZE_CONTENT);
-    lv_obj_set_height(ui_Labelpercent, LV_SIZE_CONTENT);
-
-    lv_obj_set_x(ui_Labelpercent, 80);
-    lv_obj_set_y(ui_Labelpercent, 8);
-
-    lv_obj_set_align(ui_Labelpercent, LV_ALIGN_CENTER);
-
-    lv_label_set_text(ui_Labelpercent, "%");
-
-    // ui_btempLabel
-
-    ui_btempLabel = lv_label_create(ui_Screen1);
-
-    lv_obj_set_width(ui_btempLabel, LV_SIZE_CONTENT);
-    lv_obj_set_height(ui_btempLabel, LV_SIZE_CONTENT);
-
-    lv_obj_set_x(ui_btempLabel, 0);
-    lv_obj_set_y(ui_btempLabel, 30);
-
-    lv_obj_set_align(ui_btempLabel, LV_ALIGN_CENTER);
-
-    lv_label_set_text(ui_btempLabel, "Feels Like");
-
-    // ui_btempLabelnum
-
-    lv_refresh.lv_humiture.ui_btempLabelnum = lv_label_create(ui_Screen1);
-
-    lv_obj_set_width(lv_refresh.lv_humiture.ui_btempLabelnum, LV_SIZE_CONTENT);
-    lv_obj_set_height(lv_refresh.lv_humiture.ui_btempLabelnum, LV_SIZE_CONTENT);
-
-    lv_obj_set_x(lv_refresh.lv_humiture.ui_btempLabelnum, 2);
-    lv_obj_set_y(lv_refresh.lv_humiture.ui_btempLabelnum, 53);
-
-    lv_obj_set_align(lv_refresh.lv_humiture.ui_btempLabelnum, LV_ALIGN_CENTER);
-
-    lv_label_set_text(lv_refresh.lv_humiture.ui_btempLabelnum, "25.000");
-
-    lv_obj_set_style_text_font(lv_refresh.lv_humiture.ui_btempLabelnum, &lv_font_montserrat_18, LV_PART_MAIN | LV_STATE_DEFAULT);
-
-    // ui_btempLabeldegree
-
-    ui_btempLabeldegree = lv_label_create(ui_Screen1);
-
-    lv_obj_set_width(ui_btempLabeldegree, LV_SIZE_CONTENT);
-    lv_obj_set_height(ui_btempLabeldegree, LV_SIZE_CONTENT);
-
-    lv_obj_set_x(ui_btempLabeldegree, 48);
-    lv_obj_set_y(ui_btempLabeldegree, 53);
-
-    lv_obj_set_align(ui_btempLabeldegree, LV_ALIGN_CENTER);
-
-    lv_label_set_text(ui_btempLabeldegree, "C");
-
-    // ui_timeLabel
-
-    /*Time display*/
-    lv_refresh.lv_clock.time_label = lv_label_create(ui_Screen1);
-    lv_obj_set_width(lv_refresh.lv_clock.time_label, 100);
-    lv_obj_set_height(lv_refresh.lv_clock.time_label, 20);
-
-    lv_obj_set_x(lv_refresh.lv_clock.time_label, 3);
-    lv_obj_set_y(lv_refresh.lv_clock.time_label, -62);
-
-    lv_obj_set_align(lv_refresh.lv_clock.time_label, LV_ALIGN_CENTER);
-
-    /*Date display*/
-    lv_refresh.lv_clock.date_label = lv_label_create(ui_Screen1);
-    lv_obj_set_width(lv_refresh.lv_clock.date_label, 100);
-    lv_obj_set_height(lv_refresh.lv_clock.date_label, 20);
-
-    lv_obj_set_x(lv_refresh.lv_clock.date_label, 10);
-    lv_obj_set_y(lv_refresh.lv_clock.date_label, -80);
-
-    lv_obj_set_align(lv_refresh.lv_clock.date_label, LV_ALIGN_CENTER);
-
-    /*Week display*/
-    lv_refresh.lv_clock.weekday_label = lv_label_create(ui_Screen1);
-    lv_obj_set_width(lv_refresh.lv_clock.weekday_label, 100);
-    lv_obj_set_height(lv_refresh.lv_clock.weekday_label, 20);
-
-    lv_obj_set_x(lv_refresh.lv_clock.weekday_label, 70);
-    lv_obj_set_y(lv_refresh.lv_clock.weekday_label, -62);
-
-    lv_obj_set_align(lv_refresh.lv_clock.weekday_label, LV_ALIGN_CENTER);
-
-    // ui_count
-
-    ui_count = lv_label_create(ui_Screen1);
-
-    lv_obj_set_width(ui_count, LV_SIZE_CONTENT);
-    lv_obj_set_height(ui_count, LV_SIZE_CONTENT);
-
-    lv_obj_set_x(ui_count, -7);
-    lv_obj_set_y(ui_count, 74);
-
-    lv_obj_set_align(ui_count, LV_ALIGN_CENTER);
+static void ui_sensor_event_handler(void *handler_args, esp_event_base_t base, int32_t id, void *event_data)
+{
+    lv_refresh_t *refresh = (lv_refresh_t *)handler_args;
+    const sensor_data_t *sensor_data = (const sensor_data_t *)event_data;
 
-    lv_label_set_text(ui_count, "00000000");
+    // called from the sensor event loop task, LVGL may only be touched with the GUI mutex held
+    if (!gui_lock(UI_SENSOR_LOCK_TIMEOUT_MS))
+    {
+        ESP_LOGW(TAG, "GUI busy, humiture update dropped");
+        return;
+    }
+    ui_humiture_refresh(refresh, &sensor_data->humiture);
+    gui_unlock();
 
-    // ui_countss
+    lvgl_bind_stats_t stats;
+    lvgl_bind_get_stats(&stats);
+    ESP_LOGD(TAG, "bindings: %" PRIu32 " updates, %" PRIu32 " invalidations, %" PRIu32 " suppressed",
+             stats.updates, stats.invalidations, stats.suppressed);
+}
 
-    ui_countss = lv_label_create(ui_Screen1);
+static void ui_bind_init(lv_refresh_t *refresh)
+{
+    lvgl_bind_init(&refresh->lv_clock.time, ui_timeLabel, NULL, 1);
+    lvgl_bind_init(&refresh->lv_clock.date, ui_dateLabel, NULL, 1);
+    lvgl_bind_init(&refresh->lv_clock.weekday, ui_weekdayLabel, NULL, 1);
+    lvgl_bind_init(&refresh->lv_clock.count, ui_count, NULL, 1);
+
+    // numeric labels with 1 decimal, they are given the values in 0.1 steps
+    lvgl_bind_init(&refresh->lv_humiture.temp_num, ui_tempLabelnum, NULL, 0.1f);
+    lvgl_bind_init(&refresh->lv_humiture.humi_num, ui_humiLabelnum, NULL, 0.1f);
+    lvgl_bind_init(&refresh->lv_humiture.btemp_num, ui_btempLabelnum, NULL, 0.1f);
+    lvgl_bind_init(&refresh->lv_humiture.temp_arc, ui_tempArc, NULL, 1);
+    lvgl_bind_init(&refresh->lv_humiture.humi_arc, ui_humiArc, NULL, 1);
+}
 
-    lv_obj_set_width(ui_countss, LV_SIZE_CONTENT);
-    lv_obj_set_height(ui_countss, LV_SIZE_CONTENT);
+// builder of the screen manager, ui_Screen1 is pinned as the sensor bindings stay on it
+static lv_obj_t *ui_Screen1_build(void *user_data)
+{
+    ui_Screen1_screen_init();
+    ui_bind_init((lv_refresh_t *)user_data);
+    return ui_Screen1;
+}
 
-    lv_obj_set_x(ui_countss, 50);
-    lv_obj_set_y(ui_countss, 73);
+#ifdef CONFIG_LVGL_STATIC_LAYER
+static void ui_static_init(void)
+{
+    lv_obj_t *static_objs[] = {ui_humiLabel, ui_tempLabel, ui_Labeldegree, ui_Labelpercent,
+                               ui_btempLabel, ui_btempLabeldegree, ui_countss};
+    uint32_t cnt = 0;
 
-    lv_obj_set_align(ui_countss, LV_ALIGN_CENTER);
+    for (uint32_t i = 0; i < sizeof(static_objs) / sizeof(static_objs[0]); i++)
+    {
+        ui_Screen1_static_parts[cnt].obj = static_objs[i];
+        ui_Screen1_static_parts[cnt].part = LV_PART_ANY;
+        cnt++;
+    }
+    ui_Screen1_static_parts[cnt].obj = ui_humiArc;
+    ui_Screen1_static_parts[cnt].part = LV_PART_MAIN;
+    cnt++;
 
-    lv_label_set_text(ui_countss, "sec");
+    if (!lvgl_static_layer_create(&ui_Screen1_static, ui_Screen1, ui_Screen1_static_parts, cnt))
+    {
+        ESP_LOGW(TAG, "no memory for the static layer, drawing every object");
+    }
 }
+#endif
 
 void ui_init(all_signals_t *signal)
 {
@@ -379,7 +191,30 @@ void ui_init(all_signals_t *signal)
     if (task_timer != NULL)
     {
         lv_disp_set_theme(dispp, theme);
-        ui_Screen1_screen_init();
-        lv_disp_load_scr(ui_Screen1);
+        lvgl_screen_mgr_init(&ui_screens, CONFIG_LVGL_SCREEN_MIN_FREE);
+        lvgl_screen_set_prewarm_period(&ui_screens, CONFIG_LVGL_SCREEN_PREWARM_PERIOD_MS, UI_PREWARM_MIN_IDLE);
+        const lvgl_screen_desc_t screen1 = {
+            .name = "ui_Screen1",
+            .build = ui_Screen1_build,
+            .user_data = &lv_refresh,
+            .next = LVGL_SCREEN_NONE,
+            .pinned = true,
+        };
+        ui_Screen1_id = lvgl_screen_register(&ui_screens, &screen1);
+        lvgl_screen_show(&ui_screens, ui_Screen1_id, LV_SCR_LOAD_ANIM_NONE, 0);
+        ESP_LOGI(TAG, "ui_Screen1 built in %" PRIu32 " us, %" PRIu32 " bytes of the LVGL heap",
+                 ui_screens.screens[ui_Screen1_id].build_us, ui_screens.screens[ui_Screen1_id].mem_size);
+#ifdef CONFIG_LVGL_STATIC_LAYER
+        ui_static_init();
+#endif
+
+        // show the last reading right away, then follow the data ready events of the sensor hub
+        static sensor_data_t lvgl_recv_data;
+        if (xQueuePeek(signal->xQueueSenData, &lvgl_recv_data, 0) == pdTRUE)
+        {
+            ui_humiture_refresh(&lv_refresh, &lvgl_recv_data.humiture);
+        }
+        ESP_ERROR_CHECK(iot_sensor_handler_register_with_type(HUMITURE_ID, SENSOR_TEMP_HUMI_DATA_READY,
+                                                              ui_sensor_event_handler, &lv_refresh, NULL));
     }
 }
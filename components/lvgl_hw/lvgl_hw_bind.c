@@ -0,0 +1,114 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "lvgl_hw_bind.h"
+
+static lvgl_bind_stats_t bind_stats = {0};
+
+void lvgl_bind_init(lvgl_bind_t *bind, lv_obj_t *obj, const char *fmt, float resolution)
+{
+    bind->obj = obj;
+    // lvgl_app.c passes NULL for every binding, a label may still get a float to format
+    bind->fmt = fmt != NULL ? fmt : LVGL_BIND_DEFAULT_FMT;
+    bind->resolution = resolution > 0 ? resolution : 1.0f;
+    bind->steps = 0;
+    bind->valid = false;
+    bind->text[0] = '\0';
+}
+
+// set the label if the text differs from the one it shows
+static bool bind_apply_text(lvgl_bind_t *bind, const char *text)
+{
+    if (bind->valid && strcmp(bind->text, text) == 0)
+    {
+        bind_stats.suppressed++;
+        return false;
+    }
+
+    snprintf(bind->text, sizeof(bind->text), "%s", text);
+    bind->valid = true;
+    // the binding keeps the string alive, the label needs no copy of its own
+    lv_label_set_text_static(bind->obj, bind->text);
+    bind_stats.invalidations++;
+    return true;
+}
+
+bool lvgl_bind_set_float(lvgl_bind_t *bind, float value)
+{
+    bind_stats.updates++;
+
+    if (!isfinite(value))
+    {
+        bind_stats.suppressed++;
+        return false;
+    }
+
+    // values within the same display step look the same, skip formatting and layout entirely
+    int32_t steps = (int32_t)lroundf(value / bind->resolution);
+    if (bind->valid && steps == bind->steps)
+    {
+        bind_stats.suppressed++;
+        return false;
+    }
+    bind->steps = steps;
+
+    float shown = (float)steps * bind->resolution;
+    if (lv_obj_check_type(bind->obj, &lv_arc_class))
+    {
+        int16_t arc_value = (int16_t)lroundf(shown);
+        if (bind->valid && lv_arc_get_value(bind->obj) == arc_value)
+        {
+            bind_stats.suppressed++;
+            return false;
+        }
+        bind->valid = true;
+        lv_arc_set_value(bind->obj, arc_value);
+        bind_stats.invalidations++;
+        return true;
+    }
+
+#if LV_USE_NUMLABEL
+    // the numeric label shows the steps as a fixed-point number and redraws only the changed digits
+    if (lv_obj_check_type(bind->obj, &lv_numlabel_class))
+    {
+        bind->valid = true;
+        lv_numlabel_set_value(bind->obj, steps);
+        bind_stats.invalidations++;
+        return true;
+    }
+#endif
+
+    char text[LVGL_BIND_TEXT_LEN];
+    snprintf(text, sizeof(text), bind->fmt, (double)shown);
+    return bind_apply_text(bind, text);
+}
+
+bool lvgl_bind_set_text(lvgl_bind_t *bind, const char *text)
+{
+    bind_stats.updates++;
+    return bind_apply_text(bind, text);
+}
+
+void lvgl_bind_get_stats(lvgl_bind_stats_t *stats)
+{
+    *stats = bind_stats;
+}
+
+void lvgl_bind_reset_stats(void)
+{
+    memset(&bind_stats, 0, sizeof(bind_stats));
+}
@@ -0,0 +1,116 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include "lvgl_hw_flush.h"
+
+static uint32_t flush_in_flight(const lvgl_flush_queue_t *queue)
+{
+    return queue->queued - __atomic_load_n(&queue->done, __ATOMIC_ACQUIRE);
+}
+
+bool lvgl_flush_queue_init(lvgl_flush_queue_t *queue, lv_color_t *buf, uint32_t buf_px, uint32_t slice_cnt,
+                           lv_coord_t hor_res, lvgl_flush_send_cb_t send_cb, lvgl_flush_wait_cb_t wait_cb,
+                           void *user_ctx)
+{
+    memset(queue, 0, sizeof(*queue));
+    if (slice_cnt == 0 || slice_cnt > LVGL_FLUSH_MAX_SLICES || buf_px / slice_cnt < (uint32_t)hor_res)
+    {
+        return false;
+    }
+
+    queue->slice_cnt = slice_cnt;
+    queue->slice_px = buf_px / slice_cnt;
+    for (uint32_t i = 0; i < slice_cnt; i++)
+    {
+        queue->slices[i].buf = buf + i * queue->slice_px;
+    }
+    queue->send_cb = send_cb;
+    queue->wait_cb = wait_cb;
+    queue->user_ctx = user_ctx;
+    return true;
+}
+
+// Copy the rows of an area starting at `src`, `stride` pixels apart, into slices and send them
+static void flush_queue_push_rows(lvgl_flush_queue_t *queue, const lv_area_t *area, const lv_color_t *src,
+                                  uint32_t stride)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t slice_rows = (lv_coord_t)(queue->slice_px / (uint32_t)w);
+
+    for (lv_coord_t y = area->y1; y <= area->y2; y += slice_rows)
+    {
+        while (flush_in_flight(queue) >= queue->slice_cnt)
+        {
+            queue->stats.waits++;
+            queue->wait_cb(queue->user_ctx);
+        }
+
+        // the slices are sent and released in order, the next free one follows the last queued
+        lvgl_flush_slice_t *slice = &queue->slices[queue->queued % queue->slice_cnt];
+        slice->area.x1 = area->x1;
+        slice->area.x2 = area->x2;
+        slice->area.y1 = y;
+        slice->area.y2 = LV_MIN(y + slice_rows - 1, area->y2);
+        lv_coord_t h = lv_area_get_height(&slice->area);
+        const lv_color_t *row = src + (uint32_t)(y - area->y1) * stride;
+        if (stride == (uint32_t)w)
+        {
+            memcpy(slice->buf, row, (uint32_t)w * (uint32_t)h * sizeof(lv_color_t));
+        }
+        else
+        {
+            lv_color_t *dst = slice->buf;
+            for (lv_coord_t i = 0; i < h; i++)
+            {
+                memcpy(dst, row, (uint32_t)w * sizeof(lv_color_t));
+                dst += w;
+                row += stride;
+            }
+        }
+
+        __atomic_add_fetch(&queue->queued, 1, __ATOMIC_RELEASE);
+        queue->send_cb(slice, queue->user_ctx);
+    }
+}
+
+void lvgl_flush_queue_push(lvgl_flush_queue_t *queue, const lv_area_t *area, const lv_color_t *color_map)
+{
+    flush_queue_push_rows(queue, area, color_map, (uint32_t)lv_area_get_width(area));
+}
+
+void lvgl_flush_queue_push_fb(lvgl_flush_queue_t *queue, const lv_area_t *area, const lv_color_t *fb,
+                              lv_coord_t fb_w)
+{
+    flush_queue_push_rows(queue, area, fb + (uint32_t)area->y1 * (uint32_t)fb_w + (uint32_t)area->x1,
+                          (uint32_t)fb_w);
+}
+
+void lvgl_flush_queue_done(lvgl_flush_queue_t *queue)
+{
+    const lvgl_flush_slice_t *slice = &queue->slices[queue->done % queue->slice_cnt];
+    queue->stats.slices++;
+    queue->stats.bytes += lv_area_get_size(&slice->area) * sizeof(lv_color_t);
+    __atomic_add_fetch(&queue->done, 1, __ATOMIC_RELEASE);
+}
+
+bool lvgl_flush_queue_is_idle(const lvgl_flush_queue_t *queue)
+{
+    return flush_in_flight(queue) == 0;
+}
+
+void lvgl_flush_queue_get_stats(const lvgl_flush_queue_t *queue, lvgl_flush_stats_t *stats)
+{
+    *stats = queue->stats;
+}
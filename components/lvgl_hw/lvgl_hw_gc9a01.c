@@ -25,9 +25,15 @@
 #include "driver/gpio.h"
 #include "esp_log.h"
 #include "esp_check.h"
+#include "esp_timer.h"
+#include "lvgl_hw_gc9a01.h"
 
 static const char *TAG = "gc9a01_hw";
 
+// rows of the frame memory, a RASET window reaches the last one so the next band can follow with RAMWR-continue
+#define GC9A01_GRAM_ROWS 240
+#define GC9A01_CMD_RAMWRC 0x3C
+
 static esp_err_t panel_gc9a01_del(esp_lcd_panel_t *panel);
 static esp_err_t panel_gc9a01_reset(esp_lcd_panel_t *panel);
 static esp_err_t panel_gc9a01_init(esp_lcd_panel_t *panel);
@@ -49,8 +55,20 @@ typedef struct _gcd9a01_panel_details
     unsigned int bits_per_pixel;
     uint8_t madctl_val; // save current value of LCD_CMD_MADCTL register
     uint8_t colmod_cal; // save surrent value of LCD_CMD_COLMOD register
+    // address window of the frame memory, win_x1 < 0 if unknown (after reset, init or MADCTL)
+    int win_x1;
+    int win_x2;
+    int next_y; // row a RAMWR-continue writes next, < 0 if unknown
+    gc9a01_panel_stats_t stats;
 } gc9a01_panel_t;
 
+static void panel_gc9a01_forget_window(gc9a01_panel_t *gc9a01)
+{
+    gc9a01->win_x1 = -1;
+    gc9a01->win_x2 = -1;
+    gc9a01->next_y = -1;
+}
+
 esp_err_t esp_lcd_new_panel_gc9a01(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *panel_dev_config, esp_lcd_panel_handle_t *ret_panel)
 {
     esp_err_t ret = ESP_OK;
@@ -98,6 +116,7 @@ esp_err_t esp_lcd_new_panel_gc9a01(const esp_lcd_panel_io_handle_t io, const esp
     gc9a01->bits_per_pixel = panel_dev_config->bits_per_pixel;
     gc9a01->reset_gpio_num = panel_dev_config->reset_gpio_num;
     gc9a01->reset_level = panel_dev_config->flags.reset_active_high;
+    panel_gc9a01_forget_window(gc9a01);
     gc9a01->base.del = panel_gc9a01_del;
     gc9a01->base.reset = panel_gc9a01_reset;
     gc9a01->base.init = panel_gc9a01_init;
@@ -142,6 +161,7 @@ static esp_err_t panel_gc9a01_reset(esp_lcd_panel_t *panel)
     gc9a01_panel_t *gc9a01 = __containerof(panel, gc9a01_panel_t, base);
     esp_lcd_panel_io_handle_t io = gc9a01->io;
 
+    panel_gc9a01_forget_window(gc9a01);
     // perform hardware reset
     if (gc9a01->reset_gpio_num >= 0)
     {
@@ -220,6 +240,7 @@ static esp_err_t panel_gc9a01_init(esp_lcd_panel_t *panel)
     gc9a01_panel_t *gc9a01 = __containerof(panel, gc9a01_panel_t, base);
     esp_lcd_panel_io_handle_t io = gc9a01->io;
 
+    panel_gc9a01_forget_window(gc9a01);
     // LCD goes into sleep mode and display will be turned off after power on reset, exit sleep mode first
     esp_lcd_panel_io_tx_param(io, LCD_CMD_SLPOUT, NULL, 0);
     vTaskDelay(pdMS_TO_TICKS(100));
@@ -249,34 +270,71 @@ static esp_err_t panel_gc9a01_draw_bitmap(esp_lcd_panel_t *panel, int x_start, i
     gc9a01_panel_t *gc9a01 = __containerof(panel, gc9a01_panel_t, base);
     assert((x_start < x_end) && (y_start < y_end) && "start position must be smaller than end position");
     esp_lcd_panel_io_handle_t io = gc9a01->io;
+    int64_t start_us = esp_timer_get_time();
 
     x_start += gc9a01->x_gap;
     x_end += gc9a01->x_gap;
     y_start += gc9a01->y_gap;
     y_end += gc9a01->y_gap;
 
-    // define an area of frame memory where MCU can access
-    esp_lcd_panel_io_tx_param(io, LCD_CMD_CASET, (uint8_t[]){
-                                                     (x_start >> 8) & 0xFF,
-                                                     x_start & 0xFF,
-                                                     ((x_end - 1) >> 8) & 0xFF,
-                                                     (x_end - 1) & 0xFF,
-                                                 },
-                              4);
-    esp_lcd_panel_io_tx_param(io, LCD_CMD_RASET, (uint8_t[]){
-                                                     (y_start >> 8) & 0xFF,
-                                                     y_start & 0xFF,
-                                                     ((y_end - 1) >> 8) & 0xFF,
-                                                     (y_end - 1) & 0xFF,
-                                                 },
-                              4);
+    // define an area of frame memory where MCU can access, only what differs from the current window
+    if (x_start != gc9a01->win_x1 || x_end - 1 != gc9a01->win_x2)
+    {
+        esp_lcd_panel_io_tx_param(io, LCD_CMD_CASET, (uint8_t[]){
+                                                         (x_start >> 8) & 0xFF,
+                                                         x_start & 0xFF,
+                                                         ((x_end - 1) >> 8) & 0xFF,
+                                                         (x_end - 1) & 0xFF,
+                                                     },
+                                  4);
+        gc9a01->win_x1 = x_start;
+        gc9a01->win_x2 = x_end - 1;
+        gc9a01->next_y = -1;
+        gc9a01->stats.transactions++;
+    }
+    else
+    {
+        gc9a01->stats.caset_skipped++;
+    }
+
+    // a band right below the last one in the same columns continues where the last write stopped
+    int cmd = GC9A01_CMD_RAMWRC;
+    if (y_start != gc9a01->next_y)
+    {
+        esp_lcd_panel_io_tx_param(io, LCD_CMD_RASET, (uint8_t[]){
+                                                         (y_start >> 8) & 0xFF,
+                                                         y_start & 0xFF,
+                                                         ((GC9A01_GRAM_ROWS - 1) >> 8) & 0xFF,
+                                                         (GC9A01_GRAM_ROWS - 1) & 0xFF,
+                                                     },
+                                  4);
+        cmd = LCD_CMD_RAMWR;
+        gc9a01->stats.transactions++;
+    }
+    else
+    {
+        gc9a01->stats.raset_skipped++;
+    }
+
     // transfer frame buffer
     size_t len = (x_end - x_start) * (y_end - y_start) * gc9a01->bits_per_pixel / 8;
-    esp_lcd_panel_io_tx_color(io, LCD_CMD_RAMWR, color_data, len);
+    esp_lcd_panel_io_tx_color(io, cmd, color_data, len);
+    gc9a01->next_y = y_end;
+    gc9a01->stats.transactions++;
+    gc9a01->stats.flushes++;
+    gc9a01->stats.busy_us += (uint64_t)(esp_timer_get_time() - start_us);
 
     return ESP_OK;
 }
 
+esp_err_t esp_lcd_panel_gc9a01_get_stats(esp_lcd_panel_handle_t panel, gc9a01_panel_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(panel && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    gc9a01_panel_t *gc9a01 = __containerof(panel, gc9a01_panel_t, base);
+    *stats = gc9a01->stats;
+    return ESP_OK;
+}
+
 static esp_err_t panel_gc9a01_invert_color(esp_lcd_panel_t *panel, bool invert_color_data)
 {
     gc9a01_panel_t *gc9a01 = __containerof(panel, gc9a01_panel_t, base);
@@ -291,6 +349,8 @@ static esp_err_t panel_gc9a01_invert_color(esp_lcd_panel_t *panel, bool invert_c
         command = LCD_CMD_INVOFF;
     }
     esp_lcd_panel_io_tx_param(io, command, NULL, 0);
+    // a RAMWR-continue has to follow a memory write directly
+    panel_gc9a01_forget_window(gc9a01);
     return ESP_OK;
 }
 
@@ -315,6 +375,7 @@ static esp_err_t panel_gc9a01_mirror(esp_lcd_panel_t *panel, bool mirror_x, bool
         gc9a01->madctl_val &= ~LCD_CMD_MY_BIT;
     }
     esp_lcd_panel_io_tx_param(io, LCD_CMD_MADCTL, (uint8_t[]){gc9a01->madctl_val}, 1);
+    panel_gc9a01_forget_window(gc9a01);
     return ESP_OK;
 }
 
@@ -331,6 +392,7 @@ static esp_err_t panel_gc9a01_swap_xy(esp_lcd_panel_t *panel, bool swap_axes)
         gc9a01->madctl_val &= ~LCD_CMD_MV_BIT;
     }
     esp_lcd_panel_io_tx_param(io, LCD_CMD_MADCTL, (uint8_t[]){gc9a01->madctl_val}, 1);
+    panel_gc9a01_forget_window(gc9a01);
     return ESP_OK;
 }
 
@@ -356,5 +418,7 @@ static esp_err_t panel_gc9a01_disp_off(esp_lcd_panel_t *panel, bool off)
         command = LCD_CMD_DISPOFF;
     }
     esp_lcd_panel_io_tx_param(io, command, NULL, 0);
+    // a RAMWR-continue has to follow a memory write directly
+    panel_gc9a01_forget_window(gc9a01);
     return ESP_OK;
 }
@@ -14,6 +14,8 @@
 // limitations under the License.
 
 #include "math.h"
+#include <inttypes.h>
+#include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_timer.h"
@@ -29,8 +31,14 @@
 #include "esp_log.h"
 #include "lvgl_hw_gc9a01.h"
 #include "lvgl_hw_main_task.h"
+#include "lvgl_hw_round.h"
+#include "lvgl_hw_flush.h"
 #include "lvgl.h"
+#include "src/draw/sw/lv_draw_sw.h"
 #include "lvgl_app.h"
+#ifdef CONFIG_LVGL_DEMO_BENCHMARK
+#include "demos/lv_demos.h"
+#endif
 #include "driver/gpio.h"
 #include "main.h"
 
@@ -55,25 +63,278 @@ static const char *TAG = "gui_task";
 
 #define DISP_BUF_SIZE CONFIG_DISP_BUF_SIZE
 #define LVGL_TICK_PERIOD_MS CONFIG_LVGL_TICK_PERIOD_MS
+#define LVGL_TASK_MAX_SLEEP_MS CONFIG_LVGL_TASK_MAX_SLEEP_MS
+
+// the task running lv_timer_handler, woken by notifications
+static TaskHandle_t gui_task_self = NULL;
+
+// wakeups and busy time of the running one second window and of the last complete one
+static uint32_t gui_wakeups = 0;
+static uint64_t gui_busy_us = 0;
+static int64_t gui_window_start_us = 0;
+static gui_task_stats_t gui_stats_last = {0};
+// refreshed frames and pixel bytes sent to the panel in the running window
+static uint32_t gui_frames = 0;
+static uint32_t gui_flush_bytes = 0;
+// counters of the panel driver at the start of the running window
+static gc9a01_panel_stats_t gui_panel_stats_start = {0};
+#ifdef CONFIG_LCD_FLUSH_QUEUE
+static uint32_t gui_flush_waits_total = 0;
+#endif
+
+#ifdef CONFIG_LVGL_DEMO_BENCHMARK
+#define GUI_STATS_LOG ESP_LOGI
+#else
+#define GUI_STATS_LOG ESP_LOGD
+#endif
+
+#ifdef CONFIG_LV_USE_REFR_PROF
+// one second windows since the last frame phase table
+static uint32_t gui_prof_windows = 0;
+#endif
+
+#ifdef CONFIG_LV_USE_PARALLEL_RENDER
+// the worker drawing the other half of large areas on core 0 while gui_task draws on core 1
+static TaskHandle_t render_task_self = NULL;
+static SemaphoreHandle_t render_done = NULL;
+static SemaphoreHandle_t render_lock = NULL;
+static void (*render_job_cb)(void *param) = NULL;
+static void *render_job_param = NULL;
+#endif
+
+#ifdef CONFIG_LCD_ROUND_PANEL
+#define LCD_ROUND_FLUSH_BAND_ROWS CONFIG_LCD_ROUND_FLUSH_BAND_ROWS
+#endif
+
+#ifdef CONFIG_LCD_FLUSH_QUEUE
+#define LCD_FLUSH_SLICES CONFIG_LCD_FLUSH_SLICES
+// DMA slices between LVGL and the SPI bus, flush_task sends them while the GUI task renders on
+static lvgl_flush_queue_t flush_queue;
+static QueueHandle_t flush_slices = NULL;
+#elif defined(CONFIG_LCD_ROUND_PANEL)
+// color transfers of the current flush still in flight, LVGL is released when the last one is done
+static volatile uint32_t flush_pending = 0;
+#endif
 
 static bool notify_lvgl_flush_ready(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx)
 {
+#ifdef CONFIG_LCD_FLUSH_QUEUE
+    // release the slice, the GUI task may wait for it
+    lvgl_flush_queue_done(&flush_queue);
+#else
     lv_disp_drv_t *disp_driver = (lv_disp_drv_t *)user_ctx;
+#ifdef CONFIG_LCD_ROUND_PANEL
+    if (__atomic_sub_fetch(&flush_pending, 1, __ATOMIC_SEQ_CST) != 0)
+    {
+        return false;
+    }
+#endif
     lv_disp_flush_ready(disp_driver);
-    return false;
+#endif
+    BaseType_t high_task_wakeup = pdFALSE;
+    gui_task_wakeup_from_isr(&high_task_wakeup);
+    return high_task_wakeup == pdTRUE;
+}
+
+static void lvgl_wait_cb(lv_disp_drv_t *drv)
+{
+    // sleep instead of spinning while LVGL waits for the flush, notify_lvgl_flush_ready wakes us
+    ulTaskNotifyTake(pdTRUE, 1);
+}
+
+static void lvgl_monitor_cb(lv_disp_drv_t *drv, uint32_t time, uint32_t px)
+{
+    gui_frames++;
 }
 
+#ifdef CONFIG_LCD_FLUSH_QUEUE
+static void flush_send_cb(lvgl_flush_slice_t *slice, void *user_ctx)
+{
+    // never blocks, the queue holds all slices
+    xQueueSend(flush_slices, &slice, portMAX_DELAY);
+}
+
+static void flush_wait_cb(void *user_ctx)
+{
+    // notify_lvgl_flush_ready wakes the GUI task when a slice is done
+#ifdef CONFIG_LV_USE_REFR_PROF
+    int64_t wait_start_us = esp_timer_get_time();
+    ulTaskNotifyTake(pdTRUE, 1);
+    lv_refr_prof_add(LV_REFR_PROF_FLUSH_WAIT, (uint32_t)(esp_timer_get_time() - wait_start_us));
+#else
+    ulTaskNotifyTake(pdTRUE, 1);
+#endif
+}
+
+// Send the slices in order. A color transfer of esp_lcd waits for the previous one before it sets the
+// window, so this task blocks on the bus instead of the GUI task.
+static void flush_task(void *arg)
+{
+    esp_lcd_panel_handle_t panel_handle = (esp_lcd_panel_handle_t)arg;
+    lvgl_flush_slice_t *slice;
+    while (1)
+    {
+        if (xQueueReceive(flush_slices, &slice, portMAX_DELAY) == pdTRUE)
+        {
+            esp_lcd_panel_draw_bitmap(panel_handle, slice->area.x1, slice->area.y1, slice->area.x2 + 1,
+                                      slice->area.y2 + 1, slice->buf);
+        }
+    }
+}
+#endif
+
+#if defined(CONFIG_LCD_ROUND_PANEL) && !defined(CONFIG_LCD_DIRECT_MODE)
+static void lvgl_flush_band_cb(const lv_area_t *band, const lv_color_t *color_map, void *user_ctx)
+{
+    gui_flush_bytes += lv_area_get_size(band) * sizeof(lv_color_t);
+#ifdef CONFIG_LCD_FLUSH_QUEUE
+    lvgl_flush_queue_push((lvgl_flush_queue_t *)user_ctx, band, color_map);
+#else
+    esp_lcd_panel_handle_t panel_handle = (esp_lcd_panel_handle_t)user_ctx;
+    esp_lcd_panel_draw_bitmap(panel_handle, band->x1, band->y1, band->x2 + 1, band->y2 + 1, color_map);
+#endif
+}
+#endif
+
+#ifdef CONFIG_LCD_DIRECT_MODE
+// Copy the area LVGL just rendered into the frame through the slices. LVGL passes the whole frame
+// in direct mode, the rendered area is the clip area of the draw context.
+static void lvgl_direct_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    const lv_area_t *dirty = drv->draw_ctx->clip_area;
+#ifdef CONFIG_LCD_ROUND_PANEL
+    lv_area_t band;
+    for (lv_coord_t by1 = dirty->y1; by1 <= dirty->y2; by1 += LCD_ROUND_FLUSH_BAND_ROWS)
+    {
+        if (lvgl_round_get_band(dirty, LCD_ROUND_FLUSH_BAND_ROWS, by1, &band))
+        {
+            gui_flush_bytes += lv_area_get_size(&band) * sizeof(lv_color_t);
+            lvgl_flush_queue_push_fb(&flush_queue, &band, color_map, LCD_H_RES);
+        }
+    }
+#else
+    gui_flush_bytes += lv_area_get_size(dirty) * sizeof(lv_color_t);
+    lvgl_flush_queue_push_fb(&flush_queue, dirty, color_map, LCD_H_RES);
+#endif
+    // the frame itself is never read by the DMA, LVGL can render the next area into it at once
+    lv_disp_flush_ready(drv);
+}
+#else
 static void lvgl_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
 {
+#ifdef CONFIG_LCD_FLUSH_QUEUE
+#ifdef CONFIG_LCD_ROUND_PANEL
+    lvgl_round_flush_bands(area, color_map, LCD_ROUND_FLUSH_BAND_ROWS, lvgl_flush_band_cb, &flush_queue);
+#else
+    gui_flush_bytes += lv_area_get_size(area) * sizeof(lv_color_t);
+    lvgl_flush_queue_push(&flush_queue, area, color_map);
+#endif
+    // the pixels are in the slices now, LVGL can render the next area into its buffer
+    lv_disp_flush_ready(drv);
+#else
     esp_lcd_panel_handle_t panel_handle = (esp_lcd_panel_handle_t)drv->user_data;
+#ifdef CONFIG_LCD_ROUND_PANEL
+    // send every band of rows trimmed to its visible columns, skipping the corners of the round panel
+    uint32_t bands = lvgl_round_count_bands(area, LCD_ROUND_FLUSH_BAND_ROWS);
+    if (bands == 0)
+    {
+        lv_disp_flush_ready(drv);
+        return;
+    }
+    flush_pending = bands;
+    lvgl_round_flush_bands(area, color_map, LCD_ROUND_FLUSH_BAND_ROWS, lvgl_flush_band_cb, panel_handle);
+#else
+    gui_flush_bytes += lv_area_get_size(area) * sizeof(lv_color_t);
     int offsetx1 = area->x1;
     int offsetx2 = area->x2;
     int offsety1 = area->y1;
     int offsety2 = area->y2;
     // copy a buffer's content to a specific area of the display
     esp_lcd_panel_draw_bitmap(panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, color_map);
+#endif
+#endif
+}
+#endif
+
+#if (LV_DRAW_COMPLEX && (LV_SHADOW_CACHE_SIZE > 0 || LV_ARC_MASK_CACHE_SIZE > 0)) || LV_IMG_CACHE_BUDGET > 0 || \
+    LV_GRAD_CACHE_DEF_SIZE > 0 || LV_LAYER_POOL_SIMPLE_CNT > 0 || LV_LAYER_POOL_TRANSFORM_SIZE > 0 ||             \
+    LV_FONT_CACHE_BUDGET > 0
+// the shadow, arc, image, gradient and glyph caches and the layer buffers would take a large part of the LVGL heap,
+// prefer PSRAM if the board has it
+static void *draw_cache_alloc(size_t size)
+{
+    void *p = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    return p != NULL ? p : heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+}
+#endif
+
+#ifdef CONFIG_LV_USE_PARALLEL_RENDER
+static void render_task(void *arg)
+{
+    while (1)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        render_job_cb(render_job_param);
+        xSemaphoreGive(render_done);
+    }
 }
 
+static void render_run_cb(void (*task_cb)(void *param), void *param)
+{
+    render_job_cb = task_cb;
+    render_job_param = param;
+    xTaskNotifyGive(render_task_self);
+}
+
+static void render_wait_cb(void)
+{
+    xSemaphoreTake(render_done, portMAX_DELAY);
+}
+
+static void render_lock_cb(void)
+{
+    xSemaphoreTakeRecursive(render_lock, portMAX_DELAY);
+}
+
+static void render_unlock_cb(void)
+{
+    xSemaphoreGiveRecursive(render_lock);
+}
+
+static void render_task_init(void)
+{
+    static const lv_parallel_cb_t parallel_cb = {
+        .run_cb = render_run_cb,
+        .wait_cb = render_wait_cb,
+        .lock_cb = render_lock_cb,
+        .unlock_cb = render_unlock_cb,
+        .min_px = CONFIG_LVGL_PARALLEL_MIN_PX,
+    };
+    render_done = xSemaphoreCreateBinary();
+    render_lock = xSemaphoreCreateRecursiveMutex();
+    if (render_done == NULL || render_lock == NULL ||
+        xTaskCreatePinnedToCore(render_task, "render", 4096 * 2, NULL, 2, &render_task_self, 0) != pdPASS)
+    {
+        ESP_LOGW(TAG, "No render worker, drawing on one core");
+        return;
+    }
+    lv_parallel_set_cb(&parallel_cb);
+}
+#endif
+
+#ifdef CONFIG_LV_USE_REFR_PROF
+static uint32_t prof_time_cb(void)
+{
+    return (uint32_t)esp_timer_get_time();
+}
+
+static void prof_print_cb(const char *str, void *user_ctx)
+{
+    // a line of the table with its newline, ESP_LOG adds its own
+    ESP_LOGI(TAG, "%.*s", (int)strcspn(str, "\n"), str);
+}
+#endif
+
 static void increase_lvgl_tick(void *arg)
 {
     /* Tell LVGL how many milliseconds has elapsed */
@@ -86,6 +347,7 @@ void gui_task(void *pvParameters)
 {
     all_signals_t *signal = (all_signals_t *)pvParameters;
     xGuiSemaphore = xSemaphoreCreateMutex();
+    gui_task_self = xTaskGetCurrentTaskHandle();
 
     static lv_disp_draw_buf_t disp_buf; // contains internal graphic buffer(s) called draw buffer(s)
     static lv_disp_drv_t disp_drv;      // contains callback functions
@@ -157,22 +419,84 @@ void gui_task(void *pvParameters)
 
     ESP_LOGI(TAG, "Initialize LVGL library");
     lv_init();
+#ifdef CONFIG_LV_USE_REFR_PROF
+    lv_refr_prof_set_time_cb(prof_time_cb);
+#endif
+#ifdef CONFIG_LV_USE_PARALLEL_RENDER
+    render_task_init();
+#endif
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE > 0
+    lv_draw_sw_shadow_cache_set_mem_cb(draw_cache_alloc, heap_caps_free);
+#endif
+#if LV_DRAW_COMPLEX && LV_ARC_MASK_CACHE_SIZE > 0
+    lv_draw_sw_arc_cache_set_mem_cb(draw_cache_alloc, heap_caps_free);
+#endif
+#if LV_IMG_CACHE_BUDGET > 0
+    lv_img_cache_set_mem_cb(draw_cache_alloc, heap_caps_free);
+#endif
+#if LV_GRAD_CACHE_DEF_SIZE > 0
+    lv_gradient_set_cache_mem_cb(draw_cache_alloc, heap_caps_free);
+#endif
+#if LV_FONT_CACHE_BUDGET > 0
+    lv_font_cache_set_mem_cb(draw_cache_alloc, heap_caps_free);
+#endif
+#if LV_LAYER_POOL_SIMPLE_CNT > 0 || LV_LAYER_POOL_TRANSFORM_SIZE > 0
+    // reserved by the first layer, so the pool takes no RAM until a widget with opacity is drawn
+    lv_draw_sw_layer_pool_set_mem_cb(draw_cache_alloc, heap_caps_free);
+#endif
     // alloc draw buffers used by LVGL
+#ifdef CONFIG_LCD_DIRECT_MODE
+    // the persistent frame LVGL renders into, it only has to hold what the panel shows
+    lv_color_t *buf1 = heap_caps_calloc(LCD_H_RES * LCD_V_RES, sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
+#else
     // it's recommended to choose the size of the draw buffer(s) to be at least 1/10 screen sized
     lv_color_t *buf1 = heap_caps_malloc(DISP_BUF_SIZE * sizeof(lv_color_t), MALLOC_CAP_DMA);
+#endif
     assert(buf1);
     lv_color_t *buf2 = heap_caps_malloc(DISP_BUF_SIZE * sizeof(lv_color_t), MALLOC_CAP_DMA);
     assert(buf2);
+#ifdef CONFIG_LCD_FLUSH_QUEUE
+    // LVGL renders into buf1 only, buf2 is carved into the slices in flight
+    ESP_ERROR_CHECK(lvgl_flush_queue_init(&flush_queue, buf2, DISP_BUF_SIZE, LCD_FLUSH_SLICES, LCD_H_RES,
+                                          flush_send_cb, flush_wait_cb, NULL)
+                        ? ESP_OK
+                        : ESP_ERR_INVALID_SIZE);
+    flush_slices = xQueueCreate(LCD_FLUSH_SLICES, sizeof(lvgl_flush_slice_t *));
+    assert(flush_slices);
+    xTaskCreatePinnedToCore(flush_task, "flush", 4096, panel_handle, 3, NULL, 0);
+#ifdef CONFIG_LCD_DIRECT_MODE
+    lv_disp_draw_buf_init(&disp_buf, buf1, NULL, LCD_H_RES * LCD_V_RES);
+#else
+    lv_disp_draw_buf_init(&disp_buf, buf1, NULL, DISP_BUF_SIZE);
+#endif
+#else
     // initialize LVGL draw buffers
     lv_disp_draw_buf_init(&disp_buf, buf1, buf2, DISP_BUF_SIZE);
+#endif
 
     ESP_LOGI(TAG, "Register display driver to LVGL");
     lv_disp_drv_init(&disp_drv);
     disp_drv.hor_res = LCD_H_RES;
     disp_drv.ver_res = LCD_V_RES;
+#ifdef CONFIG_LCD_DIRECT_MODE
+    // render the dirty areas in place into the frame
+    disp_drv.flush_cb = lvgl_direct_flush_cb;
+    disp_drv.direct_mode = 1;
+#else
     disp_drv.flush_cb = lvgl_flush_cb;
+#endif
+    disp_drv.wait_cb = lvgl_wait_cb;
+    disp_drv.monitor_cb = lvgl_monitor_cb;
     disp_drv.draw_buf = &disp_buf;
     disp_drv.user_data = panel_handle;
+#ifdef CONFIG_LCD_ROUND_PANEL
+    // clip invalidated areas and the SW blender to the visible circle
+    ESP_ERROR_CHECK(lvgl_round_init(LCD_H_RES, LCD_V_RES) ? ESP_OK : ESP_ERR_NO_MEM);
+    disp_drv.rounder_cb = lvgl_round_rounder_cb;
+    disp_drv.draw_ctx_init = lvgl_round_draw_ctx_init;
+    disp_drv.draw_ctx_deinit = lvgl_round_draw_ctx_deinit;
+    disp_drv.draw_ctx_size = sizeof(lvgl_round_draw_ctx_t);
+#endif
     lv_disp_t *disp = lv_disp_drv_register(&disp_drv);
     if (NULL != (void *)disp)
         ESP_LOGI(TAG, "Registered display driver to LVGL");
@@ -189,27 +513,110 @@ void gui_task(void *pvParameters)
     ESP_LOGI(TAG, "Hardware initialization complete!");
 
     ESP_LOGI(TAG, "Initializing LVGL_UI");
+#ifdef CONFIG_LVGL_DEMO_BENCHMARK
+    lv_demo_benchmark();
+#else
     ui_init(signal);
+#endif
+#ifdef CONFIG_LVGL_PROFILE_OVERLAY
+    // the middle of the round panel is always visible
+    lv_obj_center(lv_refr_prof_overlay_create());
+#endif
     ESP_LOGI(TAG, "Initialized LVGL_UI");
 
     ESP_LOGI(TAG, "Ready to display the LVGL screen");
 
     vTaskDelay(pdMS_TO_TICKS(500));
+#ifdef CONFIG_LCD_FLUSH_QUEUE
+    // the panel IO is not shared with flush_task while it sends
+    while (!lvgl_flush_queue_is_idle(&flush_queue))
+    {
+        vTaskDelay(1);
+    }
+#endif
 
     ESP_ERROR_CHECK(esp_lcd_panel_disp_on_off(panel_handle, true));
     change_backlight(LEDC_CHANNEL_0, 0.2);
 
 
+    gui_window_start_us = esp_timer_get_time();
+#ifdef CONFIG_LV_USE_REFR_PROF
+    uint32_t idle_us = 0;
+#endif
     while (1)
     {
-        // raise the task priority of LVGL and/or reduce the handler period can improve the performance
-        vTaskDelay(pdMS_TO_TICKS(1));
+        uint32_t time_till_next = LV_NO_TIMER_READY;
+        int64_t busy_start_us = esp_timer_get_time();
         // The task running lv_timer_handler should have lower priority than that running `lv_tick_inc`
         if (pdTRUE == xSemaphoreTake(xGuiSemaphore, portMAX_DELAY))
         {
-            lv_timer_handler();
+#ifdef CONFIG_LV_USE_REFR_PROF
+            // the sleep before and the wait for the lock belong to the next frame
+            lv_refr_prof_add(LV_REFR_PROF_IDLE, idle_us);
+            lv_refr_prof_add(LV_REFR_PROF_LOCK, (uint32_t)(esp_timer_get_time() - busy_start_us));
+#endif
+            time_till_next = lv_timer_handler();
             xSemaphoreGive(xGuiSemaphore);
         }
+        int64_t now_us = esp_timer_get_time();
+        gui_wakeups++;
+        gui_busy_us += now_us - busy_start_us;
+        if (now_us - gui_window_start_us >= 1000000)
+        {
+            uint32_t window_us = (uint32_t)(now_us - gui_window_start_us);
+            gui_stats_last.wakeups = gui_wakeups;
+            gui_stats_last.busy_us = (uint32_t)gui_busy_us;
+            gui_stats_last.frames = gui_frames;
+            // the bus time of the pixels against the window, the commands setting the window are overhead
+            gui_stats_last.spi_util_permille = (uint32_t)((uint64_t)gui_flush_bytes * 8 * 1000000 * 1000 /
+                                                          ((uint64_t)LCD_PIXEL_CLOCK_HZ * window_us));
+#ifdef CONFIG_LCD_FLUSH_QUEUE
+            lvgl_flush_stats_t flush_stats;
+            lvgl_flush_queue_get_stats(&flush_queue, &flush_stats);
+            gui_stats_last.flush_waits = flush_stats.waits - gui_flush_waits_total;
+            gui_flush_waits_total = flush_stats.waits;
+#endif
+            gc9a01_panel_stats_t panel_stats;
+            esp_lcd_panel_gc9a01_get_stats(panel_handle, &panel_stats);
+            gui_stats_last.panel_flushes = panel_stats.flushes - gui_panel_stats_start.flushes;
+            gui_stats_last.spi_trans = panel_stats.transactions - gui_panel_stats_start.transactions;
+            gui_stats_last.panel_us = (uint32_t)(panel_stats.busy_us - gui_panel_stats_start.busy_us);
+            gui_panel_stats_start = panel_stats;
+            GUI_STATS_LOG(TAG, "%" PRIu32 " wakeups, %" PRIu32 " us busy, %" PRIu32 " fps, SPI %" PRIu32 ".%" PRIu32 "%% busy, %" PRIu32 " flush waits in the last second",
+                          gui_stats_last.wakeups, gui_stats_last.busy_us, gui_stats_last.frames,
+                          gui_stats_last.spi_util_permille / 10, gui_stats_last.spi_util_permille % 10, gui_stats_last.flush_waits);
+            GUI_STATS_LOG(TAG, "%" PRIu32 " panel flushes, %" PRIu32 " SPI transactions, %" PRIu32 " us in draw_bitmap",
+                          gui_stats_last.panel_flushes, gui_stats_last.spi_trans, gui_stats_last.panel_us);
+#if defined(CONFIG_LV_USE_REFR_PROF) && CONFIG_LVGL_PROFILE_DUMP_PERIOD_S > 0
+            if (++gui_prof_windows >= CONFIG_LVGL_PROFILE_DUMP_PERIOD_S &&
+                pdTRUE == xSemaphoreTake(xGuiSemaphore, portMAX_DELAY))
+            {
+                lv_refr_prof_dump(prof_print_cb, NULL);
+                xSemaphoreGive(xGuiSemaphore);
+                gui_prof_windows = 0;
+            }
+#endif
+            gui_wakeups = 0;
+            gui_busy_us = 0;
+            gui_frames = 0;
+            gui_flush_bytes = 0;
+            gui_window_start_us = now_us;
+        }
+
+        // Sleep until the next LVGL timer is due. Invalidations from other tasks (gui_unlock),
+        // input and flush completion wake the task earlier.
+        if (time_till_next > LVGL_TASK_MAX_SLEEP_MS)
+        {
+            time_till_next = LVGL_TASK_MAX_SLEEP_MS;
+        }
+        TickType_t sleep_ticks = pdMS_TO_TICKS(time_till_next);
+#ifdef CONFIG_LV_USE_REFR_PROF
+        int64_t sleep_start_us = esp_timer_get_time();
+        ulTaskNotifyTake(pdTRUE, sleep_ticks > 0 ? sleep_ticks : 1);
+        idle_us = (uint32_t)(esp_timer_get_time() - sleep_start_us);
+#else
+        ulTaskNotifyTake(pdTRUE, sleep_ticks > 0 ? sleep_ticks : 1);
+#endif
     }
 
     free(buf1);
@@ -217,6 +624,42 @@ void gui_task(void *pvParameters)
     vTaskDelete(NULL);
 }
 
+void gui_task_wakeup(void)
+{
+    if (gui_task_self != NULL)
+    {
+        xTaskNotifyGive(gui_task_self);
+    }
+}
+
+void gui_task_wakeup_from_isr(BaseType_t *high_task_wakeup)
+{
+    if (gui_task_self != NULL)
+    {
+        vTaskNotifyGiveFromISR(gui_task_self, high_task_wakeup);
+    }
+}
+
+bool gui_lock(uint32_t timeout_ms)
+{
+    return xSemaphoreTake(xGuiSemaphore, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+}
+
+void gui_unlock(void)
+{
+    xSemaphoreGive(xGuiSemaphore);
+    // LVGL objects may have been invalidated by another task, let the GUI task recompute its deadline
+    if (xTaskGetCurrentTaskHandle() != gui_task_self)
+    {
+        gui_task_wakeup();
+    }
+}
+
+void gui_task_get_stats(gui_task_stats_t *stats)
+{
+    *stats = gui_stats_last;
+}
+
 void change_backlight(ledc_channel_t ledc_channel, double duty)
 {
     // Set duty
@@ -0,0 +1,401 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl_hw_round.h"
+
+static lvgl_round_span_t *round_spans = NULL;
+static lv_coord_t round_ver_res = 0;
+static uint32_t round_visible_px = 0;
+
+static void round_draw_rect(lv_draw_ctx_t *draw_ctx, const lv_draw_rect_dsc_t *dsc, const lv_area_t *coords);
+static void round_draw_bg(lv_draw_ctx_t *draw_ctx, const lv_draw_rect_dsc_t *dsc, const lv_area_t *coords);
+static void round_draw_arc(lv_draw_ctx_t *draw_ctx, const lv_draw_arc_dsc_t *dsc, const lv_point_t *center,
+                           uint16_t radius, uint16_t start_angle, uint16_t end_angle);
+static void round_draw_img_decoded(lv_draw_ctx_t *draw_ctx, const lv_draw_img_dsc_t *dsc,
+                                   const lv_area_t *coords, const uint8_t *map_p, lv_img_cf_t color_format);
+static void round_draw_line(lv_draw_ctx_t *draw_ctx, const lv_draw_line_dsc_t *dsc, const lv_point_t *point1,
+                            const lv_point_t *point2);
+static void round_draw_polygon(lv_draw_ctx_t *draw_ctx, const lv_draw_rect_dsc_t *dsc,
+                               const lv_point_t *points, uint16_t point_cnt);
+static void round_blend(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc);
+
+bool lvgl_round_init(lv_coord_t hor_res, lv_coord_t ver_res)
+{
+    lvgl_round_deinit();
+
+    round_spans = calloc(ver_res, sizeof(lvgl_round_span_t));
+    if (round_spans == NULL)
+    {
+        return false;
+    }
+    round_ver_res = ver_res;
+    round_visible_px = 0;
+
+    // Circle inscribed in the display, centered
+    int32_t d = LV_MIN(hor_res, ver_res);
+    int32_t ox = (hor_res - d) / 2;
+    int32_t oy = (ver_res - d) / 2;
+    // Keep pixels whose center is within r + 0.5 so the anti-aliased edge is still drawn.
+    // Work in half pixels to stay in integers: (2x + 1 - d)^2 + (2y + 1 - d)^2 <= (d + 1)^2
+    int32_t limit = (d + 1) * (d + 1);
+
+    for (lv_coord_t y = 0; y < ver_res; y++)
+    {
+        round_spans[y].x1 = 1;
+        round_spans[y].x2 = 0;
+
+        int32_t ry = y - oy;
+        if (ry < 0 || ry >= d)
+        {
+            continue;
+        }
+        int32_t dy = 2 * ry + 1 - d;
+        for (int32_t rx = 0; rx <= d / 2; rx++)
+        {
+            int32_t dx = 2 * rx + 1 - d;
+            if (dx * dx + dy * dy <= limit)
+            {
+                round_spans[y].x1 = ox + rx;
+                round_spans[y].x2 = ox + d - 1 - rx;
+                round_visible_px += d - 2 * rx;
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+void lvgl_round_deinit(void)
+{
+    free(round_spans);
+    round_spans = NULL;
+    round_ver_res = 0;
+    round_visible_px = 0;
+}
+
+lvgl_round_span_t lvgl_round_get_span(lv_coord_t y)
+{
+    if (round_spans == NULL || y < 0 || y >= round_ver_res)
+    {
+        return (lvgl_round_span_t){.x1 = 1, .x2 = 0};
+    }
+    return round_spans[y];
+}
+
+uint32_t lvgl_round_get_visible_px(void)
+{
+    return round_visible_px;
+}
+
+bool lvgl_round_clip_area(lv_area_t *area)
+{
+    if (round_spans == NULL)
+    {
+        return true;
+    }
+
+    lv_area_t res = {.x1 = LV_COORD_MAX, .y1 = -1, .x2 = LV_COORD_MIN, .y2 = -1};
+    lv_coord_t y1 = LV_MAX(area->y1, 0);
+    lv_coord_t y2 = LV_MIN(area->y2, round_ver_res - 1);
+
+    for (lv_coord_t y = y1; y <= y2; y++)
+    {
+        lv_coord_t x1 = LV_MAX(round_spans[y].x1, area->x1);
+        lv_coord_t x2 = LV_MIN(round_spans[y].x2, area->x2);
+        if (x1 > x2)
+        {
+            continue;
+        }
+        if (res.y1 < 0)
+        {
+            res.y1 = y;
+        }
+        res.y2 = y;
+        res.x1 = LV_MIN(res.x1, x1);
+        res.x2 = LV_MAX(res.x2, x2);
+    }
+
+    if (res.y1 < 0)
+    {
+        return false;
+    }
+    *area = res;
+    return true;
+}
+
+void lvgl_round_rounder_cb(lv_disp_drv_t *disp_drv, lv_area_t *area)
+{
+    LV_UNUSED(disp_drv);
+    // An invisible area can't be dropped here, LVGL will still refresh it as it is
+    lvgl_round_clip_area(area);
+}
+
+void lvgl_round_draw_ctx_init(lv_disp_drv_t *disp_drv, lv_draw_ctx_t *draw_ctx)
+{
+#if LV_USE_GPU_ESP32S3_PIE
+    // blend with the PIE vector kernels, the software blender stays if they fail their check
+    lv_draw_esp32s3_pie_ctx_init(disp_drv, draw_ctx);
+#else
+    lv_draw_sw_init_ctx(disp_drv, draw_ctx);
+#endif
+
+    // Narrow the clip area of every draw to the visible rows/columns so masks and
+    // shadows are not calculated for the corners, then clip the blending row by row
+    lvgl_round_draw_ctx_t *round_ctx = (lvgl_round_draw_ctx_t *)draw_ctx;
+    round_ctx->parent_draw_rect = draw_ctx->draw_rect;
+    round_ctx->parent_draw_bg = draw_ctx->draw_bg;
+    round_ctx->parent_draw_arc = draw_ctx->draw_arc;
+    round_ctx->parent_draw_img_decoded = draw_ctx->draw_img_decoded;
+    round_ctx->parent_draw_line = draw_ctx->draw_line;
+    round_ctx->parent_draw_polygon = draw_ctx->draw_polygon;
+    round_ctx->parent_blend = round_ctx->sw_ctx.blend;
+    draw_ctx->draw_rect = round_draw_rect;
+    draw_ctx->draw_bg = round_draw_bg;
+    draw_ctx->draw_arc = round_draw_arc;
+    draw_ctx->draw_img_decoded = round_draw_img_decoded;
+    draw_ctx->draw_line = round_draw_line;
+    draw_ctx->draw_polygon = round_draw_polygon;
+    round_ctx->sw_ctx.blend = round_blend;
+}
+
+void lvgl_round_draw_ctx_deinit(lv_disp_drv_t *disp_drv, lv_draw_ctx_t *draw_ctx)
+{
+    lv_draw_sw_deinit_ctx(disp_drv, draw_ctx);
+}
+
+static bool round_is_disp_buf(lv_draw_ctx_t *draw_ctx)
+{
+    // Layers are drawn in their own (possibly transformed) space, only the real draw buffer is clipped.
+    // lv_snapshot renders with a fake display which has no draw buffer.
+    lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+    return disp != NULL && disp->driver->draw_buf != NULL && draw_ctx->buf == disp->driver->draw_buf->buf_act;
+}
+
+// Replace the clip area of the draw context with its visible part, return false if nothing is visible
+static bool round_clip_begin(lv_draw_ctx_t *draw_ctx, lv_area_t *clip_area)
+{
+    *clip_area = *draw_ctx->clip_area;
+    if (!round_is_disp_buf(draw_ctx))
+    {
+        return true;
+    }
+    if (!lvgl_round_clip_area(clip_area))
+    {
+        return false;
+    }
+    draw_ctx->clip_area = clip_area;
+    return true;
+}
+
+static void round_draw_rect(lv_draw_ctx_t *draw_ctx, const lv_draw_rect_dsc_t *dsc, const lv_area_t *coords)
+{
+    lvgl_round_draw_ctx_t *round_ctx = (lvgl_round_draw_ctx_t *)draw_ctx;
+    const lv_area_t *clip_area_ori = draw_ctx->clip_area;
+    lv_area_t clip_area;
+    if (round_clip_begin(draw_ctx, &clip_area))
+    {
+        round_ctx->parent_draw_rect(draw_ctx, dsc, coords);
+    }
+    draw_ctx->clip_area = clip_area_ori;
+}
+
+static void round_draw_bg(lv_draw_ctx_t *draw_ctx, const lv_draw_rect_dsc_t *dsc, const lv_area_t *coords)
+{
+    lvgl_round_draw_ctx_t *round_ctx = (lvgl_round_draw_ctx_t *)draw_ctx;
+    const lv_area_t *clip_area_ori = draw_ctx->clip_area;
+    lv_area_t clip_area;
+    if (round_clip_begin(draw_ctx, &clip_area))
+    {
+        round_ctx->parent_draw_bg(draw_ctx, dsc, coords);
+    }
+    draw_ctx->clip_area = clip_area_ori;
+}
+
+static void round_draw_arc(lv_draw_ctx_t *draw_ctx, const lv_draw_arc_dsc_t *dsc, const lv_point_t *center,
+                           uint16_t radius, uint16_t start_angle, uint16_t end_angle)
+{
+    lvgl_round_draw_ctx_t *round_ctx = (lvgl_round_draw_ctx_t *)draw_ctx;
+    const lv_area_t *clip_area_ori = draw_ctx->clip_area;
+    lv_area_t clip_area;
+    if (round_clip_begin(draw_ctx, &clip_area))
+    {
+        round_ctx->parent_draw_arc(draw_ctx, dsc, center, radius, start_angle, end_angle);
+    }
+    draw_ctx->clip_area = clip_area_ori;
+}
+
+static void round_draw_img_decoded(lv_draw_ctx_t *draw_ctx, const lv_draw_img_dsc_t *dsc,
+                                   const lv_area_t *coords, const uint8_t *map_p, lv_img_cf_t color_format)
+{
+    lvgl_round_draw_ctx_t *round_ctx = (lvgl_round_draw_ctx_t *)draw_ctx;
+    const lv_area_t *clip_area_ori = draw_ctx->clip_area;
+    lv_area_t clip_area;
+    if (round_clip_begin(draw_ctx, &clip_area))
+    {
+        round_ctx->parent_draw_img_decoded(draw_ctx, dsc, coords, map_p, color_format);
+    }
+    draw_ctx->clip_area = clip_area_ori;
+}
+
+static void round_draw_line(lv_draw_ctx_t *draw_ctx, const lv_draw_line_dsc_t *dsc, const lv_point_t *point1,
+                            const lv_point_t *point2)
+{
+    lvgl_round_draw_ctx_t *round_ctx = (lvgl_round_draw_ctx_t *)draw_ctx;
+    const lv_area_t *clip_area_ori = draw_ctx->clip_area;
+    lv_area_t clip_area;
+    if (round_clip_begin(draw_ctx, &clip_area))
+    {
+        round_ctx->parent_draw_line(draw_ctx, dsc, point1, point2);
+    }
+    draw_ctx->clip_area = clip_area_ori;
+}
+
+static void round_draw_polygon(lv_draw_ctx_t *draw_ctx, const lv_draw_rect_dsc_t *dsc,
+                               const lv_point_t *points, uint16_t point_cnt)
+{
+    lvgl_round_draw_ctx_t *round_ctx = (lvgl_round_draw_ctx_t *)draw_ctx;
+    const lv_area_t *clip_area_ori = draw_ctx->clip_area;
+    lv_area_t clip_area;
+    if (round_clip_begin(draw_ctx, &clip_area))
+    {
+        round_ctx->parent_draw_polygon(draw_ctx, dsc, points, point_cnt);
+    }
+    draw_ctx->clip_area = clip_area_ori;
+}
+
+static void round_blend(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc)
+{
+    lvgl_round_draw_ctx_t *round_ctx = (lvgl_round_draw_ctx_t *)draw_ctx;
+    lv_area_t blend_area;
+
+    if (!round_is_disp_buf(draw_ctx) ||
+        !_lv_area_intersect(&blend_area, dsc->blend_area, draw_ctx->clip_area))
+    {
+        round_ctx->parent_blend(draw_ctx, dsc);
+        return;
+    }
+
+    // The circle is convex: if the first and last rows are fully visible all the rows between are too
+    lvgl_round_span_t top = lvgl_round_get_span(blend_area.y1);
+    lvgl_round_span_t bottom = lvgl_round_get_span(blend_area.y2);
+    if (top.x1 <= blend_area.x1 && top.x2 >= blend_area.x2 &&
+        bottom.x1 <= blend_area.x1 && bottom.x2 >= blend_area.x2)
+    {
+        round_ctx->parent_blend(draw_ctx, dsc);
+        return;
+    }
+
+    // Blend the rows in groups sharing the same visible columns by narrowing the clip area.
+    // The blender offsets the source and mask buffers by the clip area so they need no change.
+    const lv_area_t *clip_area_ori = draw_ctx->clip_area;
+    lv_area_t clip_rows;
+    bool open = false;
+
+    draw_ctx->clip_area = &clip_rows;
+    for (lv_coord_t y = blend_area.y1; y <= blend_area.y2; y++)
+    {
+        lvgl_round_span_t span = lvgl_round_get_span(y);
+        lv_coord_t x1 = LV_MAX(span.x1, blend_area.x1);
+        lv_coord_t x2 = LV_MIN(span.x2, blend_area.x2);
+
+        if (open && x1 == clip_rows.x1 && x2 == clip_rows.x2)
+        {
+            clip_rows.y2 = y;
+            continue;
+        }
+        if (open)
+        {
+            round_ctx->parent_blend(draw_ctx, dsc);
+            open = false;
+        }
+        if (x1 <= x2)
+        {
+            clip_rows.x1 = x1;
+            clip_rows.x2 = x2;
+            clip_rows.y1 = y;
+            clip_rows.y2 = y;
+            open = true;
+        }
+    }
+    if (open)
+    {
+        round_ctx->parent_blend(draw_ctx, dsc);
+    }
+    draw_ctx->clip_area = clip_area_ori;
+}
+
+bool lvgl_round_get_band(const lv_area_t *area, lv_coord_t band_rows, lv_coord_t by1, lv_area_t *band)
+{
+    band->x1 = area->x1;
+    band->x2 = area->x2;
+    band->y1 = by1;
+    band->y2 = LV_MIN(by1 + band_rows - 1, area->y2);
+    return lvgl_round_clip_area(band);
+}
+
+uint32_t lvgl_round_count_bands(const lv_area_t *area, lv_coord_t band_rows)
+{
+    uint32_t cnt = 0;
+    lv_area_t band;
+
+    for (lv_coord_t by1 = area->y1; by1 <= area->y2; by1 += band_rows)
+    {
+        if (lvgl_round_get_band(area, band_rows, by1, &band))
+        {
+            cnt++;
+        }
+    }
+    return cnt;
+}
+
+uint32_t lvgl_round_flush_bands(const lv_area_t *area, lv_color_t *color_map, lv_coord_t band_rows,
+                                lvgl_round_band_cb_t band_cb, void *user_ctx)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    uint32_t cnt = 0;
+    lv_area_t band;
+
+    for (lv_coord_t by1 = area->y1; by1 <= area->y2; by1 += band_rows)
+    {
+        if (!lvgl_round_get_band(area, band_rows, by1, &band))
+        {
+            continue;
+        }
+
+        lv_coord_t band_w = lv_area_get_width(&band);
+        lv_color_t *src = color_map + (band.y1 - area->y1) * w + (band.x1 - area->x1);
+        lv_color_t *packed = src;
+
+        if (band_w != w)
+        {
+            // Pack the rows to the start of the band. The destination never passes the source and
+            // the earlier bands (possibly still being sent) are not touched.
+            packed = color_map + (by1 - area->y1) * w;
+            lv_color_t *dst = packed;
+            for (lv_coord_t y = band.y1; y <= band.y2; y++)
+            {
+                memmove(dst, src, band_w * sizeof(lv_color_t));
+                dst += band_w;
+                src += w;
+            }
+        }
+
+        band_cb(&band, packed, user_ctx);
+        cnt++;
+    }
+    return cnt;
+}
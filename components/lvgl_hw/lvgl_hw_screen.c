@@ -0,0 +1,277 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <inttypes.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "lvgl_hw_screen.h"
+
+static const char *TAG = "lvgl_screen";
+
+static uint32_t screen_heap_free(void)
+{
+#if LV_MEM_CUSTOM == 0
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.free_size;
+#else
+    // the system heap can't be measured by LVGL, no memory pressure then
+    return UINT32_MAX;
+#endif
+}
+
+// shown, or the old or the new screen of a running load animation
+static bool screen_in_use(const lv_obj_t *scr)
+{
+    lv_disp_t *disp = lv_obj_get_disp(scr);
+    return scr == disp->act_scr || scr == disp->prev_scr || scr == disp->scr_to_load;
+}
+
+static bool screen_valid(const lvgl_screen_mgr_t *mgr, int id)
+{
+    return id >= 0 && id < (int)mgr->cnt;
+}
+
+static void screen_delete(lvgl_screen_t *s)
+{
+    if (s->desc.release != NULL)
+    {
+        s->desc.release(s->scr, s->desc.user_data);
+    }
+    lv_obj_del(s->scr);
+    s->scr = NULL;
+    s->prewarmed = false;
+}
+
+static bool screen_build(lvgl_screen_mgr_t *mgr, lvgl_screen_t *s)
+{
+    uint32_t free_before = screen_heap_free();
+    int64_t t0 = esp_timer_get_time();
+    s->scr = s->desc.build(s->desc.user_data);
+    if (s->scr == NULL)
+    {
+        mgr->stats.build_fails++;
+        ESP_LOGW(TAG, "%s could not be built", s->desc.name);
+        return false;
+    }
+    s->build_us = (uint32_t)(esp_timer_get_time() - t0);
+    uint32_t free_after = screen_heap_free();
+    s->mem_size = free_before > free_after ? free_before - free_after : 0;
+    ESP_LOGD(TAG, "%s built in %" PRIu32 " us, %" PRIu32 " bytes", s->desc.name, s->build_us, s->mem_size);
+    return true;
+}
+
+// the built screen used least recently which may be deleted, except `keep`
+static lvgl_screen_t *screen_find_lru(lvgl_screen_mgr_t *mgr, int keep)
+{
+    lvgl_screen_t *lru = NULL;
+    for (uint32_t i = 0; i < mgr->cnt; i++)
+    {
+        lvgl_screen_t *s = &mgr->screens[i];
+        if ((int)i == keep || s->scr == NULL || s->desc.pinned || screen_in_use(s->scr))
+        {
+            continue;
+        }
+        if (lru == NULL || s->last_used < lru->last_used)
+        {
+            lru = s;
+        }
+    }
+    return lru;
+}
+
+static uint32_t screen_make_room(lvgl_screen_mgr_t *mgr, uint32_t need, int keep)
+{
+    uint32_t cnt = 0;
+    while (screen_heap_free() < need)
+    {
+        lvgl_screen_t *lru = screen_find_lru(mgr, keep);
+        if (lru == NULL)
+        {
+            break;
+        }
+        ESP_LOGD(TAG, "%s evicted", lru->desc.name);
+        screen_delete(lru);
+        mgr->stats.evictions++;
+        cnt++;
+    }
+    return cnt;
+}
+
+static void screen_prewarm_timer_cb(lv_timer_t *timer)
+{
+    lvgl_screen_mgr_t *mgr = (lvgl_screen_mgr_t *)timer->user_data;
+    if (lv_timer_get_idle() >= mgr->prewarm_idle)
+    {
+        lvgl_screen_prewarm(mgr);
+    }
+}
+
+void lvgl_screen_mgr_init(lvgl_screen_mgr_t *mgr, uint32_t min_free)
+{
+    memset(mgr, 0, sizeof(*mgr));
+    mgr->min_free = min_free;
+    mgr->active = LVGL_SCREEN_NONE;
+}
+
+int lvgl_screen_register(lvgl_screen_mgr_t *mgr, const lvgl_screen_desc_t *desc)
+{
+    if (mgr->cnt >= LVGL_SCREEN_MAX)
+    {
+        ESP_LOGE(TAG, "no room for %s, LVGL_SCREEN_MAX is %d", desc->name, LVGL_SCREEN_MAX);
+        return LVGL_SCREEN_NONE;
+    }
+    lvgl_screen_t *s = &mgr->screens[mgr->cnt];
+    memset(s, 0, sizeof(*s));
+    s->desc = *desc;
+    return (int)mgr->cnt++;
+}
+
+bool lvgl_screen_show(lvgl_screen_mgr_t *mgr, int id, lv_scr_load_anim_t anim, uint32_t time)
+{
+    if (!screen_valid(mgr, id))
+    {
+        return false;
+    }
+    lvgl_screen_t *s = &mgr->screens[id];
+    int64_t t0 = esp_timer_get_time();
+    mgr->stats.shows++;
+
+    if (s->scr == NULL)
+    {
+        // what it took last time, a first build can only be checked afterwards
+        screen_make_room(mgr, mgr->min_free + s->mem_size, id);
+        if (!screen_build(mgr, s))
+        {
+            return false;
+        }
+        mgr->stats.builds++;
+    }
+    else if (s->prewarmed)
+    {
+        mgr->stats.prewarm_hits++;
+    }
+    s->prewarmed = false;
+    s->last_used = ++mgr->seq;
+    mgr->active = id;
+
+    if (lv_disp_get_scr_act(lv_obj_get_disp(s->scr)) != s->scr)
+    {
+        lv_scr_load_anim(s->scr, anim, time, 0, false);
+    }
+    // the previous screen goes too if it's no longer animated
+    screen_make_room(mgr, mgr->min_free, id);
+
+    uint32_t dt = (uint32_t)(esp_timer_get_time() - t0);
+    mgr->stats.last_switch_us = dt;
+    mgr->stats.max_switch_us = LV_MAX(mgr->stats.max_switch_us, dt);
+    mgr->stats.total_switch_us += dt;
+    return true;
+}
+
+bool lvgl_screen_prewarm(lvgl_screen_mgr_t *mgr)
+{
+    if (!screen_valid(mgr, mgr->active))
+    {
+        return false;
+    }
+    int next = mgr->screens[mgr->active].desc.next;
+    if (!screen_valid(mgr, next) || mgr->screens[next].scr != NULL)
+    {
+        return false;
+    }
+    lvgl_screen_t *s = &mgr->screens[next];
+    if (screen_heap_free() < mgr->min_free + s->mem_size || !screen_build(mgr, s))
+    {
+        return false;
+    }
+    // a first build may take more than there was to spare, it's built again when shown
+    if (screen_heap_free() < mgr->min_free)
+    {
+        screen_delete(s);
+        return false;
+    }
+    s->prewarmed = true;
+    s->last_used = mgr->seq;
+    mgr->stats.prewarms++;
+    return true;
+}
+
+void lvgl_screen_set_prewarm_period(lvgl_screen_mgr_t *mgr, uint32_t period_ms, uint8_t min_idle)
+{
+    mgr->prewarm_idle = min_idle;
+    if (period_ms == 0)
+    {
+        if (mgr->prewarm_timer != NULL)
+        {
+            lv_timer_del(mgr->prewarm_timer);
+            mgr->prewarm_timer = NULL;
+        }
+    }
+    else if (mgr->prewarm_timer == NULL)
+    {
+        mgr->prewarm_timer = lv_timer_create(screen_prewarm_timer_cb, period_ms, mgr);
+    }
+    else
+    {
+        lv_timer_set_period(mgr->prewarm_timer, period_ms);
+    }
+}
+
+uint32_t lvgl_screen_trim(lvgl_screen_mgr_t *mgr)
+{
+    return screen_make_room(mgr, mgr->min_free, LVGL_SCREEN_NONE);
+}
+
+bool lvgl_screen_evict(lvgl_screen_mgr_t *mgr, int id)
+{
+    if (!screen_valid(mgr, id))
+    {
+        return false;
+    }
+    lvgl_screen_t *s = &mgr->screens[id];
+    if (s->scr == NULL || screen_in_use(s->scr))
+    {
+        return false;
+    }
+    screen_delete(s);
+    mgr->stats.evictions++;
+    return true;
+}
+
+lv_obj_t *lvgl_screen_get(lvgl_screen_mgr_t *mgr, int id)
+{
+    return screen_valid(mgr, id) ? mgr->screens[id].scr : NULL;
+}
+
+void lvgl_screen_get_stats(lvgl_screen_mgr_t *mgr, lvgl_screen_stats_t *stats)
+{
+    *stats = mgr->stats;
+    stats->resident = 0;
+    stats->resident_bytes = 0;
+    for (uint32_t i = 0; i < mgr->cnt; i++)
+    {
+        if (mgr->screens[i].scr != NULL)
+        {
+            stats->resident++;
+            stats->resident_bytes += mgr->screens[i].mem_size;
+        }
+    }
+}
+
+void lvgl_screen_reset_stats(lvgl_screen_mgr_t *mgr)
+{
+    memset(&mgr->stats, 0, sizeof(mgr->stats));
+}
@@ -0,0 +1,249 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_heap_caps.h"
+#include "lvgl_hw_static.h"
+
+static const lv_part_t static_all_parts[] = {
+    LV_PART_MAIN, LV_PART_SCROLLBAR, LV_PART_INDICATOR, LV_PART_KNOB,
+    LV_PART_SELECTED, LV_PART_ITEMS, LV_PART_TICKS, LV_PART_CURSOR,
+};
+
+// Makes the main part transparent. LV_STYLE_OPA can't be used there: it would hide the whole object.
+static lv_style_t static_style_main_off;
+// Makes any other part transparent. LV_STYLE_OPA also beats local styles like an `arc_opa` of the part.
+static lv_style_t static_style_part_off;
+static bool static_style_inited = false;
+
+static void static_style_init(void)
+{
+    if (static_style_inited)
+    {
+        return;
+    }
+    lv_style_init(&static_style_main_off);
+    lv_style_set_bg_opa(&static_style_main_off, LV_OPA_TRANSP);
+    lv_style_set_bg_img_opa(&static_style_main_off, LV_OPA_TRANSP);
+    lv_style_set_border_opa(&static_style_main_off, LV_OPA_TRANSP);
+    lv_style_set_outline_opa(&static_style_main_off, LV_OPA_TRANSP);
+    lv_style_set_shadow_opa(&static_style_main_off, LV_OPA_TRANSP);
+    lv_style_set_img_opa(&static_style_main_off, LV_OPA_TRANSP);
+    lv_style_set_line_opa(&static_style_main_off, LV_OPA_TRANSP);
+    lv_style_set_arc_opa(&static_style_main_off, LV_OPA_TRANSP);
+    lv_style_set_text_opa(&static_style_main_off, LV_OPA_TRANSP);
+
+    lv_style_init(&static_style_part_off);
+    lv_style_set_opa(&static_style_part_off, LV_OPA_TRANSP);
+    static_style_inited = true;
+}
+
+static const lvgl_static_part_t *static_find(const lvgl_static_layer_t *layer, const lv_obj_t *obj)
+{
+    for (uint32_t i = 0; i < layer->part_cnt; i++)
+    {
+        if (layer->parts[i].obj == obj)
+        {
+            return &layer->parts[i];
+        }
+    }
+    return NULL;
+}
+
+// Make the static (or the dynamic) parts of the partly static objects transparent
+static void static_parts_off(lvgl_static_layer_t *layer, bool static_side)
+{
+    for (uint32_t i = 0; i < layer->part_cnt; i++)
+    {
+        const lvgl_static_part_t *p = &layer->parts[i];
+        if (p->part == LV_PART_ANY)
+        {
+            continue;
+        }
+        for (uint32_t j = 0; j < sizeof(static_all_parts) / sizeof(static_all_parts[0]); j++)
+        {
+            if ((static_all_parts[j] == p->part) == static_side)
+            {
+                lv_obj_add_style(p->obj, static_all_parts[j] == LV_PART_MAIN ? &static_style_main_off : &static_style_part_off,
+                                 static_all_parts[j]);
+            }
+        }
+    }
+}
+
+static void static_parts_on(lvgl_static_layer_t *layer)
+{
+    for (uint32_t i = 0; i < layer->part_cnt; i++)
+    {
+        if (layer->parts[i].part != LV_PART_ANY)
+        {
+            lv_obj_remove_style(layer->parts[i].obj, &static_style_main_off, LV_PART_ANY | LV_STATE_ANY);
+            lv_obj_remove_style(layer->parts[i].obj, &static_style_part_off, LV_PART_ANY | LV_STATE_ANY);
+        }
+    }
+}
+
+// Show or hide the objects which are static as a whole
+static void static_objs_hide(lvgl_static_layer_t *layer, bool hide)
+{
+    for (uint32_t i = 0; i < layer->part_cnt; i++)
+    {
+        if (layer->parts[i].part != LV_PART_ANY)
+        {
+            continue;
+        }
+        if (hide)
+        {
+            lv_obj_add_flag(layer->parts[i].obj, LV_OBJ_FLAG_HIDDEN);
+        }
+        else
+        {
+            lv_obj_clear_flag(layer->parts[i].obj, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+}
+
+static void static_apply(lvgl_static_layer_t *layer, bool en)
+{
+    static_parts_on(layer);
+    static_objs_hide(layer, en);
+    if (en)
+    {
+        static_parts_off(layer, true);
+        lv_obj_clear_flag(layer->img, LV_OBJ_FLAG_HIDDEN);
+    }
+    else
+    {
+        lv_obj_add_flag(layer->img, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+static bool static_render(lvgl_static_layer_t *layer)
+{
+    lv_obj_t *scr = layer->scr;
+    uint32_t child_cnt = lv_obj_get_child_cnt(scr);
+    bool *hidden_by_us = lv_mem_alloc(child_cnt ? child_cnt : 1);
+    if (hidden_by_us == NULL)
+    {
+        return false;
+    }
+
+    // Leave only the static parts visible
+    static_apply(layer, false);
+    for (uint32_t i = 0; i < child_cnt; i++)
+    {
+        lv_obj_t *child = lv_obj_get_child(scr, i);
+        hidden_by_us[i] = static_find(layer, child) == NULL && !lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN);
+        if (hidden_by_us[i])
+        {
+            lv_obj_add_flag(child, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+    static_parts_off(layer, false);
+
+    lv_res_t res = lv_snapshot_take_to_buf(scr, LV_IMG_CF_TRUE_COLOR, &layer->dsc, layer->buf, layer->buf_size);
+
+    static_parts_on(layer);
+    for (uint32_t i = 0; i < child_cnt; i++)
+    {
+        if (hidden_by_us[i])
+        {
+            lv_obj_clear_flag(lv_obj_get_child(scr, i), LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+    lv_mem_free(hidden_by_us);
+
+    if (res != LV_RES_OK)
+    {
+        return false;
+    }
+    // the descriptor is the source of the image object, drop what the decoder may have cached of it
+    lv_img_cache_invalidate_src(&layer->dsc);
+    static_apply(layer, layer->enabled);
+    lv_obj_invalidate(scr);
+    return true;
+}
+
+bool lvgl_static_layer_create(lvgl_static_layer_t *layer, lv_obj_t *scr, const lvgl_static_part_t *parts,
+                              uint32_t part_cnt)
+{
+    static_style_init();
+
+    memset(layer, 0, sizeof(*layer));
+    layer->scr = scr;
+    layer->parts = parts;
+    layer->part_cnt = part_cnt;
+
+    layer->buf_size = lv_snapshot_buf_size_needed(scr, LV_IMG_CF_TRUE_COLOR);
+    // larger than the LVGL heap, and it lives as long as the screen, so it has to be in PSRAM
+    layer->buf = heap_caps_malloc(layer->buf_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (layer->buf == NULL)
+    {
+        return false;
+    }
+
+    layer->img = lv_img_create(scr);
+    lv_obj_add_flag(layer->img, LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_IGNORE_LAYOUT);
+    lv_obj_clear_flag(layer->img, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_move_background(layer->img);
+
+    if (!static_render(layer))
+    {
+        lvgl_static_layer_delete(layer);
+        return false;
+    }
+
+    // the snapshot covers the coordinates of the screen, place the image there regardless of its padding
+    lv_img_set_src(layer->img, &layer->dsc);
+    lv_obj_update_layout(scr);
+    lv_obj_set_pos(layer->img, scr->coords.x1 - layer->img->coords.x1, scr->coords.y1 - layer->img->coords.y1);
+
+    lvgl_static_layer_set_enabled(layer, true);
+    return true;
+}
+
+bool lvgl_static_layer_update(lvgl_static_layer_t *layer)
+{
+    if (layer->buf == NULL || lv_snapshot_buf_size_needed(layer->scr, LV_IMG_CF_TRUE_COLOR) > layer->buf_size)
+    {
+        return false;
+    }
+    return static_render(layer);
+}
+
+void lvgl_static_layer_set_enabled(lvgl_static_layer_t *layer, bool en)
+{
+    if (layer->img == NULL)
+    {
+        return;
+    }
+    layer->enabled = en;
+    static_apply(layer, en);
+    lv_obj_invalidate(layer->scr);
+}
+
+void lvgl_static_layer_delete(lvgl_static_layer_t *layer)
+{
+    if (layer->img != NULL)
+    {
+        static_apply(layer, false);
+        lv_obj_del(layer->img);
+        layer->img = NULL;
+        lv_img_cache_invalidate_src(&layer->dsc);
+    }
+    heap_caps_free(layer->buf);
+    layer->buf = NULL;
+    layer->enabled = false;
+}
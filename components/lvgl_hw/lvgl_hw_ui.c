@@ -0,0 +1,60 @@
+// Copyright 2022 JeongYeham
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lvgl_hw_ui.h"
+
+lv_obj_t *lvgl_ui_create(const lvgl_ui_obj_t *objs, uint32_t cnt)
+{
+    lv_obj_t *parents[LVGL_UI_MAX_DEPTH] = {NULL};
+
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+        const lvgl_ui_obj_t *o = &objs[i];
+        LV_ASSERT(o->depth < LVGL_UI_MAX_DEPTH && (i == 0) == (o->depth == 0));
+        lv_obj_t *obj = o->create(o->depth ? parents[o->depth - 1] : NULL);
+        parents[o->depth] = obj;
+        if (o->var != NULL)
+        {
+            *o->var = obj;
+        }
+
+        if (o->flags_add)
+        {
+            lv_obj_add_flag(obj, o->flags_add);
+        }
+        if (o->flags_clear)
+        {
+            lv_obj_clear_flag(obj, o->flags_clear);
+        }
+
+        // the create refreshed the object with the theme, refresh once more with all the styles
+        if (o->style_cnt)
+        {
+            lv_obj_enable_style_refresh(false);
+            for (uint32_t s = 0; s < o->style_cnt; s++)
+            {
+                lv_obj_add_style(obj, (lv_style_t *)o->styles[s].style, o->styles[s].selector);
+            }
+            lv_obj_enable_style_refresh(true);
+            lv_obj_refresh_style(obj, LV_PART_ANY, LV_STYLE_PROP_ANY);
+        }
+
+        // after the styles, e.g. a label measures its text with the font of its style
+        if (o->init != NULL)
+        {
+            o->init(obj);
+        }
+    }
+    return parents[0];
+}
@@ -0,0 +1,359 @@
+#!/usr/bin/env python3
+# Copyright 2022 JeongYeham
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Generates the C code of a screen from its description in ui/<screen>.json (or .yaml), run by the
+build of lvgl_hw:
+
+    lvgl_ui_gen.py ui/ui_Screen1.json -o build/dir
+
+writes ui_Screen1.c and ui_Screen1.h with a global lv_obj_t * per named object and
+`void ui_Screen1_screen_init(void)`.
+
+The default mode `const` puts the geometry and the styles of every object into const styles
+(LV_STYLE_CONST_INIT, in flash) and the objects into a const table which lvgl_ui_create() of
+lvgl_hw_ui.c builds in one pass: no local style is allocated and every object is refreshed once.
+The mode `calls` writes the lv_obj_set_*() / lv_obj_set_style_*() calls of a hand written screen
+instead, each allocating or growing the local style of the object. host_test/bench_ui_gen.c
+compares both, `--suffix` renames the symbols of one of them so both can be linked together.
+
+A description:
+
+    {
+        "screen": "ui_Screen1",
+        "flags_clear": ["SCROLLABLE"],
+        "children": [
+            {
+                "type": "label",                        # lv_label_create()
+                "name": "ui_humiLabel",                 # the global of the object, optional
+                "comment": "shown above the object",    # optional
+                "width": "content", "height": 20,       # also "50%"
+                "x": 41, "y": -45, "align": "CENTER",
+                "flags_add": [...], "flags_clear": ["PRESS_LOCK"],
+                "set": {"text": "humi"},                # lv_label_set_text(), in order
+                "styles": {"MAIN": {"text_font": "lv_font_montserrat_24"},
+                           "INDICATOR|PRESSED": {"arc_color": "0x00D3FF", "arc_opa": 255}},
+                "children": [...]
+            }
+        ]
+    }
+"""
+
+import argparse
+import json
+import os
+import sys
+
+GEOMETRY = ("width", "height", "x", "y", "align")
+# lv_obj_set_width() etc. of the calls mode, they set the same properties as the const styles
+GEOMETRY_SETTERS = {"width": "lv_obj_set_width", "height": "lv_obj_set_height", "x": "lv_obj_set_x",
+                    "y": "lv_obj_set_y", "align": "lv_obj_set_align"}
+MAX_DEPTH = 8  # LVGL_UI_MAX_DEPTH of lvgl_hw_ui.h
+
+
+class GenError(Exception):
+    pass
+
+
+def load(path):
+    with open(path, encoding="utf-8") as f:
+        if path.endswith((".yaml", ".yml")):
+            import yaml  # only needed for YAML descriptions
+            return yaml.safe_load(f)
+        return json.load(f)
+
+
+def c_str(s):
+    out = ""
+    for ch in s:
+        if ch in "\\\"":
+            out += "\\" + ch
+        elif ch == "\n":
+            out += "\\n"
+        elif ord(ch) < 0x20 or ord(ch) > 0x7E:
+            # UTF-8 bytes, in a string of their own so no hex digit follows
+            out += "".join("\\x%02X\"\"" % b for b in ch.encode("utf-8"))
+        else:
+            out += ch
+    return "\"" + out + "\""
+
+
+def c_arg(v):
+    if isinstance(v, bool):
+        return "true" if v else "false"
+    if isinstance(v, int):
+        return str(v)
+    if isinstance(v, str):
+        return c_str(v)
+    raise GenError("unsupported argument %r" % (v,))
+
+
+def rgb(v):
+    s = str(v)
+    if s.startswith("#"):
+        s = "0x" + s[1:]
+    try:
+        c = int(s, 16)
+    except ValueError:
+        raise GenError("bad color %r, expected 0xRRGGBB or #RRGGBB" % (v,))
+    return c
+
+
+def prop_value(name, v, const):
+    """C expression of a style property value"""
+    if name.endswith("_color"):
+        c = rgb(v)
+        if const:
+            return "LV_COLOR_MAKE(0x%02X, 0x%02X, 0x%02X)" % (c >> 16, (c >> 8) & 0xFF, c & 0xFF)
+        return "lv_color_hex(0x%06X)" % c
+    if name.endswith("_font"):
+        return "&" + v
+    if isinstance(v, bool):
+        raise GenError("bad value %r of %s" % (v, name))
+    if isinstance(v, int):
+        return str(v)
+    if isinstance(v, str):
+        if name == "align":
+            return "LV_ALIGN_" + v.upper()
+        if v == "content":
+            return "LV_SIZE_CONTENT"
+        if v.endswith("%"):
+            return "LV_PCT(%d)" % int(v[:-1])
+        if v.startswith("LV_"):
+            return v
+    raise GenError("bad value %r of %s" % (v, name))
+
+
+def selector(key):
+    part, _, state = key.partition("|")
+    return "LV_PART_%s | LV_STATE_%s" % (part.strip().upper(), (state.strip() or "DEFAULT").upper())
+
+
+def flags(names):
+    return " | ".join("LV_OBJ_FLAG_" + n.upper() for n in names)
+
+
+class Obj:
+    def __init__(self, desc, depth, index):
+        self.desc = desc
+        self.depth = depth
+        self.index = index
+        self.type = desc.get("type", "obj")
+        self.name = desc.get("name")
+
+
+class Generator:
+    def __init__(self, desc, suffix):
+        self.suffix = suffix
+        self.screen = desc["screen"]
+        self.objs = []
+        root = dict(desc)
+        root["name"] = self.screen
+        self.walk(root, 0)
+
+    def walk(self, desc, depth):
+        if depth >= MAX_DEPTH:
+            raise GenError("%s is nested deeper than %d" % (desc.get("name", "an object"), MAX_DEPTH))
+        unknown = set(desc) - set(GEOMETRY) - {"screen", "type", "name", "comment", "flags_add",
+                                                "flags_clear", "set", "styles", "children"}
+        if unknown:
+            raise GenError("unknown keys %s" % ", ".join(sorted(unknown)))
+        if depth and "type" not in desc:
+            raise GenError("%s has no type" % desc.get("name", "an object"))
+        self.objs.append(Obj(desc, depth, len(self.objs)))
+        for child in desc.get("children", []):
+            self.walk(child, depth + 1)
+
+    def sym(self, name):
+        return name + self.suffix
+
+    def var(self, o):
+        return self.sym(o.name) if o.name else "obj%d" % o.index
+
+    def setters(self, o, const):
+        """The lv_<type>_set_*() calls of an object as (function, args)"""
+        calls = []
+        for key, v in o.desc.get("set", {}).items():
+            fn = "lv_%s_set_%s" % (o.type, key)
+            if o.type == "label" and key == "text" and const:
+                # the text stays in flash instead of a copy in the heap
+                fn = "lv_label_set_text_static"
+            args = v if isinstance(v, list) else [v]
+            calls.append((fn, [c_arg(a) for a in args]))
+        return calls
+
+    def header(self, out_name):
+        guard = "_%s_H" % out_name.upper()
+        lines = ["// Generated by tools/lvgl_ui_gen.py, do not edit", "",
+                 "#ifndef %s" % guard, "#define %s" % guard, "",
+                 "#ifdef __cplusplus", "extern \"C\"", "{", "#endif", "",
+                 "#include \"lvgl.h\"", ""]
+        for o in self.objs:
+            if o.name:
+                lines.append("    extern lv_obj_t *%s;" % self.sym(o.name))
+        lines += ["", "    void %s(void);" % self.sym(self.screen + "_screen_init"), "",
+                  "#ifdef __cplusplus", "}", "#endif", "", "#endif", ""]
+        return "\n".join(lines)
+
+    def source_start(self, out_name, src_name):
+        lines = ["// Generated by tools/lvgl_ui_gen.py from %s, do not edit" % src_name, "",
+                 "#include \"%s.h\"" % out_name]
+        return lines
+
+    def globals(self):
+        return ["lv_obj_t *%s;" % self.sym(o.name) for o in self.objs if o.name]
+
+    def source_const(self, out_name, src_name):
+        lines = self.source_start(out_name, src_name) + ["#include \"lvgl_hw_ui.h\"", ""]
+        lines += self.globals() + [""]
+
+        # the styles, objects with the same properties share one
+        styles = {}
+        style_lines = []
+        obj_styles = []
+        for o in self.objs:
+            groups = []
+            geometry = [(k, o.desc[k]) for k in GEOMETRY if k in o.desc]
+            parts = dict(o.desc.get("styles", {}))
+            main = geometry + list(parts.pop("MAIN", {}).items())
+            if main:
+                groups.append(("MAIN", main))
+            groups += [(k, list(v.items())) for k, v in parts.items()]
+
+            refs = []
+            for sel, props in groups:
+                if not props:
+                    continue
+                entries = tuple("LV_STYLE_CONST_%s(%s)" % (k.upper(), prop_value(k, v, True)) for k, v in props)
+                if entries not in styles:
+                    name = self.sym("%s_style_%d" % (self.screen, len(styles)))
+                    styles[entries] = name
+                    style_lines.append("static const lv_style_const_prop_t %s_props[] = {" % name)
+                    style_lines += ["    %s," % e for e in entries]
+                    style_lines += ["};", "static LV_STYLE_CONST_INIT(%s, %s_props);" % (name, name), ""]
+                refs.append((styles[entries], selector(sel)))
+            obj_styles.append(refs)
+        lines += style_lines
+
+        for o, refs in zip(self.objs, obj_styles):
+            if refs:
+                lines.append("static const lvgl_ui_style_t %s_styles[] = {" % self.item(o))
+                lines += ["    {&%s, %s}," % r for r in refs]
+                lines += ["};", ""]
+
+        for o in self.objs:
+            calls = self.setters(o, True)
+            if calls:
+                lines += ["static void %s_init(lv_obj_t *obj)" % self.item(o), "{"]
+                lines += ["    %s(obj, %s);" % (fn, ", ".join(args)) for fn, args in calls]
+                lines += ["}", ""]
+
+        table = self.sym(self.screen + "_objs")
+        lines.append("static const lvgl_ui_obj_t %s[] = {" % table)
+        for o, refs in zip(self.objs, obj_styles):
+            if "comment" in o.desc:
+                lines.append("    // %s" % o.desc["comment"])
+            fields = [".create = lv_%s_create" % o.type, ".var = %s" % ("&" + self.sym(o.name) if o.name else "NULL")]
+            if refs:
+                fields += [".styles = %s_styles" % self.item(o), ".style_cnt = %d" % len(refs)]
+            fields.append(".depth = %d" % o.depth)
+            if o.desc.get("flags_add"):
+                fields.append(".flags_add = " + flags(o.desc["flags_add"]))
+            if o.desc.get("flags_clear"):
+                fields.append(".flags_clear = " + flags(o.desc["flags_clear"]))
+            if self.setters(o, True):
+                fields.append(".init = %s_init" % self.item(o))
+            lines.append("    {%s}," % ", ".join(fields))
+        lines += ["};", ""]
+
+        lines += ["void %s(void)" % self.sym(self.screen + "_screen_init"), "{",
+                  "    lvgl_ui_create(%s, sizeof(%s) / sizeof(%s[0]));" % (table, table, table), "}", ""]
+        return "\n".join(lines)
+
+    def item(self, o):
+        """Prefix of the static symbols of an object"""
+        return self.sym(o.name) if o.name else self.sym("%s_obj%d" % (self.screen, o.index))
+
+    def source_calls(self, out_name, src_name):
+        lines = self.source_start(out_name, src_name) + [""]
+        lines += self.globals() + [""]
+        lines += ["void %s(void)" % self.sym(self.screen + "_screen_init"), "{"]
+        locals_ = ["obj%d" % o.index for o in self.objs if not o.name]
+        if locals_:
+            lines.append("    lv_obj_t *%s;" % ", *".join(locals_))
+
+        parents = []
+        for o in self.objs:
+            del parents[o.depth:]
+            v = self.var(o)
+            if o.index or locals_:
+                lines.append("")
+            lines.append("    // %s" % (o.name or "obj%d" % o.index))
+            if "comment" in o.desc:
+                lines.append("    // %s" % o.desc["comment"])
+            lines.append("    %s = lv_%s_create(%s);" % (v, o.type, parents[-1] if parents else "NULL"))
+            parents.append(v)
+
+            for k in GEOMETRY:
+                if k in o.desc:
+                    lines.append("    %s(%s, %s);" % (GEOMETRY_SETTERS[k], v, prop_value(k, o.desc[k], False)))
+            if o.desc.get("flags_add"):
+                lines.append("    lv_obj_add_flag(%s, %s);" % (v, flags(o.desc["flags_add"])))
+            if o.desc.get("flags_clear"):
+                lines.append("    lv_obj_clear_flag(%s, %s);" % (v, flags(o.desc["flags_clear"])))
+            for fn, args in self.setters(o, False):
+                lines.append("    %s(%s, %s);" % (fn, v, ", ".join(args)))
+            for sel, props in o.desc.get("styles", {}).items():
+                for k, val in props.items():
+                    lines.append("    lv_obj_set_style_%s(%s, %s, %s);" % (k, v, prop_value(k, val, False),
+                                                                            selector(sel)))
+        lines += ["}", ""]
+        return "\n".join(lines)
+
+
+def write(path, text):
+    with open(path, "w", encoding="utf-8") as f:
+        f.write(text)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate the C code of a screen from its JSON/YAML description")
+    parser.add_argument("input", help="ui/<screen>.json or .yaml")
+    parser.add_argument("-o", "--out-dir", default=".", help="directory of <screen><suffix>.c and .h")
+    parser.add_argument("--mode", choices=("const", "calls"), default="const",
+                        help="const styles and an object table (default) or lv_obj_set_style_*() calls")
+    parser.add_argument("--suffix", default="", help="appended to every global symbol and the file names")
+    args = parser.parse_args()
+
+    try:
+        desc = load(args.input)
+        gen = Generator(desc, args.suffix)
+        out_name = gen.sym(gen.screen)
+        src_name = os.path.basename(args.input)
+        if args.mode == "const":
+            source = gen.source_const(out_name, src_name)
+        else:
+            source = gen.source_calls(out_name, src_name)
+        header = gen.header(out_name)
+    except (GenError, KeyError, ValueError) as e:
+        sys.exit("%s: %s" % (args.input, e))
+
+    os.makedirs(args.out_dir, exist_ok=True)
+    write(os.path.join(args.out_dir, out_name + ".c"), source)
+    write(os.path.join(args.out_dir, out_name + ".h"), header)
+
+
+if __name__ == "__main__":
+    main()